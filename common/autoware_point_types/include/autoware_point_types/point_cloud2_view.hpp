@@ -0,0 +1,229 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_POINT_TYPES__POINT_CLOUD2_VIEW_HPP_
+#define AUTOWARE_POINT_TYPES__POINT_CLOUD2_VIEW_HPP_
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/size.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <pcl/for_each_type.h>
+#include <pcl/point_traits.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace autoware_point_types
+{
+/**
+ * @brief read a scalar stored with the given PointField datatype and convert it to T
+ */
+template <class T>
+T readAs(const std::uint8_t * data, const std::uint8_t datatype)
+{
+  const auto read = [data](auto value) {
+    std::memcpy(&value, data, sizeof(value));
+    return static_cast<T>(value);
+  };
+  using sensor_msgs::msg::PointField;
+  switch (datatype) {
+    case PointField::INT8:
+      return read(std::int8_t{});
+    case PointField::UINT8:
+      return read(std::uint8_t{});
+    case PointField::INT16:
+      return read(std::int16_t{});
+    case PointField::UINT16:
+      return read(std::uint16_t{});
+    case PointField::INT32:
+      return read(std::int32_t{});
+    case PointField::UINT32:
+      return read(std::uint32_t{});
+    case PointField::FLOAT32:
+      return read(float{});
+    case PointField::FLOAT64:
+      return read(double{});
+    default:
+      return T{};
+  }
+}
+
+/**
+ * @brief read only typed access to the points of a PointCloud2, without conversion nor copy
+ * @details PointT must be registered with POINT_CLOUD_REGISTER_POINT_STRUCT and have scalar fields.
+ * If the message has exactly the memory layout of PointT (same field offsets and datatypes,
+ * point_step == sizeof(PointT), no row padding, little endian), the fields are read at their
+ * compile time offset. Otherwise each field of PointT is looked up by name in the message and
+ * converted from the datatype of the message, the fields which are missing read as 0.
+ */
+template <class PointT>
+class PointCloud2View
+{
+  using FieldList = typename pcl::traits::fieldList<PointT>::type;
+  static constexpr std::size_t num_fields = boost::mpl::size<FieldList>::value;
+
+  template <class Tag>
+  using FieldType = typename pcl::traits::datatype<PointT, Tag>::type;
+
+  template <class Tag>
+  static constexpr std::size_t fieldIndex()
+  {
+    return boost::mpl::distance<
+      typename boost::mpl::begin<FieldList>::type,
+      typename boost::mpl::find<FieldList, Tag>::type>::value;
+  }
+
+public:
+  explicit PointCloud2View(const sensor_msgs::msg::PointCloud2 & msg)
+  : data_(msg.data.data()),
+    size_(static_cast<std::size_t>(msg.width) * msg.height),
+    width_(msg.width),
+    point_step_(msg.point_step),
+    row_step_(msg.row_step),
+    is_contiguous_(msg.height <= 1 || msg.row_step == msg.width * msg.point_step)
+  {
+    if (msg.data.size() < (msg.height == 0 ? 0 : (msg.height - 1) * msg.row_step) +
+                            static_cast<std::size_t>(msg.width) * msg.point_step) {
+      size_ = 0;  // truncated message
+    }
+    bool is_exact_layout = !msg.is_bigendian && is_contiguous_ && point_step_ == sizeof(PointT);
+    pcl::for_each_type<FieldList>(FieldLookup{msg, *this, is_exact_layout});
+    is_exact_layout_ = is_exact_layout;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /// @brief true if the message is an array of PointT, the fields are read at fixed offsets
+  bool isExactLayout() const { return is_exact_layout_; }
+
+  /// @brief true if the message has a field with the name of Tag
+  template <class Tag>
+  bool hasField() const
+  {
+    return field_offsets_[fieldIndex<Tag>()] >= 0;
+  }
+
+  /// @brief read the field Tag of the i-th point, 0 if the message does not have this field
+  template <class Tag>
+  FieldType<Tag> get(const std::size_t i) const
+  {
+    FieldType<Tag> value{};
+    if (is_exact_layout_) {
+      std::memcpy(
+        &value, data_ + i * sizeof(PointT) + pcl::traits::offset<PointT, Tag>::value,
+        sizeof(value));
+      return value;
+    }
+    constexpr std::size_t field_index = fieldIndex<Tag>();
+    if (field_offsets_[field_index] < 0) {
+      return value;
+    }
+    return readAs<FieldType<Tag>>(
+      data_ + pointOffset(i) + field_offsets_[field_index], field_datatypes_[field_index]);
+  }
+
+  /// @brief copy the i-th point
+  PointT operator[](const std::size_t i) const
+  {
+    PointT point{};
+    if (is_exact_layout_) {
+      std::memcpy(&point, data_ + i * sizeof(PointT), sizeof(PointT));
+      return point;
+    }
+    pcl::for_each_type<FieldList>(FieldCopy{*this, data_ + pointOffset(i), point});
+    return point;
+  }
+
+  /// @brief raw bytes of the i-th point in the message
+  const std::uint8_t * pointData(const std::size_t i) const { return data_ + pointOffset(i); }
+
+private:
+  // find the offset and datatype of every field of PointT in the message
+  struct FieldLookup
+  {
+    const sensor_msgs::msg::PointCloud2 & msg;
+    PointCloud2View & view;
+    bool & is_exact_layout;
+
+    template <class Tag>
+    void operator()()
+    {
+      constexpr std::size_t field_index = fieldIndex<Tag>();
+      view.field_offsets_[field_index] = -1;
+      for (const auto & field : msg.fields) {
+        if (field.name != pcl::traits::name<PointT, Tag>::value || field.count != 1) {
+          continue;
+        }
+        view.field_offsets_[field_index] = static_cast<std::int64_t>(field.offset);
+        view.field_datatypes_[field_index] = field.datatype;
+        is_exact_layout = is_exact_layout &&
+                          field.offset == pcl::traits::offset<PointT, Tag>::value &&
+                          field.datatype == pcl::traits::datatype<PointT, Tag>::value;
+        return;
+      }
+      is_exact_layout = false;
+    }
+  };
+
+  // copy every field found in the message to the point
+  struct FieldCopy
+  {
+    const PointCloud2View & view;
+    const std::uint8_t * point_data;
+    PointT & point;
+
+    template <class Tag>
+    void operator()()
+    {
+      constexpr std::size_t field_index = fieldIndex<Tag>();
+      if (view.field_offsets_[field_index] < 0) {
+        return;
+      }
+      const auto value = readAs<FieldType<Tag>>(
+        point_data + view.field_offsets_[field_index], view.field_datatypes_[field_index]);
+      std::memcpy(
+        reinterpret_cast<std::uint8_t *>(&point) + pcl::traits::offset<PointT, Tag>::value, &value,
+        sizeof(value));
+    }
+  };
+
+  std::size_t pointOffset(const std::size_t i) const
+  {
+    return is_contiguous_ ? i * point_step_ : (i / width_) * row_step_ + (i % width_) * point_step_;
+  }
+
+  const std::uint8_t * data_;
+  std::size_t size_;
+  std::size_t width_;
+  std::size_t point_step_;
+  std::size_t row_step_;
+  bool is_contiguous_;
+  bool is_exact_layout_{false};
+
+  // offset and datatype of every field of PointT in the message, -1 if the field is missing
+  std::array<std::int64_t, num_fields> field_offsets_{};
+  std::array<std::uint8_t, num_fields> field_datatypes_{};
+};
+
+}  // namespace autoware_point_types
+
+#endif  // AUTOWARE_POINT_TYPES__POINT_CLOUD2_VIEW_HPP_
@@ -0,0 +1,150 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_POINT_TYPES__RING_AZIMUTH_INDEX_HPP_
+#define AUTOWARE_POINT_TYPES__RING_AZIMUTH_INDEX_HPP_
+
+#include "autoware_point_types/point_cloud2_view.hpp"
+#include "autoware_point_types/types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace autoware_point_types
+{
+/**
+ * @brief point indices of a scan organized as a ring x azimuth grid
+ * @details the points are grouped by ring, then by azimuth bin, with a stable counting sort:
+ * the points of the same cell keep the order of the message. With a single azimuth bin, every
+ * ring keeps the firing order of the message.
+ * If the message is already ordered by ring and azimuth bin, for instance because the driver
+ * publishes it so, no point is moved and isIdentity() returns true: the points of a cell are
+ * then contiguous in the message and can be read without indirection.
+ * The buffers are reused between calls to build().
+ */
+class RingAzimuthIndex
+{
+public:
+  /**
+   * @param azimuth_resolution width of an azimuth bin, in the unit of the azimuth field
+   * (0.01 deg), 0 for a single bin per ring
+   */
+  explicit RingAzimuthIndex(const float azimuth_resolution = 0.0f)
+  : azimuth_resolution_(azimuth_resolution),
+    num_azimuth_bins_(
+      azimuth_resolution > 0.0f
+        ? static_cast<std::size_t>(std::ceil(max_azimuth / azimuth_resolution))
+        : 1)
+  {
+  }
+
+  /// @brief index the points of the view, PointT must have ring and azimuth fields
+  template <class PointT>
+  void build(const PointCloud2View<PointT> & view)
+  {
+    const std::size_t num_points = view.size();
+    cell_keys_.resize(num_points);
+    std::size_t num_rings = 0;
+    is_identity_ = true;
+    for (std::size_t i = 0; i < num_points; ++i) {
+      const std::size_t ring = view.template get<pcl::fields::ring>(i);
+      std::size_t key = ring * num_azimuth_bins_;
+      if (num_azimuth_bins_ > 1) {
+        key += azimuthBin(view.template get<pcl::fields::azimuth>(i));
+      }
+      cell_keys_[i] = static_cast<std::uint32_t>(key);
+      num_rings = std::max(num_rings, ring + 1);
+      is_identity_ = is_identity_ && (i == 0 || cell_keys_[i - 1] <= key);
+    }
+    num_rings_ = num_rings;
+
+    cell_offsets_.assign(num_rings_ * num_azimuth_bins_ + 1, 0);
+    for (const auto key : cell_keys_) {
+      ++cell_offsets_[key + 1];
+    }
+    std::partial_sum(cell_offsets_.begin(), cell_offsets_.end(), cell_offsets_.begin());
+
+    indices_.resize(num_points);
+    if (is_identity_) {
+      std::iota(indices_.begin(), indices_.end(), 0U);
+      return;
+    }
+    // scatter with the begin offsets, which are then shifted back by one cell
+    for (std::size_t i = 0; i < num_points; ++i) {
+      indices_[cell_offsets_[cell_keys_[i]]++] = static_cast<std::uint32_t>(i);
+    }
+    for (std::size_t cell = cell_offsets_.size() - 1; cell > 0; --cell) {
+      cell_offsets_[cell] = cell_offsets_[cell - 1];
+    }
+    cell_offsets_[0] = 0;
+  }
+
+  /// @brief rings are numbered from 0 to getNumRings() - 1, some of them may be empty
+  std::size_t getNumRings() const { return num_rings_; }
+  std::size_t getNumAzimuthBins() const { return num_azimuth_bins_; }
+  std::size_t size() const { return indices_.size(); }
+
+  /// @brief true if the message was already ordered by ring and azimuth bin
+  bool isIdentity() const { return is_identity_; }
+
+  /// @brief point indices of a ring (< getNumRings()), ordered by azimuth bin
+  const std::uint32_t * ringBegin(const std::size_t ring) const
+  {
+    return indices_.data() + cell_offsets_[ring * num_azimuth_bins_];
+  }
+  const std::uint32_t * ringEnd(const std::size_t ring) const
+  {
+    return indices_.data() + cell_offsets_[(ring + 1) * num_azimuth_bins_];
+  }
+
+  /// @brief point indices of a (ring, azimuth bin) cell
+  const std::uint32_t * cellBegin(const std::size_t ring, const std::size_t azimuth_bin) const
+  {
+    return indices_.data() + cell_offsets_[ring * num_azimuth_bins_ + azimuth_bin];
+  }
+  const std::uint32_t * cellEnd(const std::size_t ring, const std::size_t azimuth_bin) const
+  {
+    return indices_.data() + cell_offsets_[ring * num_azimuth_bins_ + azimuth_bin + 1];
+  }
+
+  /// @brief azimuth bin of an azimuth in [0, 36000), the out of range values are clamped
+  std::size_t azimuthBin(const float azimuth) const
+  {
+    if (!(azimuth > 0.0f)) {
+      return 0;
+    }
+    return std::min(
+      static_cast<std::size_t>(azimuth / azimuth_resolution_), num_azimuth_bins_ - 1);
+  }
+
+private:
+  static constexpr float max_azimuth = 36000.0f;
+
+  float azimuth_resolution_;
+  std::size_t num_azimuth_bins_;
+  std::size_t num_rings_{0};
+  bool is_identity_{true};
+
+  std::vector<std::uint32_t> cell_keys_;
+  std::vector<std::uint32_t> cell_offsets_{0};
+  std::vector<std::uint32_t> indices_;
+};
+
+}  // namespace autoware_point_types
+
+#endif  // AUTOWARE_POINT_TYPES__RING_AZIMUTH_INDEX_HPP_
@@ -90,6 +90,10 @@ using PointXYZIRADRTGenerator = std::tuple<
 
 }  // namespace autoware_point_types
 
+POINT_CLOUD_REGISTER_POINT_STRUCT(
+  autoware_point_types::PointXYZI,
+  (float, x, x)(float, y, y)(float, z, z)(float, intensity, intensity))
+
 POINT_CLOUD_REGISTER_POINT_STRUCT(
   autoware_point_types::PointXYZIRADRT,
   (float, x, x)(float, y, y)(float, z, z)(float, intensity, intensity)(std::uint16_t, ring, ring)(
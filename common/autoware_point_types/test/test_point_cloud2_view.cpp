@@ -0,0 +1,178 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_point_types/point_cloud2_view.hpp"
+#include "autoware_point_types/ring_azimuth_index.hpp"
+#include "autoware_point_types/types.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using autoware_point_types::PointCloud2View;
+using autoware_point_types::PointXYZI;
+using autoware_point_types::PointXYZIRADRT;
+using autoware_point_types::PointXYZIRADRTGenerator;
+using autoware_point_types::RingAzimuthIndex;
+using point_cloud_msg_wrapper::PointCloud2Modifier;
+using sensor_msgs::msg::PointCloud2;
+using sensor_msgs::msg::PointField;
+
+namespace
+{
+PointCloud2 createCloud(const std::vector<PointXYZIRADRT> & points)
+{
+  PointCloud2 cloud;
+  PointCloud2Modifier<PointXYZIRADRT, PointXYZIRADRTGenerator> modifier{cloud, "base_link"};
+  for (const auto & point : points) {
+    modifier.push_back(point);
+  }
+  return cloud;
+}
+
+PointField createField(const std::string & name, const uint32_t offset, const uint8_t datatype)
+{
+  PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  return field;
+}
+}  // namespace
+
+TEST(PointCloud2View, ExactLayout)
+{
+  const std::vector<PointXYZIRADRT> points{
+    {0, 1, 2, 3, 4, 5, 6, 7, 8}, {10, 11, 12, 13, 14, 15, 16, 17, 18}};
+  const auto cloud = createCloud(points);
+
+  const PointCloud2View<PointXYZIRADRT> view(cloud);
+  ASSERT_TRUE(view.isExactLayout());
+  ASSERT_EQ(view.size(), 2U);
+  EXPECT_EQ(view[0], points[0]);
+  EXPECT_EQ(view[1], points[1]);
+  EXPECT_FLOAT_EQ(view.get<pcl::fields::y>(1), 11.0f);
+  EXPECT_EQ(view.get<pcl::fields::ring>(1), 14U);
+  EXPECT_EQ(view.get<pcl::fields::return_type>(0), 7U);
+  EXPECT_DOUBLE_EQ(view.get<pcl::fields::time_stamp>(1), 18.0);
+
+  // a view over a subset of the fields reads them at their offset in the message
+  const PointCloud2View<PointXYZI> xyzi_view(cloud);
+  EXPECT_FALSE(xyzi_view.isExactLayout());
+  EXPECT_EQ(xyzi_view[1], (PointXYZI{10, 11, 12, 13}));
+}
+
+TEST(PointCloud2View, RuntimeLayout)
+{
+  // organized cloud with padded rows, uint8 intensity, fields out of order and no azimuth
+  PointCloud2 cloud;
+  cloud.height = 2;
+  cloud.width = 2;
+  cloud.point_step = 16;
+  cloud.row_step = 40;
+  cloud.fields = {
+    createField("ring", 13, PointField::UINT16), createField("x", 0, PointField::FLOAT32),
+    createField("y", 4, PointField::FLOAT32), createField("z", 8, PointField::FLOAT32),
+    createField("intensity", 12, PointField::UINT8)};
+  cloud.data.assign(cloud.height * cloud.row_step, 0);
+  for (uint32_t row = 0; row < cloud.height; ++row) {
+    for (uint32_t col = 0; col < cloud.width; ++col) {
+      uint8_t * data = cloud.data.data() + row * cloud.row_step + col * cloud.point_step;
+      const float x = static_cast<float>(row * cloud.width + col);
+      const uint16_t ring = static_cast<uint16_t>(row);
+      std::memcpy(data, &x, sizeof(x));
+      data[12] = 200;
+      std::memcpy(data + 13, &ring, sizeof(ring));
+    }
+  }
+
+  const PointCloud2View<PointXYZIRADRT> view(cloud);
+  ASSERT_FALSE(view.isExactLayout());
+  ASSERT_EQ(view.size(), 4U);
+  EXPECT_FALSE(view.hasField<pcl::fields::azimuth>());
+  EXPECT_TRUE(view.hasField<pcl::fields::ring>());
+  EXPECT_FLOAT_EQ(view.get<pcl::fields::x>(3), 3.0f);
+  EXPECT_EQ(view.get<pcl::fields::ring>(2), 1U);
+  EXPECT_FLOAT_EQ(view.get<pcl::fields::azimuth>(2), 0.0f);
+  const auto point = view[3];
+  EXPECT_FLOAT_EQ(point.x, 3.0f);
+  EXPECT_FLOAT_EQ(point.intensity, 200.0f);
+  EXPECT_EQ(point.ring, 1U);
+
+  // truncated data
+  cloud.data.resize(50);
+  EXPECT_TRUE(PointCloud2View<PointXYZIRADRT>(cloud).empty());
+}
+
+TEST(RingAzimuthIndex, Build)
+{
+  std::vector<PointXYZIRADRT> points;
+  for (uint16_t i = 0; i < 12; ++i) {
+    PointXYZIRADRT point;
+    point.ring = static_cast<uint16_t>((i * 7) % 3);
+    point.azimuth = static_cast<float>((i * 5000) % 36000);
+    point.x = static_cast<float>(i);
+    points.push_back(point);
+  }
+  const auto cloud = createCloud(points);
+  const PointCloud2View<PointXYZIRADRT> view(cloud);
+
+  // one bin per ring: the points of a ring stay in the message order
+  RingAzimuthIndex ring_index;
+  ring_index.build(view);
+  EXPECT_FALSE(ring_index.isIdentity());
+  ASSERT_EQ(ring_index.getNumRings(), 3U);
+  for (size_t ring = 0; ring < ring_index.getNumRings(); ++ring) {
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < points.size(); ++i) {
+      if (points[i].ring == ring) expected.push_back(i);
+    }
+    EXPECT_EQ(
+      std::vector<uint32_t>(ring_index.ringBegin(ring), ring_index.ringEnd(ring)), expected);
+  }
+
+  // 10 deg bins: every cell holds the points of its ring and azimuth bin
+  RingAzimuthIndex grid_index(1000.0f);
+  grid_index.build(view);
+  ASSERT_EQ(grid_index.getNumAzimuthBins(), 36U);
+  size_t num_indexed = 0;
+  for (size_t ring = 0; ring < grid_index.getNumRings(); ++ring) {
+    float last_azimuth = -1.0f;
+    for (size_t bin = 0; bin < grid_index.getNumAzimuthBins(); ++bin) {
+      for (auto it = grid_index.cellBegin(ring, bin); it != grid_index.cellEnd(ring, bin); ++it) {
+        EXPECT_EQ(points[*it].ring, ring);
+        EXPECT_EQ(grid_index.azimuthBin(points[*it].azimuth), bin);
+        EXPECT_GE(points[*it].azimuth, last_azimuth);
+        last_azimuth = points[*it].azimuth;
+        ++num_indexed;
+      }
+    }
+  }
+  EXPECT_EQ(num_indexed, points.size());
+
+  // a cloud already sorted by ring and azimuth is indexed without moving any point
+  std::vector<PointXYZIRADRT> sorted_points;
+  for (size_t ring = 0; ring < grid_index.getNumRings(); ++ring) {
+    for (auto it = grid_index.ringBegin(ring); it != grid_index.ringEnd(ring); ++it) {
+      sorted_points.push_back(points[*it]);
+    }
+  }
+  const auto sorted_cloud = createCloud(sorted_points);
+  grid_index.build(PointCloud2View<PointXYZIRADRT>(sorted_cloud));
+  EXPECT_TRUE(grid_index.isIdentity());
+  EXPECT_EQ(grid_index.size(), points.size());
+}
@@ -0,0 +1,97 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gnn_solver/gnn_solver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Random scenes where trackers and measurements are spread on a 200m x 200m area and only pairs
+// closer than the gating distance get a score, as in the multi object tracker
+std::vector<std::vector<double>> randomScoreMatrix(
+  const int n_trackers, const int n_measurements, std::default_random_engine & engine)
+{
+  constexpr double max_dist = 5.0;
+  std::uniform_real_distribution<double> position_dist(-100.0, 100.0);
+  std::normal_distribution<double> noise_dist(0.0, 1.0);
+  std::vector<std::pair<double, double>> trackers(n_trackers);
+  for (auto & [x, y] : trackers) {
+    x = position_dist(engine);
+    y = position_dist(engine);
+  }
+  std::vector<std::vector<double>> score(n_trackers, std::vector<double>(n_measurements, 0.0));
+  for (int m = 0; m < n_measurements; ++m) {
+    // most measurements are close to a tracker
+    const auto & [tx, ty] = trackers[m % n_trackers];
+    const double x = m < n_trackers ? tx + noise_dist(engine) : position_dist(engine);
+    const double y = m < n_trackers ? ty + noise_dist(engine) : position_dist(engine);
+    for (int t = 0; t < n_trackers; ++t) {
+      const double dist = std::hypot(trackers[t].first - x, trackers[t].second - y);
+      if (dist < max_dist) score[t][m] = (max_dist - dist) / max_dist;
+    }
+  }
+  return score;
+}
+
+template <class Solver>
+double solveTime(
+  Solver & solver, const std::vector<std::vector<std::vector<double>>> & scores,
+  double & total_score)
+{
+  total_score = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto & score : scores) {
+    std::unordered_map<int, int> direct_assignment;
+    std::unordered_map<int, int> reverse_assignment;
+    solver.maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+    for (const auto & [agent, task] : direct_assignment) total_score += score[agent][task];
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / scores.size();
+}
+
+int main()
+{
+  constexpr int nb_iterations = 20;
+  std::default_random_engine engine(0);
+  gnn_solver::SSP ssp;
+  gnn_solver::MuSSP mussp;
+  gnn_solver::SparseSSP sparse_ssp;
+
+  std::printf("#Trackers Measurements SSP[ms] muSSP[ms] SparseSSP[ms] score_diff\n");
+  for (const auto nb_objects : {10, 50, 100, 200, 500, 1000}) {
+    std::vector<std::vector<std::vector<double>>> scores;
+    for (int i = 0; i < nb_iterations; ++i) {
+      scores.push_back(randomScoreMatrix(nb_objects, nb_objects + nb_objects / 5, engine));
+    }
+    double ssp_score;
+    double mussp_score;
+    double sparse_ssp_score;
+    const double ssp_time = solveTime(ssp, scores, ssp_score);
+    const double mussp_time = solveTime(mussp, scores, mussp_score);
+    const double sparse_ssp_time = solveTime(sparse_ssp, scores, sparse_ssp_score);
+    const double score_diff = std::max(
+      std::abs(ssp_score - sparse_ssp_score), std::abs(mussp_score - sparse_ssp_score));
+    std::printf(
+      "%d %d %f %f %f %e\n", nb_objects, nb_objects + nb_objects / 5, ssp_time, mussp_time,
+      sparse_ssp_time, score_diff);
+  }
+  return 0;
+}
@@ -12,14 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_INTERFACE_HPP_
-#define MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_INTERFACE_HPP_
+#ifndef GNN_SOLVER__GNN_SOLVER_INTERFACE_HPP_
+#define GNN_SOLVER__GNN_SOLVER_INTERFACE_HPP_
 
 #include <unordered_map>
 #include <vector>
 
 namespace gnn_solver
 {
+struct AssignmentEdge
+{
+  int agent;
+  int task;
+  double score;
+};
+
 class GnnSolverInterface
 {
 public:
@@ -32,4 +39,4 @@ public:
 };
 }  // namespace gnn_solver
 
-#endif  // MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_INTERFACE_HPP_
+#endif  // GNN_SOLVER__GNN_SOLVER_INTERFACE_HPP_
@@ -0,0 +1,93 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GNN_SOLVER__SPARSE_SUCCESSIVE_SHORTEST_PATH_HPP_
+#define GNN_SOLVER__SPARSE_SUCCESSIVE_SHORTEST_PATH_HPP_
+
+#include "gnn_solver/gnn_solver_interface.hpp"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gnn_solver
+{
+/**
+ * @brief Successive shortest path solver working on a sparse list of gated (agent, task) scores
+ * @details The problem is split into the connected components of the bipartite graph, which are
+ *          solved independently (in parallel when OpenMP is available). All buffers are kept as
+ *          members and reused across calls.
+ */
+class SparseSSP : public GnnSolverInterface
+{
+public:
+  SparseSSP() = default;
+  ~SparseSSP() = default;
+
+  void maximizeLinearAssignment(
+    const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment) override;
+
+  /**
+   * @brief maximize the sum of scores of the assigned pairs
+   * @param n_agents number of agents
+   * @param n_tasks number of tasks
+   * @param edges gated (agent, task) pairs with a positive score, pairs not in the list can not
+   *              be assigned
+   */
+  void maximizeLinearAssignment(
+    const int n_agents, const int n_tasks, const std::vector<AssignmentEdge> & edges,
+    std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment);
+
+private:
+  struct Component
+  {
+    int agent_begin;
+    int task_begin;
+    int n_agents;
+    int n_tasks;
+  };
+
+  struct Workspace
+  {
+    std::vector<double> potentials;
+    std::vector<double> distances;
+    std::vector<char> is_visited;
+    std::vector<int> prev;
+    std::vector<int> matched_edge;
+    std::vector<std::pair<double, int>> heap;
+  };
+
+  int findRoot(int node);
+  void solveComponent(const Component & component, Workspace & workspace);
+
+  // union-find over agents [0, n_agents) and tasks [n_agents, n_agents + n_tasks)
+  std::vector<int> parents_;
+  // edges (with local agent/task indexes) sorted by component then by agent
+  std::vector<AssignmentEdge> sorted_edges_;
+  std::vector<int> agent_offsets_;
+  std::vector<int> local_index_;
+  // agents of all components followed by the tasks of all components
+  std::vector<int> global_index_;
+  std::vector<int> component_of_root_;
+  std::vector<Component> components_;
+  // local task assigned to each agent of global_index_ (-1 if not assigned)
+  std::vector<int> assigned_task_;
+  std::vector<Workspace> workspaces_;
+  std::vector<AssignmentEdge> dense_edges_;
+};
+}  // namespace gnn_solver
+
+#endif  // GNN_SOLVER__SPARSE_SUCCESSIVE_SHORTEST_PATH_HPP_
@@ -0,0 +1,320 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gnn_solver/sparse_successive_shortest_path.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gnn_solver
+{
+namespace
+{
+// below this number of edges, the overhead of spawning threads is larger than the gain
+constexpr size_t min_edges_for_parallel_solve = 2000;
+// same threshold as the dense SSP to consider a score as assignable
+constexpr double min_score = 1e-5;
+}  // namespace
+
+void SparseSSP::maximizeLinearAssignment(
+  const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
+{
+  // When there is no agents or no tasks, terminate
+  if (cost.size() == 0 || cost.at(0).size() == 0) {
+    return;
+  }
+
+  dense_edges_.clear();
+  for (size_t agent = 0; agent < cost.size(); ++agent) {
+    for (size_t task = 0; task < cost[agent].size(); ++task) {
+      if (cost[agent][task] > min_score) {
+        dense_edges_.push_back(
+          {static_cast<int>(agent), static_cast<int>(task), cost[agent][task]});
+      }
+    }
+  }
+  maximizeLinearAssignment(
+    cost.size(), cost.at(0).size(), dense_edges_, direct_assignment, reverse_assignment);
+}
+
+int SparseSSP::findRoot(int node)
+{
+  while (parents_[node] != node) {
+    parents_[node] = parents_[parents_[node]];
+    node = parents_[node];
+  }
+  return node;
+}
+
+void SparseSSP::maximizeLinearAssignment(
+  const int n_agents, const int n_tasks, const std::vector<AssignmentEdge> & edges,
+  std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
+{
+  if (n_agents == 0 || n_tasks == 0 || edges.empty()) {
+    return;
+  }
+
+  // Connected components of the bipartite graph (agents first, then tasks)
+  const int n_nodes = n_agents + n_tasks;
+  parents_.resize(n_nodes);
+  std::iota(parents_.begin(), parents_.end(), 0);
+  for (const auto & edge : edges) {
+    if (edge.score <= min_score) continue;
+    const int agent_root = findRoot(edge.agent);
+    const int task_root = findRoot(n_agents + edge.task);
+    if (agent_root != task_root) parents_[task_root] = agent_root;
+  }
+
+  components_.clear();
+  component_of_root_.assign(n_nodes, -1);
+  for (const auto & edge : edges) {
+    if (edge.score <= min_score) continue;
+    const int root = findRoot(edge.agent);
+    if (component_of_root_[root] == -1) {
+      component_of_root_[root] = static_cast<int>(components_.size());
+      components_.push_back({0, 0, 0, 0});
+    }
+  }
+  if (components_.empty()) {
+    return;
+  }
+
+  // Local indexes of agents and tasks inside their component
+  local_index_.assign(n_nodes, -1);
+  for (int node = 0; node < n_nodes; ++node) {
+    const int component_idx = component_of_root_[findRoot(node)];
+    if (component_idx == -1) continue;
+    auto & component = components_[component_idx];
+    local_index_[node] = node < n_agents ? component.n_agents++ : component.n_tasks++;
+  }
+  int n_component_agents = 0;
+  int n_component_tasks = 0;
+  for (auto & component : components_) {
+    component.agent_begin = n_component_agents;
+    component.task_begin = n_component_tasks;
+    n_component_agents += component.n_agents;
+    n_component_tasks += component.n_tasks;
+  }
+  global_index_.resize(n_component_agents + n_component_tasks);
+  for (int node = 0; node < n_nodes; ++node) {
+    if (local_index_[node] == -1) continue;
+    const auto & component = components_[component_of_root_[findRoot(node)]];
+    if (node < n_agents) {
+      global_index_[component.agent_begin + local_index_[node]] = node;
+    } else {
+      global_index_[n_component_agents + component.task_begin + local_index_[node]] =
+        node - n_agents;
+    }
+  }
+
+  // Counting sort of the edges by (component, local agent) into a CSR layout
+  agent_offsets_.assign(n_component_agents + 1, 0);
+  for (const auto & edge : edges) {
+    if (edge.score <= min_score) continue;
+    const auto & component = components_[component_of_root_[findRoot(edge.agent)]];
+    ++agent_offsets_[component.agent_begin + local_index_[edge.agent] + 1];
+  }
+  std::partial_sum(agent_offsets_.begin(), agent_offsets_.end(), agent_offsets_.begin());
+  sorted_edges_.resize(agent_offsets_.back());
+  {
+    // use assigned_task_ as the insertion cursor of each agent
+    assigned_task_.assign(agent_offsets_.begin(), agent_offsets_.end() - 1);
+    for (const auto & edge : edges) {
+      if (edge.score <= min_score) continue;
+      const auto & component = components_[component_of_root_[findRoot(edge.agent)]];
+      const int local_agent = local_index_[edge.agent];
+      sorted_edges_[assigned_task_[component.agent_begin + local_agent]++] = {
+        local_agent, local_index_[n_agents + edge.task], edge.score};
+    }
+  }
+
+  // Solve each component independently
+  assigned_task_.assign(n_component_agents, -1);
+  int n_threads = 1;
+#ifdef _OPENMP
+  n_threads = omp_get_max_threads();
+#endif
+  workspaces_.resize(n_threads);
+  const int n_components = static_cast<int>(components_.size());
+  const bool is_parallel = sorted_edges_.size() >= min_edges_for_parallel_solve;
+#pragma omp parallel for schedule(dynamic) if (is_parallel)
+  for (int component_idx = 0; component_idx < n_components; ++component_idx) {
+    int thread_idx = 0;
+#ifdef _OPENMP
+    thread_idx = omp_get_thread_num();
+#endif
+    solveComponent(components_[component_idx], workspaces_[thread_idx]);
+  }
+
+  // Output
+  for (const auto & component : components_) {
+    for (int agent = 0; agent < component.n_agents; ++agent) {
+      const int task = assigned_task_[component.agent_begin + agent];
+      if (task == -1) continue;
+      const int global_agent = global_index_[component.agent_begin + agent];
+      const int global_task = global_index_[n_component_agents + component.task_begin + task];
+      (*direct_assignment)[global_agent] = global_task;
+      (*reverse_assignment)[global_task] = global_agent;
+    }
+  }
+}
+
+void SparseSSP::solveComponent(const Component & component, Workspace & workspace)
+{
+  // Nodes of the residual graph
+  //     - 0: source node
+  //     - {1, ..., n_agents}: agent nodes
+  //     - {n_agents+1, ..., n_agents+n_tasks}: task nodes
+  //     - n_agents+n_tasks+1: sink node
+  // Edges are implicit: source->free agent, agent->task (cost max_cost - score, not in the
+  // matching), task->matched agent (negative cost) and free task->sink
+  const int n_agents = component.n_agents;
+  const int n_tasks = component.n_tasks;
+  const int source = 0;
+  const int sink = n_agents + n_tasks + 1;
+  const int n_nodes = n_agents + n_tasks + 2;
+  const auto agent_node = [](const int agent) { return agent + 1; };
+  const auto task_node = [&](const int task) { return task + n_agents + 1; };
+  const int edge_begin = agent_offsets_[component.agent_begin];
+  const int edge_end = agent_offsets_[component.agent_begin + n_agents];
+
+  // Any constant larger than every score keeps the costs non negative
+  double max_cost = 0.0;
+  for (int e = edge_begin; e < edge_end; ++e) {
+    max_cost = std::max(max_cost, sorted_edges_[e].score);
+  }
+  max_cost += 1.0;
+  constexpr double inf_dist = std::numeric_limits<double>::max();
+
+  auto & potentials = workspace.potentials;
+  auto & distances = workspace.distances;
+  auto & is_visited = workspace.is_visited;
+  // previous task of an agent node (-1 for the source), previous edge of a task node, previous
+  // task of the sink
+  auto & prev = workspace.prev;
+  // matched edge of each agent [0, n_agents) and task [n_agents, n_agents+n_tasks)
+  auto & matched_edge = workspace.matched_edge;
+  auto & heap = workspace.heap;
+  potentials.assign(n_nodes, 0.0);
+  distances.resize(n_nodes);
+  is_visited.resize(n_nodes);
+  prev.resize(n_nodes);
+  matched_edge.assign(n_agents + n_tasks, -1);
+
+  const auto heap_compare = std::greater<std::pair<double, int>>();
+  const int max_flow = std::min(n_agents, n_tasks);
+  for (int i = 0; i < max_flow; ++i) {
+    std::fill(distances.begin(), distances.end(), inf_dist);
+    std::fill(is_visited.begin(), is_visited.end(), 0);
+    heap.clear();
+    distances[source] = 0.0;
+    heap.emplace_back(0.0, source);
+
+    const auto relax = [&](const int node, const double reduced_cost, const int prev_value) {
+      if (!is_visited[node] && distances[node] > reduced_cost) {
+        distances[node] = reduced_cost;
+        prev[node] = prev_value;
+        heap.emplace_back(reduced_cost, node);
+        std::push_heap(heap.begin(), heap.end(), heap_compare);
+      }
+    };
+
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), heap_compare);
+      const auto [cur_node_dist, cur_node] = heap.back();
+      heap.pop_back();
+      if (is_visited[cur_node]) {
+        continue;
+      }
+      is_visited[cur_node] = 1;
+      potentials[cur_node] += cur_node_dist;
+      if (cur_node == sink) {
+        break;
+      }
+
+      if (cur_node == source) {
+        for (int agent = 0; agent < n_agents; ++agent) {
+          if (matched_edge[agent] != -1) continue;
+          const int node = agent_node(agent);
+          relax(node, potentials[source] - potentials[node], -1);
+        }
+      } else if (cur_node <= n_agents) {
+        const int agent = cur_node - 1;
+        const int agent_edge_begin = agent_offsets_[component.agent_begin + agent];
+        const int agent_edge_end = agent_offsets_[component.agent_begin + agent + 1];
+        for (int e = agent_edge_begin; e < agent_edge_end; ++e) {
+          if (matched_edge[agent] == e) continue;
+          const int node = task_node(sorted_edges_[e].task);
+          const double cost = max_cost - sorted_edges_[e].score;
+          relax(node, cost + potentials[cur_node] - potentials[node], e);
+        }
+      } else {
+        const int task = cur_node - n_agents - 1;
+        const int e = matched_edge[n_agents + task];
+        if (e == -1) {
+          relax(sink, potentials[cur_node] - potentials[sink], task);
+        } else {
+          const int node = agent_node(sorted_edges_[e].agent);
+          const double cost = sorted_edges_[e].score - max_cost;
+          relax(node, cost + potentials[cur_node] - potentials[node], task);
+        }
+      }
+    }
+
+    // Shortest path length to sink is greater than max_cost,
+    // which means no augmenting path increases the total score, terminate
+    if (!is_visited[sink] || potentials[sink] >= max_cost) {
+      break;
+    }
+
+    // Update potentials of unvisited nodes
+    for (int v = 0; v < n_nodes; ++v) {
+      if (!is_visited[v]) {
+        potentials[v] += distances[sink];
+      }
+    }
+
+    // Flip the matching along the shortest path from the sink back to the source
+    int task = prev[sink];
+    while (true) {
+      const int e = prev[task_node(task)];
+      const int agent = sorted_edges_[e].agent;
+      const int next_task = prev[agent_node(agent)];
+      matched_edge[agent] = e;
+      matched_edge[n_agents + task] = e;
+      if (next_task == -1) {
+        break;
+      }
+      task = next_task;
+    }
+  }
+
+  for (int agent = 0; agent < n_agents; ++agent) {
+    if (matched_edge[agent] != -1) {
+      assigned_task_[component.agent_begin + agent] = sorted_edges_[matched_edge[agent]].task;
+    }
+  }
+}
+}  // namespace gnn_solver
@@ -0,0 +1,108 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gnn_solver/gnn_solver.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+double totalScore(
+  const std::vector<std::vector<double>> & score, const std::unordered_map<int, int> & assignment)
+{
+  double total = 0.0;
+  for (const auto & [agent, task] : assignment) {
+    total += score[agent][task];
+  }
+  return total;
+}
+
+void checkConsistency(
+  const std::unordered_map<int, int> & direct_assignment,
+  const std::unordered_map<int, int> & reverse_assignment)
+{
+  EXPECT_EQ(direct_assignment.size(), reverse_assignment.size());
+  for (const auto & [agent, task] : direct_assignment) {
+    ASSERT_NE(reverse_assignment.find(task), reverse_assignment.end());
+    EXPECT_EQ(reverse_assignment.at(task), agent);
+  }
+}
+}  // namespace
+
+TEST(SparseSSP, simple)
+{
+  // agent 0 prefers task 0, but the best total assigns agent 1 to task 0
+  const std::vector<std::vector<double>> score = {
+    {0.9, 0.8, 0.0}, {0.85, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+  gnn_solver::SparseSSP solver;
+  std::unordered_map<int, int> direct_assignment;
+  std::unordered_map<int, int> reverse_assignment;
+  solver.maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+  checkConsistency(direct_assignment, reverse_assignment);
+  ASSERT_EQ(direct_assignment.size(), 2lu);
+  EXPECT_EQ(direct_assignment.at(0), 1);
+  EXPECT_EQ(direct_assignment.at(1), 0);
+  EXPECT_EQ(reverse_assignment.find(2), reverse_assignment.end());
+}
+
+TEST(SparseSSP, empty)
+{
+  gnn_solver::SparseSSP solver;
+  std::unordered_map<int, int> direct_assignment;
+  std::unordered_map<int, int> reverse_assignment;
+  solver.maximizeLinearAssignment({}, &direct_assignment, &reverse_assignment);
+  EXPECT_TRUE(direct_assignment.empty());
+  solver.maximizeLinearAssignment({{0.0, 0.0}}, &direct_assignment, &reverse_assignment);
+  EXPECT_TRUE(direct_assignment.empty());
+  solver.maximizeLinearAssignment(3, 3, {}, &direct_assignment, &reverse_assignment);
+  EXPECT_TRUE(direct_assignment.empty());
+}
+
+TEST(SparseSSP, sameTotalScoreAsSSP)
+{
+  std::default_random_engine engine(0);
+  std::uniform_int_distribution<int> size_dist(1, 60);
+  std::uniform_real_distribution<double> score_dist(0.0, 1.0);
+  std::bernoulli_distribution gate_dist(0.1);
+
+  gnn_solver::SSP ssp;
+  gnn_solver::SparseSSP sparse_ssp;
+  for (int iteration = 0; iteration < 200; ++iteration) {
+    const int n_agents = size_dist(engine);
+    const int n_tasks = size_dist(engine);
+    std::vector<std::vector<double>> score(n_agents, std::vector<double>(n_tasks, 0.0));
+    for (auto & row : score) {
+      for (auto & s : row) {
+        if (gate_dist(engine)) s = score_dist(engine);
+      }
+    }
+
+    std::unordered_map<int, int> ssp_direct;
+    std::unordered_map<int, int> ssp_reverse;
+    ssp.maximizeLinearAssignment(score, &ssp_direct, &ssp_reverse);
+    std::unordered_map<int, int> sparse_direct;
+    std::unordered_map<int, int> sparse_reverse;
+    sparse_ssp.maximizeLinearAssignment(score, &sparse_direct, &sparse_reverse);
+
+    checkConsistency(sparse_direct, sparse_reverse);
+    for (const auto & [agent, task] : sparse_direct) {
+      EXPECT_GT(score[agent][task], 0.0);
+    }
+    EXPECT_NEAR(totalScore(score, ssp_direct), totalScore(score, sparse_direct), 1e-9);
+  }
+}
@@ -0,0 +1,104 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRID_MAP_UTILS__POLYGON_RASTERIZER_HPP_
+#define GRID_MAP_UTILS__POLYGON_RASTERIZER_HPP_
+
+#include "grid_map_core/TypeDefs.hpp"
+#include "grid_map_utils/polygon_iterator.hpp"
+
+#include <grid_map_core/GridMap.hpp>
+#include <grid_map_core/Polygon.hpp>
+
+#include <vector>
+
+namespace grid_map_utils
+{
+
+/// @brief How the value written in a cell is combined with the current value of the cell
+enum class FillMode {
+  ASSIGN,  ///< the cell takes the value
+  MAX      ///< the cell takes the value if it is higher than its current value
+};
+
+/// @brief Contiguous cells of a row of the grid map, in buffer indexes (i.e., after wrapping)
+struct CellSpan
+{
+  int row;
+  int col;
+  int length;
+};
+
+/** @brief A polygon rasterizer for grid_map::GridMap based on the scan line algorithm.
+    @details This rasterizer selects the same cells as the grid_map_utils::PolygonIterator (cells \
+             whose center is inside the polygon) but outputs them as spans of contiguous cells  \
+             which can be filled directly in the layer matrix.                                  \
+             The edges crossing the current row are kept in an active edge list and the         \
+             intersections only need to be sorted when there are more than 2 of them, which     \
+             never happens for convex polygons. The buffers are reused between calls.
+*/
+class PolygonRasterizer
+{
+public:
+  /// @brief Calculate the spans of cells whose center is inside the polygon.
+  /// @param grid_map the grid map defining the cells.
+  /// @param polygon the polygonal area to rasterize.
+  /// @return the spans of cells, valid until the next call to the rasterizer.
+  const std::vector<CellSpan> & rasterize(
+    const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon);
+
+  /// @brief Fill the cells whose center is inside the polygon.
+  /// @param[in, out] layer a layer of the grid map.
+  /// @param grid_map the grid map defining the cells.
+  /// @param polygon the polygonal area to fill.
+  /// @param value the value to write in the cells.
+  /// @param mode how the value is combined with the current value of the cells.
+  void fill(
+    grid_map::Matrix & layer, const grid_map::GridMap & grid_map,
+    const grid_map::Polygon & polygon, const float value, const FillMode mode);
+
+  /// @brief Fill the cells whose center is inside each polygon, one polygon after the other.
+  /// @param[in, out] layer a layer of the grid map.
+  /// @param grid_map the grid map defining the cells.
+  /// @param polygons the polygonal areas to fill.
+  /// @param values the value to write for each polygon, must have the size of polygons.
+  /// @param mode how the values are combined with the current value of the cells.
+  void fill(
+    grid_map::Matrix & layer, const grid_map::GridMap & grid_map,
+    const std::vector<grid_map::Polygon> & polygons, const std::vector<float> & values,
+    const FillMode mode);
+
+  /// @brief Fill the given spans of cells.
+  /// @param[in, out] layer a layer of the grid map.
+  /// @param spans spans of cells of the layer.
+  /// @param value the value to write in the cells.
+  /// @param mode how the value is combined with the current value of the cells.
+  static void fill(
+    grid_map::Matrix & layer, const std::vector<CellSpan> & spans, const float value,
+    const FillMode mode);
+
+private:
+  /// @brief Add the spans of a row between its intersections (sorted in decreasing order).
+  void addRowSpans(
+    const int row, const grid_map::Index & map_start_idx, const grid_map::Size & map_size,
+    const double map_resolution, const double map_origin_y);
+
+  std::vector<Edge> edges_;
+  std::vector<size_t> active_edges_;
+  std::vector<double> intersections_;
+  std::vector<CellSpan> spans_;
+};
+}  // namespace grid_map_utils
+
+#endif  // GRID_MAP_UTILS__POLYGON_RASTERIZER_HPP_
@@ -0,0 +1,173 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "grid_map_utils/polygon_rasterizer.hpp"
+
+#include "grid_map_core/GridMap.hpp"
+#include "grid_map_core/GridMapMath.hpp"
+#include "grid_map_core/Polygon.hpp"
+#include "grid_map_core/TypeDefs.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace grid_map_utils
+{
+
+const std::vector<CellSpan> & PolygonRasterizer::rasterize(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
+{
+  spans_.clear();
+  const auto & vertices = polygon.getVertices();
+  if (vertices.size() < 3) return spans_;
+
+  // edges ordered by decreasing x, horizontal edges are ignored (see PolygonIterator)
+  edges_.clear();
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const auto & vertex = vertices[i];
+    const auto & next_vertex = vertices[(i + 1) % vertices.size()];
+    if (vertex.x() > next_vertex.x())
+      edges_.emplace_back(vertex, next_vertex);
+    else if (vertex.x() < next_vertex.x())
+      edges_.emplace_back(next_vertex, vertex);
+  }
+  if (edges_.empty()) return spans_;
+  std::sort(edges_.begin(), edges_.end());
+
+  const auto map_start_idx = grid_map.getStartIndex();
+  const auto map_size = grid_map.getSize();
+  const auto map_resolution = grid_map.getResolution();
+  grid_map::Position origin;
+  grid_map.getPosition(map_start_idx, origin);
+
+  // range of rows covering the edges
+  auto min_vertex_x = edges_.front().second.x();
+  for (const auto & edge : edges_) min_vertex_x = std::min(min_vertex_x, edge.second.x());
+  const auto max_vertex_x = edges_.front().first.x();
+  const auto dist_min_to_origin = origin.x() - min_vertex_x + map_resolution;
+  const auto dist_max_to_origin = origin.x() - max_vertex_x + map_resolution;
+  const auto from_row =
+    std::clamp(static_cast<int>(dist_max_to_origin / map_resolution), 0, map_size(0) - 1);
+  const auto to_row =
+    std::clamp(static_cast<int>(dist_min_to_origin / map_resolution), 0, map_size(0) - 1);
+
+  // scan the rows from high to low x, keeping the edges that can cross the current row
+  active_edges_.clear();
+  size_t next_edge = 0;
+  for (auto row = from_row; row <= to_row; ++row) {
+    const auto line_x = origin.x() - map_resolution * row;
+    while (next_edge < edges_.size() && edges_[next_edge].first.x() >= line_x)
+      active_edges_.push_back(next_edge++);
+    // edges above the line never cross the next rows either
+    active_edges_.erase(
+      std::remove_if(
+        active_edges_.begin(), active_edges_.end(),
+        [&](const size_t e) { return edges_[e].second.x() > line_x; }),
+      active_edges_.end());
+
+    intersections_.clear();
+    for (const auto e : active_edges_) {
+      const auto & edge = edges_[e];
+      // special case when exactly touching a vertex: only count edge for its lowest x
+      if (edge.second.x() == line_x) {
+        intersections_.push_back(edge.second.y());
+      } else {
+        const auto diff = edge.first - edge.second;
+        intersections_.push_back(
+          edge.second.y() + (line_x - edge.second.x()) * diff.y() / diff.x());
+      }
+    }
+    if (intersections_.size() < 2) continue;
+    if (intersections_.size() == 2) {
+      if (intersections_[0] < intersections_[1]) std::swap(intersections_[0], intersections_[1]);
+    } else {
+      std::sort(intersections_.begin(), intersections_.end(), std::greater());
+    }
+    addRowSpans(row, map_start_idx, map_size, map_resolution, origin.y());
+  }
+  return spans_;
+}
+
+void PolygonRasterizer::addRowSpans(
+  const int row, const grid_map::Index & map_start_idx, const grid_map::Size & map_size,
+  const double map_resolution, const double map_origin_y)
+{
+  // remove pairs outside of map, as done by the PolygonIterator
+  auto begin = intersections_.begin();
+  auto end = intersections_.end();
+  while (std::distance(begin, end) >= 2 && *begin >= map_origin_y &&
+         *std::next(begin) >= map_origin_y)
+    std::advance(begin, 2);
+  const auto last_col_y = map_origin_y - (map_size(1) - 1) * map_resolution;
+  const auto after_last_col = std::lower_bound(begin, end, last_col_y, std::greater());
+  if (std::distance(after_last_col, end) % 2 == 1) {
+    *after_last_col = *std::prev(end);
+    end = std::next(after_last_col);
+  } else {
+    end = after_last_col;
+  }
+
+  int buffer_row = map_start_idx(0) + row;
+  grid_map::wrapIndexToRange(buffer_row, map_size(0));
+  for (auto iter = begin; std::distance(iter, end) >= 2; std::advance(iter, 2)) {
+    const auto dist_from_origin = map_origin_y - *iter + map_resolution;
+    const auto dist_to_origin = map_origin_y - *std::next(iter);
+    const auto from_col =
+      std::clamp(static_cast<int>(dist_from_origin / map_resolution), 0, map_size(1) - 1);
+    const auto to_col =
+      std::clamp(static_cast<int>(dist_to_origin / map_resolution), 0, map_size(1) - 1);
+    // intersections not encompassing the center of a cell
+    if (to_col < from_col) continue;
+
+    // split the span if it wraps around the end of the buffer
+    int buffer_col = map_start_idx(1) + from_col;
+    grid_map::wrapIndexToRange(buffer_col, map_size(1));
+    const auto length = to_col - from_col + 1;
+    const auto length_before_wrap = std::min(length, map_size(1) - buffer_col);
+    spans_.push_back({buffer_row, buffer_col, length_before_wrap});
+    if (length_before_wrap < length) {
+      spans_.push_back({buffer_row, 0, length - length_before_wrap});
+    }
+  }
+}
+
+void PolygonRasterizer::fill(
+  grid_map::Matrix & layer, const std::vector<CellSpan> & spans, const float value,
+  const FillMode mode)
+{
+  for (const auto & span : spans) {
+    for (auto col = span.col; col < span.col + span.length; ++col) {
+      auto & cell = layer(span.row, col);
+      if (mode == FillMode::ASSIGN || value > cell) cell = value;
+    }
+  }
+}
+
+void PolygonRasterizer::fill(
+  grid_map::Matrix & layer, const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon,
+  const float value, const FillMode mode)
+{
+  fill(layer, rasterize(grid_map, polygon), value, mode);
+}
+
+void PolygonRasterizer::fill(
+  grid_map::Matrix & layer, const grid_map::GridMap & grid_map,
+  const std::vector<grid_map::Polygon> & polygons, const std::vector<float> & values,
+  const FillMode mode)
+{
+  for (size_t i = 0; i < polygons.size() && i < values.size(); ++i)
+    fill(layer, rasterize(grid_map, polygons[i]), values[i], mode);
+}
+}  // namespace grid_map_utils
@@ -0,0 +1,140 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "grid_map_core/TypeDefs.hpp"
+#include "grid_map_utils/polygon_iterator.hpp"
+#include "grid_map_utils/polygon_rasterizer.hpp"
+
+#include <grid_map_core/iterators/PolygonIterator.hpp>
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+// random boxes, as the object footprints of a costmap
+std::vector<grid_map::Polygon> makeBoxes(
+  const size_t nb_boxes, const double map_length, std::default_random_engine & engine)
+{
+  std::uniform_real_distribution<double> position_dist(-map_length / 2.0, map_length / 2.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size_dist(0.5, 5.0);
+  std::vector<grid_map::Polygon> boxes(nb_boxes);
+  for (auto & box : boxes) {
+    const grid_map::Position center(position_dist(engine), position_dist(engine));
+    const auto yaw = yaw_dist(engine);
+    const grid_map::Position length_vector =
+      size_dist(engine) / 2.0 * grid_map::Position(std::cos(yaw), std::sin(yaw));
+    const grid_map::Position width_vector =
+      size_dist(engine) / 2.0 * grid_map::Position(-std::sin(yaw), std::cos(yaw));
+    box.addVertex(center + length_vector + width_vector);
+    box.addVertex(center + length_vector - width_vector);
+    box.addVertex(center - length_vector - width_vector);
+    box.addVertex(center - length_vector + width_vector);
+  }
+  return boxes;
+}
+
+// random star shaped polygon with many vertices
+grid_map::Polygon makeStar(
+  const size_t nb_vertices, const double map_length, std::default_random_engine & engine)
+{
+  std::uniform_real_distribution<double> radius_dist(map_length / 8.0, map_length / 2.0);
+  grid_map::Polygon polygon;
+  for (size_t i = 0; i < nb_vertices; ++i) {
+    const auto angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(nb_vertices);
+    polygon.addVertex(radius_dist(engine) * grid_map::Position(std::cos(angle), std::sin(angle)));
+  }
+  return polygon;
+}
+}  // namespace
+
+int main()
+{
+  constexpr auto nb_iterations = 10;
+  constexpr auto map_length = 100.0;
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> move_dist(-5.0, 5.0);
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stopwatch;
+  grid_map_utils::PolygonRasterizer rasterizer;
+
+  std::printf(
+    "#Size Polygons Vertices grid_map[ms] grid_map_utils[ms] rasterizer[ms] "
+    "rasterizer_max[ms] mismatches\n");
+  for (const auto resolution : {0.5, 0.2, 0.1}) {
+    grid_map::GridMap map({"grid_map", "grid_map_utils", "rasterizer"});
+    map.setGeometry(grid_map::Length(map_length, map_length), resolution);
+    map.move(grid_map::Position(move_dist(engine), move_dist(engine)));
+    for (const auto & [nb_polygons, nb_vertices] :
+         {std::make_pair(1lu, 100lu), std::make_pair(10lu, 4lu), std::make_pair(100lu, 4lu),
+          std::make_pair(500lu, 4lu)}) {
+      std::vector<grid_map::Polygon> polygons;
+      if (nb_vertices == 4) {
+        polygons = makeBoxes(nb_polygons, map_length, engine);
+      } else {
+        for (size_t i = 0; i < nb_polygons; ++i)
+          polygons.push_back(makeStar(nb_vertices, map_length, engine));
+      }
+      std::vector<float> values(nb_polygons);
+      for (size_t i = 0; i < nb_polygons; ++i) values[i] = static_cast<float>(i + 1);
+
+      double grid_map_duration{};
+      double grid_map_utils_duration{};
+      double rasterizer_duration{};
+      double rasterizer_max_duration{};
+      long mismatches = 0;  // NOLINT
+      for (auto iteration = 0; iteration < nb_iterations; ++iteration) {
+        for (const auto & layer : {"grid_map", "grid_map_utils", "rasterizer"})
+          map[layer].setConstant(0.0);
+
+        stopwatch.tic();
+        auto & grid_map_layer = map["grid_map"];
+        for (size_t i = 0; i < nb_polygons; ++i)
+          for (grid_map::PolygonIterator iterator(map, polygons[i]); !iterator.isPastEnd();
+               ++iterator)
+            grid_map_layer((*iterator)(0), (*iterator)(1)) = values[i];
+        grid_map_duration += stopwatch.toc();
+
+        stopwatch.tic();
+        auto & grid_map_utils_layer = map["grid_map_utils"];
+        for (size_t i = 0; i < nb_polygons; ++i)
+          for (grid_map_utils::PolygonIterator iterator(map, polygons[i]); !iterator.isPastEnd();
+               ++iterator)
+            grid_map_utils_layer((*iterator)(0), (*iterator)(1)) = values[i];
+        grid_map_utils_duration += stopwatch.toc();
+
+        stopwatch.tic();
+        rasterizer.fill(
+          map["rasterizer"], map, polygons, values, grid_map_utils::FillMode::ASSIGN);
+        rasterizer_duration += stopwatch.toc();
+
+        // the values are increasing: blending with max gives the same result as assigning
+        map["rasterizer"].setConstant(0.0);
+        stopwatch.tic();
+        rasterizer.fill(map["rasterizer"], map, polygons, values, grid_map_utils::FillMode::MAX);
+        rasterizer_max_duration += stopwatch.toc();
+
+        mismatches += (map["grid_map_utils"].array() != map["rasterizer"].array()).count();
+      }
+      std::printf(
+        "%d %lu %lu %f %f %f %f %ld\n", map.getSize()(0), nb_polygons, nb_vertices,
+        grid_map_duration / nb_iterations, grid_map_utils_duration / nb_iterations,
+        rasterizer_duration / nb_iterations, rasterizer_max_duration / nb_iterations, mismatches);
+    }
+  }
+  return 0;
+}
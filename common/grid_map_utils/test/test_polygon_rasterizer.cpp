@@ -0,0 +1,132 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "grid_map_utils/polygon_iterator.hpp"
+#include "grid_map_utils/polygon_rasterizer.hpp"
+
+#include <grid_map_core/iterators/GridMapIterator.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// Vector
+#include <random>
+#include <vector>
+
+using grid_map::GridMap;
+using grid_map::Length;
+using grid_map::Polygon;
+using grid_map::Position;
+using grid_map_utils::FillMode;
+using grid_map_utils::PolygonRasterizer;
+
+TEST(PolygonRasterizer, EmptyPolygon)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));
+
+  PolygonRasterizer rasterizer;
+  Polygon polygon;
+  EXPECT_TRUE(rasterizer.rasterize(map, polygon).empty());
+  polygon.addVertex(Position(-100.0, 100.0));
+  polygon.addVertex(Position(100.0, 100.0));
+  EXPECT_TRUE(rasterizer.rasterize(map, polygon).empty());
+}
+
+TEST(PolygonRasterizer, FullCover)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+
+  Polygon polygon;
+  polygon.addVertex(Position(-100.0, 100.0));
+  polygon.addVertex(Position(100.0, 100.0));
+  polygon.addVertex(Position(100.0, -100.0));
+  polygon.addVertex(Position(-100.0, -100.0));
+
+  PolygonRasterizer rasterizer;
+  const auto & spans = rasterizer.rasterize(map, polygon);
+  ASSERT_EQ(spans.size(), 8lu);
+  for (auto row = 0; row < 8; ++row) {
+    EXPECT_EQ(spans[row].row, row);
+    EXPECT_EQ(spans[row].col, 0);
+    EXPECT_EQ(spans[row].length, 5);
+  }
+}
+
+TEST(PolygonRasterizer, SameAsPolygonIterator)
+{
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> vertex_dist(-6.0, 6.0);
+  std::uniform_real_distribution<double> move_dist(-3.0, 3.0);
+  std::uniform_int_distribution<size_t> nb_vertices_dist(3, 12);
+
+  PolygonRasterizer rasterizer;
+  for (auto iteration = 0; iteration < 100; ++iteration) {
+    GridMap map({"layer"});
+    map.setGeometry(Length(10.0, 8.0), 0.25, Position(0.0, 0.0));
+    // moving the map changes its start index: the spans must wrap around the buffer
+    map.move(Position(move_dist(engine), move_dist(engine)));
+    map["layer"].setConstant(0.0);
+
+    Polygon polygon;
+    const auto nb_vertices = nb_vertices_dist(engine);
+    for (size_t i = 0; i < nb_vertices; ++i)
+      polygon.addVertex(Position(vertex_dist(engine), vertex_dist(engine)));
+
+    grid_map::Matrix expected = map["layer"];
+    for (grid_map_utils::PolygonIterator iterator(map, polygon); !iterator.isPastEnd();
+         ++iterator)
+      expected((*iterator)(0), (*iterator)(1)) = 1.0;
+    rasterizer.fill(map["layer"], map, polygon, 1.0, FillMode::ASSIGN);
+    for (auto i = 0; i < expected.size(); ++i) EXPECT_EQ(map["layer"](i), expected(i));
+  }
+}
+
+TEST(PolygonRasterizer, FillModes)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+  map["layer"].setConstant(0.5);
+
+  // two overlapping squares
+  std::vector<Polygon> polygons(2);
+  polygons[0].addVertex(Position(3.9, 2.4));
+  polygons[0].addVertex(Position(3.9, -0.1));
+  polygons[0].addVertex(Position(-0.1, -0.1));
+  polygons[0].addVertex(Position(-0.1, 2.4));
+  polygons[1].addVertex(Position(1.9, 0.9));
+  polygons[1].addVertex(Position(1.9, -2.4));
+  polygons[1].addVertex(Position(-3.9, -2.4));
+  polygons[1].addVertex(Position(-3.9, 0.9));
+
+  PolygonRasterizer rasterizer;
+  auto max_layer = map["layer"];
+  rasterizer.fill(max_layer, map, polygons, {1.0, 0.2}, FillMode::MAX);
+  auto assign_layer = map["layer"];
+  rasterizer.fill(assign_layer, map, polygons, {1.0, 0.2}, FillMode::ASSIGN);
+
+  for (grid_map::GridMapIterator iterator(map); !iterator.isPastEnd(); ++iterator) {
+    Position position;
+    map.getPosition(*iterator, position);
+    const auto in_first =
+      position.x() > -0.1 && position.x() < 3.9 && position.y() > -0.1 && position.y() < 2.4;
+    const auto in_second =
+      position.x() > -3.9 && position.x() < 1.9 && position.y() > -2.4 && position.y() < 0.9;
+    const auto i = (*iterator)(0);
+    const auto j = (*iterator)(1);
+    EXPECT_FLOAT_EQ(max_layer(i, j), in_first ? 1.0 : 0.5);
+    EXPECT_FLOAT_EQ(assign_layer(i, j), in_second ? 0.2 : (in_first ? 1.0 : 0.5));
+  }
+}
@@ -0,0 +1,155 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interpolation/spline_interpolation.hpp"
+#include "interpolation/spline_interpolation_points_2d.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+constexpr int num_cycles = 30;  // one second at the controller rate
+constexpr size_t num_channels = 6;  // x, y, z, yaw, k and smooth_k of the MPC trajectory
+
+// keys with an irregular interval of about 1 m and smooth values
+std::vector<double> createKeys(const size_t size)
+{
+  std::vector<double> keys;
+  for (size_t i = 0; i < size; ++i) {
+    keys.push_back(static_cast<double>(i) + 0.3 * std::sin(static_cast<double>(i)));
+  }
+  return keys;
+}
+
+std::vector<std::vector<double>> createValues(const std::vector<double> & keys)
+{
+  std::vector<std::vector<double>> values(num_channels);
+  for (size_t channel = 0; channel < num_channels; ++channel) {
+    for (const double key : keys) {
+      values.at(channel).push_back(
+        std::sin(key / (10.0 + static_cast<double>(channel))) * static_cast<double>(channel + 1));
+    }
+  }
+  return values;
+}
+
+// previous SplineInterpolationPoints2d::getSplineInterpolatedYaws(): one spline per coordinate and
+// one validation and linear segment search per point
+std::vector<double> calcYawsReference(
+  const std::vector<double> & base_s, const std::vector<double> & base_x,
+  const std::vector<double> & base_y)
+{
+  const SplineInterpolation spline_x(base_s, base_x);
+  const SplineInterpolation spline_y(base_s, base_y);
+  std::vector<double> yaw_vec;
+  for (const double s : base_s) {
+    const double diff_x = spline_x.getSplineInterpolatedDiffValues({s}).at(0);
+    const double diff_y = spline_y.getSplineInterpolatedDiffValues({s}).at(0);
+    yaw_vec.push_back(std::atan2(diff_y, diff_x));
+  }
+  return yaw_vec;
+}
+}  // namespace
+
+int main()
+{
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+
+  std::printf(
+    "#base keys, query keys, spline x6 [ms], splineMultiChannel [ms], max diff, "
+    "yaws reference [ms], SplineInterpolationPoints2d yaws [ms], max yaw diff\n");
+  for (const size_t size : {50, 200, 1000, 5000}) {
+    const auto base_keys = createKeys(size);
+    const auto base_values = createValues(base_keys);
+    std::vector<double> query_keys;
+    for (double s = base_keys.front(); s < base_keys.back(); s += 0.1) {
+      query_keys.push_back(s);
+    }
+
+    // resampling of the MPC trajectory: each channel by interpolation::spline
+    std::vector<std::vector<double>> reference_values(num_channels);
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      for (size_t channel = 0; channel < num_channels; ++channel) {
+        reference_values.at(channel) =
+          interpolation::spline(base_keys, base_values.at(channel), query_keys);
+      }
+    }
+    const double reference_time = stop_watch.toc() / num_cycles;
+
+    std::vector<std::vector<double>> values;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      values = interpolation::splineMultiChannel(base_keys, base_values, query_keys);
+    }
+    const double multi_channel_time = stop_watch.toc() / num_cycles;
+
+    double max_diff = 0.0;
+    for (size_t channel = 0; channel < num_channels; ++channel) {
+      for (size_t i = 0; i < query_keys.size(); ++i) {
+        max_diff = std::max(
+          max_diff, std::abs(values.at(channel).at(i) - reference_values.at(channel).at(i)));
+      }
+    }
+
+    // yaws of the points, e.g. the reference points of the path smoother
+    std::vector<geometry_msgs::msg::Point> points;
+    for (size_t i = 0; i < size; ++i) {
+      geometry_msgs::msg::Point p;
+      p.x = base_keys.at(i);
+      p.y = base_values.at(0).at(i);
+      p.z = 0.0;
+      points.push_back(p);
+    }
+    const SplineInterpolationPoints2d points_spline(points);
+    std::vector<double> base_s;
+    std::vector<double> base_x;
+    std::vector<double> base_y;
+    for (size_t i = 0; i < points_spline.getSize(); ++i) {
+      base_s.push_back(points_spline.getAccumulatedLength(i));
+      base_x.push_back(points.at(i).x);
+      base_y.push_back(points.at(i).y);
+    }
+
+    stop_watch.tic();
+    std::vector<double> reference_yaws;
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_yaws = calcYawsReference(base_s, base_x, base_y);
+    }
+    const double reference_yaw_time = stop_watch.toc() / num_cycles;
+
+    stop_watch.tic();
+    std::vector<double> yaws;
+    for (int i = 0; i < num_cycles; ++i) {
+      yaws = SplineInterpolationPoints2d(points).getSplineInterpolatedYaws();
+    }
+    const double yaw_time = stop_watch.toc() / num_cycles;
+
+    double max_yaw_diff = 0.0;
+    for (size_t i = 0; i < yaws.size(); ++i) {
+      max_yaw_diff = std::max(max_yaw_diff, std::abs(yaws.at(i) - reference_yaws.at(i)));
+    }
+
+    std::printf(
+      "%zu, %zu, %.3f, %.3f, %.3e, %.3f, %.3f, %.3e\n", size, query_keys.size(), reference_time,
+      multi_channel_time, max_diff, reference_yaw_time, yaw_time, max_yaw_diff);
+  }
+  return 0;
+}
@@ -52,6 +52,12 @@ std::vector<double> spline(
 std::vector<double> splineByAkima(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys);
+
+// spline interpolation of several values on the same base_keys
+// return value is the vector of the interpolated values of each base_values
+std::vector<std::vector<double>> splineMultiChannel(
+  const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values,
+  const std::vector<double> & query_keys);
 }  // namespace interpolation
 
 // non-static 1-dimensional spline interpolation
@@ -105,4 +111,60 @@ private:
     const std::vector<double> & base_keys, const std::vector<double> & base_values);
 };
 
+// non-static spline interpolation of several values (channels) on the same base keys
+// NOTE: The tridiagonal matrix of the spline depends only on the base keys. It is factorized once
+//       and solved for all the channels, and all the channels are evaluated in one sweep of the
+//       query keys. Each channel is interpolated exactly as SplineInterpolation does.
+//
+// Usage:
+// ```
+// SplineInterpolationMultiChannel spline(base_keys, {base_x_values, base_y_values});
+// // memorize pre-interpolation result internally
+// const auto xy = spline.getSplineInterpolatedValues(query_keys);  // {x(query_keys), y(...)}
+// const double y = spline.getSplineInterpolatedValue(1, query_key);
+// ```
+class SplineInterpolationMultiChannel
+{
+public:
+  SplineInterpolationMultiChannel() = default;
+  SplineInterpolationMultiChannel(
+    const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values)
+  {
+    calcSplineCoefficients(base_keys, base_values);
+  }
+
+  //!< @brief get values of spline interpolation of all the channels on designated sampling points.
+  std::vector<std::vector<double>> getSplineInterpolatedValues(
+    const std::vector<double> & query_keys) const;
+
+  //!< @brief get 1st differential values of all the channels on designated sampling points.
+  std::vector<std::vector<double>> getSplineInterpolatedDiffValues(
+    const std::vector<double> & query_keys) const;
+
+  //!< @brief get 2nd differential values of all the channels on designated sampling points.
+  std::vector<std::vector<double>> getSplineInterpolatedQuadDiffValues(
+    const std::vector<double> & query_keys) const;
+
+  //!< @brief get value of one channel on one sampling point.
+  //!< @details the segment of query_key is found by binary search
+  double getSplineInterpolatedValue(const size_t channel, const double query_key) const;
+  double getSplineInterpolatedDiffValue(const size_t channel, const double query_key) const;
+  double getSplineInterpolatedQuadDiffValue(const size_t channel, const double query_key) const;
+
+  size_t getSize() const { return base_keys_.size(); }
+  size_t getNumChannels() const { return multi_spline_coefs_.size(); }
+
+private:
+  std::vector<double> base_keys_;
+  std::vector<interpolation::MultiSplineCoef> multi_spline_coefs_;
+
+  void calcSplineCoefficients(
+    const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values);
+  double validateKey(const double query_key) const;
+  size_t getSegmentIndex(const double query_key) const;
+  template <typename CalcValue>
+  std::vector<std::vector<double>> getSplineInterpolatedValuesImpl(
+    const std::vector<double> & query_keys, const CalcValue & calc_value) const;
+};
+
 #endif  // INTERPOLATION__SPLINE_INTERPOLATION_HPP_
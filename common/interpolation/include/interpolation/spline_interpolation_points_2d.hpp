@@ -82,9 +82,8 @@ public:
 
 private:
   void calcSplineCoefficientsInner(const std::vector<geometry_msgs::msg::Point> & points);
-  SplineInterpolation spline_x_;
-  SplineInterpolation spline_y_;
-  SplineInterpolation spline_z_;
+  // x, y and z on the same base_s_vec_
+  SplineInterpolationMultiChannel spline_xyz_;
 
   std::vector<double> base_s_vec_;
 };
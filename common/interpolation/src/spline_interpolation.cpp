@@ -14,6 +14,11 @@
 
 #include "interpolation/spline_interpolation.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace
@@ -32,36 +37,64 @@ struct TDMACoef
     a.resize(num_row - 1);
     b.resize(num_row);
     c.resize(num_row - 1);
-    d.resize(num_row);
   }
 
   std::vector<double> a;
   std::vector<double> b;
   std::vector<double> c;
-  std::vector<double> d;
 };
 
-inline std::vector<double> solveTridiagonalMatrixAlgorithm(const TDMACoef & tdma_coef)
+// forward elimination of A, which does not depend on d
+// NOTE: The factorization is shared by the right hand sides solved with the same A.
+struct TDMAFactorization
+{
+  std::vector<double> a;
+  std::vector<double> p;
+  std::vector<double> den;
+};
+
+inline TDMAFactorization factorizeTridiagonalMatrix(const TDMACoef & tdma_coef)
 {
   const auto & a = tdma_coef.a;
   const auto & b = tdma_coef.b;
   const auto & c = tdma_coef.c;
-  const auto & d = tdma_coef.d;
 
   const size_t num_row = b.size();
 
+  TDMAFactorization factorization;
+  factorization.a = a;
+  factorization.p.reserve(num_row);
+  factorization.den.reserve(num_row);
+  factorization.den.push_back(b[0]);
+  if (num_row != 1) {
+    factorization.p.push_back(-c[0] / b[0]);
+    for (size_t i = 1; i < num_row; ++i) {
+      const double den = b[i] + a[i - 1] * factorization.p[i - 1];
+      factorization.p.push_back(-c[i - 1] / den);
+      factorization.den.push_back(den);
+    }
+  }
+
+  return factorization;
+}
+
+inline std::vector<double> solveTridiagonalMatrixAlgorithm(
+  const TDMAFactorization & factorization, const std::vector<double> & d)
+{
+  const auto & a = factorization.a;
+  const auto & p = factorization.p;
+  const auto & den = factorization.den;
+
+  const size_t num_row = den.size();
+
   std::vector<double> x(num_row);
   if (num_row != 1) {
-    // calculate p and q
-    std::vector<double> p;
-    std::vector<double> q;
-    p.push_back(-c[0] / b[0]);
-    q.push_back(d[0] / b[0]);
+    // calculate q
+    std::vector<double> q(num_row);
+    q[0] = d[0] / den[0];
 
     for (size_t i = 1; i < num_row; ++i) {
-      const double den = b[i] + a[i - 1] * p[i - 1];
-      p.push_back(-c[i - 1] / den);
-      q.push_back((d[i] - a[i - 1] * q[i - 1]) / den);
+      q[i] = (d[i] - a[i - 1] * q[i - 1]) / den[i];
     }
 
     // calculate solution
@@ -72,11 +105,95 @@ inline std::vector<double> solveTridiagonalMatrixAlgorithm(const TDMACoef & tdma
       x[j] = p[j] * x[j + 1] + q[j];
     }
   } else {
-    x[0] = (d[0] / b[0]);
+    x[0] = (d[0] / den[0]);
   }
 
   return x;
 }
+
+// tridiagonal matrix of the second derivatives on the base keys
+inline TDMAFactorization factorizeSplineMatrix(const std::vector<double> & diff_keys)
+{
+  const size_t num_row = diff_keys.size() - 1;  // N-1
+  TDMACoef tdma_coef(num_row);
+  for (size_t i = 0; i < num_row; ++i) {
+    tdma_coef.b[i] = 2 * (diff_keys[i] + diff_keys[i + 1]);
+    if (i != num_row - 1) {
+      tdma_coef.a[i] = diff_keys[i + 1];
+      tdma_coef.c[i] = diff_keys[i + 1];
+    }
+  }
+  return factorizeTridiagonalMatrix(tdma_coef);
+}
+
+inline std::vector<double> calcDiffKeys(const std::vector<double> & base_keys)
+{
+  std::vector<double> diff_keys;  // N
+  diff_keys.reserve(base_keys.size() - 1);
+  for (size_t i = 0; i < base_keys.size() - 1; ++i) {
+    diff_keys.push_back(base_keys.at(i + 1) - base_keys.at(i));
+  }
+  return diff_keys;
+}
+
+// NOTE: factorization is empty when the number of the base keys is 2.
+interpolation::MultiSplineCoef calcMultiSplineCoef(
+  const std::vector<double> & diff_keys, const TDMAFactorization & factorization,
+  const std::vector<double> & base_values)
+{
+  const size_t num_base = diff_keys.size() + 1;  // N+1
+
+  std::vector<double> diff_values;  // N
+  diff_values.reserve(num_base - 1);
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    diff_values.push_back(base_values.at(i + 1) - base_values.at(i));
+  }
+
+  std::vector<double> v = {0.0};
+  if (num_base > 2) {
+    // solve tridiagonal matrix algorithm
+    std::vector<double> d(num_base - 2);  // N-1
+    for (size_t i = 0; i < num_base - 2; ++i) {
+      d[i] = 6.0 * (diff_values[i + 1] / diff_keys[i + 1] - diff_values[i] / diff_keys[i]);
+    }
+
+    const std::vector<double> tdma_res = solveTridiagonalMatrixAlgorithm(factorization, d);
+
+    // calculate v
+    v.insert(v.end(), tdma_res.begin(), tdma_res.end());
+  }
+  v.push_back(0.0);
+
+  // calculate a, b, c, d of spline coefficients
+  interpolation::MultiSplineCoef multi_spline_coef{num_base - 1};  // N
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    multi_spline_coef.a[i] = (v[i + 1] - v[i]) / 6.0 / diff_keys[i];
+    multi_spline_coef.b[i] = v[i] / 2.0;
+    multi_spline_coef.c[i] =
+      diff_values[i] / diff_keys[i] - diff_keys[i] * (2 * v[i] + v[i + 1]) / 6.0;
+    multi_spline_coef.d[i] = base_values[i];
+  }
+
+  return multi_spline_coef;
+}
+
+inline double calcValue(
+  const interpolation::MultiSplineCoef & coef, const size_t j, const double ds)
+{
+  return coef.d[j] + (coef.c[j] + (coef.b[j] + coef.a[j] * ds) * ds) * ds;
+}
+
+inline double calcDiffValue(
+  const interpolation::MultiSplineCoef & coef, const size_t j, const double ds)
+{
+  return coef.c[j] + (2.0 * coef.b[j] + 3.0 * coef.a[j] * ds) * ds;
+}
+
+inline double calcQuadDiffValue(
+  const interpolation::MultiSplineCoef & coef, const size_t j, const double ds)
+{
+  return 2.0 * coef.b[j] + 6.0 * coef.a[j] * ds;
+}
 }  // namespace
 
 namespace interpolation
@@ -92,6 +209,17 @@ std::vector<double> spline(
   return interpolator.getSplineInterpolatedValues(query_keys);
 }
 
+std::vector<std::vector<double>> splineMultiChannel(
+  const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values,
+  const std::vector<double> & query_keys)
+{
+  // calculate spline coefficients of all the channels
+  SplineInterpolationMultiChannel interpolator(base_keys, base_values);
+
+  // interpolate base_keys at query_keys
+  return interpolator.getSplineInterpolatedValues(query_keys);
+}
+
 std::vector<double> splineByAkima(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys)
@@ -172,46 +300,10 @@ void SplineInterpolation::calcSplineCoefficients(
   // throw exceptions for invalid arguments
   interpolation_utils::validateKeysAndValues(base_keys, base_values);
 
-  const size_t num_base = base_keys.size();  // N+1
-
-  std::vector<double> diff_keys;    // N
-  std::vector<double> diff_values;  // N
-  for (size_t i = 0; i < num_base - 1; ++i) {
-    diff_keys.push_back(base_keys.at(i + 1) - base_keys.at(i));
-    diff_values.push_back(base_values.at(i + 1) - base_values.at(i));
-  }
-
-  std::vector<double> v = {0.0};
-  if (num_base > 2) {
-    // solve tridiagonal matrix algorithm
-    TDMACoef tdma_coef(num_base - 2);  // N-1
-
-    for (size_t i = 0; i < num_base - 2; ++i) {
-      tdma_coef.b[i] = 2 * (diff_keys[i] + diff_keys[i + 1]);
-      if (i != num_base - 3) {
-        tdma_coef.a[i] = diff_keys[i + 1];
-        tdma_coef.c[i] = diff_keys[i + 1];
-      }
-      tdma_coef.d[i] =
-        6.0 * (diff_values[i + 1] / diff_keys[i + 1] - diff_values[i] / diff_keys[i]);
-    }
-
-    const std::vector<double> tdma_res = solveTridiagonalMatrixAlgorithm(tdma_coef);
-
-    // calculate v
-    v.insert(v.end(), tdma_res.begin(), tdma_res.end());
-  }
-  v.push_back(0.0);
-
-  // calculate a, b, c, d of spline coefficients
-  multi_spline_coef_ = interpolation::MultiSplineCoef{num_base - 1};  // N
-  for (size_t i = 0; i < num_base - 1; ++i) {
-    multi_spline_coef_.a[i] = (v[i + 1] - v[i]) / 6.0 / diff_keys[i];
-    multi_spline_coef_.b[i] = v[i] / 2.0;
-    multi_spline_coef_.c[i] =
-      diff_values[i] / diff_keys[i] - diff_keys[i] * (2 * v[i] + v[i + 1]) / 6.0;
-    multi_spline_coef_.d[i] = base_values[i];
-  }
+  const auto diff_keys = calcDiffKeys(base_keys);
+  const auto factorization =
+    base_keys.size() > 2 ? factorizeSplineMatrix(diff_keys) : TDMAFactorization{};
+  multi_spline_coef_ = calcMultiSplineCoef(diff_keys, factorization, base_values);
 
   base_keys_ = base_keys;
 }
@@ -287,3 +379,133 @@ std::vector<double> SplineInterpolation::getSplineInterpolatedQuadDiffValues(
 
   return res;
 }
+
+void SplineInterpolationMultiChannel::calcSplineCoefficients(
+  const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values)
+{
+  // throw exceptions for invalid arguments
+  if (base_values.empty()) {
+    throw std::invalid_argument("Points is empty.");
+  }
+  for (const auto & values : base_values) {
+    interpolation_utils::validateKeysAndValues(base_keys, values);
+  }
+  // NOTE: checked here once so that a single query key is validated in constant time
+  if (!interpolation_utils::isIncreasing(base_keys)) {
+    throw std::invalid_argument("base_keys is not sorted.");
+  }
+
+  // the tridiagonal matrix depends only on the base keys
+  const auto diff_keys = calcDiffKeys(base_keys);
+  const auto factorization =
+    base_keys.size() > 2 ? factorizeSplineMatrix(diff_keys) : TDMAFactorization{};
+
+  multi_spline_coefs_.clear();
+  multi_spline_coefs_.reserve(base_values.size());
+  for (const auto & values : base_values) {
+    multi_spline_coefs_.push_back(calcMultiSplineCoef(diff_keys, factorization, values));
+  }
+
+  base_keys_ = base_keys;
+}
+
+size_t SplineInterpolationMultiChannel::getSegmentIndex(const double query_key) const
+{
+  // the first segment whose end is not smaller than query_key, as the sweep of the query keys
+  const auto itr = std::lower_bound(base_keys_.begin() + 1, base_keys_.end() - 1, query_key);
+  return static_cast<size_t>(std::distance(base_keys_.begin() + 1, itr));
+}
+
+double SplineInterpolationMultiChannel::validateKey(const double query_key) const
+{
+  // throw exceptions for invalid arguments, and crop query_key as validateKeys does
+  if (base_keys_.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. base_keys.size() = " + std::to_string(base_keys_.size()));
+  }
+
+  constexpr double epsilon = 1e-3;
+  if (query_key < base_keys_.front() - epsilon || base_keys_.back() + epsilon < query_key) {
+    throw std::invalid_argument("query_keys is out of base_keys");
+  }
+
+  return std::clamp(query_key, base_keys_.front(), base_keys_.back());
+}
+
+std::vector<std::vector<double>> SplineInterpolationMultiChannel::getSplineInterpolatedValues(
+  const std::vector<double> & query_keys) const
+{
+  return getSplineInterpolatedValuesImpl(query_keys, calcValue);
+}
+
+std::vector<std::vector<double>> SplineInterpolationMultiChannel::getSplineInterpolatedDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  return getSplineInterpolatedValuesImpl(query_keys, calcDiffValue);
+}
+
+std::vector<std::vector<double>>
+SplineInterpolationMultiChannel::getSplineInterpolatedQuadDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  return getSplineInterpolatedValuesImpl(query_keys, calcQuadDiffValue);
+}
+
+template <typename CalcValue>
+std::vector<std::vector<double>> SplineInterpolationMultiChannel::getSplineInterpolatedValuesImpl(
+  const std::vector<double> & query_keys, const CalcValue & calc_value) const
+{
+  // throw exceptions for invalid arguments
+  const auto validated_query_keys = interpolation_utils::validateKeys(base_keys_, query_keys);
+
+  // segment and offset of each query key, shared by all the channels
+  std::vector<size_t> segment_indices;
+  std::vector<double> segment_offsets;
+  segment_indices.reserve(validated_query_keys.size());
+  segment_offsets.reserve(validated_query_keys.size());
+  size_t j = 0;
+  for (const auto & query_key : validated_query_keys) {
+    while (base_keys_.at(j + 1) < query_key) {
+      ++j;
+    }
+    segment_indices.push_back(j);
+    segment_offsets.push_back(query_key - base_keys_.at(j));
+  }
+
+  std::vector<std::vector<double>> res;
+  res.reserve(multi_spline_coefs_.size());
+  for (const auto & coef : multi_spline_coefs_) {
+    std::vector<double> values(validated_query_keys.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = calc_value(coef, segment_indices[i], segment_offsets[i]);
+    }
+    res.push_back(std::move(values));
+  }
+
+  return res;
+}
+
+double SplineInterpolationMultiChannel::getSplineInterpolatedValue(
+  const size_t channel, const double query_key) const
+{
+  const double validated_query_key = validateKey(query_key);
+  const size_t j = getSegmentIndex(validated_query_key);
+  return calcValue(multi_spline_coefs_.at(channel), j, validated_query_key - base_keys_.at(j));
+}
+
+double SplineInterpolationMultiChannel::getSplineInterpolatedDiffValue(
+  const size_t channel, const double query_key) const
+{
+  const double validated_query_key = validateKey(query_key);
+  const size_t j = getSegmentIndex(validated_query_key);
+  return calcDiffValue(multi_spline_coefs_.at(channel), j, validated_query_key - base_keys_.at(j));
+}
+
+double SplineInterpolationMultiChannel::getSplineInterpolatedQuadDiffValue(
+  const size_t channel, const double query_key) const
+{
+  const double validated_query_key = validateKey(query_key);
+  const size_t j = getSegmentIndex(validated_query_key);
+  return calcQuadDiffValue(
+    multi_spline_coefs_.at(channel), j, validated_query_key - base_keys_.at(j));
+}
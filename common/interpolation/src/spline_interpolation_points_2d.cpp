@@ -14,6 +14,9 @@
 
 #include "interpolation/spline_interpolation_points_2d.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace
@@ -76,10 +79,10 @@ std::array<std::vector<double>, 3> slerp2dFromXY(
   const std::vector<double> & base_y_values, const std::vector<double> & query_keys)
 {
   // calculate spline coefficients
-  SplineInterpolation interpolator_x(base_keys, base_x_values);
-  SplineInterpolation interpolator_y(base_keys, base_y_values);
-  const auto diff_x = interpolator_x.getSplineInterpolatedDiffValues(query_keys);
-  const auto diff_y = interpolator_y.getSplineInterpolatedDiffValues(query_keys);
+  SplineInterpolationMultiChannel interpolator(base_keys, {base_x_values, base_y_values});
+  const auto diff_xy = interpolator.getSplineInterpolatedDiffValues(query_keys);
+  const auto & diff_x = diff_xy.at(0);
+  const auto & diff_y = diff_xy.at(1);
 
   // calculate yaw
   std::vector<double> yaw_vec;
@@ -88,9 +91,8 @@ std::array<std::vector<double>, 3> slerp2dFromXY(
     yaw_vec.push_back(yaw);
   }
   // interpolate base_keys at query_keys
-  return {
-    interpolator_x.getSplineInterpolatedValues(query_keys),
-    interpolator_y.getSplineInterpolatedValues(query_keys), yaw_vec};
+  auto xy = interpolator.getSplineInterpolatedValues(query_keys);
+  return {std::move(xy.at(0)), std::move(xy.at(1)), yaw_vec};
 }
 
 template <typename T>
@@ -137,9 +139,9 @@ geometry_msgs::msg::Point SplineInterpolationPoints2d::getSplineInterpolatedPoin
     whole_s = base_s_vec_.back();
   }
 
-  const double x = spline_x_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double y = spline_y_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double z = spline_z_.getSplineInterpolatedValues({whole_s}).at(0);
+  const double x = spline_xyz_.getSplineInterpolatedValue(0, whole_s);
+  const double y = spline_xyz_.getSplineInterpolatedValue(1, whole_s);
+  const double z = spline_xyz_.getSplineInterpolatedValue(2, whole_s);
 
   geometry_msgs::msg::Point geom_point;
   geom_point.x = x;
@@ -157,8 +159,8 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const double diff_x = spline_xyz_.getSplineInterpolatedDiffValue(0, whole_s);
+  const double diff_y = spline_xyz_.getSplineInterpolatedDiffValue(1, whole_s);
 
   return std::atan2(diff_y, diff_x);
 }
@@ -166,7 +168,7 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedYaws() const
 {
   std::vector<double> yaw_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
+  for (size_t i = 0; i < spline_xyz_.getSize(); ++i) {
     const double yaw = getSplineInterpolatedYaw(i, 0.0);
     yaw_vec.push_back(yaw);
   }
@@ -183,11 +185,11 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const double diff_x = spline_xyz_.getSplineInterpolatedDiffValue(0, whole_s);
+  const double diff_y = spline_xyz_.getSplineInterpolatedDiffValue(1, whole_s);
 
-  const double quad_diff_x = spline_x_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
-  const double quad_diff_y = spline_y_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
+  const double quad_diff_x = spline_xyz_.getSplineInterpolatedQuadDiffValue(0, whole_s);
+  const double quad_diff_y = spline_xyz_.getSplineInterpolatedQuadDiffValue(1, whole_s);
 
   return (diff_x * quad_diff_y - quad_diff_x * diff_y) /
          std::pow(std::pow(diff_x, 2) + std::pow(diff_y, 2), 1.5);
@@ -196,7 +198,7 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedCurvatures() const
 {
   std::vector<double> curvature_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
+  for (size_t i = 0; i < spline_xyz_.getSize(); ++i) {
     const double curvature = getSplineInterpolatedCurvature(i, 0.0);
     curvature_vec.push_back(curvature);
   }
@@ -206,10 +208,9 @@ std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedCurvatures
 size_t SplineInterpolationPoints2d::getOffsetIndex(const size_t idx, const double offset) const
 {
   const double whole_s = base_s_vec_.at(idx) + offset;
-  for (size_t s_idx = 0; s_idx < base_s_vec_.size(); ++s_idx) {
-    if (whole_s < base_s_vec_.at(s_idx)) {
-      return s_idx;
-    }
+  const auto itr = std::upper_bound(base_s_vec_.begin(), base_s_vec_.end(), whole_s);
+  if (itr != base_s_vec_.end()) {
+    return static_cast<size_t>(std::distance(base_s_vec_.begin(), itr));
   }
   return base_s_vec_.size() - 1;
 }
@@ -233,7 +234,5 @@ void SplineInterpolationPoints2d::calcSplineCoefficientsInner(
   const auto & base_z_vec = base.at(3);
 
   // calculate spline coefficients
-  spline_x_ = SplineInterpolation(base_s_vec_, base_x_vec);
-  spline_y_ = SplineInterpolation(base_s_vec_, base_y_vec);
-  spline_z_ = SplineInterpolation(base_s_vec_, base_z_vec);
+  spline_xyz_ = SplineInterpolationMultiChannel(base_s_vec_, {base_x_vec, base_y_vec, base_z_vec});
 }
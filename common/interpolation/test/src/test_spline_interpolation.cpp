@@ -235,3 +235,105 @@ TEST(spline_interpolation, SplineInterpolation)
     EXPECT_NEAR(query_values.at(i), ans.at(i), epsilon);
   }
 }
+
+TEST(spline_interpolation, splineMultiChannel)
+{
+  {  // same as spline of each channel
+    const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+    const std::vector<std::vector<double>> base_values{
+      {-1.2, 0.5, 1.0, 1.2, 2.0, 1.0},
+      {0.0, 1.5, 3.0, 4.5, 6.0, 7.5},
+      {3.0, 2.0, 3.0, 2.0, 3.0, 2.0}};
+    const std::vector<double> query_keys{-1.5, 0.0, 1.0, 8.0, 15.0, 18.0, 20.0};
+
+    const auto query_values = interpolation::splineMultiChannel(base_keys, base_values, query_keys);
+    ASSERT_EQ(query_values.size(), base_values.size());
+    for (size_t channel = 0; channel < base_values.size(); ++channel) {
+      const auto ans = interpolation::spline(base_keys, base_values.at(channel), query_keys);
+      ASSERT_EQ(query_values.at(channel).size(), ans.size());
+      for (size_t i = 0; i < ans.size(); ++i) {
+        EXPECT_DOUBLE_EQ(query_values.at(channel).at(i), ans.at(i));
+      }
+    }
+  }
+
+  {  // size of base_keys is 2
+    const std::vector<double> base_keys{0.0, 1.0};
+    const std::vector<std::vector<double>> base_values{{0.0, 1.5}, {2.0, 1.0}};
+    const std::vector<double> query_keys{0.0, 0.3, 1.0};
+    const std::vector<std::vector<double>> ans{{0.0, 0.45, 1.5}, {2.0, 1.7, 1.0}};
+
+    const auto query_values = interpolation::splineMultiChannel(base_keys, base_values, query_keys);
+    for (size_t channel = 0; channel < ans.size(); ++channel) {
+      for (size_t i = 0; i < query_keys.size(); ++i) {
+        EXPECT_NEAR(query_values.at(channel).at(i), ans.at(channel).at(i), epsilon);
+      }
+    }
+  }
+
+  {  // invalid arguments
+    const std::vector<double> base_keys{0.0, 1.0, 2.0};
+    EXPECT_THROW(
+      interpolation::splineMultiChannel(base_keys, {}, base_keys), std::invalid_argument);
+    EXPECT_THROW(
+      interpolation::splineMultiChannel(base_keys, {{0.0, 1.0, 2.0}, {0.0, 1.0}}, base_keys),
+      std::invalid_argument);
+    EXPECT_THROW(
+      interpolation::splineMultiChannel({0.0, 2.0, 1.0}, {{0.0, 1.0, 2.0}}, base_keys),
+      std::invalid_argument);
+  }
+}
+
+TEST(spline_interpolation, SplineInterpolationMultiChannel)
+{
+  const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+  const std::vector<double> base_values_x{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+  const std::vector<double> base_values_y{0.0, 1.5, 3.0, 4.5, 6.0, 7.5};
+  const std::vector<double> query_keys{-1.5, 0.0, 1.0, 8.0, 18.0, 20.0};
+
+  const SplineInterpolation s_x(base_keys, base_values_x);
+  const SplineInterpolation s_y(base_keys, base_values_y);
+  const SplineInterpolationMultiChannel s(base_keys, {base_values_x, base_values_y});
+  EXPECT_EQ(s.getSize(), base_keys.size());
+  EXPECT_EQ(s.getNumChannels(), 2U);
+
+  {  // values, 1st and 2nd differential values on all the query keys
+    const auto values = s.getSplineInterpolatedValues(query_keys);
+    const auto diff_values = s.getSplineInterpolatedDiffValues(query_keys);
+    const auto quad_diff_values = s.getSplineInterpolatedQuadDiffValues(query_keys);
+    const std::vector<const SplineInterpolation *> single_splines{&s_x, &s_y};
+    for (size_t channel = 0; channel < single_splines.size(); ++channel) {
+      const auto & single = *single_splines.at(channel);
+      const auto ans = single.getSplineInterpolatedValues(query_keys);
+      const auto diff_ans = single.getSplineInterpolatedDiffValues(query_keys);
+      const auto quad_diff_ans = single.getSplineInterpolatedQuadDiffValues(query_keys);
+      for (size_t i = 0; i < query_keys.size(); ++i) {
+        EXPECT_DOUBLE_EQ(values.at(channel).at(i), ans.at(i));
+        EXPECT_DOUBLE_EQ(diff_values.at(channel).at(i), diff_ans.at(i));
+        EXPECT_DOUBLE_EQ(quad_diff_values.at(channel).at(i), quad_diff_ans.at(i));
+      }
+    }
+  }
+
+  {  // value on one query key
+    for (const double query_key : query_keys) {
+      EXPECT_DOUBLE_EQ(
+        s.getSplineInterpolatedValue(0, query_key),
+        s_x.getSplineInterpolatedValues({query_key}).front());
+      EXPECT_DOUBLE_EQ(
+        s.getSplineInterpolatedDiffValue(1, query_key),
+        s_y.getSplineInterpolatedDiffValues({query_key}).front());
+      EXPECT_DOUBLE_EQ(
+        s.getSplineInterpolatedQuadDiffValue(1, query_key),
+        s_y.getSplineInterpolatedQuadDiffValues({query_key}).front());
+    }
+
+    // query key slightly out of base keys is cropped
+    EXPECT_DOUBLE_EQ(
+      s.getSplineInterpolatedValue(0, base_keys.back() + 1e-4),
+      s.getSplineInterpolatedValue(0, base_keys.back()));
+
+    EXPECT_THROW(s.getSplineInterpolatedValue(0, base_keys.back() + 1.0), std::invalid_argument);
+    EXPECT_THROW(s.getSplineInterpolatedValue(2, 0.0), std::out_of_range);
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "perception_utils/matching.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <autoware_auto_perception_msgs/msg/detected_object.hpp>
+
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using autoware_auto_perception_msgs::msg::DetectedObject;
+using autoware_auto_perception_msgs::msg::Shape;
+
+// IoU as computed before the convex polygon clipping was introduced
+double boostIoU(const DetectedObject & source_object, const DetectedObject & target_object)
+{
+  const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
+  const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
+  std::vector<tier4_autoware_utils::Polygon2d> intersection_polygons;
+  boost::geometry::intersection(source_polygon, target_polygon, intersection_polygons);
+  const double intersection_area = perception_utils::getSumArea(intersection_polygons);
+  if (intersection_area == 0.0) return 0.0;
+  const double union_area = perception_utils::getUnionArea(source_polygon, target_polygon);
+  return union_area < 0.01 ? 0.0 : std::min(1.0, intersection_area / union_area);
+}
+
+int main()
+{
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> position_dist(-10.0, 10.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size_dist(0.5, 5.0);
+  std::bernoulli_distribution is_box_dist(0.8);
+
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stopwatch;
+  std::printf("#Objects Pairs boost[ms] convex[ms] batch[ms] max_abs_diff\n");
+  for (const auto nb_objects : {10lu, 50lu, 100lu, 200lu}) {
+    std::vector<DetectedObject> objects(nb_objects);
+    for (auto & object : objects) {
+      auto & pose = object.kinematics.pose_with_covariance.pose;
+      pose.position.x = position_dist(engine);
+      pose.position.y = position_dist(engine);
+      pose.orientation = tier4_autoware_utils::createQuaternionFromYaw(yaw_dist(engine));
+      object.shape.type = is_box_dist(engine) ? Shape::BOUNDING_BOX : Shape::CYLINDER;
+      object.shape.dimensions.x = size_dist(engine);
+      object.shape.dimensions.y = size_dist(engine);
+    }
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t i = 0; i < nb_objects; ++i) {
+      for (size_t j = 0; j < nb_objects; ++j) {
+        pairs.emplace_back(i, j);
+      }
+    }
+
+    std::vector<double> boost_ious;
+    boost_ious.reserve(pairs.size());
+    stopwatch.tic();
+    for (const auto & [i, j] : pairs) boost_ious.push_back(boostIoU(objects[i], objects[j]));
+    const auto boost_time = stopwatch.toc();
+
+    std::vector<double> convex_ious;
+    convex_ious.reserve(pairs.size());
+    stopwatch.tic();
+    for (const auto & [i, j] : pairs) {
+      convex_ious.push_back(perception_utils::get2dIoU(objects[i], objects[j]));
+    }
+    const auto convex_time = stopwatch.toc();
+
+    stopwatch.tic();
+    const auto batch_ious = perception_utils::get2dIoUBatch(objects, objects, pairs);
+    const auto batch_time = stopwatch.toc();
+
+    double max_diff = 0.0;
+    for (size_t k = 0; k < pairs.size(); ++k) {
+      max_diff = std::max(max_diff, std::abs(boost_ious[k] - convex_ious[k]));
+      max_diff = std::max(max_diff, std::abs(boost_ious[k] - batch_ious[k]));
+    }
+    std::printf(
+      "%lu %lu %f %f %f %e\n", nb_objects, pairs.size(), boost_time, convex_time, batch_time,
+      max_diff);
+  }
+  return 0;
+}
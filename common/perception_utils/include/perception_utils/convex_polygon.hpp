@@ -0,0 +1,196 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PERCEPTION_UTILS__CONVEX_POLYGON_HPP_
+#define PERCEPTION_UTILS__CONVEX_POLYGON_HPP_
+
+#include "tier4_autoware_utils/geometry/boost_geometry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace perception_utils
+{
+/**
+ * @brief fixed capacity vertex buffer living on the stack
+ * @details vertices are stored counter clockwise and the ring is NOT closed
+ */
+template <std::size_t Capacity>
+struct VertexBuffer
+{
+  struct Vertex
+  {
+    double x;
+    double y;
+  };
+
+  std::array<Vertex, Capacity> vertices;
+  std::size_t size = 0;
+
+  void clear() { size = 0; }
+  void push_back(const Vertex & v) { vertices[size++] = v; }
+  const Vertex & operator[](const std::size_t i) const { return vertices[i]; }
+  Vertex & operator[](const std::size_t i) { return vertices[i]; }
+};
+
+// object footprints have 4 (box), 6 (cylinder) or a few more (convex hull) vertices
+constexpr std::size_t max_convex_polygon_vertices = 32;
+// intersection or convex hull of two convex polygons has at most n + m vertices
+constexpr std::size_t max_clipped_polygon_vertices = 2 * max_convex_polygon_vertices;
+
+using ConvexPolygon2d = VertexBuffer<max_convex_polygon_vertices>;
+using ClippedPolygon2d = VertexBuffer<max_clipped_polygon_vertices>;
+
+template <std::size_t Capacity>
+double getArea(const VertexBuffer<Capacity> & polygon)
+{
+  if (polygon.size < 3) return 0.0;
+  double twice_area = 0.0;
+  for (std::size_t i = 0, j = polygon.size - 1; i < polygon.size; j = i++) {
+    twice_area += polygon[j].x * polygon[i].y - polygon[i].x * polygon[j].y;
+  }
+  return 0.5 * twice_area;
+}
+
+/**
+ * @brief convert a boost polygon to a counter clockwise convex vertex buffer
+ * @return false if the polygon is degenerate, not convex, self-intersecting or has too many
+ * vertices
+ */
+inline bool toConvexPolygon2d(
+  const tier4_autoware_utils::Polygon2d & polygon, ConvexPolygon2d & convex_polygon)
+{
+  convex_polygon.clear();
+  const auto & outer = polygon.outer();
+  std::size_t nb_vertices = outer.size();
+  // skip the closing point
+  if (nb_vertices > 1 && outer.front().x() == outer.back().x() &&
+      outer.front().y() == outer.back().y()) {
+    --nb_vertices;
+  }
+  if (nb_vertices < 3 || nb_vertices > max_convex_polygon_vertices) return false;
+
+  for (std::size_t i = 0; i < nb_vertices; ++i) {
+    convex_polygon.push_back({outer[i].x(), outer[i].y()});
+  }
+  if (getArea(convex_polygon) < 0.0) {
+    std::reverse(convex_polygon.vertices.begin(), convex_polygon.vertices.begin() + nb_vertices);
+  }
+
+  // every turn must be to the left (collinear vertices are allowed) and the turns must add up to
+  // a single revolution, a star polygon such as a pentagram only turns left but winds twice
+  constexpr double epsilon = 1e-9;
+  double total_turn = 0.0;
+  for (std::size_t i = 0; i < nb_vertices; ++i) {
+    const auto & p0 = convex_polygon[i];
+    const auto & p1 = convex_polygon[(i + 1) % nb_vertices];
+    const auto & p2 = convex_polygon[(i + 2) % nb_vertices];
+    const double cross = (p1.x - p0.x) * (p2.y - p1.y) - (p1.y - p0.y) * (p2.x - p1.x);
+    if (cross < -epsilon) return false;
+    const double dot = (p1.x - p0.x) * (p2.x - p1.x) + (p1.y - p0.y) * (p2.y - p1.y);
+    total_turn += std::atan2(std::max(cross, 0.0), dot);
+  }
+  return total_turn < 2.0 * M_PI + 1e-6;
+}
+
+/**
+ * @brief area of the intersection of two counter clockwise convex polygons
+ * @details Sutherland-Hodgman clipping of the source by every edge of the target
+ */
+inline double getConvexIntersectionArea(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygon2d & target_polygon)
+{
+  ClippedPolygon2d buffers[2];
+  auto * input = &buffers[0];
+  auto * output = &buffers[1];
+  for (std::size_t i = 0; i < source_polygon.size; ++i) {
+    output->push_back({source_polygon[i].x, source_polygon[i].y});
+  }
+
+  for (std::size_t e = 0; e < target_polygon.size && output->size > 0; ++e) {
+    std::swap(input, output);
+    output->clear();
+    const auto & a = target_polygon[e];
+    const auto & b = target_polygon[(e + 1) % target_polygon.size];
+    const double edge_x = b.x - a.x;
+    const double edge_y = b.y - a.y;
+    const auto side = [&](const auto & p) {
+      return edge_x * (p.y - a.y) - edge_y * (p.x - a.x);
+    };
+
+    auto prev = (*input)[input->size - 1];
+    double prev_side = side(prev);
+    for (std::size_t i = 0; i < input->size; ++i) {
+      const auto curr = (*input)[i];
+      const double curr_side = side(curr);
+      if ((curr_side >= 0.0) != (prev_side >= 0.0)) {
+        const double ratio = prev_side / (prev_side - curr_side);
+        output->push_back(
+          {prev.x + ratio * (curr.x - prev.x), prev.y + ratio * (curr.y - prev.y)});
+      }
+      if (curr_side >= 0.0) {
+        output->push_back(curr);
+      }
+      prev = curr;
+      prev_side = curr_side;
+    }
+  }
+  return std::max(0.0, getArea(*output));
+}
+
+/**
+ * @brief area of the convex hull of two convex polygons (Andrew's monotone chain)
+ */
+inline double getConvexHullArea(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygon2d & target_polygon)
+{
+  ClippedPolygon2d points;
+  for (std::size_t i = 0; i < source_polygon.size; ++i) {
+    points.push_back({source_polygon[i].x, source_polygon[i].y});
+  }
+  for (std::size_t i = 0; i < target_polygon.size; ++i) {
+    points.push_back({target_polygon[i].x, target_polygon[i].y});
+  }
+  const auto begin = points.vertices.begin();
+  const auto end = begin + points.size;
+  std::sort(begin, end, [](const auto & p, const auto & q) {
+    return p.x < q.x || (p.x == q.x && p.y < q.y);
+  });
+
+  const auto cross = [](const auto & o, const auto & p, const auto & q) {
+    return (p.x - o.x) * (q.y - o.y) - (p.y - o.y) * (q.x - o.x);
+  };
+  VertexBuffer<max_clipped_polygon_vertices + 1> hull;
+  for (std::size_t i = 0; i < points.size; ++i) {  // lower hull
+    while (hull.size >= 2 && cross(hull[hull.size - 2], hull[hull.size - 1], points[i]) <= 0.0) {
+      --hull.size;
+    }
+    hull.push_back({points[i].x, points[i].y});
+  }
+  const std::size_t lower_size = hull.size + 1;
+  for (std::size_t i = points.size - 1; i > 0; --i) {  // upper hull
+    const auto & p = points[i - 1];
+    while (hull.size >= lower_size && cross(hull[hull.size - 2], hull[hull.size - 1], p) <= 0.0) {
+      --hull.size;
+    }
+    hull.push_back({p.x, p.y});
+  }
+  --hull.size;  // the last point is the first one
+  return getArea(hull);
+}
+}  // namespace perception_utils
+
+#endif  // PERCEPTION_UTILS__CONVEX_POLYGON_HPP_
@@ -15,6 +15,7 @@
 #ifndef PERCEPTION_UTILS__MATCHING_HPP_
 #define PERCEPTION_UTILS__MATCHING_HPP_
 
+#include "perception_utils/convex_polygon.hpp"
 #include "perception_utils/geometry.hpp"
 #include "tier4_autoware_utils/geometry/boost_geometry.hpp"
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
@@ -50,6 +51,14 @@ inline double getSumArea(const std::vector<Polygon2d> & polygons)
 inline double getIntersectionArea(
   const Polygon2d & source_polygon, const Polygon2d & target_polygon)
 {
+  ConvexPolygon2d source_convex;
+  ConvexPolygon2d target_convex;
+  if (
+    toConvexPolygon2d(source_polygon, source_convex) &&
+    toConvexPolygon2d(target_polygon, target_convex)) {
+    return getConvexIntersectionArea(source_convex, target_convex);
+  }
+
   std::vector<Polygon2d> intersection_polygons;
   boost::geometry::intersection(source_polygon, target_polygon, intersection_polygons);
   return getSumArea(intersection_polygons);
@@ -62,12 +71,31 @@ inline double getUnionArea(const Polygon2d & source_polygon, const Polygon2d & t
   return getSumArea(union_polygons);
 }
 
+inline double get2dIoU(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygon2d & target_polygon,
+  const double min_union_area = 0.01)
+{
+  const double intersection_area = getConvexIntersectionArea(source_polygon, target_polygon);
+  if (intersection_area == 0.0) return 0.0;
+  const double union_area = getArea(source_polygon) + getArea(target_polygon) - intersection_area;
+
+  return union_area < min_union_area ? 0.0 : std::min(1.0, intersection_area / union_area);
+}
+
 template <class T1, class T2>
 double get2dIoU(const T1 source_object, const T2 target_object, const double min_union_area = 0.01)
 {
   const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
   const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
 
+  ConvexPolygon2d source_convex;
+  ConvexPolygon2d target_convex;
+  if (
+    toConvexPolygon2d(source_polygon, source_convex) &&
+    toConvexPolygon2d(target_polygon, target_convex)) {
+    return get2dIoU(source_convex, target_convex, min_union_area);
+  }
+
   const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
   if (intersection_area == 0.0) return 0.0;
   const double union_area = getUnionArea(source_polygon, target_polygon);
@@ -77,15 +105,75 @@ double get2dIoU(const T1 source_object, const T2 target_object, const double min
   return iou;
 }
 
+/**
+ * @brief IoU of many (source, target) pairs
+ * @details every object is converted to a polygon only once, pairs of convex polygons are
+ *          computed without heap allocation
+ */
+template <class T1, class T2>
+std::vector<double> get2dIoUBatch(
+  const std::vector<T1> & source_objects, const std::vector<T2> & target_objects,
+  const std::vector<std::pair<size_t, size_t>> & pairs, const double min_union_area = 0.01)
+{
+  const auto to_polygons = [](const auto & objects, auto & polygons, auto & convex_polygons,
+                              std::vector<bool> & is_convex) {
+    polygons.reserve(objects.size());
+    convex_polygons.resize(objects.size());
+    is_convex.resize(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+      polygons.push_back(tier4_autoware_utils::toPolygon2d(objects[i]));
+      is_convex[i] = toConvexPolygon2d(polygons.back(), convex_polygons[i]);
+    }
+  };
+  std::vector<Polygon2d> source_polygons;
+  std::vector<Polygon2d> target_polygons;
+  std::vector<ConvexPolygon2d> source_convex;
+  std::vector<ConvexPolygon2d> target_convex;
+  std::vector<bool> source_is_convex;
+  std::vector<bool> target_is_convex;
+  to_polygons(source_objects, source_polygons, source_convex, source_is_convex);
+  to_polygons(target_objects, target_polygons, target_convex, target_is_convex);
+
+  std::vector<double> ious;
+  ious.reserve(pairs.size());
+  for (const auto & [source_idx, target_idx] : pairs) {
+    if (source_is_convex[source_idx] && target_is_convex[target_idx]) {
+      ious.push_back(get2dIoU(source_convex[source_idx], target_convex[target_idx], min_union_area));
+      continue;
+    }
+    const auto & source_polygon = source_polygons[source_idx];
+    const auto & target_polygon = target_polygons[target_idx];
+    const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
+    const double union_area =
+      intersection_area == 0.0 ? 0.0 : getUnionArea(source_polygon, target_polygon);
+    ious.push_back(
+      union_area < min_union_area ? 0.0 : std::min(1.0, intersection_area / union_area));
+  }
+  return ious;
+}
+
 template <class T1, class T2>
 double get2dGeneralizedIoU(const T1 & source_object, const T2 & target_object)
 {
   const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
   const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
 
-  const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
-  const double union_area = getUnionArea(source_polygon, target_polygon);
-  const double convex_shape_area = getConvexShapeArea(source_polygon, target_polygon);
+  double intersection_area;
+  double union_area;
+  double convex_shape_area;
+  ConvexPolygon2d source_convex;
+  ConvexPolygon2d target_convex;
+  if (
+    toConvexPolygon2d(source_polygon, source_convex) &&
+    toConvexPolygon2d(target_polygon, target_convex)) {
+    intersection_area = getConvexIntersectionArea(source_convex, target_convex);
+    union_area = getArea(source_convex) + getArea(target_convex) - intersection_area;
+    convex_shape_area = getConvexHullArea(source_convex, target_convex);
+  } else {
+    intersection_area = getIntersectionArea(source_polygon, target_polygon);
+    union_area = getUnionArea(source_polygon, target_polygon);
+    convex_shape_area = getConvexShapeArea(source_polygon, target_polygon);
+  }
 
   const double iou = union_area < 0.01 ? 0.0 : std::min(1.0, intersection_area / union_area);
   return iou - (convex_shape_area - union_area) / convex_shape_area;
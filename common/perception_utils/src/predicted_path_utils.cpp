@@ -19,6 +19,8 @@
 #include "interpolation/spline_interpolation.hpp"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace perception_utils
 {
@@ -78,9 +80,18 @@ autoware_auto_perception_msgs::msg::PredictedPath resamplePredictedPath(
     return interpolation::slerp(input_time, input, resampled_time);
   };
 
-  const auto interpolated_x = use_spline_for_xy ? spline(x) : lerp(x);
-  const auto interpolated_y = use_spline_for_xy ? spline(y) : lerp(y);
-  const auto interpolated_z = use_spline_for_z ? spline(z) : lerp(z);
+  // the splined channels share the same keys, so they are solved together in one pass
+  std::vector<std::vector<double>> splined_values;
+  if (use_spline_for_xy && use_spline_for_z) {
+    splined_values = interpolation::splineMultiChannel(input_time, {x, y, z}, resampled_time);
+  } else if (use_spline_for_xy) {
+    splined_values = interpolation::splineMultiChannel(input_time, {x, y}, resampled_time);
+  } else if (use_spline_for_z) {
+    splined_values = {spline(z)};
+  }
+  const auto interpolated_x = use_spline_for_xy ? std::move(splined_values.at(0)) : lerp(x);
+  const auto interpolated_y = use_spline_for_xy ? std::move(splined_values.at(1)) : lerp(y);
+  const auto interpolated_z = use_spline_for_z ? std::move(splined_values.back()) : lerp(z);
   const auto interpolated_quat = slerp(quat);
 
   autoware_auto_perception_msgs::msg::PredictedPath resampled_path;
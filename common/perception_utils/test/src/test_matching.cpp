@@ -284,3 +284,109 @@ TEST(matching, test_get2dRecall)
     EXPECT_DOUBLE_EQ(reversed_recall, quart_circle * 4);
   }
 }
+
+TEST(matching, test_get2dIoUBatch)
+{
+  using autoware_auto_perception_msgs::msg::DetectedObject;
+  using autoware_auto_perception_msgs::msg::Shape;
+  using perception_utils::get2dIoU;
+  using perception_utils::get2dIoUBatch;
+
+  std::vector<DetectedObject> objects;
+  {  // box
+    DetectedObject obj;
+    obj.kinematics.pose_with_covariance.pose = createPose(0.5, 0.5, M_PI);
+    obj.shape.type = Shape::BOUNDING_BOX;
+    obj.shape.dimensions.x = 1.0;
+    obj.shape.dimensions.y = 1.0;
+    objects.push_back(obj);
+  }
+  {  // cylinder
+    DetectedObject obj;
+    obj.kinematics.pose_with_covariance.pose = createPose(0.0, 0.0, M_PI_2);
+    obj.shape.type = Shape::CYLINDER;
+    obj.shape.dimensions.x = 1.0;
+    objects.push_back(obj);
+  }
+  {  // rotated box
+    DetectedObject obj;
+    obj.kinematics.pose_with_covariance.pose = createPose(0.2, -0.3, M_PI_4);
+    obj.shape.type = Shape::BOUNDING_BOX;
+    obj.shape.dimensions.x = 2.0;
+    obj.shape.dimensions.y = 0.7;
+    objects.push_back(obj);
+  }
+  {  // non convex polygon (falls back to boost::geometry)
+    DetectedObject obj;
+    obj.kinematics.pose_with_covariance.pose = createPose(0.0, 0.0, 0.0);
+    obj.shape.type = Shape::POLYGON;
+    for (const auto & [x, y] : std::vector<std::pair<double, double>>{
+           {-1.0, -1.0}, {1.0, -1.0}, {1.0, 1.0}, {0.0, 0.0}, {-1.0, 1.0}}) {
+      geometry_msgs::msg::Point32 p;
+      p.x = x;
+      p.y = y;
+      obj.shape.footprint.points.push_back(p);
+    }
+    objects.push_back(obj);
+  }
+
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    for (size_t j = 0; j < objects.size(); ++j) {
+      pairs.emplace_back(i, j);
+    }
+  }
+  const auto ious = get2dIoUBatch(objects, objects, pairs);
+  ASSERT_EQ(ious.size(), pairs.size());
+  for (size_t k = 0; k < pairs.size(); ++k) {
+    const auto & [i, j] = pairs[k];
+    EXPECT_NEAR(ious[k], get2dIoU(objects[i], objects[j]), epsilon);
+    if (i == j) {
+      EXPECT_NEAR(ious[k], 1.0, epsilon);
+    }
+  }
+}
+
+TEST(matching, test_convex_polygon_area)
+{
+  using perception_utils::ConvexPolygon2d;
+  using perception_utils::getConvexHullArea;
+  using perception_utils::getConvexIntersectionArea;
+  using perception_utils::toConvexPolygon2d;
+  using tier4_autoware_utils::Polygon2d;
+
+  Polygon2d square;
+  square.outer() = {Point2d{0.0, 0.0}, Point2d{0.0, 2.0}, Point2d{2.0, 2.0}, Point2d{2.0, 0.0},
+                    Point2d{0.0, 0.0}};
+  Polygon2d shifted_square;
+  shifted_square.outer() = {Point2d{1.0, 1.0}, Point2d{1.0, 3.0}, Point2d{3.0, 3.0},
+                            Point2d{3.0, 1.0}, Point2d{1.0, 1.0}};
+  Polygon2d non_convex;
+  non_convex.outer() = {Point2d{0.0, 0.0}, Point2d{1.0, 1.0}, Point2d{2.0, 0.0},
+                        Point2d{1.0, 2.0}, Point2d{0.0, 0.0}};
+
+  // pentagram: every turn is to the left but the boundary winds twice around its center
+  Polygon2d star;
+  for (int i = 0; i <= 5; ++i) {
+    const double angle = 0.5 * M_PI + 4.0 * M_PI * (i % 5) / 5.0;
+    star.outer().push_back(Point2d{std::cos(angle), std::sin(angle)});
+  }
+
+  ConvexPolygon2d convex_square;
+  ConvexPolygon2d convex_shifted_square;
+  ConvexPolygon2d convex_non_convex;
+  ConvexPolygon2d convex_star;
+  ASSERT_TRUE(toConvexPolygon2d(square, convex_square));
+  ASSERT_TRUE(toConvexPolygon2d(shifted_square, convex_shifted_square));
+  EXPECT_FALSE(toConvexPolygon2d(non_convex, convex_non_convex));
+  EXPECT_FALSE(toConvexPolygon2d(star, convex_star));
+
+  EXPECT_NEAR(perception_utils::getArea(convex_square), 4.0, epsilon);
+  EXPECT_NEAR(getConvexIntersectionArea(convex_square, convex_shifted_square), 1.0, epsilon);
+  EXPECT_NEAR(getConvexIntersectionArea(convex_shifted_square, convex_square), 1.0, epsilon);
+  EXPECT_NEAR(getConvexIntersectionArea(convex_square, convex_square), 4.0, epsilon);
+  EXPECT_NEAR(getConvexHullArea(convex_square, convex_shifted_square), 8.0, epsilon);
+  EXPECT_NEAR(
+    perception_utils::getIntersectionArea(square, shifted_square),
+    getConvexIntersectionArea(convex_square, convex_shifted_square), epsilon);
+}
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::motion::control::mpc_lateral_controller
@@ -95,13 +96,17 @@ bool resampleMPCTrajectoryByDistance(
   std::vector<double> input_yaw = input.yaw;
   convertEulerAngleToMonotonic(&input_yaw);
 
-  output->x = interpolation::spline(input_arclength, input.x, output_arclength);
-  output->y = interpolation::spline(input_arclength, input.y, output_arclength);
-  output->z = interpolation::spline(input_arclength, input.z, output_arclength);
-  output->yaw = interpolation::spline(input_arclength, input.yaw, output_arclength);
+  // x, y, z, yaw, k and smooth_k share the spline factorization of the arc length
+  auto spline_values = interpolation::splineMultiChannel(
+    input_arclength, {input.x, input.y, input.z, input.yaw, input.k, input.smooth_k},
+    output_arclength);
+  output->x = std::move(spline_values.at(0));
+  output->y = std::move(spline_values.at(1));
+  output->z = std::move(spline_values.at(2));
+  output->yaw = std::move(spline_values.at(3));
   output->vx = interpolation::lerp(input_arclength, input.vx, output_arclength);
-  output->k = interpolation::spline(input_arclength, input.k, output_arclength);
-  output->smooth_k = interpolation::spline(input_arclength, input.smooth_k, output_arclength);
+  output->k = std::move(spline_values.at(4));
+  output->smooth_k = std::move(spline_values.at(5));
   output->relative_time =
     interpolation::lerp(input_arclength, input.relative_time, output_arclength);
 
@@ -0,0 +1,195 @@
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_collision_checker/obstacle_collision_checker.hpp"
+
+#include <pcl_ros/transforms.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <tier4_autoware_utils/geometry/geometry.hpp>
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <boost/geometry.hpp>
+
+#include <pcl_conversions/pcl_conversions.h>
+#include <tf2/utils.h>
+
+#ifdef ROS_DISTRO_GALACTIC
+#include <tf2_eigen/tf2_eigen.h>
+#else
+#include <tf2_eigen/tf2_eigen.hpp>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+using obstacle_collision_checker::LinearRing2d;
+
+// previous implementation: copy of the transformed cloud, filtering of every point against every
+// trajectory point, then every footprint tested against every filtered point
+bool willCollideReference(
+  const sensor_msgs::msg::PointCloud2 & pointcloud_msg,
+  const geometry_msgs::msg::Transform & transform,
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double radius,
+  const std::vector<LinearRing2d> & vehicle_passing_areas)
+{
+  const Eigen::Matrix4f transform_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
+  sensor_msgs::msg::PointCloud2 transformed_msg;
+  pcl_ros::transformPointCloud(transform_matrix, pointcloud_msg, transformed_msg);
+  pcl::PointCloud<pcl::PointXYZ> pointcloud;
+  pcl::fromROSMsg(transformed_msg, pointcloud);
+
+  pcl::PointCloud<pcl::PointXYZ> filtered_pointcloud;
+  for (const auto & point : pointcloud.points) {
+    for (const auto & trajectory_point : trajectory.points) {
+      const double dx = trajectory_point.pose.position.x - point.x;
+      const double dy = trajectory_point.pose.position.y - point.y;
+      if (std::hypot(dx, dy) < radius) {
+        filtered_pointcloud.points.push_back(point);
+        break;
+      }
+    }
+  }
+
+  for (size_t i = 1; i < vehicle_passing_areas.size(); i++) {
+    for (const auto & point : filtered_pointcloud.points) {
+      if (boost::geometry::within(
+            tier4_autoware_utils::Point2d{point.x, point.y}, vehicle_passing_areas.at(i))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// trajectory going straight then turning left, with points every 0.1m
+autoware_auto_planning_msgs::msg::Trajectory::SharedPtr makeTrajectory(const size_t nb_points)
+{
+  auto trajectory = std::make_shared<autoware_auto_planning_msgs::msg::Trajectory>();
+  double x = 0.0;
+  double y = 0.0;
+  double yaw = 0.0;
+  for (size_t i = 0; i < nb_points; ++i) {
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position.x = x;
+    p.pose.position.y = y;
+    p.pose.orientation = tier4_autoware_utils::createQuaternionFromYaw(yaw);
+    trajectory->points.push_back(p);
+    x += 0.1 * std::cos(yaw);
+    y += 0.1 * std::sin(yaw);
+    if (i > nb_points / 2) yaw += 0.001;
+  }
+  return trajectory;
+}
+
+// obstacles around the trajectory, and one point on it if required
+sensor_msgs::msg::PointCloud2::SharedPtr makePointCloud(
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const size_t nb_points,
+  const bool with_collision, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<size_t> index_distribution(0, trajectory.points.size() - 1);
+  std::uniform_real_distribution<float> offset_distribution(3.0f, 15.0f);
+  std::bernoulli_distribution side_distribution;
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  for (size_t i = 0; i < nb_points; ++i) {
+    const auto & pose = trajectory.points[index_distribution(gen)].pose;
+    const auto yaw = tf2::getYaw(pose.orientation);
+    const auto offset =
+      side_distribution(gen) ? offset_distribution(gen) : -offset_distribution(gen);
+    cloud.emplace_back(
+      pose.position.x - offset * std::sin(yaw), pose.position.y + offset * std::cos(yaw), 0.5f);
+  }
+  if (with_collision) {
+    const auto & position = trajectory.points[trajectory.points.size() * 3 / 4].pose.position;
+    cloud.emplace_back(position.x, position.y, 0.5f);
+  }
+  auto msg = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  pcl::toROSMsg(cloud, *msg);
+  return msg;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  rclcpp::NodeOptions node_options;
+  node_options.append_parameter_override("wheel_radius", 0.5);
+  node_options.append_parameter_override("wheel_width", 0.2);
+  node_options.append_parameter_override("wheel_base", 3.0);
+  node_options.append_parameter_override("wheel_tread", 2.0);
+  node_options.append_parameter_override("front_overhang", 1.0);
+  node_options.append_parameter_override("rear_overhang", 1.0);
+  node_options.append_parameter_override("left_overhang", 0.5);
+  node_options.append_parameter_override("right_overhang", 0.5);
+  node_options.append_parameter_override("vehicle_height", 1.5);
+  node_options.append_parameter_override("max_steer_angle", 0.7);
+  const auto node =
+    std::make_shared<rclcpp::Node>("obstacle_collision_checker_benchmark", node_options);
+
+  obstacle_collision_checker::Param param;
+  param.delay_time = 0.3;
+  param.footprint_margin = 0.0;
+  param.max_deceleration = 0.5;  // long braking distance to check the whole trajectory
+  param.resample_interval = 0.3;
+  param.search_radius = 5.0;
+  obstacle_collision_checker::ObstacleCollisionChecker checker(*node);
+  checker.setParam(param);
+
+  obstacle_collision_checker::Input input;
+  auto twist = std::make_shared<geometry_msgs::msg::Twist>();
+  twist->linear.x = 15.0;
+  input.current_twist = twist;
+  input.obstacle_transform = std::make_shared<geometry_msgs::msg::TransformStamped>();
+
+  constexpr auto nb_iterations = 5;
+  std::mt19937 gen(0);
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stopwatch;
+  // Update is the whole update() of the checker, Reference only the replaced steps (transform,
+  // filtering by trajectory and collision tests) on the same passing areas
+  std::printf("#TrajectoryPoints CloudPoints Collision Reference[ms] Update[ms] Mismatches\n");
+  for (const auto nb_trajectory_points : {500lu, 2000lu, 5000lu}) {
+    input.predicted_trajectory = makeTrajectory(nb_trajectory_points);
+    for (const auto nb_cloud_points : {10000lu, 100000lu}) {
+      for (const auto with_collision : {false, true}) {
+        double reference_duration{};
+        double duration{};
+        int nb_mismatches{};
+        for (auto i = 0; i < nb_iterations; ++i) {
+          input.obstacle_pointcloud =
+            makePointCloud(*input.predicted_trajectory, nb_cloud_points, with_collision, gen);
+
+          stopwatch.tic();
+          const auto output = checker.update(input);
+          duration += stopwatch.toc();
+
+          stopwatch.tic();
+          const auto reference = willCollideReference(
+            *input.obstacle_pointcloud, input.obstacle_transform->transform,
+            output.resampled_trajectory, param.search_radius, output.vehicle_passing_areas);
+          reference_duration += stopwatch.toc();
+          if (reference != output.will_collide) ++nb_mismatches;
+        }
+        std::printf(
+          "%lu %lu %d %f %f %d\n", nb_trajectory_points, nb_cloud_points, with_collision,
+          reference_duration / nb_iterations, duration / nb_iterations, nb_mismatches);
+      }
+    }
+  }
+  rclcpp::shutdown();
+  return 0;
+}
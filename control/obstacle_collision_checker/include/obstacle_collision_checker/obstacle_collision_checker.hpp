@@ -15,6 +15,8 @@
 #ifndef OBSTACLE_COLLISION_CHECKER__OBSTACLE_COLLISION_CHECKER_HPP_
 #define OBSTACLE_COLLISION_CHECKER__OBSTACLE_COLLISION_CHECKER_HPP_
 
+#include "obstacle_collision_checker/point_grid.hpp"
+
 #include <tier4_autoware_utils/geometry/boost_geometry.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
@@ -95,12 +97,9 @@ private:
     const LinearRing2d & area1, const LinearRing2d & area2);
 
   static bool willCollide(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-    const std::vector<LinearRing2d> & vehicle_footprints);
+    const PointGrid & obstacle_grid, const std::vector<LinearRing2d> & vehicle_footprints);
 
-  static bool hasCollision(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-    const LinearRing2d & vehicle_footprint);
+  static bool hasCollision(const PointGrid & obstacle_grid, const LinearRing2d & vehicle_footprint);
 };
 }  // namespace obstacle_collision_checker
 
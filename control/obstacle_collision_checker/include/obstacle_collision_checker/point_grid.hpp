@@ -0,0 +1,112 @@
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_COLLISION_CHECKER__POINT_GRID_HPP_
+#define OBSTACLE_COLLISION_CHECKER__POINT_GRID_HPP_
+
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace obstacle_collision_checker
+{
+using tier4_autoware_utils::Box2d;
+using tier4_autoware_utils::Point2d;
+
+/**
+ * @brief spatial hash of 2D points on a regular grid
+ * @details the points are sorted by cell once at construction. Each non-empty cell maps to a
+ * contiguous range of point indices, in increasing order, so that a box query only visits the
+ * points of the cells overlapping the box. The points must be finite.
+ */
+class PointGrid
+{
+public:
+  PointGrid(std::vector<Point2d> points, const double cell_size)
+  : points_(std::move(points)), cell_size_(cell_size)
+  {
+    std::vector<std::int64_t> keys(points_.size());
+    for (size_t i = 0; i < points_.size(); ++i) {
+      keys[i] = cellKey(cellIndex(points_[i].x()), cellIndex(points_[i].y()));
+    }
+    indices_.resize(points_.size());
+    std::iota(indices_.begin(), indices_.end(), 0);
+    std::stable_sort(indices_.begin(), indices_.end(), [&](const size_t a, const size_t b) {
+      return keys[a] < keys[b];
+    });
+    for (size_t begin = 0; begin < indices_.size();) {
+      const auto key = keys[indices_[begin]];
+      auto end = begin + 1;
+      while (end < indices_.size() && keys[indices_[end]] == key) ++end;
+      cells_.emplace(key, std::make_pair(begin, end));
+      begin = end;
+    }
+  }
+
+  const std::vector<Point2d> & points() const { return points_; }
+  size_t size() const { return points_.size(); }
+  bool empty() const { return points_.empty(); }
+
+  /**
+   * @brief call the predicate on the index of each point in the cells overlapping the box
+   * @details the points of a cell are visited in increasing index order but the cells are visited
+   * by increasing x then y index. The search stops as soon as the predicate returns true.
+   * @return true if the predicate returned true for a point
+   */
+  template <class Predicate>
+  bool anyOf(const Box2d & box, Predicate && predicate) const
+  {
+    if (points_.empty()) return false;
+    const auto min_x = cellIndex(box.min_corner().x());
+    const auto max_x = cellIndex(box.max_corner().x());
+    const auto min_y = cellIndex(box.min_corner().y());
+    const auto max_y = cellIndex(box.max_corner().y());
+    for (auto x = min_x; x <= max_x; ++x) {
+      for (auto y = min_y; y <= max_y; ++y) {
+        const auto cell = cells_.find(cellKey(x, y));
+        if (cell == cells_.end()) continue;
+        for (auto i = cell->second.first; i < cell->second.second; ++i) {
+          if (predicate(indices_[i])) return true;
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  std::int32_t cellIndex(const double coordinate) const
+  {
+    return static_cast<std::int32_t>(std::floor(coordinate / cell_size_));
+  }
+
+  static std::int64_t cellKey(const std::int32_t x, const std::int32_t y)
+  {
+    return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+  }
+
+  std::vector<Point2d> points_;
+  double cell_size_;
+  // indices of the points sorted by cell and range of each cell in this vector
+  std::vector<size_t> indices_;
+  std::unordered_map<std::int64_t, std::pair<size_t, size_t>> cells_;
+};
+}  // namespace obstacle_collision_checker
+
+#endif  // OBSTACLE_COLLISION_CHECKER__POINT_GRID_HPP_
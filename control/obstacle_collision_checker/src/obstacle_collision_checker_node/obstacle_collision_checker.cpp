@@ -14,7 +14,7 @@
 
 #include "obstacle_collision_checker/obstacle_collision_checker.hpp"
 
-#include <pcl_ros/transforms.hpp>
+#include <autoware_point_types/point_cloud2_view.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/math/normalization.hpp>
@@ -23,7 +23,6 @@
 
 #include <boost/geometry.hpp>
 
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2/utils.h>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -32,22 +31,32 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <cmath>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 namespace
 {
+// [m] a few cells per passing area so that a footprint query visits few points
+constexpr double obstacle_grid_cell_size = 1.0;
+
 pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
   const sensor_msgs::msg::PointCloud2 & pointcloud_msg,
   const geometry_msgs::msg::Transform & transform)
 {
   const Eigen::Matrix4f transform_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
 
-  sensor_msgs::msg::PointCloud2 transformed_msg;
-  pcl_ros::transformPointCloud(transform_matrix, pointcloud_msg, transformed_msg);
-
+  // read the points from the message buffer and transform them in a single copy
+  const autoware_point_types::PointCloud2View<pcl::PointXYZ> points(pointcloud_msg);
   pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(transformed_msg, transformed_pointcloud);
+  transformed_pointcloud.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Eigen::Vector4f point(
+      points.get<pcl::fields::x>(i), points.get<pcl::fields::y>(i), points.get<pcl::fields::z>(i),
+      1.0f);
+    transformed_pointcloud.points[i].getVector4fMap() = transform_matrix * point;
+  }
 
   return transformed_pointcloud;
 }
@@ -57,14 +66,33 @@ pcl::PointCloud<pcl::PointXYZ> filterPointCloudByTrajectory(
   const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double radius)
 {
   pcl::PointCloud<pcl::PointXYZ> filtered_pointcloud;
+  if (radius <= 0.0) {
+    return filtered_pointcloud;
+  }
+
+  // with cells as large as the radius, only the trajectory points of the neighboring cells are
+  // compared to each point
+  std::vector<obstacle_collision_checker::Point2d> trajectory_points;
+  trajectory_points.reserve(trajectory.points.size());
+  for (const auto & trajectory_point : trajectory.points) {
+    trajectory_points.emplace_back(
+      trajectory_point.pose.position.x, trajectory_point.pose.position.y);
+  }
+  const obstacle_collision_checker::PointGrid trajectory_grid(trajectory_points, radius);
+
   for (const auto & point : pointcloud.points) {
-    for (const auto & trajectory_point : trajectory.points) {
-      const double dx = trajectory_point.pose.position.x - point.x;
-      const double dy = trajectory_point.pose.position.y - point.y;
-      if (std::hypot(dx, dy) < radius) {
-        filtered_pointcloud.points.push_back(point);
-        break;
-      }
+    if (!std::isfinite(point.x) || !std::isfinite(point.y)) {
+      continue;
+    }
+    const tier4_autoware_utils::Box2d search_box{
+      {point.x - radius, point.y - radius}, {point.x + radius, point.y + radius}};
+    const auto is_near_trajectory = trajectory_grid.anyOf(search_box, [&](const size_t i) {
+      const double dx = trajectory_grid.points()[i].x() - point.x;
+      const double dy = trajectory_grid.points()[i].y() - point.y;
+      return std::hypot(dx, dy) < radius;
+    });
+    if (is_near_trajectory) {
+      filtered_pointcloud.points.push_back(point);
     }
   }
   return filtered_pointcloud;
@@ -107,6 +135,13 @@ Output ObstacleCollisionChecker::update(const Input & input)
     getTransformedPointCloud(*input.obstacle_pointcloud, input.obstacle_transform->transform);
   const auto filtered_obstacle_pointcloud = filterPointCloudByTrajectory(
     obstacle_pointcloud, output.resampled_trajectory, param_.search_radius);
+  std::vector<Point2d> obstacle_points;
+  obstacle_points.reserve(filtered_obstacle_pointcloud.size());
+  for (const auto & point : filtered_obstacle_pointcloud.points) {
+    obstacle_points.emplace_back(point.x, point.y);
+  }
+  const PointGrid obstacle_grid(std::move(obstacle_points), obstacle_grid_cell_size);
+  output.processing_time_map["createObstacleGrid"] = stop_watch.toc(true);
 
   output.vehicle_footprints =
     createVehicleFootprints(output.resampled_trajectory, param_, vehicle_info_);
@@ -115,7 +150,7 @@ Output ObstacleCollisionChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  output.will_collide = willCollide(filtered_obstacle_pointcloud, output.vehicle_passing_areas);
+  output.will_collide = willCollide(obstacle_grid, output.vehicle_passing_areas);
   output.processing_time_map["willCollide"] = stop_watch.toc(true);
 
   return output;
@@ -234,13 +269,12 @@ LinearRing2d ObstacleCollisionChecker::createHullFromFootprints(
 }
 
 bool ObstacleCollisionChecker::willCollide(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-  const std::vector<LinearRing2d> & vehicle_footprints)
+  const PointGrid & obstacle_grid, const std::vector<LinearRing2d> & vehicle_footprints)
 {
   for (size_t i = 1; i < vehicle_footprints.size(); i++) {
     // skip first footprint because surround obstacle checker handle it
     const auto & vehicle_footprint = vehicle_footprints.at(i);
-    if (hasCollision(obstacle_pointcloud, vehicle_footprint)) {
+    if (hasCollision(obstacle_grid, vehicle_footprint)) {
       RCLCPP_WARN(
         rclcpp::get_logger("obstacle_collision_checker"), "ObstacleCollisionChecker::willCollide");
       return true;
@@ -251,17 +285,26 @@ bool ObstacleCollisionChecker::willCollide(
 }
 
 bool ObstacleCollisionChecker::hasCollision(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-  const LinearRing2d & vehicle_footprint)
+  const PointGrid & obstacle_grid, const LinearRing2d & vehicle_footprint)
 {
-  for (const auto & point : obstacle_pointcloud.points) {
-    if (boost::geometry::within(
-          tier4_autoware_utils::Point2d{point.x, point.y}, vehicle_footprint)) {
-      RCLCPP_WARN(
-        rclcpp::get_logger("obstacle_collision_checker"),
-        "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x, point.y);
-      return true;
+  // only the points of the cells covered by the footprint are tested, the first colliding point
+  // of the cloud is reported
+  const auto & points = obstacle_grid.points();
+  auto collision_index = points.size();
+  const auto footprint_box = boost::geometry::return_envelope<Box2d>(vehicle_footprint);
+  obstacle_grid.anyOf(footprint_box, [&](const size_t i) {
+    if (i < collision_index && boost::geometry::within(points[i], vehicle_footprint)) {
+      collision_index = i;
     }
+    return false;
+  });
+
+  if (collision_index < points.size()) {
+    const auto & point = points[collision_index];
+    RCLCPP_WARN(
+      rclcpp::get_logger("obstacle_collision_checker"),
+      "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x(), point.y());
+    return true;
   }
 
   return false;
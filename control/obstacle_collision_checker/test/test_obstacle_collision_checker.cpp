@@ -44,3 +44,47 @@ TEST(test_obstacle_collision_checker, filterPointCloudByTrajectory)
     }
   }
 }
+
+TEST(test_obstacle_collision_checker, PointGrid)
+{
+  using obstacle_collision_checker::Box2d;
+  using obstacle_collision_checker::Point2d;
+  using obstacle_collision_checker::PointGrid;
+
+  std::vector<Point2d> points;
+  for (double x = -5.0; x <= 5.0; x += 0.25) {
+    for (double y = -5.0; y <= 5.0; y += 0.25) {
+      points.emplace_back(x, y);
+    }
+  }
+  const PointGrid grid(points, 1.0);
+  EXPECT_EQ(grid.size(), points.size());
+
+  const auto is_in_box = [](const Point2d & p, const Box2d & box) {
+    return p.x() >= box.min_corner().x() && p.x() <= box.max_corner().x() &&
+           p.y() >= box.min_corner().y() && p.y() <= box.max_corner().y();
+  };
+  for (const auto & box : {Box2d{{-0.1, -0.1}, {0.1, 0.1}}, Box2d{{-3.3, 1.2}, {2.7, 4.9}},
+                           Box2d{{-10.0, -10.0}, {10.0, 10.0}}, Box2d{{6.0, 6.0}, {7.0, 7.0}}}) {
+    // every point of the box is visited exactly once
+    std::vector<int> nb_visits(points.size(), 0);
+    EXPECT_FALSE(grid.anyOf(box, [&](const size_t i) {
+      ++nb_visits[i];
+      return false;
+    }));
+    for (size_t i = 0; i < points.size(); ++i) {
+      EXPECT_LE(nb_visits[i], 1);
+      if (is_in_box(points[i], box)) {
+        EXPECT_EQ(nb_visits[i], 1);
+      }
+    }
+  }
+
+  // the search stops at the first point matching the predicate
+  size_t nb_visits = 0;
+  EXPECT_TRUE(grid.anyOf(Box2d{{-10.0, -10.0}, {10.0, 10.0}}, [&](const size_t) {
+    ++nb_visits;
+    return true;
+  }));
+  EXPECT_EQ(nb_visits, 1ul);
+}
@@ -0,0 +1,231 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pure_pursuit/pure_pursuit.hpp"
+#include "pure_pursuit/util/planning_utils.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+using autoware_auto_planning_msgs::msg::Trajectory;
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using geometry_msgs::msg::Pose;
+namespace planning_utils = pure_pursuit::planning_utils;
+
+// same values as the default parameters of the lateral controller
+constexpr int64_t moving_ave_num = 25;
+constexpr double resampling_ds = 0.1;
+constexpr double lookahead_distance = 8.0;
+constexpr int num_prediction_steps = 71;  // control command and prediction_distance_length / ds
+constexpr double prediction_ds = 0.3;
+constexpr int num_cycles = 30;  // one second at the controller rate
+
+Trajectory createTrajectory(const size_t size)
+{
+  Trajectory trajectory;
+  for (size_t i = 0; i < size; ++i) {
+    const double s = static_cast<double>(i) * resampling_ds;
+    TrajectoryPoint p;
+    p.pose.position.x = 1000.0 + s;
+    p.pose.position.y = 2000.0 + 5.0 * std::sin(s / 20.0);
+    p.pose.orientation = planning_utils::getQuaternionFromYaw(std::atan(0.25 * std::cos(s / 20.0)));
+    p.longitudinal_velocity_mps = static_cast<float>(10.0 + std::sin(s / 7.0));
+    p.acceleration_mps2 = static_cast<float>(0.1 * std::cos(s / 7.0));
+    p.heading_rate_rps = static_cast<float>(0.01 * std::sin(s / 20.0));
+    trajectory.points.push_back(p);
+  }
+  return trajectory;
+}
+
+// previous implementation: the full window of each point is summed again
+Trajectory calcMovingAverageTrajectoryReference(const Trajectory & u, const int64_t num)
+{
+  Trajectory filtered_trajectory(u);
+  for (int64_t i = 0; i < static_cast<int64_t>(u.points.size()); ++i) {
+    TrajectoryPoint tmp{};
+    int64_t num_tmp = num;
+    int64_t count = 0;
+    double yaw = 0.0;
+    if (i - num_tmp < 0) {
+      num_tmp = i;
+    }
+    if (i + num_tmp > static_cast<int64_t>(u.points.size()) - 1) {
+      num_tmp = static_cast<int64_t>(u.points.size()) - i - 1;
+    }
+    for (int64_t j = -num_tmp; j <= num_tmp; ++j) {
+      const auto & p = u.points.at(static_cast<size_t>(i + j));
+      tmp.pose.position.x += p.pose.position.x;
+      tmp.pose.position.y += p.pose.position.y;
+      tmp.pose.position.z += p.pose.position.z;
+      tmp.longitudinal_velocity_mps += p.longitudinal_velocity_mps;
+      tmp.acceleration_mps2 += p.acceleration_mps2;
+      tmp.front_wheel_angle_rad += p.front_wheel_angle_rad;
+      tmp.heading_rate_rps += p.heading_rate_rps;
+      yaw += tf2::getYaw(p.pose.orientation);
+      tmp.lateral_velocity_mps += p.lateral_velocity_mps;
+      tmp.rear_wheel_angle_rad += p.rear_wheel_angle_rad;
+      ++count;
+    }
+    auto & p = filtered_trajectory.points.at(static_cast<size_t>(i));
+    p.pose.position.x = tmp.pose.position.x / count;
+    p.pose.position.y = tmp.pose.position.y / count;
+    p.pose.position.z = tmp.pose.position.z / count;
+    p.longitudinal_velocity_mps = tmp.longitudinal_velocity_mps / count;
+    p.acceleration_mps2 = tmp.acceleration_mps2 / count;
+    p.front_wheel_angle_rad = tmp.front_wheel_angle_rad / count;
+    p.heading_rate_rps = tmp.heading_rate_rps / count;
+    p.lateral_velocity_mps = tmp.lateral_velocity_mps / count;
+    p.rear_wheel_angle_rad = tmp.rear_wheel_angle_rad / count;
+    p.pose.orientation = planning_utils::getQuaternionFromYaw(yaw / count);
+  }
+  return filtered_trajectory;
+}
+
+// previous implementation of PurePursuit::findNextPointIdx: the lane direction and the relative
+// position are computed again on each waypoint
+int32_t findNextPointIdxReference(
+  const std::vector<Pose> & wps, const Pose & pose, const int32_t search_start_idx)
+{
+  if (wps.empty() || search_start_idx == -1) {
+    return -1;
+  }
+  for (int32_t i = search_start_idx; i < static_cast<int32_t>(wps.size()); i++) {
+    if (i == static_cast<int32_t>(wps.size()) - 1) {
+      return i;
+    }
+    const auto gld = planning_utils::getLaneDirection(wps, 0.05);
+    if (gld == 0) {
+      const auto ret = planning_utils::transformToRelativeCoordinate2D(wps.at(i).position, pose);
+      if (ret.x < 0) {
+        continue;
+      }
+    } else if (gld == 1) {
+      const auto ret = planning_utils::transformToRelativeCoordinate2D(wps.at(i).position, pose);
+      if (ret.x > 0) {
+        continue;
+      }
+    } else {
+      return -1;
+    }
+    const double ds = planning_utils::calcDistSquared2D(wps.at(i).position, pose.position);
+    if (ds > std::pow(lookahead_distance, 2)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// ego poses of the control command and the prediction steps, slightly off the trajectory
+std::vector<Pose> createPredictedPoses(const Trajectory & trajectory, const size_t start_idx)
+{
+  std::vector<Pose> poses;
+  const size_t step = static_cast<size_t>(std::round(prediction_ds / resampling_ds));
+  for (int i = 0; i < num_prediction_steps; ++i) {
+    const size_t idx =
+      std::min(start_idx + static_cast<size_t>(i) * step, trajectory.points.size() - 1);
+    Pose pose = trajectory.points.at(idx).pose;
+    pose.position.y += 0.2;
+    poses.push_back(pose);
+  }
+  return poses;
+}
+}  // namespace
+
+int main()
+{
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+
+  std::printf(
+    "#points, moving average reference [ms], moving average [ms], max diff [m], "
+    "cycle reference [ms], cycle [ms], next waypoint mismatches\n");
+  for (const size_t size : {1000, 3000, 10000, 30000}) {
+    const auto trajectory = createTrajectory(size);
+    const auto poses = createPredictedPoses(trajectory, size / 3);
+
+    // moving average
+    stop_watch.tic();
+    Trajectory reference_filtered;
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_filtered = calcMovingAverageTrajectoryReference(trajectory, moving_ave_num);
+    }
+    const double reference_average_time = stop_watch.toc() / num_cycles;
+
+    stop_watch.tic();
+    Trajectory filtered;
+    for (int i = 0; i < num_cycles; ++i) {
+      filtered = planning_utils::calcMovingAverageTrajectory(trajectory, moving_ave_num);
+    }
+    const double average_time = stop_watch.toc() / num_cycles;
+
+    double max_diff = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+      max_diff = std::max(
+        max_diff, planning_utils::calcDistance2D(
+                    filtered.points.at(i).pose.position,
+                    reference_filtered.points.at(i).pose.position));
+    }
+
+    // pure pursuit on the control command and all the prediction steps of one cycle: the waypoints
+    // were copied on each step and the next waypoint search restarted the lane direction
+    std::vector<int32_t> reference_next_indices;
+    stop_watch.tic();
+    for (int cycle = 0; cycle < num_cycles; ++cycle) {
+      reference_next_indices.clear();
+      for (const auto & pose : poses) {
+        const auto wps = planning_utils::extractPoses(filtered);
+        const auto closest =
+          planning_utils::findClosestIdxWithDistAngThr(wps, pose, 3.0, M_PI / 4);
+        reference_next_indices.push_back(findNextPointIdxReference(wps, pose, closest.second));
+      }
+    }
+    const double reference_cycle_time = stop_watch.toc() / num_cycles;
+
+    pure_pursuit::PurePursuit pure_pursuit;
+    pure_pursuit.setLookaheadDistance(lookahead_distance);
+    std::vector<geometry_msgs::msg::Point> next_waypoints;
+    stop_watch.tic();
+    for (int cycle = 0; cycle < num_cycles; ++cycle) {
+      next_waypoints.clear();
+      pure_pursuit.setWaypoints(planning_utils::extractPoses(filtered));
+      for (const auto & pose : poses) {
+        pure_pursuit.setCurrentPose(pose);
+        pure_pursuit.run();
+        next_waypoints.push_back(pure_pursuit.getLocationOfNextWaypoint());
+      }
+    }
+    const double cycle_time = stop_watch.toc() / num_cycles;
+
+    size_t num_mismatches = 0;
+    for (size_t i = 0; i < poses.size(); ++i) {
+      const auto idx = reference_next_indices.at(i);
+      if (
+        idx < 0 || planning_utils::calcDistance2D(
+                     filtered.points.at(idx).pose.position, next_waypoints.at(i)) > 0.0) {
+        num_mismatches++;
+      }
+    }
+
+    std::printf(
+      "%zu, %.3f, %.3f, %.3e, %.3f, %.3f, %zu\n", size, reference_average_time, average_time,
+      max_diff, reference_cycle_time, cycle_time, num_mismatches);
+  }
+  return 0;
+}
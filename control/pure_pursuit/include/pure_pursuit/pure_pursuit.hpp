@@ -34,6 +34,8 @@
 
 #include <geometry_msgs/msg/pose.hpp>
 
+#include <boost/optional.hpp>
+
 #include <memory>
 #include <utility>
 #include <vector>
@@ -78,7 +80,11 @@ private:
   std::shared_ptr<std::vector<geometry_msgs::msg::Pose>> curr_wps_ptr_;
   std::shared_ptr<geometry_msgs::msg::Pose> curr_pose_ptr_;
 
+  // direction of the current waypoints, computed once after they are set
+  boost::optional<int8_t> lane_direction_;
+
   // functions
+  int8_t getLaneDirection();
   int32_t findNextPointIdx(int32_t search_start_idx);
   std::pair<bool, geometry_msgs::msg::Point> lerpNextTarget(int32_t next_wp_idx);
 };
@@ -68,6 +68,10 @@ double convertCurvatureToSteeringAngle(double wheel_base, double kappa);
 std::vector<geometry_msgs::msg::Pose> extractPoses(
   const autoware_auto_planning_msgs::msg::Trajectory & motions);
 
+// moving average over [i - num, i + num] (shrunk at both ends) with one pass of prefix sums
+autoware_auto_planning_msgs::msg::Trajectory calcMovingAverageTrajectory(
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const int64_t moving_ave_num);
+
 std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   const std::vector<geometry_msgs::msg::Pose> & poses,
   const geometry_msgs::msg::Pose & current_pose, const double th_dist = 3.0,
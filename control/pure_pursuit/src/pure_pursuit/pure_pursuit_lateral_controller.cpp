@@ -224,48 +224,8 @@ void PurePursuitLateralController::averageFilterTrajectory(
     return;
   }
 
-  autoware_auto_planning_msgs::msg::Trajectory filtered_trajectory(u);
-
-  for (int64_t i = 0; i < static_cast<int64_t>(u.points.size()); ++i) {
-    TrajectoryPoint tmp{};
-    int64_t num_tmp = param_.path_filter_moving_ave_num;
-    int64_t count = 0;
-    double yaw = 0.0;
-    if (i - num_tmp < 0) {
-      num_tmp = i;
-    }
-    if (i + num_tmp > static_cast<int64_t>(u.points.size()) - 1) {
-      num_tmp = static_cast<int64_t>(u.points.size()) - i - 1;
-    }
-    for (int64_t j = -num_tmp; j <= num_tmp; ++j) {
-      const auto & p = u.points.at(static_cast<size_t>(i + j));
-
-      tmp.pose.position.x += p.pose.position.x;
-      tmp.pose.position.y += p.pose.position.y;
-      tmp.pose.position.z += p.pose.position.z;
-      tmp.longitudinal_velocity_mps += p.longitudinal_velocity_mps;
-      tmp.acceleration_mps2 += p.acceleration_mps2;
-      tmp.front_wheel_angle_rad += p.front_wheel_angle_rad;
-      tmp.heading_rate_rps += p.heading_rate_rps;
-      yaw += tf2::getYaw(p.pose.orientation);
-      tmp.lateral_velocity_mps += p.lateral_velocity_mps;
-      tmp.rear_wheel_angle_rad += p.rear_wheel_angle_rad;
-      ++count;
-    }
-    auto & p = filtered_trajectory.points.at(static_cast<size_t>(i));
-
-    p.pose.position.x = tmp.pose.position.x / count;
-    p.pose.position.y = tmp.pose.position.y / count;
-    p.pose.position.z = tmp.pose.position.z / count;
-    p.longitudinal_velocity_mps = tmp.longitudinal_velocity_mps / count;
-    p.acceleration_mps2 = tmp.acceleration_mps2 / count;
-    p.front_wheel_angle_rad = tmp.front_wheel_angle_rad / count;
-    p.heading_rate_rps = tmp.heading_rate_rps / count;
-    p.lateral_velocity_mps = tmp.lateral_velocity_mps / count;
-    p.rear_wheel_angle_rad = tmp.rear_wheel_angle_rad / count;
-    p.pose.orientation = pure_pursuit::planning_utils::getQuaternionFromYaw(yaw / count);
-  }
-  trajectory_resampled_ = std::make_shared<Trajectory>(filtered_trajectory);
+  trajectory_resampled_ = std::make_shared<Trajectory>(
+    planning_utils::calcMovingAverageTrajectory(u, param_.path_filter_moving_ave_num));
 }
 
 boost::optional<Trajectory> PurePursuitLateralController::generatePredictedTrajectory()
@@ -354,6 +314,8 @@ LateralOutput PurePursuitLateralController::run(const InputData & input_data)
   if (param_.enable_path_smoothing) {
     averageFilterTrajectory(*trajectory_resampled_);
   }
+  // the waypoints are shared by the control command and all the steps of the prediction
+  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_resampled_));
   const auto cmd_msg = generateOutputControlCmd();
 
   LateralOutput output;
@@ -471,7 +433,6 @@ boost::optional<PpOutput> PurePursuitLateralController::calcTargetCurvature(
 
   // Set PurePursuit data
   pure_pursuit_->setCurrentPose(pose);
-  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_resampled_));
   pure_pursuit_->setLookaheadDistance(lookahead_distance);
 
   // Run PurePursuit
@@ -14,6 +14,8 @@
 
 #include "pure_pursuit/util/planning_utils.hpp"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -104,6 +106,7 @@ std::vector<geometry_msgs::msg::Pose> extractPoses(
   const autoware_auto_planning_msgs::msg::Trajectory & trajectory)
 {
   std::vector<geometry_msgs::msg::Pose> poses;
+  poses.reserve(trajectory.points.size());
 
   for (const auto & p : trajectory.points) {
     poses.push_back(p.pose);
@@ -112,6 +115,63 @@ std::vector<geometry_msgs::msg::Pose> extractPoses(
   return poses;
 }
 
+autoware_auto_planning_msgs::msg::Trajectory calcMovingAverageTrajectory(
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const int64_t moving_ave_num)
+{
+  autoware_auto_planning_msgs::msg::Trajectory filtered_trajectory(trajectory);
+  const auto & points = trajectory.points;
+  const int64_t size = static_cast<int64_t>(points.size());
+  if (size == 0) {
+    return filtered_trajectory;
+  }
+
+  // prefix sums of x, y, z, longitudinal_velocity, acceleration, front_wheel_angle, heading_rate,
+  // yaw, lateral_velocity and rear_wheel_angle. Positions are relative to the first point so that
+  // the sums stay small compared to the map coordinates.
+  constexpr size_t num_fields = 10;
+  const auto & origin = points.front().pose.position;
+  std::vector<std::array<double, num_fields>> prefix_sums(points.size() + 1);
+  prefix_sums.front().fill(0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto & p = points.at(i);
+    const std::array<double, num_fields> values = {
+      p.pose.position.x - origin.x,
+      p.pose.position.y - origin.y,
+      p.pose.position.z - origin.z,
+      p.longitudinal_velocity_mps,
+      p.acceleration_mps2,
+      p.front_wheel_angle_rad,
+      p.heading_rate_rps,
+      tf2::getYaw(p.pose.orientation),
+      p.lateral_velocity_mps,
+      p.rear_wheel_angle_rad};
+    for (size_t k = 0; k < num_fields; ++k) {
+      prefix_sums.at(i + 1).at(k) = prefix_sums.at(i).at(k) + values.at(k);
+    }
+  }
+
+  for (int64_t i = 0; i < size; ++i) {
+    const int64_t num_tmp = std::min({moving_ave_num, i, size - i - 1});
+    const auto & begin = prefix_sums.at(static_cast<size_t>(i - num_tmp));
+    const auto & end = prefix_sums.at(static_cast<size_t>(i + num_tmp + 1));
+    const double count = static_cast<double>(2 * num_tmp + 1);
+    const auto average = [&](const size_t k) { return (end.at(k) - begin.at(k)) / count; };
+
+    auto & p = filtered_trajectory.points.at(static_cast<size_t>(i));
+    p.pose.position.x = origin.x + average(0);
+    p.pose.position.y = origin.y + average(1);
+    p.pose.position.z = origin.z + average(2);
+    p.longitudinal_velocity_mps = average(3);
+    p.acceleration_mps2 = average(4);
+    p.front_wheel_angle_rad = average(5);
+    p.heading_rate_rps = average(6);
+    p.pose.orientation = getQuaternionFromYaw(average(7));
+    p.lateral_velocity_mps = average(8);
+    p.rear_wheel_angle_rad = average(9);
+  }
+  return filtered_trajectory;
+}
+
 // get closest point index from current pose
 std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   const std::vector<geometry_msgs::msg::Pose> & poses,
@@ -119,6 +179,7 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
 {
   double dist_squared_min = std::numeric_limits<double>::max();
   int32_t idx_min = -1;
+  const double yaw_pose = tf2::getYaw(current_pose.orientation);
 
   for (size_t i = 0; i < poses.size(); ++i) {
     const double ds = calcDistSquared2D(poses.at(i).position, current_pose.position);
@@ -126,7 +187,6 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
       continue;
     }
 
-    const double yaw_pose = tf2::getYaw(current_pose.orientation);
     const double yaw_ps = tf2::getYaw(poses.at(i).orientation);
     const double yaw_diff = normalizeEulerAngle(yaw_pose - yaw_ps);
     if (fabs(yaw_diff) > th_yaw) {
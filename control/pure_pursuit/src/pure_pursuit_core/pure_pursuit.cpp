@@ -154,40 +154,47 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
     return -1;
   }
 
+  const int32_t wps_size = static_cast<int32_t>(curr_wps_ptr_->size());
+  const double lookahead_distance_squared = std::pow(lookahead_distance_, 2);
+
+  // rotation to the ego frame, same as planning_utils::transformToRelativeCoordinate2D
+  const geometry_msgs::msg::Point & curr_pose_point = curr_pose_ptr_->position;
+  const double yaw = tf2::getYaw(curr_pose_ptr_->orientation);
+  const double cos_yaw = std::cos(yaw);
+  const double sin_yaw = std::sin(yaw);
+
   // look for the next waypoint.
-  for (int32_t i = search_start_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
+  for (int32_t i = search_start_idx; i < wps_size; i++) {
     // if search waypoint is the last
-    if (i == ((int32_t)curr_wps_ptr_->size() - 1)) {
+    if (i == wps_size - 1) {
       return i;
     }
 
+    const geometry_msgs::msg::Point & curr_motion_point = curr_wps_ptr_->at(i).position;
+    const double rel_x = cos_yaw * (curr_motion_point.x - curr_pose_point.x) +
+                         sin_yaw * (curr_motion_point.y - curr_pose_point.y);
+
     // if waypoint direction is forward
-    const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
+    const auto gld = getLaneDirection();
     if (gld == 0) {
       // if waypoint is not in front of ego, skip
-      auto ret = planning_utils::transformToRelativeCoordinate2D(
-        curr_wps_ptr_->at(i).position, *curr_pose_ptr_);
-      if (ret.x < 0) {
+      if (rel_x < 0) {
         continue;
       }
     } else if (gld == 1) {
       // waypoint direction is backward
 
       // if waypoint is in front of ego, skip
-      auto ret = planning_utils::transformToRelativeCoordinate2D(
-        curr_wps_ptr_->at(i).position, *curr_pose_ptr_);
-      if (ret.x > 0) {
+      if (rel_x > 0) {
         continue;
       }
     } else {
       return -1;
     }
 
-    const geometry_msgs::msg::Point & curr_motion_point = curr_wps_ptr_->at(i).position;
-    const geometry_msgs::msg::Point & curr_pose_point = curr_pose_ptr_->position;
     // if there exists an effective waypoint
     const double ds = planning_utils::calcDistSquared2D(curr_motion_point, curr_pose_point);
-    if (ds > std::pow(lookahead_distance_, 2)) {
+    if (ds > lookahead_distance_squared) {
       return i;
     }
   }
@@ -206,6 +213,15 @@ void PurePursuit::setWaypoints(const std::vector<geometry_msgs::msg::Pose> & msg
 {
   curr_wps_ptr_ = std::make_shared<std::vector<geometry_msgs::msg::Pose>>();
   *curr_wps_ptr_ = msg;
+  lane_direction_ = boost::none;
+}
+
+int8_t PurePursuit::getLaneDirection()
+{
+  if (!lane_direction_) {
+    lane_direction_ = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
+  }
+  return *lane_direction_;
 }
 
 }  // namespace pure_pursuit
@@ -0,0 +1,199 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "planning_evaluator/metrics/deviation_metrics.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
+#include "planning_evaluator/metrics/obstacle_metrics.hpp"
+#include "planning_evaluator/metrics/stability_metrics.hpp"
+#include "tier4_autoware_utils/tier4_autoware_utils.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace
+{
+using autoware_auto_perception_msgs::msg::PredictedObject;
+using autoware_auto_perception_msgs::msg::PredictedObjects;
+using autoware_auto_planning_msgs::msg::Trajectory;
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using planning_diagnostics::Stat;
+using tier4_autoware_utils::calcDistance2d;
+namespace metrics = planning_diagnostics::metrics;
+
+constexpr int num_cycles = 10;
+constexpr double interval = 0.5;  // [m]
+constexpr size_t num_obstacles = 100;
+
+// curved trajectory with an offset from the reference
+Trajectory createTrajectory(const size_t size, const double offset)
+{
+  Trajectory traj;
+  for (size_t i = 0; i < size; ++i) {
+    const double s = static_cast<double>(i) * interval;
+    TrajectoryPoint p;
+    p.pose.position.x = s;
+    p.pose.position.y = 20.0 * std::sin(s / 50.0) + offset;
+    p.longitudinal_velocity_mps = 10.0f;
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+
+PredictedObjects createObstacles(const Trajectory & traj)
+{
+  PredictedObjects obstacles;
+  const double length = traj.points.back().pose.position.x;
+  for (size_t i = 0; i < num_obstacles; ++i) {
+    PredictedObject object;
+    auto & position = object.kinematics.initial_pose_with_covariance.pose.position;
+    position.x = length * static_cast<double>((i * 37) % num_obstacles) / num_obstacles;
+    position.y = 20.0 * std::sin(position.x / 50.0) + ((i % 2 == 0) ? 3.0 : -3.5);
+    obstacles.objects.push_back(object);
+  }
+  return obstacles;
+}
+
+// previous calcLateralDeviation(): full nearest search for each point
+Stat<double> calcLateralDeviationReference(const Trajectory & ref, const Trajectory & traj)
+{
+  Stat<double> stat;
+  for (const TrajectoryPoint & p : traj.points) {
+    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+    stat.add(
+      tier4_autoware_utils::calcLateralDeviation(ref.points[nearest_index].pose, p.pose.position));
+  }
+  return stat;
+}
+
+// previous calcDistanceToObstacle(): all the obstacles for each point
+Stat<double> calcDistanceToObstacleReference(
+  const PredictedObjects & obstacles, const Trajectory & traj)
+{
+  Stat<double> stat;
+  for (const TrajectoryPoint & p : traj.points) {
+    double min_dist = std::numeric_limits<double>::max();
+    for (const auto & object : obstacles.objects) {
+      const auto dist = calcDistance2d(object.kinematics.initial_pose_with_covariance.pose, p);
+      min_dist = std::min(min_dist, dist);
+    }
+    stat.add(min_dist);
+  }
+  return stat;
+}
+
+// previous calcFrechetDistance(): full traj1 x traj2 matrix
+Stat<double> calcFrechetDistanceReference(const Trajectory & traj1, const Trajectory & traj2)
+{
+  Stat<double> stat;
+  std::vector<std::vector<double>> ca(
+    traj1.points.size(), std::vector<double>(traj2.points.size()));
+  for (size_t i = 0; i < traj1.points.size(); ++i) {
+    for (size_t j = 0; j < traj2.points.size(); ++j) {
+      const double dist = calcDistance2d(traj1.points[i], traj2.points[j]);
+      if (i > 0 && j > 0) {
+        ca[i][j] = std::max(std::min(ca[i - 1][j], std::min(ca[i - 1][j - 1], ca[i][j - 1])), dist);
+      } else if (i > 0) {
+        ca[i][j] = std::max(ca[i - 1][0], dist);
+      } else if (j > 0) {
+        ca[i][j] = std::max(ca[0][j - 1], dist);
+      } else {
+        ca[i][j] = dist;
+      }
+    }
+  }
+  stat.add(ca.back().back());
+  return stat;
+}
+
+double calcStatDiff(const Stat<double> & a, const Stat<double> & b)
+{
+  return std::max(
+    {std::abs(a.min() - b.min()), std::abs(a.max() - b.max()),
+     static_cast<double>(std::abs(a.mean() - b.mean()))});
+}
+}  // namespace
+
+int main()
+{
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+
+  std::printf(
+    "#points, lateral deviation reference [ms], lateral deviation [ms], diff, "
+    "obstacle distance reference [ms], obstacle distance [ms], diff, "
+    "frechet reference [ms], frechet [ms], diff\n");
+  for (const size_t size : {100, 300, 1000, 3000}) {
+    const auto ref = createTrajectory(size, 0.0);
+    const auto traj = createTrajectory(size, 0.3);
+    const auto obstacles = createObstacles(traj);
+
+    Stat<double> reference_deviation;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_deviation = calcLateralDeviationReference(ref, traj);
+    }
+    const double reference_deviation_time = stop_watch.toc() / num_cycles;
+
+    Stat<double> deviation;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      deviation = metrics::calcLateralDeviation(ref, traj);
+    }
+    const double deviation_time = stop_watch.toc() / num_cycles;
+
+    Stat<double> reference_obstacle_distance;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_obstacle_distance = calcDistanceToObstacleReference(obstacles, traj);
+    }
+    const double reference_obstacle_time = stop_watch.toc() / num_cycles;
+
+    // the index is built once for each set of obstacles by the metrics calculator
+    Stat<double> obstacle_distance;
+    stop_watch.tic();
+    const metrics::utils::ObstacleIndex obstacle_index(obstacles);
+    for (int i = 0; i < num_cycles; ++i) {
+      obstacle_distance = metrics::calcDistanceToObstacle(obstacle_index, traj);
+    }
+    const double obstacle_time = stop_watch.toc() / num_cycles;
+
+    Stat<double> reference_frechet;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_frechet = calcFrechetDistanceReference(ref, traj);
+    }
+    const double reference_frechet_time = stop_watch.toc() / num_cycles;
+
+    Stat<double> frechet;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      frechet = metrics::calcFrechetDistance(ref, traj);
+    }
+    const double frechet_time = stop_watch.toc() / num_cycles;
+
+    std::printf(
+      "%zu, %.3f, %.3f, %.3e, %.3f, %.3f, %.3e, %.3f, %.3f, %.3e\n", size,
+      reference_deviation_time, deviation_time, calcStatDiff(reference_deviation, deviation),
+      reference_obstacle_time, obstacle_time,
+      calcStatDiff(reference_obstacle_distance, obstacle_distance), reference_frechet_time,
+      frechet_time, calcStatDiff(reference_frechet, frechet));
+  }
+  return 0;
+}
@@ -17,8 +17,14 @@
 
 #include "planning_evaluator/stat.hpp"
 
+#include "autoware_auto_perception_msgs/msg/predicted_objects.hpp"
 #include "autoware_auto_planning_msgs/msg/trajectory.hpp"
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
+#include "geometry_msgs/msg/point.hpp"
+
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -26,7 +32,10 @@ namespace metrics
 {
 namespace utils
 {
+using autoware_auto_perception_msgs::msg::PredictedObjects;
 using autoware_auto_planning_msgs::msg::Trajectory;
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using geometry_msgs::msg::Point;
 
 /**
  * @brief find the index in the trajectory at the given distance of the given index
@@ -37,6 +46,75 @@ using autoware_auto_planning_msgs::msg::Trajectory;
  */
 size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, const double distance);
 
+/**
+ * @brief nearest index search on a trajectory for a sequence of points following it
+ * The nearest index of each point first moves from the previous one while the distance decreases.
+ * This local minimum is then checked against the trajectory points sorted along the longer axis
+ * of the trajectory, of which only the ones closer along that axis than the minimum are visited.
+ * The result is the same as motion_utils::findNearestIndex, and the search is fast when the
+ * points follow the trajectory. Otherwise, e.g. when they jump past a bend of the trajectory, it
+ * costs up to a full search.
+ */
+class NearestIndexCursor
+{
+public:
+  /**
+   * @brief constructor
+   * @param [in] points non-empty points of the trajectory, which must outlive the cursor
+   */
+  explicit NearestIndexCursor(const std::vector<TrajectoryPoint> & points);
+
+  /**
+   * @brief find the index of the trajectory point nearest to the given point
+   * @param [in] point point following the previously given one
+   * @return index of the nearest trajectory point
+   */
+  size_t findNearestIndex(const Point & point);
+
+private:
+  double getSortKey(const Point & point) const { return is_sorted_by_x_ ? point.x : point.y; }
+
+  const std::vector<TrajectoryPoint> & points_;
+  std::optional<size_t> index_;
+  bool is_sorted_by_x_{true};
+  // (coordinate along the sorted axis, index) of the trajectory points
+  std::vector<std::pair<double, size_t>> sorted_keys_;
+};
+
+/**
+ * @brief positions of the obstacles sorted by x to search the ones close to a point
+ * It is built once for each set of obstacles and used by all the trajectories of the cycle.
+ */
+class ObstacleIndex
+{
+public:
+  ObstacleIndex() = default;
+
+  /**
+   * @brief constructor
+   * @param [in] obstacles obstacles, indexed by the position of their initial pose
+   */
+  explicit ObstacleIndex(const PredictedObjects & obstacles);
+
+  /**
+   * @brief calculate the distance from the point to the closest obstacle
+   * @param [in] point point
+   * @return distance to the closest obstacle, or the maximum double value if there is none
+   */
+  double calcMinDistance(const Point & point) const;
+
+  /**
+   * @brief check if an obstacle is within the given distance of the point
+   * @param [in] point point
+   * @param [in] distance distance threshold (inclusive)
+   * @return true if an obstacle is within the distance
+   */
+  bool hasObstacleWithin(const Point & point, const double distance) const;
+
+private:
+  std::vector<Point> positions_;
+};
+
 }  // namespace utils
 }  // namespace metrics
 }  // namespace planning_diagnostics
@@ -15,6 +15,7 @@
 #ifndef PLANNING_EVALUATOR__METRICS__OBSTACLE_METRICS_HPP_
 #define PLANNING_EVALUATOR__METRICS__OBSTACLE_METRICS_HPP_
 
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "planning_evaluator/stat.hpp"
 
 #include "autoware_auto_perception_msgs/msg/predicted_objects.hpp"
@@ -35,6 +36,15 @@ using autoware_auto_planning_msgs::msg::Trajectory;
  */
 Stat<double> calcDistanceToObstacle(const PredictedObjects & obstacles, const Trajectory & traj);
 
+/**
+ * @brief calculate the distance to the closest obstacle at each point of the trajectory
+ * @param [in] obstacle_index index of the obstacles
+ * @param [in] traj trajectory
+ * @return calculated statistics
+ */
+Stat<double> calcDistanceToObstacle(
+  const utils::ObstacleIndex & obstacle_index, const Trajectory & traj);
+
 /**
  * @brief calculate the time to collision of the trajectory with the given obstacles
  * Assume that "now" corresponds to the first trajectory point
@@ -45,6 +55,17 @@ Stat<double> calcDistanceToObstacle(const PredictedObjects & obstacles, const Tr
 Stat<double> calcTimeToCollision(
   const PredictedObjects & obstacles, const Trajectory & traj, const double distance_threshold);
 
+/**
+ * @brief calculate the time to collision of the trajectory with the given obstacles
+ * Assume that "now" corresponds to the first trajectory point
+ * @param [in] obstacle_index index of the obstacles
+ * @param [in] traj trajectory
+ * @return calculated statistics
+ */
+Stat<double> calcTimeToCollision(
+  const utils::ObstacleIndex & obstacle_index, const Trajectory & traj,
+  const double distance_threshold);
+
 }  // namespace metrics
 }  // namespace planning_diagnostics
 
@@ -15,6 +15,7 @@
 #ifndef PLANNING_EVALUATOR__METRICS_CALCULATOR_HPP_
 #define PLANNING_EVALUATOR__METRICS_CALCULATOR_HPP_
 #include "planning_evaluator/metrics/metric.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "planning_evaluator/parameters.hpp"
 #include "planning_evaluator/stat.hpp"
 
@@ -98,6 +99,7 @@ private:
   Trajectory previous_trajectory_;
   Trajectory previous_trajectory_lookahead_;
   PredictedObjects dynamic_objects_;
+  metrics::utils::ObstacleIndex obstacle_index_;
   geometry_msgs::msg::Pose ego_pose_;
   PoseWithUuidStamped modified_goal_;
 };  // class MetricsCalculator
@@ -12,9 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "planning_evaluator/metrics/metrics_utils.hpp"
+
+#include "motion_utils/trajectory/trajectory.hpp"
 #include "planning_evaluator/metrics/trajectory_metrics.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <utility>
+
 namespace planning_diagnostics
 {
 namespace metrics
@@ -24,6 +33,7 @@ namespace utils
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using tier4_autoware_utils::calcDistance2d;
+using tier4_autoware_utils::calcSquaredDistance2d;
 
 size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, const double distance)
 {
@@ -43,6 +53,127 @@ size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, cons
   return target_id;
 }
 
+NearestIndexCursor::NearestIndexCursor(const std::vector<TrajectoryPoint> & points)
+: points_(points)
+{
+  const auto [min_x, max_x] = std::minmax_element(
+    points_.begin(), points_.end(), [](const TrajectoryPoint & a, const TrajectoryPoint & b) {
+      return a.pose.position.x < b.pose.position.x;
+    });
+  const auto [min_y, max_y] = std::minmax_element(
+    points_.begin(), points_.end(), [](const TrajectoryPoint & a, const TrajectoryPoint & b) {
+      return a.pose.position.y < b.pose.position.y;
+    });
+  if (!points_.empty()) {
+    is_sorted_by_x_ = max_x->pose.position.x - min_x->pose.position.x >=
+                      max_y->pose.position.y - min_y->pose.position.y;
+  }
+
+  sorted_keys_.reserve(points_.size());
+  for (size_t i = 0; i < points_.size(); ++i) {
+    sorted_keys_.emplace_back(getSortKey(points_[i].pose.position), i);
+  }
+  std::sort(sorted_keys_.begin(), sorted_keys_.end());
+}
+
+size_t NearestIndexCursor::findNearestIndex(const Point & point)
+{
+  if (!index_) {
+    index_ = motion_utils::findNearestIndex(points_, point);
+    return *index_;
+  }
+
+  // move forward while the distance decreases, otherwise backward
+  // NOTE: ties are resolved to the first index as in motion_utils::findNearestIndex
+  size_t index = *index_;
+  double min_dist = calcSquaredDistance2d(points_.at(index), point);
+  while (index + 1 < points_.size()) {
+    const double dist = calcSquaredDistance2d(points_.at(index + 1), point);
+    if (dist >= min_dist) {
+      break;
+    }
+    min_dist = dist;
+    ++index;
+  }
+  if (index == *index_) {
+    while (index > 0) {
+      const double dist = calcSquaredDistance2d(points_.at(index - 1), point);
+      if (dist > min_dist) {
+        break;
+      }
+      min_dist = dist;
+      --index;
+    }
+  }
+
+  // check the local minimum with the points closer along the sorted axis
+  // NOTE: the squared difference along the axis is not more than the squared distance
+  const double key = getSortKey(point);
+  const auto update = [&](const size_t candidate) {
+    const double dist = calcSquaredDistance2d(points_.at(candidate), point);
+    if (dist < min_dist || (dist == min_dist && candidate < index)) {
+      min_dist = dist;
+      index = candidate;
+    }
+  };
+  const auto it = std::lower_bound(
+    sorted_keys_.begin(), sorted_keys_.end(), std::make_pair(key, size_t{0}));
+  for (auto right = it;
+       right != sorted_keys_.end() && (right->first - key) * (right->first - key) <= min_dist;
+       ++right) {
+    update(right->second);
+  }
+  for (auto left = it; left != sorted_keys_.begin() &&
+                       (key - std::prev(left)->first) * (key - std::prev(left)->first) <= min_dist;
+       --left) {
+    update(std::prev(left)->second);
+  }
+  index_ = index;
+  return index;
+}
+
+ObstacleIndex::ObstacleIndex(const PredictedObjects & obstacles)
+{
+  positions_.reserve(obstacles.objects.size());
+  for (const auto & object : obstacles.objects) {
+    positions_.push_back(object.kinematics.initial_pose_with_covariance.pose.position);
+  }
+  std::sort(positions_.begin(), positions_.end(), [](const Point & a, const Point & b) {
+    return a.x < b.x;
+  });
+}
+
+double ObstacleIndex::calcMinDistance(const Point & point) const
+{
+  // search outward from the x of the point until the x difference alone exceeds the minimum
+  double min_dist = std::numeric_limits<double>::max();
+  const auto it = std::lower_bound(
+    positions_.begin(), positions_.end(), point.x,
+    [](const Point & position, const double x) { return position.x < x; });
+  for (auto right = it; right != positions_.end() && right->x - point.x < min_dist; ++right) {
+    min_dist = std::min(min_dist, calcDistance2d(point, *right));
+  }
+  for (auto left = it; left != positions_.begin() && point.x - std::prev(left)->x < min_dist;
+       --left) {
+    min_dist = std::min(min_dist, calcDistance2d(point, *std::prev(left)));
+  }
+  return min_dist;
+}
+
+bool ObstacleIndex::hasObstacleWithin(const Point & point, const double distance) const
+{
+  // NOTE: the x difference is compared instead of the bounds of x to avoid rounding errors
+  const auto begin = std::partition_point(
+    positions_.begin(), positions_.end(),
+    [&](const Point & position) { return point.x - position.x > distance; });
+  for (auto it = begin; it != positions_.end() && it->x - point.x <= distance; ++it) {
+    if (calcDistance2d(point, *it) <= distance) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace utils
 }  // namespace metrics
 }  // namespace planning_diagnostics
@@ -14,14 +14,11 @@
 
 #include "planning_evaluator/metrics/obstacle_metrics.hpp"
 
-#include "eigen3/Eigen/Core"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
-#include <algorithm>
-#include <limits>
-
 namespace planning_diagnostics
 {
 namespace metrics
@@ -30,22 +27,30 @@ using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using tier4_autoware_utils::calcDistance2d;
 
 Stat<double> calcDistanceToObstacle(const PredictedObjects & obstacles, const Trajectory & traj)
+{
+  return calcDistanceToObstacle(utils::ObstacleIndex(obstacles), traj);
+}
+
+Stat<double> calcDistanceToObstacle(
+  const utils::ObstacleIndex & obstacle_index, const Trajectory & traj)
 {
   Stat<double> stat;
   for (const TrajectoryPoint & p : traj.points) {
-    double min_dist = std::numeric_limits<double>::max();
-    for (const auto & object : obstacles.objects) {
-      // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
-      const auto dist = calcDistance2d(object.kinematics.initial_pose_with_covariance.pose, p);
-      min_dist = std::min(min_dist, dist);
-    }
-    stat.add(min_dist);
+    // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
+    stat.add(obstacle_index.calcMinDistance(p.pose.position));
   }
   return stat;
 }
 
 Stat<double> calcTimeToCollision(
   const PredictedObjects & obstacles, const Trajectory & traj, const double distance_threshold)
+{
+  return calcTimeToCollision(utils::ObstacleIndex(obstacles), traj, distance_threshold);
+}
+
+Stat<double> calcTimeToCollision(
+  const utils::ObstacleIndex & obstacle_index, const Trajectory & traj,
+  const double distance_threshold)
 {
   Stat<double> stat;
   /** TODO(Maxime CLEMENT):
@@ -62,14 +67,9 @@ Stat<double> calcTimeToCollision(
     if (p0.longitudinal_velocity_mps != 0) {
       const double dt = traj_dist / std::abs(p0.longitudinal_velocity_mps);
       t += dt;
-      for (auto obstacle : obstacles.objects) {
-        const double obst_dist =
-          calcDistance2d(p, obstacle.kinematics.initial_pose_with_covariance.pose);
-        // TODO(Maxime CLEMENT): take shape into consideration
-        if (obst_dist <= distance_threshold) {
-          stat.add(t);
-          break;
-        }
+      // TODO(Maxime CLEMENT): take shape into consideration
+      if (obstacle_index.hasObstacleWithin(p.pose.position, distance_threshold)) {
+        stat.add(t);
       }
     }
     if (stat.count() > 0) {
@@ -14,13 +14,15 @@
 
 #include "planning_evaluator/metrics/stability_metrics.hpp"
 
-#include "eigen3/Eigen/Core"
 #include "motion_utils/trajectory/trajectory.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -36,23 +38,83 @@ Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & tr
     return stat;
   }
 
-  Eigen::MatrixXd ca = Eigen::MatrixXd::Zero(traj1.points.size(), traj2.points.size());
+  const size_t n1 = traj1.points.size();
+  const size_t n2 = traj2.points.size();
+  const auto calcDistance = [&](const size_t i, const size_t j) {
+    return tier4_autoware_utils::calcDistance2d(traj1.points[i], traj2.points[j]);
+  };
 
-  for (size_t i = 0; i < traj1.points.size(); ++i) {
-    for (size_t j = 0; j < traj2.points.size(); ++j) {
-      const double dist = tier4_autoware_utils::calcDistance2d(traj1.points[i], traj2.points[j]);
-      if (i > 0 && j > 0) {
-        ca(i, j) = std::max(std::min(ca(i - 1, j), std::min(ca(i - 1, j - 1), ca(i, j - 1))), dist);
-      } else if (i > 0 /*&& j == 0*/) {
-        ca(i, j) = std::max(ca(i - 1, 0), dist);
-      } else if (j > 0 /*&& i == 0*/) {
-        ca(i, j) = std::max(ca(0, j - 1), dist);
-      } else { /* i == j == 0 */
-        ca(i, j) = dist;
+  // upper bound of the distance from a greedy coupling of the trajectories
+  double max_dist = calcDistance(0, 0);
+  for (size_t i = 0, j = 0; i + 1 < n1 || j + 1 < n2;) {
+    double next_dist = std::numeric_limits<double>::infinity();
+    size_t next_i = i;
+    size_t next_j = j;
+    const auto updateNext = [&](const size_t candidate_i, const size_t candidate_j) {
+      const double dist = calcDistance(candidate_i, candidate_j);
+      if (dist < next_dist) {
+        next_dist = dist;
+        next_i = candidate_i;
+        next_j = candidate_j;
       }
+    };
+    if (i + 1 < n1 && j + 1 < n2) {
+      updateNext(i + 1, j + 1);
     }
+    if (i + 1 < n1) {
+      updateNext(i + 1, j);
+    }
+    if (j + 1 < n2) {
+      updateNext(i, j + 1);
+    }
+    i = next_i;
+    j = next_j;
+    max_dist = std::max(max_dist, next_dist);
+  }
+
+  // Coupling distances of the previous and current rows of the traj1 x traj2 matrix. Only the
+  // cells within the upper bound can be on the optimal coupling, so that the other ones are set to
+  // infinity and each row is only calculated on the band [begin, end) reachable from the previous
+  // one.
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> prev_ca(n2, inf);
+  std::vector<double> ca(n2, inf);
+  size_t prev_begin = 0;
+  size_t prev_end = 0;
+
+  for (size_t i = 0; i < n1; ++i) {
+    const auto getPrev = [&](const size_t j) {
+      return (prev_begin <= j && j < prev_end) ? prev_ca[j] : inf;
+    };
+    size_t begin = n2;
+    size_t end = n2;
+    for (size_t j = (i == 0) ? 0 : prev_begin; j < n2; ++j) {
+      const double left = (j > 0 && end == j) ? ca[j - 1] : inf;
+      if (j > prev_end && left == inf) {
+        break;
+      }
+      double prev_min = 0.0; /* i == j == 0 */
+      if (i > 0 || j > 0) {
+        prev_min = std::min(getPrev(j), left);
+        if (j > 0) {
+          prev_min = std::min(prev_min, getPrev(j - 1));
+        }
+      }
+      ca[j] = inf;
+      if (prev_min <= max_dist) {
+        const double coupling_dist = std::max(prev_min, calcDistance(i, j));
+        if (coupling_dist <= max_dist) {
+          ca[j] = coupling_dist;
+          begin = std::min(begin, j);
+        }
+      }
+      end = j + 1;
+    }
+    std::swap(prev_ca, ca);
+    prev_begin = begin;
+    prev_end = end;
   }
-  stat.add(ca(traj1.points.size() - 1, traj2.points.size() - 1));
+  stat.add(prev_ca.back());
   return stat;
 }
 
@@ -67,9 +67,9 @@ std::optional<Stat<double>> MetricsCalculator::calculate(
           traj, parameters.trajectory.lookahead.max_dist_m,
           parameters.trajectory.lookahead.max_time_s));
     case Metric::obstacle_distance:
-      return metrics::calcDistanceToObstacle(dynamic_objects_, traj);
+      return metrics::calcDistanceToObstacle(obstacle_index_, traj);
     case Metric::obstacle_ttc:
-      return metrics::calcTimeToCollision(dynamic_objects_, traj, parameters.obstacle.dist_thr_m);
+      return metrics::calcTimeToCollision(obstacle_index_, traj, parameters.obstacle.dist_thr_m);
     default:
       return {};
   }
@@ -104,6 +104,7 @@ void MetricsCalculator::setPreviousTrajectory(const Trajectory & traj)
 void MetricsCalculator::setPredictedObjects(const PredictedObjects & objects)
 {
   dynamic_objects_ = objects;
+  obstacle_index_ = metrics::utils::ObstacleIndex(objects);
 }
 
 void MetricsCalculator::setEgoPose(const geometry_msgs::msg::Pose & pose)
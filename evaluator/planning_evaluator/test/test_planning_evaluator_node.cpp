@@ -320,6 +320,21 @@ TEST_F(EvalTest, TestLateralDeviation)
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t), 0.0);
   Trajectory t2 = makeTrajectory({{0.0, 1.0}, {1.0, 1.0}});
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t2), 1.0);
+
+  // trajectory going back along the reference
+  Trajectory ref = makeTrajectory({{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {4.0, 0.0}});
+  publishReferenceTrajectory(ref);
+  Trajectory t3 = makeTrajectory({{3.0, 1.0}, {4.0, 1.0}, {2.0, 1.0}, {0.0, 1.0}});
+  EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t3), 1.0);
+
+  // trajectory jumping past the bend of a curved reference: the nearest point of (0.0, 1.75) is
+  // (0.0, 2.0) and not the local minimum (0.0, 0.0) of the distance along the reference
+  Trajectory curved_ref = makeTrajectory(
+    {{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {4.0, 0.0}, {4.0, 1.0}, {4.0, 2.0}, {3.0, 2.0},
+     {2.0, 2.0}, {1.0, 2.0}, {0.0, 2.0}});
+  publishReferenceTrajectory(curved_ref);
+  Trajectory t4 = makeTrajectory({{0.0, 0.5}, {0.0, 1.75}});
+  EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t4), 0.125);
 }
 
 TEST_F(EvalTest, TestYawDeviation)
@@ -419,6 +434,16 @@ TEST_F(EvalTest, TestObstacleDistance)
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t), 0.5);
   Trajectory t2 = makeTrajectory({{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}});
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t2), 1.0);  // (0.0 + 1.0 + 2.0) / 3
+
+  // closest of several obstacles
+  obj.kinematics.initial_pose_with_covariance.pose.position.x = 2.0;
+  obj.kinematics.initial_pose_with_covariance.pose.position.y = 1.0;
+  objs.objects.push_back(obj);
+  obj.kinematics.initial_pose_with_covariance.pose.position.x = -3.0;
+  obj.kinematics.initial_pose_with_covariance.pose.position.y = 0.0;
+  objs.objects.push_back(obj);
+  publishObjects(objs);
+  EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t2), 2.0 / 3);  // (0.0 + 1.0 + 1.0) / 3
 }
 
 TEST_F(EvalTest, TestObstacleTTC)
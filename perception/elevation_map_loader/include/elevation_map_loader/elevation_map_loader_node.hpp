@@ -26,14 +26,19 @@
 
 #include "tier4_external_api_msgs/msg/map_hash.hpp"
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
+#include <nav_msgs/msg/odometry.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
 #include <pcl/pcl_base.h>
 #include <pcl/point_types.h>
 
 #include <filesystem>
+#include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 class DataManager
@@ -64,21 +69,36 @@ private:
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sub_pointcloud_map_;
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr sub_vector_map_;
   rclcpp::Subscription<tier4_external_api_msgs::msg::MapHash>::SharedPtr sub_map_hash_;
+  rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr sub_odometry_;
   rclcpp::Publisher<grid_map_msgs::msg::GridMap>::SharedPtr pub_elevation_map_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_elevation_map_cloud_;
   void onPointcloudMap(const sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud_map);
   void onMapHash(const tier4_external_api_msgs::msg::MapHash::ConstSharedPtr map_hash);
   void onVectorMap(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr vector_map);
+  void onOdometry(const nav_msgs::msg::Odometry::ConstSharedPtr odometry);
 
   void publish();
+  void publishElevationMap();
   void createElevationMap();
   void setVerbosityLevelToDebugIfFlagSet();
   void createElevationMapFromPointcloud(
-    const pcl::shared_ptr<grid_map::GridMapPclLoader> & grid_map_pcl_loader);
-  void inpaintElevationMap(const float radius);
+    const pcl::shared_ptr<grid_map::GridMapPclLoader> & grid_map_pcl_loader) const;
+  void inpaintElevationMap(
+    grid_map::GridMap & elevation_map, const float radius,
+    const lanelet::ConstLanelets & road_lanelets) const;
   pcl::PointCloud<pcl::PointXYZ>::Ptr createPointcloudFromElevationMap();
   void saveElevationMap();
 
+  // x and y indexes of a square tile of the map
+  using TileIndex = std::pair<int, int>;
+  std::filesystem::path getTileDirectory() const;
+  std::filesystem::path getTilePath(const TileIndex & tile_index) const;
+  bool loadElevationMapTileIndex();
+  void createElevationMapTiles();
+  grid_map::GridMap createElevationMapTile(
+    const TileIndex & tile_index, const pcl::PointCloud<pcl::PointXYZ>::Ptr & tile_cloud) const;
+  void publishElevationMapAroundVehicle();
+
   grid_map::GridMap elevation_map_;
   std::string layer_name_;
   std::string map_frame_;
@@ -88,6 +108,18 @@ private:
   bool use_elevation_map_cloud_publisher_;
   std::string param_file_path_;
 
+  // the tiled elevation map is built per tile in parallel, cached next to the elevation map and
+  // only the tiles around the vehicle are loaded and published
+  bool use_tiled_elevation_map_;
+  double tile_size_;
+  double tile_margin_;
+  double tile_load_radius_;
+  int num_tile_threads_;
+  std::set<TileIndex> available_tiles_;
+  std::map<TileIndex, grid_map::GridMap> loaded_tiles_;
+  std::set<TileIndex> published_tiles_;
+  std::optional<grid_map::Position> vehicle_position_;
+
   DataManager data_manager_;
   struct LaneFilter
   {
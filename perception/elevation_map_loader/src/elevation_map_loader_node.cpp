@@ -29,6 +29,7 @@
 #include <boost/geometry/algorithms/intersects.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
 
+#include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_core/geometry/Polygon.h>
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/pcl_base.h>
@@ -36,7 +37,11 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <sensor_msgs/msg/point_cloud2.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -64,6 +69,11 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
 
   lane_filter_.use_lane_filter_ = use_lane_filter;
   lane_filter_.lane_margin_ = this->declare_parameter("lane_margin", 0.0);
+  use_tiled_elevation_map_ = this->declare_parameter("use_tiled_elevation_map", false);
+  tile_size_ = this->declare_parameter("tile_size", 100.0);
+  tile_margin_ = this->declare_parameter("tile_margin", 5.0);
+  tile_load_radius_ = this->declare_parameter("tile_load_radius", 150.0);
+  num_tile_threads_ = this->declare_parameter("num_tile_threads", 4);
 
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -84,10 +94,27 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
     std::bind(&ElevationMapLoaderNode::onPointcloudMap, this, _1));
   sub_vector_map_ = this->create_subscription<autoware_auto_mapping_msgs::msg::HADMapBin>(
     "input/vector_map", durable_qos, std::bind(&ElevationMapLoaderNode::onVectorMap, this, _1));
+  if (use_tiled_elevation_map_) {
+    sub_odometry_ = this->create_subscription<nav_msgs::msg::Odometry>(
+      "input/odometry", rclcpp::QoS{1}, std::bind(&ElevationMapLoaderNode::onOdometry, this, _1));
+  }
 }
 
 void ElevationMapLoaderNode::publish()
 {
+  if (use_tiled_elevation_map_) {
+    if (!loadElevationMapTileIndex()) {
+      RCLCPP_INFO(this->get_logger(), "Create elevation map tiles from pointcloud map ");
+      createElevationMapTiles();
+    }
+    loaded_tiles_.clear();
+    published_tiles_.clear();
+    if (vehicle_position_) {
+      publishElevationMapAroundVehicle();
+    }
+    return;
+  }
+
   struct stat info;
   if (stat(data_manager_.elevation_map_path_->c_str(), &info) != 0) {
     RCLCPP_INFO(this->get_logger(), "Create elevation map from pointcloud map ");
@@ -117,6 +144,11 @@ void ElevationMapLoaderNode::publish()
     }
   }
 
+  publishElevationMap();
+}
+
+void ElevationMapLoaderNode::publishElevationMap()
+{
   elevation_map_.setFrameId(map_frame_);
   auto msg = grid_map::GridMapRosConverter::toMessage(elevation_map_);
   pub_elevation_map_->publish(std::move(msg));
@@ -170,6 +202,15 @@ void ElevationMapLoaderNode::onVectorMap(
   }
 }
 
+void ElevationMapLoaderNode::onOdometry(const nav_msgs::msg::Odometry::ConstSharedPtr odometry)
+{
+  vehicle_position_ =
+    grid_map::Position(odometry->pose.pose.position.x, odometry->pose.pose.position.y);
+  if (!available_tiles_.empty()) {
+    publishElevationMapAroundVehicle();
+  }
+}
+
 void ElevationMapLoaderNode::createElevationMap()
 {
   auto grid_map_logger = rclcpp::get_logger("grid_map_logger");
@@ -183,13 +224,13 @@ void ElevationMapLoaderNode::createElevationMap()
     elevation_map_ = grid_map_pcl_loader->getGridMap();
   }
   if (use_inpaint_) {
-    inpaintElevationMap(inpaint_radius_);
+    inpaintElevationMap(elevation_map_, inpaint_radius_, lane_filter_.road_lanelets_);
   }
   saveElevationMap();
 }
 
 void ElevationMapLoaderNode::createElevationMapFromPointcloud(
-  const pcl::shared_ptr<grid_map::GridMapPclLoader> & grid_map_pcl_loader)
+  const pcl::shared_ptr<grid_map::GridMapPclLoader> & grid_map_pcl_loader) const
 {
   const auto start = std::chrono::high_resolution_clock::now();
   grid_map_pcl_loader->preProcessInputCloud();
@@ -199,18 +240,20 @@ void ElevationMapLoaderNode::createElevationMapFromPointcloud(
     start, "Finish creating elevation map. Total time: ", this->get_logger());
 }
 
-void ElevationMapLoaderNode::inpaintElevationMap(const float radius)
+void ElevationMapLoaderNode::inpaintElevationMap(
+  grid_map::GridMap & elevation_map, const float radius,
+  const lanelet::ConstLanelets & road_lanelets) const
 {
   // Convert elevation layer to OpenCV image to fill in holes.
   // Get the inpaint mask (nonzero pixels indicate where values need to be filled in).
   namespace bg = boost::geometry;
   using tier4_autoware_utils::Point2d;
 
-  elevation_map_.add("inpaint_mask", 0.0);
+  elevation_map.add("inpaint_mask", 0.0);
 
-  elevation_map_.setBasicLayers(std::vector<std::string>());
+  elevation_map.setBasicLayers(std::vector<std::string>());
   if (lane_filter_.use_lane_filter_) {
-    for (const auto & lanelet : lane_filter_.road_lanelets_) {
+    for (const auto & lanelet : road_lanelets) {
       auto lane_polygon = lanelet.polygon2d().basicPolygon();
       grid_map::Polygon polygon;
 
@@ -230,37 +273,37 @@ void ElevationMapLoaderNode::inpaintElevationMap(const float radius)
       for (const auto & p : lane_polygon) {
         polygon.addVertex(grid_map::Position(p[0], p[1]));
       }
-      for (grid_map_utils::PolygonIterator iterator(elevation_map_, polygon); !iterator.isPastEnd();
+      for (grid_map_utils::PolygonIterator iterator(elevation_map, polygon); !iterator.isPastEnd();
            ++iterator) {
-        if (!elevation_map_.isValid(*iterator, layer_name_)) {
-          elevation_map_.at("inpaint_mask", *iterator) = 1.0;
+        if (!elevation_map.isValid(*iterator, layer_name_)) {
+          elevation_map.at("inpaint_mask", *iterator) = 1.0;
         }
       }
     }
   } else {
-    for (grid_map::GridMapIterator iterator(elevation_map_); !iterator.isPastEnd(); ++iterator) {
-      if (!elevation_map_.isValid(*iterator, layer_name_)) {
-        elevation_map_.at("inpaint_mask", *iterator) = 1.0;
+    for (grid_map::GridMapIterator iterator(elevation_map); !iterator.isPastEnd(); ++iterator) {
+      if (!elevation_map.isValid(*iterator, layer_name_)) {
+        elevation_map.at("inpaint_mask", *iterator) = 1.0;
       }
     }
   }
   cv::Mat original_image;
   cv::Mat mask;
   cv::Mat filled_image;
-  const float min_value = elevation_map_.get(layer_name_).minCoeffOfFinites();
-  const float max_value = elevation_map_.get(layer_name_).maxCoeffOfFinites();
+  const float min_value = elevation_map.get(layer_name_).minCoeffOfFinites();
+  const float max_value = elevation_map.get(layer_name_).maxCoeffOfFinites();
 
   grid_map::GridMapCvConverter::toImage<unsigned char, 3>(
-    elevation_map_, layer_name_, CV_8UC3, min_value, max_value, original_image);
+    elevation_map, layer_name_, CV_8UC3, min_value, max_value, original_image);
   grid_map::GridMapCvConverter::toImage<unsigned char, 1>(
-    elevation_map_, "inpaint_mask", CV_8UC1, mask);
+    elevation_map, "inpaint_mask", CV_8UC1, mask);
 
-  const float radius_in_pixels = radius / elevation_map_.getResolution();
+  const float radius_in_pixels = radius / elevation_map.getResolution();
   cv::inpaint(original_image, mask, filled_image, radius_in_pixels, cv::INPAINT_NS);
 
   grid_map::GridMapCvConverter::addLayerFromImage<unsigned char, 3>(
-    filled_image, layer_name_, elevation_map_, min_value, max_value);
-  elevation_map_.erase("inpaint_mask");
+    filled_image, layer_name_, elevation_map, min_value, max_value);
+  elevation_map.erase("inpaint_mask");
 }
 
 pcl::PointCloud<pcl::PointXYZ>::Ptr ElevationMapLoaderNode::createPointcloudFromElevationMap()
@@ -294,5 +337,192 @@ void ElevationMapLoaderNode::saveElevationMap()
     this->get_logger(), "Saving elevation map successful: " << std::boolalpha << saving_successful);
 }
 
+std::filesystem::path ElevationMapLoaderNode::getTileDirectory() const
+{
+  return std::filesystem::path(data_manager_.elevation_map_path_->string() + "_tiles");
+}
+
+std::filesystem::path ElevationMapLoaderNode::getTilePath(const TileIndex & tile_index) const
+{
+  return getTileDirectory() /
+         ("tile_" + std::to_string(tile_index.first) + "_" + std::to_string(tile_index.second));
+}
+
+bool ElevationMapLoaderNode::loadElevationMapTileIndex()
+{
+  // the index is written once all the tiles are saved, so a partial cache is never used
+  available_tiles_.clear();
+  std::ifstream index_file(getTileDirectory() / "tile_index.txt");
+  if (!index_file) {
+    return false;
+  }
+  RCLCPP_INFO(
+    this->get_logger(), "Load elevation map tiles from: %s", getTileDirectory().c_str());
+  TileIndex tile_index;
+  while (index_file >> tile_index.first >> tile_index.second) {
+    available_tiles_.insert(tile_index);
+  }
+  return true;
+}
+
+void ElevationMapLoaderNode::createElevationMapTiles()
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  // Split the pointcloud map into tiles, with the points of the margin around each tile so that
+  // the tiles do not have seams
+  std::map<TileIndex, pcl::PointCloud<pcl::PointXYZ>::Ptr> tile_clouds;
+  for (const auto & p : data_manager_.map_pcl_ptr_->points) {
+    const int min_x = static_cast<int>(std::floor((p.x - tile_margin_) / tile_size_));
+    const int max_x = static_cast<int>(std::floor((p.x + tile_margin_) / tile_size_));
+    const int min_y = static_cast<int>(std::floor((p.y - tile_margin_) / tile_size_));
+    const int max_y = static_cast<int>(std::floor((p.y + tile_margin_) / tile_size_));
+    for (int x = min_x; x <= max_x; ++x) {
+      for (int y = min_y; y <= max_y; ++y) {
+        auto & tile_cloud = tile_clouds[TileIndex(x, y)];
+        if (!tile_cloud) {
+          tile_cloud = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+        }
+        tile_cloud->push_back(p);
+      }
+    }
+  }
+  std::vector<TileIndex> tile_indices;
+  tile_indices.reserve(tile_clouds.size());
+  for (const auto & tile_cloud : tile_clouds) {
+    tile_indices.push_back(tile_cloud.first);
+  }
+
+  std::filesystem::remove_all(getTileDirectory());
+  std::filesystem::create_directories(getTileDirectory());
+  std::vector<char> is_tile_saved(tile_indices.size(), false);
+  // The logger level is global and rosbag2 writers are not thread safe, so the level is set once
+  // here and the bags are written one at a time
+  rclcpp::get_logger("grid_map_logger").set_level(rclcpp::Logger::Level::Error);
+#pragma omp parallel for schedule(dynamic) num_threads(num_tile_threads_)
+  for (int i = 0; i < static_cast<int>(tile_indices.size()); ++i) {
+    const auto & tile_index = tile_indices[i];
+    const auto tile_map = createElevationMapTile(tile_index, tile_clouds.at(tile_index));
+    if (tile_map.getSize().prod() == 0) {
+      continue;
+    }
+#pragma omp critical(elevation_map_tile_bag)
+    is_tile_saved[i] = grid_map::GridMapRosConverter::saveToBag(
+      tile_map, getTilePath(tile_index), "elevation_map");
+  }
+
+  std::ofstream index_file(getTileDirectory() / "tile_index.txt");
+  for (size_t i = 0; i < tile_indices.size(); ++i) {
+    if (is_tile_saved[i]) {
+      available_tiles_.insert(tile_indices[i]);
+      index_file << tile_indices[i].first << " " << tile_indices[i].second << "\n";
+    }
+  }
+  grid_map::grid_map_pcl::printTimeElapsedToRosInfoStream(
+    start, "Finish creating " + std::to_string(available_tiles_.size()) +
+             " elevation map tiles. Total time: ",
+    this->get_logger());
+}
+
+grid_map::GridMap ElevationMapLoaderNode::createElevationMapTile(
+  const TileIndex & tile_index, const pcl::PointCloud<pcl::PointXYZ>::Ptr & tile_cloud) const
+{
+  const auto grid_map_logger = rclcpp::get_logger("grid_map_logger");
+  grid_map::GridMap tile_map;
+  {
+    pcl::shared_ptr<grid_map::GridMapPclLoader> grid_map_pcl_loader =
+      pcl::make_shared<grid_map::GridMapPclLoader>(grid_map_logger);
+    grid_map_pcl_loader->loadParameters(param_file_path_);
+    grid_map_pcl_loader->setInputCloud(tile_cloud);
+    createElevationMapFromPointcloud(grid_map_pcl_loader);
+    tile_map = grid_map_pcl_loader->getGridMap();
+  }
+  if (tile_map.getSize().prod() == 0 || !tile_map.get(layer_name_).array().isFinite().any()) {
+    return grid_map::GridMap();
+  }
+
+  const double min_x = tile_index.first * tile_size_;
+  const double min_y = tile_index.second * tile_size_;
+  if (use_inpaint_) {
+    // only the road lanelets overlapping the tile and its margin are used
+    lanelet::ConstLanelets tile_lanelets;
+    if (lane_filter_.use_lane_filter_) {
+      // the bounding box of a lanelet also overlaps the tiles it crosses without a vertex in them
+      const double margin = tile_margin_ + lane_filter_.lane_margin_;
+      const lanelet::BoundingBox2d tile_box(
+        lanelet::BasicPoint2d(min_x - margin, min_y - margin),
+        lanelet::BasicPoint2d(min_x + tile_size_ + margin, min_y + tile_size_ + margin));
+      for (const auto & lanelet : lane_filter_.road_lanelets_) {
+        if (lanelet::geometry::boundingBox2d(lanelet).intersects(tile_box)) {
+          tile_lanelets.push_back(lanelet);
+        }
+      }
+    }
+    inpaintElevationMap(tile_map, inpaint_radius_, tile_lanelets);
+  }
+
+  // Remove the margin
+  bool is_success = false;
+  const auto tile_core_map = tile_map.getSubmap(
+    grid_map::Position(min_x + 0.5 * tile_size_, min_y + 0.5 * tile_size_),
+    grid_map::Length(tile_size_, tile_size_), is_success);
+  return is_success ? tile_core_map : tile_map;
+}
+
+void ElevationMapLoaderNode::publishElevationMapAroundVehicle()
+{
+  const auto & position = *vehicle_position_;
+  std::set<TileIndex> required_tiles;
+  const int min_x = static_cast<int>(std::floor((position.x() - tile_load_radius_) / tile_size_));
+  const int max_x = static_cast<int>(std::floor((position.x() + tile_load_radius_) / tile_size_));
+  const int min_y = static_cast<int>(std::floor((position.y() - tile_load_radius_) / tile_size_));
+  const int max_y = static_cast<int>(std::floor((position.y() + tile_load_radius_) / tile_size_));
+  for (int x = min_x; x <= max_x; ++x) {
+    for (int y = min_y; y <= max_y; ++y) {
+      if (available_tiles_.count(TileIndex(x, y)) != 0) {
+        required_tiles.insert(TileIndex(x, y));
+      }
+    }
+  }
+  if (required_tiles.empty() || required_tiles == published_tiles_) {
+    return;
+  }
+
+  // Unload the tiles far from the vehicle and load the new ones from the cache
+  for (auto it = loaded_tiles_.begin(); it != loaded_tiles_.end();) {
+    it = required_tiles.count(it->first) == 0 ? loaded_tiles_.erase(it) : std::next(it);
+  }
+  for (const auto & tile_index : required_tiles) {
+    if (loaded_tiles_.count(tile_index) != 0) {
+      continue;
+    }
+    grid_map::GridMap tile_map;
+    bool is_bag_loaded = false;
+    try {
+      is_bag_loaded = grid_map::GridMapRosConverter::loadFromBag(
+        getTilePath(tile_index), "elevation_map", tile_map);
+    } catch (rosbag2_storage_plugins::SqliteException & e) {
+      is_bag_loaded = false;
+    }
+    if (is_bag_loaded) {
+      loaded_tiles_.emplace(tile_index, std::move(tile_map));
+    } else {
+      RCLCPP_ERROR(
+        this->get_logger(), "Failed to load elevation map tile: %s",
+        getTilePath(tile_index).c_str());
+    }
+  }
+  if (loaded_tiles_.empty()) {
+    return;
+  }
+
+  elevation_map_ = loaded_tiles_.begin()->second;
+  for (auto it = std::next(loaded_tiles_.begin()); it != loaded_tiles_.end(); ++it) {
+    elevation_map_.addDataFrom(it->second, true, true, true);
+  }
+  published_tiles_ = required_tiles;
+  publishElevationMap();
+}
+
 #include <rclcpp_components/register_node_macro.hpp>
 RCLCPP_COMPONENTS_REGISTER_NODE(ElevationMapLoaderNode)
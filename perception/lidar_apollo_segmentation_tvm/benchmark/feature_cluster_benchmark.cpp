@@ -0,0 +1,143 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Time the feature map generation and the clustering on recorded scans.
+// Usage: feature_cluster_benchmark [scan.pcd ...]
+// Without argument, a synthetic scan of a few boxes around the vehicle is used.
+
+#include <common/types.hpp>
+#include <lidar_apollo_segmentation_tvm/cluster2d.hpp>
+#include <lidar_apollo_segmentation_tvm/feature_generator.hpp>
+
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using autoware::common::types::float32_t;
+using autoware::perception::lidar_apollo_segmentation_tvm::Cluster2D;
+using autoware::perception::lidar_apollo_segmentation_tvm::FeatureGenerator;
+
+namespace
+{
+constexpr int32_t kGridSize = 864;
+constexpr int32_t kRange = 90;
+constexpr int32_t kOutputChannels = 12;
+constexpr int kIterations = 50;
+
+pcl::PointCloud<pcl::PointXYZI>::Ptr createSyntheticScan()
+{
+  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float32_t> position(-60.0f, 60.0f);
+  std::uniform_real_distribution<float32_t> offset(-1.0f, 1.0f);
+  std::uniform_real_distribution<float32_t> intensity(0.0f, 255.0f);
+  // 32 rings of ground points
+  for (int ring = 0; ring < 32; ++ring) {
+    const float32_t radius = 3.0f + 2.0f * static_cast<float32_t>(ring);
+    for (int azimuth = 0; azimuth < 1800; ++azimuth) {
+      const float32_t angle = static_cast<float32_t>(azimuth) * static_cast<float32_t>(M_PI) / 900;
+      pcl::PointXYZI p;
+      p.x = radius * std::cos(angle);
+      p.y = radius * std::sin(angle);
+      p.z = -1.8f;
+      p.intensity = intensity(gen);
+      cloud->push_back(p);
+    }
+  }
+  // 100 objects of 500 points
+  for (int object = 0; object < 100; ++object) {
+    const float32_t center_x = position(gen);
+    const float32_t center_y = position(gen);
+    for (int i = 0; i < 500; ++i) {
+      pcl::PointXYZI p;
+      p.x = center_x + 2.0f * offset(gen);
+      p.y = center_y + offset(gen);
+      p.z = 0.5f * offset(gen);
+      p.intensity = intensity(gen);
+      cloud->push_back(p);
+    }
+  }
+  return cloud;
+}
+
+// Stand-in for the network output: every nonempty cell is an object pointing to itself.
+void fakeInference(const float32_t * nonempty_data, std::vector<float32_t> & inferred_data)
+{
+  const int32_t size = kGridSize * kGridSize;
+  inferred_data.assign(static_cast<size_t>(kOutputChannels * size), 0.0f);
+  for (int32_t i = 0; i < size; ++i) {
+    inferred_data[i] = nonempty_data[i];             // category
+    inferred_data[3 * size + i] = nonempty_data[i];  // confidence
+    inferred_data[5 * size + i] = 1.0f;              // META_SMALL_MOT class
+    inferred_data[9 * size + i] = 1.0f;              // heading x
+  }
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  std::vector<pcl::PointCloud<pcl::PointXYZI>::Ptr> scans;
+  for (int i = 1; i < argc; ++i) {
+    pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>);
+    if (pcl::io::loadPCDFile(argv[i], *cloud) != 0) {
+      std::fprintf(stderr, "failed to load %s\n", argv[i]);
+      return 1;
+    }
+    scans.push_back(cloud);
+  }
+  if (scans.empty()) {
+    scans.push_back(createSyntheticScan());
+  }
+
+  FeatureGenerator feature_generator(kGridSize, kGridSize, kRange, true, true, -5.0f, 5.0f);
+  Cluster2D cluster2d(kGridSize, kGridSize, static_cast<float32_t>(kRange));
+  std::vector<float32_t> inferred_data;
+  pcl::PointIndices valid_indices;
+
+  std::printf("#Scan Points generate[ms] cluster[ms] Obstacles\n");
+  for (size_t scan_id = 0; scan_id < scans.size(); ++scan_id) {
+    const auto & scan = scans[scan_id];
+    valid_indices.indices.resize(scan->size());
+    for (size_t i = 0; i < scan->size(); ++i) {
+      valid_indices.indices[i] = static_cast<int>(i);
+    }
+
+    double generate_time = 0.0;
+    double cluster_time = 0.0;
+    size_t num_obstacles = 0;
+    for (int iteration = 0; iteration < kIterations; ++iteration) {
+      const auto start = std::chrono::steady_clock::now();
+      const auto feature_map = feature_generator.generate(scan);
+      const auto generated = std::chrono::steady_clock::now();
+      fakeInference(feature_map->nonempty_data, inferred_data);
+      const auto inferred = std::chrono::steady_clock::now();
+      cluster2d.cluster(inferred_data.data(), scan, valid_indices, 0.5f, true);
+      const auto objects = cluster2d.getObjects(0.1f, 0.5f, 3);
+      const auto clustered = std::chrono::steady_clock::now();
+
+      generate_time += std::chrono::duration<double, std::milli>(generated - start).count();
+      cluster_time += std::chrono::duration<double, std::milli>(clustered - inferred).count();
+      num_obstacles = objects->feature_objects.size();
+    }
+    std::printf(
+      "%lu %lu %f %f %lu\n", scan_id, scan->size(), generate_time / kIterations,
+      cluster_time / kIterations, num_obstacles);
+  }
+  return 0;
+}
@@ -28,6 +28,8 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -38,7 +40,6 @@ namespace perception
 namespace lidar_apollo_segmentation_tvm
 {
 using autoware::common::types::bool8_t;
-using autoware::common::types::char8_t;
 using autoware::common::types::float32_t;
 
 /// \brief Internal obstacle classification categories.
@@ -130,30 +131,18 @@ private:
   pcl::PointCloud<pcl::PointXYZI>::ConstPtr pc_ptr_;
   const std::vector<int32_t> * valid_indices_in_pc_ = nullptr;
 
-  /// \brief Node of a directed graph.
-  struct Node
-  {
-    Node * center_node;
-    Node * parent;
-    char8_t node_rank;
-    char8_t traversed;
-    bool8_t is_center;
-    bool8_t is_object;
-    int32_t point_num;
-    int32_t obstacle_id;
-
-    Node()
-    {
-      center_node = nullptr;
-      parent = nullptr;
-      node_rank = 0;
-      traversed = 0;
-      is_center = false;
-      is_object = false;
-      point_num = 0;
-      obstacle_id = -1;
-    }
-  };
+  // Directed graph over the grid cells, every cell points to the cell of its predicted object
+  // center. The buffers are indexed by grid and reused across calls.
+  std::vector<int32_t> parent_;
+  std::vector<uint8_t> node_rank_;
+  std::vector<uint8_t> traversed_;
+  std::vector<uint8_t> is_center_;
+  std::vector<int32_t> point_num_;
+  std::vector<int32_t> root_obstacle_id_;
+  // Object cells in row major order, and the center cells in the order they were found.
+  std::vector<int32_t> object_grids_;
+  std::vector<int32_t> center_grids_;
+  std::vector<int32_t> traverse_path_;
 
   /// \brief Check whether a signed row and column values are valid array indices.
   inline bool IsValidRowCol(int32_t row, int32_t col) const
@@ -170,9 +159,25 @@ private:
   /// \brief Transform a row and column coordinate to a linear grid index.
   inline int32_t RowCol2Grid(int32_t row, int32_t col) const { return row * cols_ + col; }
 
+  /// \brief Get the grid of the object center predicted for a cell.
+  inline int32_t CenterGrid(
+    int32_t grid, const float32_t * instance_pt_x_data, const float32_t * instance_pt_y_data) const
+  {
+    const int32_t row = grid / cols_;
+    const int32_t col = grid - row * cols_;
+    int32_t center_row = row + static_cast<int32_t>(std::round(instance_pt_x_data[grid] * scale_));
+    int32_t center_col = col + static_cast<int32_t>(std::round(instance_pt_y_data[grid] * scale_));
+    center_row = std::min(std::max(center_row, 0), rows_ - 1);
+    center_col = std::min(std::max(center_col, 0), cols_ - 1);
+    return RowCol2Grid(center_row, center_col);
+  }
+
   /// \brief Traverse the directed graph until visiting a node.
-  /// \param[in] x Node to visit.
-  void traverse(Node * x) const;
+  /// \param[in] grid Grid of the node to visit.
+  /// \param[in] instance_pt_x_data Predicted row offsets to the object centers.
+  /// \param[in] instance_pt_y_data Predicted column offsets to the object centers.
+  void traverse(
+    int32_t grid, const float32_t * instance_pt_x_data, const float32_t * instance_pt_y_data);
 };
 }  // namespace lidar_apollo_segmentation_tvm
 }  // namespace perception
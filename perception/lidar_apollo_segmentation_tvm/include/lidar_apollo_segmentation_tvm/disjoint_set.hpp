@@ -15,6 +15,8 @@
 #ifndef LIDAR_APOLLO_SEGMENTATION_TVM__DISJOINT_SET_HPP_
 #define LIDAR_APOLLO_SEGMENTATION_TVM__DISJOINT_SET_HPP_
 
+#include <vector>
+
 namespace autoware
 {
 namespace perception
@@ -22,60 +24,50 @@ namespace perception
 namespace lidar_apollo_segmentation_tvm
 {
 /// \brief Add a new element in a new set.
-/// \param[inout] x The element to be added.
-template <class T>
-void DisjointSetMakeSet(T * x)
+/// \param[in] x The index of the element to be added.
+/// \param[inout] parent The parent index of every element.
+/// \param[inout] rank The rank of every element.
+template <class Index, class Rank>
+void DisjointSetMakeSet(const Index x, std::vector<Index> & parent, std::vector<Rank> & rank)
 {
-  x->parent = x;
-  x->node_rank = 0;
-}
-
-/// \brief Recursively follow the chain of parent pointers from the input until reaching a root.
-/// \param[inout] x The element which root is looked for.
-/// \return The root of the set containing x.
-template <class T>
-T * DisjointSetFindRecursive(T * x)
-{
-  if (x->parent != x) {
-    x->parent = DisjointSetFindRecursive(x->parent);
-  }
-  return x->parent;
+  parent[x] = x;
+  rank[x] = 0;
 }
 
-/// \brief Find the root of the set x belongs to.
-/// \param[inout] x The set element.
-/// \return The root of the set containing x.
-template <class T>
-T * DisjointSetFind(T * x)
+/// \brief Find the root of the set x belongs to, halving the path on the way.
+/// \param[in] x The index of the set element.
+/// \param[inout] parent The parent index of every element.
+/// \return The index of the root of the set containing x.
+template <class Index>
+Index DisjointSetFind(Index x, std::vector<Index> & parent)
 {
-  T * y = x->parent;
-  if (y == x || y->parent == y) {
-    return y;
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
   }
-  T * root = DisjointSetFindRecursive(y->parent);
-  x->parent = root;
-  y->parent = root;
-  return root;
+  return x;
 }
 
 /// \brief Replace the set containing x and the set containing y with their union.
-/// \param[inout] x An element of a first set.
-/// \param[inout] y An element of a second set.
-template <class T>
-void DisjointSetUnion(T * x, T * y)
+/// \param[in] x The index of an element of a first set.
+/// \param[in] y The index of an element of a second set.
+/// \param[inout] parent The parent index of every element.
+/// \param[inout] rank The rank of every element.
+template <class Index, class Rank>
+void DisjointSetUnion(Index x, Index y, std::vector<Index> & parent, std::vector<Rank> & rank)
 {
-  x = DisjointSetFind(x);
-  y = DisjointSetFind(y);
+  x = DisjointSetFind(x, parent);
+  y = DisjointSetFind(y, parent);
   if (x == y) {
     return;
   }
-  if (x->node_rank < y->node_rank) {
-    x->parent = y;
-  } else if (y->node_rank < x->node_rank) {
-    y->parent = x;
+  if (rank[x] < rank[y]) {
+    parent[x] = y;
+  } else if (rank[y] < rank[x]) {
+    parent[y] = x;
   } else {
-    y->parent = x;
-    x->node_rank++;
+    parent[y] = x;
+    rank[x]++;
   }
 }
 }  // namespace lidar_apollo_segmentation_tvm
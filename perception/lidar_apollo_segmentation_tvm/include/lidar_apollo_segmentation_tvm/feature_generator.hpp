@@ -26,6 +26,7 @@
 #include <pcl/point_types.h>
 
 #include <memory>
+#include <vector>
 
 namespace autoware
 {
@@ -45,6 +46,8 @@ private:
   const float32_t min_height_;
   const float32_t max_height_;
   std::shared_ptr<FeatureMapInterface> map_ptr_;
+  // grid of every point, -1 if the point is out of the map, reused across calls
+  std::vector<int32_t> point_grids_;
 
 public:
   /// \brief Constructor
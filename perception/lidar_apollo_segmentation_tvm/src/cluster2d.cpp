@@ -62,28 +62,41 @@ Cluster2D::Cluster2D(const int32_t rows, const int32_t cols, const float32_t ran
   id_img_.assign(siz_, -1);
   pc_ptr_.reset();
   valid_indices_in_pc_ = nullptr;
+
+  parent_.resize(siz_);
+  node_rank_.resize(siz_);
+  traversed_.resize(siz_);
+  is_center_.resize(siz_);
+  point_num_.resize(siz_);
+  root_obstacle_id_.resize(siz_);
+  object_grids_.reserve(siz_);
+  center_grids_.reserve(siz_);
 }
 
-void Cluster2D::traverse(Node * x) const
+void Cluster2D::traverse(
+  int32_t grid, const float32_t * instance_pt_x_data, const float32_t * instance_pt_y_data)
 {
-  std::vector<Node *> p;
-  p.clear();
+  traverse_path_.clear();
 
-  while (x->traversed == 0) {
-    p.push_back(x);
-    x->traversed = 2;
-    x = x->center_node;
+  while (traversed_[grid] == 0) {
+    traverse_path_.push_back(grid);
+    DisjointSetMakeSet(grid, parent_, node_rank_);
+    traversed_[grid] = 2;
+    grid = CenterGrid(grid, instance_pt_x_data, instance_pt_y_data);
   }
-  if (x->traversed == 2) {
-    for (int i = static_cast<int>(p.size()) - 1; i >= 0 && p[i] != x; i--) {
-      p[i]->is_center = true;
+  if (traversed_[grid] == 2) {
+    // the path ends with a cycle, whose nodes are all centers
+    for (auto it = traverse_path_.rbegin(); it != traverse_path_.rend() && *it != grid; ++it) {
+      is_center_[*it] = 1;
+      center_grids_.push_back(*it);
     }
-    x->is_center = true;
+    is_center_[grid] = 1;
+    center_grids_.push_back(grid);
   }
-  for (size_t i = 0; i < p.size(); i++) {
-    Node * y = p[i];
-    y->traversed = 1;
-    y->parent = x->parent;
+  const int32_t center_parent = parent_[grid];
+  for (const int32_t path_grid : traverse_path_) {
+    traversed_[path_grid] = 1;
+    parent_[path_grid] = center_parent;
   }
 }
 
@@ -98,7 +111,9 @@ void Cluster2D::cluster(
 
   pc_ptr_ = pc_ptr;
 
-  std::vector<std::vector<Node>> nodes(rows_, std::vector<Node>(cols_, Node()));
+  std::fill(point_num_.begin(), point_num_.end(), 0);
+  std::fill(traversed_.begin(), traversed_.end(), 0);
+  std::fill(is_center_.begin(), is_center_.end(), 0);
 
   valid_indices_in_pc_ = &(valid_indices.indices);
   point2grid_.assign(valid_indices_in_pc_->size(), -1);
@@ -113,73 +128,55 @@ void Cluster2D::cluster(
     int32_t pos_y = F2I(point.x, range_, inv_res_y_);  // row
     if (IsValidRowCol(pos_y, pos_x)) {
       point2grid_[i] = RowCol2Grid(pos_y, pos_x);
-      nodes[pos_y][pos_x].point_num++;
+      point_num_[point2grid_[i]]++;
     }
   }
 
-  for (int32_t row = 0; row < rows_; ++row) {
-    for (int32_t col = 0; col < cols_; ++col) {
-      int32_t grid = RowCol2Grid(row, col);
-      Node * node = &nodes[row][col];
-      DisjointSetMakeSet(node);
-      node->is_object = (use_all_grids_for_clustering || nodes[row][col].point_num > 0) &&
-                        (*(category_pt_data + grid) >= objectness_thresh);
-      int32_t center_row =
-        row + static_cast<int32_t>(std::round(instance_pt_x_data[grid] * scale_));
-      int32_t center_col =
-        col + static_cast<int32_t>(std::round(instance_pt_y_data[grid] * scale_));
-      center_row = std::min(std::max(center_row, 0), rows_ - 1);
-      center_col = std::min(std::max(center_col, 0), cols_ - 1);
-      node->center_node = &nodes[center_row][center_col];
+  // only the object cells and the cells their center chains go through are part of the graph
+  object_grids_.clear();
+  for (int32_t grid = 0; grid < siz_; ++grid) {
+    if (
+      (use_all_grids_for_clustering || point_num_[grid] > 0) &&
+      category_pt_data[grid] >= objectness_thresh) {
+      object_grids_.push_back(grid);
     }
   }
 
-  for (int32_t row = 0; row < rows_; ++row) {
-    for (int32_t col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (node->is_object && node->traversed == 0) {
-        traverse(node);
-      }
+  center_grids_.clear();
+  for (const int32_t grid : object_grids_) {
+    if (traversed_[grid] == 0) {
+      traverse(grid, instance_pt_x_data, instance_pt_y_data);
     }
   }
 
-  for (int32_t row = 0; row < rows_; ++row) {
-    for (int32_t col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_center) {
-        continue;
-      }
-      for (int32_t row2 = row - 1; row2 <= row + 1; ++row2) {
-        for (int32_t col2 = col - 1; col2 <= col + 1; ++col2) {
-          if ((row2 == row || col2 == col) && IsValidRowCol(row2, col2)) {
-            Node * node2 = &nodes[row2][col2];
-            if (node2->is_center) {
-              DisjointSetUnion(node, node2);
-            }
-          }
-        }
-      }
+  // first pass: merge the 4-connected centers, looking right and down is enough as the union is
+  // symmetric
+  for (const int32_t grid : center_grids_) {
+    const int32_t row = grid / cols_;
+    const int32_t col = grid - row * cols_;
+    if (col + 1 < cols_ && is_center_[grid + 1]) {
+      DisjointSetUnion(grid, grid + 1, parent_, node_rank_);
+    }
+    if (row + 1 < rows_ && is_center_[grid + cols_]) {
+      DisjointSetUnion(grid, grid + cols_, parent_, node_rank_);
     }
   }
 
+  // second pass: label the object cells with the obstacle of their root
   int32_t count_obstacles = 0;
   obstacles_.clear();
-  id_img_.assign(siz_, -1);
-  for (int32_t row = 0; row < rows_; ++row) {
-    for (int32_t col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_object) {
-        continue;
-      }
-      Node * root = DisjointSetFind(node);
-      if (root->obstacle_id < 0) {
-        root->obstacle_id = count_obstacles++;
-        obstacles_.push_back(Obstacle());
-      }
-      int32_t grid = RowCol2Grid(row, col);
-      id_img_[grid] = root->obstacle_id;
-      obstacles_[root->obstacle_id].grids.push_back(grid);
+  std::fill(id_img_.begin(), id_img_.end(), -1);
+  for (const int32_t grid : center_grids_) {
+    root_obstacle_id_[DisjointSetFind(grid, parent_)] = -1;
+  }
+  for (const int32_t grid : object_grids_) {
+    const int32_t root = DisjointSetFind(grid, parent_);
+    if (root_obstacle_id_[root] < 0) {
+      root_obstacle_id_[root] = count_obstacles++;
+      obstacles_.push_back(Obstacle());
     }
+    id_img_[grid] = root_obstacle_id_[root];
+    obstacles_[root_obstacle_id_[root]].grids.push_back(grid);
   }
   filter(inferred_data);
   classify(inferred_data);
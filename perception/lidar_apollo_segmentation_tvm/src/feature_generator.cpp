@@ -16,12 +16,13 @@
 #include <lidar_apollo_segmentation_tvm/feature_generator.hpp>
 #include <lidar_apollo_segmentation_tvm/log_table.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
-using autoware::common::types::float64_t;
 
 namespace autoware
 {
@@ -62,55 +63,74 @@ FeatureGenerator::FeatureGenerator(
 std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
   const pcl::PointCloud<pcl::PointXYZI>::ConstPtr & pc_ptr)
 {
-  const float64_t epsilon = 1e-6;
   map_ptr_->resetMap(map_ptr_->map_data);
 
   const int32_t size = map_ptr_->height * map_ptr_->width;
+  const int32_t width = map_ptr_->width;
+  const int32_t height = map_ptr_->height;
+  const float32_t range = static_cast<float32_t>(map_ptr_->range);
 
   const float32_t inv_res_x = 0.5f * map_ptr_->width / map_ptr_->range;
   const float32_t inv_res_y = 0.5f * map_ptr_->height / map_ptr_->range;
 
-  for (size_t i = 0; i < pc_ptr->points.size(); ++i) {
-    if (pc_ptr->points[i].z <= min_height_ || max_height_ <= pc_ptr->points[i].z) {
-      continue;
-    }
-
+  // first pass: compute the grid of every point, without data dependency between points
+  const auto & points = pc_ptr->points;
+  const size_t num_points = points.size();
+  point_grids_.resize(num_points);
+  int32_t * point_grids = point_grids_.data();
+  for (size_t i = 0; i < num_points; ++i) {
     // x on grid
-    const int32_t pos_x = static_cast<int32_t>(
-      std::floor((static_cast<float32_t>(map_ptr_->range) - pc_ptr->points[i].y) * inv_res_x));
+    const int32_t pos_x = static_cast<int32_t>(std::floor((range - points[i].y) * inv_res_x));
     // y on grid
-    const int32_t pos_y = static_cast<int32_t>(
-      std::floor((static_cast<float32_t>(map_ptr_->range) - pc_ptr->points[i].x) * inv_res_y));
-    if (pos_x < 0 || map_ptr_->width <= pos_x || pos_y < 0 || map_ptr_->height <= pos_y) {
+    const int32_t pos_y = static_cast<int32_t>(std::floor((range - points[i].x) * inv_res_y));
+    const bool8_t is_valid = !(points[i].z <= min_height_ || max_height_ <= points[i].z) &&
+                             0 <= pos_x && pos_x < width && 0 <= pos_y && pos_y < height;
+    point_grids[i] = is_valid ? pos_y * width + pos_x : -1;
+  }
+
+  // second pass: accumulate the points in their cell
+  float32_t * max_height_data = map_ptr_->max_height_data;
+  float32_t * mean_height_data = map_ptr_->mean_height_data;
+  float32_t * count_data = map_ptr_->count_data;
+  float32_t * top_intensity_data = map_ptr_->top_intensity_data;
+  float32_t * mean_intensity_data = map_ptr_->mean_intensity_data;
+  float32_t * nonempty_data = map_ptr_->nonempty_data;
+  for (size_t i = 0; i < num_points; ++i) {
+    const int32_t idx = point_grids[i];
+    if (idx < 0) {
       continue;
     }
-
-    const int32_t idx = pos_y * map_ptr_->width + pos_x;
-
-    if (map_ptr_->max_height_data[idx] < pc_ptr->points[i].z) {
-      map_ptr_->max_height_data[idx] = pc_ptr->points[i].z;
-      if (map_ptr_->top_intensity_data != nullptr) {
-        map_ptr_->top_intensity_data[idx] = normalizeIntensity(pc_ptr->points[i].intensity);
+    const auto & point = points[i];
+    if (max_height_data[idx] < point.z) {
+      max_height_data[idx] = point.z;
+      if (top_intensity_data != nullptr) {
+        top_intensity_data[idx] = normalizeIntensity(point.intensity);
       }
     }
-    map_ptr_->mean_height_data[idx] += pc_ptr->points[i].z;
-    if (map_ptr_->mean_intensity_data != nullptr) {
-      map_ptr_->mean_intensity_data[idx] += normalizeIntensity(pc_ptr->points[i].intensity);
+    mean_height_data[idx] += point.z;
+    if (mean_intensity_data != nullptr) {
+      mean_intensity_data[idx] += normalizeIntensity(point.intensity);
     }
-    map_ptr_->count_data[idx] += 1.0f;
+    count_data[idx] += 1.0f;
   }
 
+  // third pass: normalize the cells, branch free so that the loops can be vectorized
   for (int32_t i = 0; i < size; ++i) {
-    if (static_cast<float64_t>(map_ptr_->count_data[i]) < epsilon) {
-      map_ptr_->max_height_data[i] = 0.0f;
-    } else {
-      map_ptr_->mean_height_data[i] /= map_ptr_->count_data[i];
-      if (map_ptr_->mean_intensity_data != nullptr) {
-        map_ptr_->mean_intensity_data[i] /= map_ptr_->count_data[i];
-      }
-      map_ptr_->nonempty_data[i] = 1.0f;
+    const float32_t count = count_data[i];
+    max_height_data[i] = count > 0.0f ? max_height_data[i] : 0.0f;
+    mean_height_data[i] /= std::max(count, 1.0f);
+    nonempty_data[i] = count > 0.0f ? 1.0f : 0.0f;
+  }
+  if (mean_intensity_data != nullptr) {
+    for (int32_t i = 0; i < size; ++i) {
+      mean_intensity_data[i] /= std::max(count_data[i], 1.0f);
+    }
+  }
+  for (int32_t i = 0; i < size; ++i) {
+    // ln(1 + 0) is 0, only the nonempty cells need a lookup
+    if (count_data[i] > 0.0f) {
+      count_data[i] = calcApproximateLog(count_data[i]);
     }
-    map_ptr_->count_data[i] = calcApproximateLog(map_ptr_->count_data[i]);
   }
   return map_ptr_;
 }
@@ -16,6 +16,7 @@
 #include <lidar_apollo_segmentation_tvm/feature_map.hpp>
 #include <lidar_apollo_segmentation_tvm/util.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -61,12 +62,10 @@ void FeatureMap::resetMap(std::vector<float32_t> & map)
 {
   const int32_t size = width * height;
   (void)map;
-  for (int32_t i = 0; i < size; ++i) {
-    max_height_data[i] = -5.0f;
-    mean_height_data[i] = 0.0f;
-    count_data[i] = 0.0f;
-    nonempty_data[i] = 0.0f;
-  }
+  std::fill_n(max_height_data, size, -5.0f);
+  std::fill_n(mean_height_data, size, 0.0f);
+  std::fill_n(count_data, size, 0.0f);
+  std::fill_n(nonempty_data, size, 0.0f);
 }
 
 FeatureMapWithIntensity::FeatureMapWithIntensity(
@@ -88,14 +87,12 @@ void FeatureMapWithIntensity::resetMap(std::vector<float32_t> & map)
 {
   const int32_t size = width * height;
   (void)map;
-  for (int32_t i = 0; i < size; ++i) {
-    max_height_data[i] = -5.0f;
-    mean_height_data[i] = 0.0f;
-    count_data[i] = 0.0f;
-    top_intensity_data[i] = 0.0f;
-    mean_intensity_data[i] = 0.0f;
-    nonempty_data[i] = 0.0f;
-  }
+  std::fill_n(max_height_data, size, -5.0f);
+  std::fill_n(mean_height_data, size, 0.0f);
+  std::fill_n(count_data, size, 0.0f);
+  std::fill_n(top_intensity_data, size, 0.0f);
+  std::fill_n(mean_intensity_data, size, 0.0f);
+  std::fill_n(nonempty_data, size, 0.0f);
 }
 
 FeatureMapWithConstant::FeatureMapWithConstant(
@@ -132,12 +129,10 @@ void FeatureMapWithConstant::resetMap(std::vector<float32_t> & map)
 {
   const int32_t size = width * height;
   (void)map;
-  for (int32_t i = 0; i < size; ++i) {
-    max_height_data[i] = -5.0f;
-    mean_height_data[i] = 0.0f;
-    count_data[i] = 0.0f;
-    nonempty_data[i] = 0.0f;
-  }
+  std::fill_n(max_height_data, size, -5.0f);
+  std::fill_n(mean_height_data, size, 0.0f);
+  std::fill_n(count_data, size, 0.0f);
+  std::fill_n(nonempty_data, size, 0.0f);
 }
 
 FeatureMapWithConstantAndIntensity::FeatureMapWithConstantAndIntensity(
@@ -176,14 +171,12 @@ void FeatureMapWithConstantAndIntensity::resetMap(std::vector<float32_t> & map)
 {
   const int32_t size = width * height;
   (void)map;
-  for (int32_t i = 0; i < size; ++i) {
-    max_height_data[i] = -5.0f;
-    mean_height_data[i] = 0.0f;
-    count_data[i] = 0.0f;
-    top_intensity_data[i] = 0.0f;
-    mean_intensity_data[i] = 0.0f;
-    nonempty_data[i] = 0.0f;
-  }
+  std::fill_n(max_height_data, size, -5.0f);
+  std::fill_n(mean_height_data, size, 0.0f);
+  std::fill_n(count_data, size, 0.0f);
+  std::fill_n(top_intensity_data, size, 0.0f);
+  std::fill_n(mean_intensity_data, size, 0.0f);
+  std::fill_n(nonempty_data, size, 0.0f);
 }
 }  // namespace lidar_apollo_segmentation_tvm
 }  // namespace perception
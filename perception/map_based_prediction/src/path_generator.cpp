@@ -319,12 +319,11 @@ PosePath PathGenerator::interpolateReferencePath(
   }
 
   // Spline Interpolation
-  std::vector<double> spline_ref_path_x =
-    interpolation::spline(base_path_s, base_path_x, resampled_s);
-  std::vector<double> spline_ref_path_y =
-    interpolation::spline(base_path_s, base_path_y, resampled_s);
-  std::vector<double> spline_ref_path_z =
-    interpolation::spline(base_path_s, base_path_z, resampled_s);
+  const auto spline_ref_path_xyz = interpolation::splineMultiChannel(
+    base_path_s, {base_path_x, base_path_y, base_path_z}, resampled_s);
+  const std::vector<double> & spline_ref_path_x = spline_ref_path_xyz.at(0);
+  const std::vector<double> & spline_ref_path_y = spline_ref_path_xyz.at(1);
+  const std::vector<double> & spline_ref_path_z = spline_ref_path_xyz.at(2);
 
   interpolated_path.resize(interpolate_num);
   for (size_t i = 0; i < interpolate_num - 1; ++i) {
@@ -25,7 +25,7 @@
 #include <vector>
 
 #define EIGEN_MPL2_ONLY
-#include "multi_object_tracker/data_association/solver/gnn_solver.hpp"
+#include "gnn_solver/gnn_solver.hpp"
 #include "multi_object_tracker/tracker/tracker.hpp"
 
 #include <Eigen/Core>
@@ -43,7 +43,8 @@ private:
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
   const double score_threshold_;
-  std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
+  std::unique_ptr<gnn_solver::SparseSSP> gnn_solver_ptr_;
+  std::vector<gnn_solver::AssignmentEdge> gated_edges_;
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
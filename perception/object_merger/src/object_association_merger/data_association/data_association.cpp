@@ -14,7 +14,7 @@
 
 #include "object_association_merger/data_association/data_association.hpp"
 
-#include "object_association_merger/data_association/solver/gnn_solver.hpp"
+#include "gnn_solver/gnn_solver.hpp"
 #include "object_association_merger/utils/utils.hpp"
 #include "perception_utils/perception_utils.hpp"
 #include "tier4_autoware_utils/geometry/geometry.hpp"
@@ -77,39 +77,25 @@ DataAssociation::DataAssociation(
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
 
-  gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
+  gnn_solver_ptr_ = std::make_unique<gnn_solver::SparseSSP>();
 }
 
 void DataAssociation::assign(
   const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(src.rows());
+  // Only the pairs which passed the gates can be assigned
+  gated_edges_.clear();
   for (int row = 0; row < src.rows(); ++row) {
-    score.at(row).resize(src.cols());
     for (int col = 0; col < src.cols(); ++col) {
-      score.at(row).at(col) = src(row, col);
+      if (score_threshold_ <= src(row, col)) {
+        gated_edges_.push_back({row, col, src(row, col)});
+      }
     }
   }
   // Solve
-  gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
-
-  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
-    if (src(itr->first, itr->second) < score_threshold_) {
-      itr = direct_assignment.erase(itr);
-      continue;
-    } else {
-      ++itr;
-    }
-  }
-  for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
-    if (src(itr->second, itr->first) < score_threshold_) {
-      itr = reverse_assignment.erase(itr);
-      continue;
-    } else {
-      ++itr;
-    }
-  }
+  gnn_solver_ptr_->maximizeLinearAssignment(
+    src.rows(), src.cols(), gated_edges_, &direct_assignment, &reverse_assignment);
 }
 
 Eigen::MatrixXd DataAssociation::calcScoreMatrix(
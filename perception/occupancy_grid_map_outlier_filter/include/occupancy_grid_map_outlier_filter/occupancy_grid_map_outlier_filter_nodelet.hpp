@@ -36,8 +36,10 @@
 #include <tf2_ros/message_filter.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace occupancy_grid_map_outlier_filter
 {
@@ -59,12 +61,24 @@ public:
     PclPointCloud & output, PclPointCloud & outlier);
 
 private:
+  int getMinPointsThreshold(const float x, const float y, const Pose & pose) const;
+  // count the neighbors in a fixed resolution grid (integral image) instead of a kd-tree search
+  // return false if the grid covering the pointcloud would be too large
+  bool filterByCountGrid(
+    const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
+    PclPointCloud & output, PclPointCloud & outlier);
+
   float search_radius_;
   float min_points_and_distance_ratio_;
   int min_points_;
   int max_points_;
   long unsigned int max_filter_points_nb_;
+  bool use_count_grid_;
+  float count_grid_resolution_;
   pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
+  // buffers reused across frames
+  std::vector<std::uint32_t> integral_count_;
+  std::vector<std::uint8_t> is_inlier_;
 };
 
 class OccupancyGridMapOutlierFilterComponent : public rclcpp::Node
@@ -125,6 +139,9 @@ private:
   std::string map_frame_;
   std::string base_link_frame_;
   int cost_threshold_;
+
+  // buffers reused across frames
+  std::vector<std::int8_t> point_labels_;
 };
 }  // namespace occupancy_grid_map_outlier_filter
 
@@ -17,8 +17,6 @@
 #include <pcl_ros/transforms.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
-#include <boost/optional.hpp>
-
 #include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 
@@ -29,6 +27,10 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -74,29 +76,28 @@ geometry_msgs::msg::PoseStamped getPoseStamped(
   return tier4_autoware_utils::transform2pose(tf_stamped);
 }
 
-boost::optional<char> getCost(
-  const nav_msgs::msg::OccupancyGrid & map, const double & x, const double & y)
+// offset of a float32 field within the point step, -1 if not found
+int getFieldOffset(const sensor_msgs::msg::PointCloud2 & pointcloud, const std::string & name)
 {
-  const auto & map_position = map.info.origin.position;
-  const auto & map_resolution = map.info.resolution;
-  const double map_height_m = map.info.height /* cell size */ * map_resolution;
-  const double map_width_m = map.info.width /* cell size */ * map_resolution;
-  const double map_min_x = map_position.x;
-  const double map_max_x = map_position.x + map_width_m;
-  const double map_min_y = map_position.y;
-  const double map_max_y = map_position.y + map_height_m;
-
-  if (map_min_x < x && x < map_max_x && map_min_y < y && y < map_max_y) {
-    unsigned int map_cell_x{};
-    unsigned int map_cell_y{};
-    map_cell_x = std::floor((x - map_position.x) / map_resolution);
-    map_cell_y = std::floor((y - map_position.y) / map_resolution);
-    size_t index = map_cell_y * map.info.width + map_cell_x;
-    return map.data.at(index);
+  for (const auto & field : pointcloud.fields) {
+    if (
+      field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32 &&
+      static_cast<size_t>(field.offset) + sizeof(float) <= pointcloud.point_step) {
+      return static_cast<int>(field.offset);
+    }
   }
-  return boost::none;
+  return -1;
+}
+
+float readFloat(const std::uint8_t * data)
+{
+  float value;
+  std::memcpy(&value, data, sizeof(float));
+  return value;
 }
 
+// the largest grid used to count neighbors (e.g. 200m x 200m with a 0.1m resolution)
+constexpr size_t max_count_grid_cells = 4000000;
 }  // namespace
 
 namespace occupancy_grid_map_outlier_filter
@@ -110,12 +111,109 @@ RadiusSearch2dfilter::RadiusSearch2dfilter(rclcpp::Node & node)
   max_points_ = node.declare_parameter("radius_search_2d_filter.max_points", 70);
   max_filter_points_nb_ =
     node.declare_parameter("radius_search_2d_filter.max_filter_points_nb", 15000);
+  use_count_grid_ = node.declare_parameter("radius_search_2d_filter.use_count_grid", false);
+  count_grid_resolution_ =
+    node.declare_parameter("radius_search_2d_filter.count_grid_resolution", 0.25f);
   kd_tree_ = pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
 }
 
+int RadiusSearch2dfilter::getMinPointsThreshold(
+  const float x, const float y, const Pose & pose) const
+{
+  const float distance = std::hypot(x - pose.position.x, y - pose.position.y);
+  return std::min(
+    std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
+    max_points_);
+}
+
+bool RadiusSearch2dfilter::filterByCountGrid(
+  const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
+  PclPointCloud & output, PclPointCloud & outlier)
+{
+  if (low_conf_input.points.empty()) {
+    return true;
+  }
+
+  // Grid covering all points
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  for (const auto * cloud : {&low_conf_input, &high_conf_input}) {
+    for (const auto & p : cloud->points) {
+      min_x = std::min(min_x, p.x);
+      min_y = std::min(min_y, p.y);
+      max_x = std::max(max_x, p.x);
+      max_y = std::max(max_y, p.y);
+    }
+  }
+  const float resolution = count_grid_resolution_;
+  const int width = static_cast<int>((max_x - min_x) / resolution) + 1;
+  const int height = static_cast<int>((max_y - min_y) / resolution) + 1;
+  // integral image with an extra row and column of zeros
+  const size_t stride = static_cast<size_t>(width) + 1;
+  if (stride * (static_cast<size_t>(height) + 1) > max_count_grid_cells) {
+    return false;
+  }
+  const auto to_cell = [&](const pcl::PointXYZ & p) {
+    return std::make_pair(
+      std::min(static_cast<int>((p.x - min_x) / resolution), width - 1),
+      std::min(static_cast<int>((p.y - min_y) / resolution), height - 1));
+  };
+
+  integral_count_.assign(stride * (height + 1), 0);
+  for (const auto * cloud : {&low_conf_input, &high_conf_input}) {
+    for (const auto & p : cloud->points) {
+      const auto [ix, iy] = to_cell(p);
+      ++integral_count_[(iy + 1) * stride + ix + 1];
+    }
+  }
+  for (int iy = 1; iy <= height; ++iy) {
+    std::uint32_t row_sum = 0;
+    for (int ix = 1; ix <= width; ++ix) {
+      row_sum += integral_count_[iy * stride + ix];
+      integral_count_[iy * stride + ix] = row_sum + integral_count_[(iy - 1) * stride + ix];
+    }
+  }
+
+  // square window of (2 * half_window + 1) cells whose side is closest to the side r * sqrt(pi) of
+  // the square with the same area as the search circle, centered on the cell of the point
+  const int half_window = std::max(
+    0, static_cast<int>(std::round((search_radius_ * std::sqrt(M_PI) / resolution - 1.0) / 2.0)));
+  const int nb_low_conf_points = static_cast<int>(low_conf_input.points.size());
+  is_inlier_.resize(nb_low_conf_points);
+#pragma omp parallel for
+  for (int i = 0; i < nb_low_conf_points; ++i) {
+    const auto & p = low_conf_input.points[i];
+    const auto [ix, iy] = to_cell(p);
+    const size_t x0 = std::max(ix - half_window, 0);
+    const size_t x1 = std::min(ix + half_window, width - 1) + 1;
+    const size_t y0 = std::max(iy - half_window, 0);
+    const size_t y1 = std::min(iy + half_window, height - 1) + 1;
+    const std::uint32_t points_num = integral_count_[y1 * stride + x1] -
+                                     integral_count_[y0 * stride + x1] -
+                                     integral_count_[y1 * stride + x0] +
+                                     integral_count_[y0 * stride + x0];
+    is_inlier_[i] = static_cast<int>(points_num) >= getMinPointsThreshold(p.x, p.y, pose);
+  }
+
+  for (int i = 0; i < nb_low_conf_points; ++i) {
+    if (is_inlier_[i]) {
+      output.points.push_back(low_conf_input.points[i]);
+    } else {
+      outlier.points.push_back(low_conf_input.points[i]);
+    }
+  }
+  return true;
+}
+
 void RadiusSearch2dfilter::filter(
   const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
 {
+  if (use_count_grid_ && filterByCountGrid(PclPointCloud{}, input, pose, output, outlier)) {
+    return;
+  }
+
   const auto & xyz_cloud = input;
   pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
   xy_cloud->points.resize(xyz_cloud.points.size());
@@ -128,11 +226,8 @@ void RadiusSearch2dfilter::filter(
   std::vector<float> k_dists(xy_cloud->points.size());
   kd_tree_->setInputCloud(xy_cloud);
   for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
-    const int min_points_threshold = std::min(
-      std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
-      max_points_);
+    const int min_points_threshold =
+      getMinPointsThreshold(xy_cloud->points[i].x, xy_cloud->points[i].y, pose);
     const int points_num =
       kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists, min_points_threshold);
 
@@ -157,6 +252,11 @@ void RadiusSearch2dfilter::filter(
       "Skip outlier filter since too much low_confidence pointcloud!");
     return;
   }
+  if (
+    use_count_grid_ &&
+    filterByCountGrid(high_conf_xyz_cloud, low_conf_xyz_cloud, pose, output, outlier)) {
+    return;
+  }
 
   pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
   xy_cloud->points.resize(low_conf_xyz_cloud.points.size() + high_conf_xyz_cloud.points.size());
@@ -173,11 +273,8 @@ void RadiusSearch2dfilter::filter(
   std::vector<float> k_dists(xy_cloud->points.size());
   kd_tree_->setInputCloud(xy_cloud);
   for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
-    const int min_points_threshold = std::min(
-      std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
-      max_points_);
+    const int min_points_threshold =
+      getMinPointsThreshold(xy_cloud->points[i].x, xy_cloud->points[i].y, pose);
     const int points_num =
       kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists, min_points_threshold);
 
@@ -237,17 +334,35 @@ OccupancyGridMapOutlierFilterComponent::OccupancyGridMapOutlierFilterComponent(
 void OccupancyGridMapOutlierFilterComponent::splitPointCloudFrontBack(
   const PointCloud2::ConstSharedPtr & input_pc, PointCloud2 & front_pc, PointCloud2 & behind_pc)
 {
+  const int x_offset = getFieldOffset(*input_pc, "x");
+  const int y_offset = getFieldOffset(*input_pc, "y");
+  const int z_offset = getFieldOffset(*input_pc, "z");
   PclPointCloud tmp_behind_pc;
   PclPointCloud tmp_front_pc;
-  for (sensor_msgs::PointCloud2ConstIterator<float> x(*input_pc, "x"), y(*input_pc, "y"),
-       z(*input_pc, "z");
-       x != x.end(); ++x, ++y, ++z) {
-    if (*x < 0.0) {
-      tmp_behind_pc.push_back(pcl::PointXYZ(*x, *y, *z));
-    } else {
-      tmp_front_pc.push_back(pcl::PointXYZ(*x, *y, *z));
+  if (x_offset < 0 || y_offset < 0 || z_offset < 0) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "The input pointcloud does not have float32 x, y and z fields within its point step.");
+  } else {
+    const size_t nb_points = input_pc->data.size() / input_pc->point_step;
+    tmp_front_pc.points.reserve(nb_points);
+    tmp_behind_pc.points.reserve(nb_points);
+    for (const auto * point = input_pc->data.data();
+         point < input_pc->data.data() + nb_points * input_pc->point_step;
+         point += input_pc->point_step) {
+      const pcl::PointXYZ p(
+        readFloat(point + x_offset), readFloat(point + y_offset), readFloat(point + z_offset));
+      if (p.x < 0.0) {
+        tmp_behind_pc.points.push_back(p);
+      } else {
+        tmp_front_pc.points.push_back(p);
+      }
     }
   }
+  tmp_front_pc.width = tmp_front_pc.points.size();
+  tmp_front_pc.height = 1;
+  tmp_behind_pc.width = tmp_behind_pc.points.size();
+  tmp_behind_pc.height = 1;
   pcl::toROSMsg(tmp_front_pc, front_pc);
   pcl::toROSMsg(tmp_behind_pc, behind_pc);
   front_pc.header = input_pc->header;
@@ -325,18 +440,58 @@ void OccupancyGridMapOutlierFilterComponent::filterByOccupancyGridMap(
   const OccupancyGrid & occupancy_grid_map, const PointCloud2 & pointcloud,
   PclPointCloud & high_confidence, PclPointCloud & low_confidence, PclPointCloud & out_ogm)
 {
-  for (sensor_msgs::PointCloud2ConstIterator<float> x(pointcloud, "x"), y(pointcloud, "y"),
-       z(pointcloud, "z");
-       x != x.end(); ++x, ++y, ++z) {
-    const auto cost = getCost(occupancy_grid_map, *x, *y);
-    if (cost) {
-      if (cost_threshold_ < *cost) {
-        high_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
-      } else {
-        low_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
-      }
+  const int x_offset = getFieldOffset(pointcloud, "x");
+  const int y_offset = getFieldOffset(pointcloud, "y");
+  const int z_offset = getFieldOffset(pointcloud, "z");
+  if (x_offset < 0 || y_offset < 0 || z_offset < 0) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "The pointcloud does not have float32 x, y and z fields within its point step.");
+    return;
+  }
+
+  // map bounds computed once for all points
+  const auto & map_position = occupancy_grid_map.info.origin.position;
+  const double map_resolution = occupancy_grid_map.info.resolution;
+  const double map_min_x = map_position.x;
+  const double map_max_x = map_position.x + occupancy_grid_map.info.width * map_resolution;
+  const double map_min_y = map_position.y;
+  const double map_max_y = map_position.y + occupancy_grid_map.info.height * map_resolution;
+
+  // label of each point: 0 out of the map, 1 low confidence, 2 high confidence
+  constexpr std::int8_t out_of_map = 0;
+  constexpr std::int8_t low = 1;
+  constexpr std::int8_t high = 2;
+  const int nb_points = static_cast<int>(pointcloud.data.size() / pointcloud.point_step);
+  point_labels_.resize(nb_points);
+#pragma omp parallel for
+  for (int i = 0; i < nb_points; ++i) {
+    const auto * point = pointcloud.data.data() + static_cast<size_t>(i) * pointcloud.point_step;
+    const double x = readFloat(point + x_offset);
+    const double y = readFloat(point + y_offset);
+    if (map_min_x < x && x < map_max_x && map_min_y < y && y < map_max_y) {
+      const auto map_cell_x =
+        static_cast<unsigned int>(std::floor((x - map_min_x) / map_resolution));
+      const auto map_cell_y =
+        static_cast<unsigned int>(std::floor((y - map_min_y) / map_resolution));
+      const char cost =
+        occupancy_grid_map.data[map_cell_y * occupancy_grid_map.info.width + map_cell_x];
+      point_labels_[i] = cost_threshold_ < cost ? high : low;
+    } else {
+      point_labels_[i] = out_of_map;
+    }
+  }
+
+  for (int i = 0; i < nb_points; ++i) {
+    const auto * point = pointcloud.data.data() + static_cast<size_t>(i) * pointcloud.point_step;
+    const pcl::PointXYZ p(
+      readFloat(point + x_offset), readFloat(point + y_offset), readFloat(point + z_offset));
+    if (point_labels_[i] == high) {
+      high_confidence.push_back(p);
+    } else if (point_labels_[i] == low) {
+      low_confidence.push_back(p);
     } else {
-      out_ogm.push_back(pcl::PointXYZ(*x, *y, *z));
+      out_ogm.push_back(p);
     }
   }
 }
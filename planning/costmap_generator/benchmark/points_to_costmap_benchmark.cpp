@@ -0,0 +1,138 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "costmap_generator/points_to_costmap.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double maximum_height_thres = 0.3;
+constexpr double minimum_lidar_height_thres = -2.2;
+constexpr double grid_min_value = 0.0;
+constexpr double grid_max_value = 1.0;
+const std::string layer_name = "points";
+
+// costmap as computed before the cell states were introduced, one vector of heights per cell
+grid_map::Matrix referenceCostmap(
+  const grid_map::GridMap & gridmap, const pcl::PointCloud<pcl::PointXYZ> & points)
+{
+  const double length_x = gridmap.getLength().x();
+  const double length_y = gridmap.getLength().y();
+  const double resolution = gridmap.getResolution();
+  const double x_cell_size = std::ceil(length_x * (1 / resolution));
+  const double y_cell_size = std::ceil(length_y * (1 / resolution));
+  const double origin_x_offset = length_x / 2.0 - gridmap.getPosition().x();
+  const double origin_y_offset = length_y / 2.0 - gridmap.getPosition().y();
+
+  std::vector<std::vector<std::vector<double>>> grid_vec(
+    x_cell_size, std::vector<std::vector<double>>(y_cell_size));
+  for (const auto & point : points) {
+    const int x_ind = std::ceil((length_x - origin_x_offset - point.x) / resolution);
+    const int y_ind = std::ceil((length_y - origin_y_offset - point.y) / resolution);
+    if (x_ind >= 0 && x_ind < x_cell_size && y_ind >= 0 && y_ind < y_cell_size) {
+      grid_vec[x_ind][y_ind].push_back(point.z);
+    }
+  }
+
+  grid_map::Matrix gridmap_data = gridmap[layer_name];
+  for (size_t x_ind = 0; x_ind < grid_vec.size(); x_ind++) {
+    for (size_t y_ind = 0; y_ind < grid_vec[0].size(); y_ind++) {
+      if (grid_vec[x_ind][y_ind].empty()) {
+        gridmap_data(x_ind, y_ind) = grid_min_value;
+        continue;
+      }
+      for (const auto & z : grid_vec[x_ind][y_ind]) {
+        if (z > maximum_height_thres || z < minimum_lidar_height_thres) {
+          continue;
+        }
+        gridmap_data(x_ind, y_ind) = grid_max_value;
+        break;
+      }
+    }
+  }
+  return gridmap_data;
+}
+
+double elapsedMs(const std::chrono::steady_clock::time_point & start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+}  // namespace
+
+int main()
+{
+  constexpr int iterations = 10;
+  std::default_random_engine engine(0);
+  std::normal_distribution<float> z_dist(-0.5f, 1.0f);
+
+  std::printf("#Grid[m] Resolution[m] Points reference[ms] vector[ms] raw[ms] mismatches\n");
+  for (const double grid_length : {70.0, 140.0}) {
+    grid_map::GridMap gridmap;
+    gridmap.setGeometry(grid_map::Length(grid_length, grid_length), 0.1);
+    gridmap.add(layer_name, static_cast<float>(grid_min_value));
+    std::uniform_real_distribution<float> xy_dist(-grid_length / 2.0, grid_length / 2.0);
+
+    for (const size_t nb_points : {100000lu, 300000lu, 1000000lu}) {
+      pcl::PointCloud<pcl::PointXYZ> points;
+      points.reserve(nb_points);
+      for (size_t i = 0; i < nb_points; ++i) {
+        points.emplace_back(xy_dist(engine), xy_dist(engine), z_dist(engine));
+      }
+      sensor_msgs::msg::PointCloud2 msg;
+      pcl::toROSMsg(points, msg);
+
+      grid_map::Matrix reference;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        reference = referenceCostmap(gridmap, points);
+      }
+      const double reference_time = elapsedMs(start) / iterations;
+
+      PointsToCostmap points_to_costmap;
+      grid_map::Matrix costmap;
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        costmap = points_to_costmap.makeCostmapFromPoints(
+          maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
+          layer_name, points);
+      }
+      const double vector_time = elapsedMs(start) / iterations;
+
+      grid_map::GridMap raw_gridmap = gridmap;
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        points_to_costmap.updateCostmapFromPoints(
+          maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, msg,
+          Eigen::Matrix4f::Identity(), raw_gridmap, layer_name);
+      }
+      const double raw_time = elapsedMs(start) / iterations;
+
+      const auto mismatches = (reference.array() != costmap.array()).count() +
+                              (reference.array() != raw_gridmap[layer_name].array()).count();
+      std::printf(
+        "%.0f %.1f %lu %f %f %f %ld\n", grid_length, gridmap.getResolution(), nb_points,
+        reference_time, vector_time, raw_time, static_cast<long>(mismatches));  // NOLINT
+    }
+  }
+  return 0;
+}
@@ -182,10 +182,9 @@ private:
     const lanelet::LaneletMapPtr lanelet_map,
     std::vector<std::vector<geometry_msgs::msg::Point>> * area_points);
 
-  /// \brief calculate cost from pointcloud data
+  /// \brief calculate cost from pointcloud data, in place in the points layer of costmap_
   /// \param[in] in_points: subscribed pointcloud data
-  grid_map::Matrix generatePointsCostmap(
-    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_points);
+  void updatePointsCostmap(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_points);
 
   /// \brief calculate cost from DynamicObjectArray
   /// \param[in] in_objects: subscribed DynamicObjectArray
@@ -46,6 +46,7 @@
 #define COSTMAP_GENERATOR__OBJECTS_TO_COSTMAP_HPP_
 
 #include <grid_map_ros/grid_map_ros.hpp>
+#include <grid_map_utils/polygon_rasterizer.hpp>
 
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
@@ -79,6 +80,8 @@ private:
   const std::string OBJECTS_COSTMAP_LAYER_;
   const std::string BLURRED_OBJECTS_COSTMAP_LAYER_;
 
+  grid_map_utils::PolygonRasterizer polygon_rasterizer_;
+
   /// \brief make 4 rectangle points from centroid position and orientation
   /// \param[in] in_object: subscribed one of PredictedObjects
   /// \param[in] expand_rectangle_size: expanding 4 points
@@ -116,12 +119,11 @@ private:
 
   /// \brief set cost in polygon by using DynamicObject's score
   /// \param[in] polygon: 4 rectangle points in polygon format
-  /// \param[in] gridmap_layer_name: target gridmap layer name for calculated cost
   /// \param[in] score: set score as a cost for costmap
-  /// \param[in] objects_costmap: update cost in this objects_costmap[gridmap_layer_name]
+  /// \param[in] objects_costmap: update cost in the objects and blurred objects layers of this
+  /// costmap
   void setCostInPolygon(
-    const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
-    grid_map::GridMap & objects_costmap);
+    const grid_map::Polygon & polygon, const float score, grid_map::GridMap & objects_costmap);
 };
 
 #endif  // COSTMAP_GENERATOR__OBJECTS_TO_COSTMAP_HPP_
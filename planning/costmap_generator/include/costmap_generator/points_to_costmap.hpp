@@ -47,8 +47,11 @@
 
 #include <grid_map_ros/grid_map_ros.hpp>
 
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -70,7 +73,27 @@ public:
     const std::string & gridmap_layer_name,
     const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
 
+  /// \brief calculate cost from sensor points in place in the gridmap layer
+  /// \details the points are read from the message buffer and transformed to the gridmap frame
+  /// on the fly, without intermediate pointcloud
+  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
+  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
+  /// \param[in] grid_min_value: Minimum cost for costmap
+  /// \param[in] grid_max_value: Maximum cost fot costmap
+  /// \param[in] in_sensor_points: subscribed pointcloud
+  /// \param[in] transform: transform from the pointcloud frame to the gridmap frame
+  /// \param[inout] gridmap: costmap based on gridmap
+  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
+  void updateCostmapFromPoints(
+    const double maximum_height_thres, const double minimum_height_thres,
+    const double grid_min_value, const double grid_max_value,
+    const sensor_msgs::msg::PointCloud2 & in_sensor_points, const Eigen::Matrix4f & transform,
+    grid_map::GridMap & gridmap, const std::string & gridmap_layer_name);
+
 private:
+  /// \brief points found in a grid cell
+  enum CellState : std::uint8_t { NO_POINT = 0, NO_POINT_IN_HEIGHT_RANGE, POINT_IN_HEIGHT_RANGE };
+
   double grid_length_x_;
   double grid_length_y_;
   double grid_resolution_;
@@ -79,7 +102,11 @@ private:
   double y_cell_size_;
   double x_cell_size_;
 
-  /// \brief initialize gridmap parameters
+  /// \brief state of every cell, in the column major order of grid_map::Matrix, reused across
+  /// calls
+  std::vector<std::uint8_t> cell_states_;
+
+  /// \brief initialize gridmap parameters and clear the cell states
   /// \param[in] gridmap: gridmap object to be initialized
   void initGridmapParam(const grid_map::GridMap & gridmap);
 
@@ -93,27 +120,21 @@ private:
   /// \param[out] index in gridmap
   grid_map::Index fetchGridIndexFromPoint(const pcl::PointXYZ & point);
 
-  /// \brief Assign pointcloud to appropriate cell in gridmap
-  /// \param[in] in_sensor_points: subscribed pointcloud
-  /// \param[out] grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell
-  std::vector<std::vector<std::vector<double>>> assignPoints2GridCell(
-    const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
-
-  /// \brief calculate costmap from subscribed pointcloud
+  /// \brief Assign one point to the state of its cell in gridmap
+  /// \param[in] point: one of subscribed pointcloud
   /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
   /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
-  /// \param[in] grid_min_value: Minimum cost for costmap
-  /// \param[in] grid_max_value: Maximum cost fot costmap
-  /// \param[in] gridmap: costmap based on gridmap
-  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
-  /// \param[in] grid_vec: grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell \param[out] calculated costmap in grid_map::Matrix format
-  grid_map::Matrix calculateCostmap(
-    const double maximum_height_thres, const double minimum_lidar_height_thres,
-    const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-    const std::string & gridmap_layer_name,
-    const std::vector<std::vector<std::vector<double>>> grid_vec);
+  void assignPoint2GridCell(
+    const pcl::PointXYZ & point, const double maximum_height_thres,
+    const double minimum_height_thres);
+
+  /// \brief write the cost of every cell from its state
+  /// \param[in] grid_min_value: Minimum cost for costmap, for the cells without point
+  /// \param[in] grid_max_value: Maximum cost fot costmap, for the cells with a point in the
+  /// height range. The other cells keep their cost.
+  /// \param[inout] gridmap_data: costmap layer
+  void calculateCostmap(
+    const double grid_min_value, const double grid_max_value, grid_map::Matrix & gridmap_data);
 };
 
 #endif  // COSTMAP_GENERATOR__POINTS_TO_COSTMAP_HPP_
@@ -49,7 +49,6 @@
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <lanelet2_extension/visualization/visualization.hpp>
-#include <pcl_ros/transforms.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
 #include <tf2/utils.h>
@@ -140,21 +139,6 @@ std::vector<geometry_msgs::msg::Point> poly2vector(const geometry_msgs::msg::Pol
   return ps;
 }
 
-pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
-  const sensor_msgs::msg::PointCloud2 & pointcloud_msg,
-  const geometry_msgs::msg::Transform & transform)
-{
-  const Eigen::Matrix4f transform_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
-
-  sensor_msgs::msg::PointCloud2 transformed_msg;
-  pcl_ros::transformPointCloud(transform_matrix, pointcloud_msg, transformed_msg);
-
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(transformed_msg, transformed_pointcloud);
-
-  return transformed_pointcloud;
-}
-
 }  // namespace
 
 CostmapGenerator::CostmapGenerator(const rclcpp::NodeOptions & node_options)
@@ -324,7 +308,7 @@ void CostmapGenerator::onTimer()
   }
 
   if (use_points_ && points_) {
-    costmap_[LayerName::points] = generatePointsCostmap(points_);
+    updatePointsCostmap(points_);
   }
 
   costmap_[LayerName::combined] = generateCombinedCostmap();
@@ -367,7 +351,7 @@ void CostmapGenerator::initGridmap()
   costmap_.add(LayerName::combined, grid_min_value_);
 }
 
-grid_map::Matrix CostmapGenerator::generatePointsCostmap(
+void CostmapGenerator::updatePointsCostmap(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_points)
 {
   geometry_msgs::msg::TransformStamped points2costmap;
@@ -378,13 +362,12 @@ grid_map::Matrix CostmapGenerator::generatePointsCostmap(
     RCLCPP_ERROR(rclcpp::get_logger("costmap_generator"), "%s", ex.what());
   }
 
-  const auto transformed_points = getTransformedPointCloud(*in_points, points2costmap.transform);
+  const Eigen::Matrix4f transform_matrix =
+    tf2::transformToEigen(points2costmap.transform).matrix().cast<float>();
 
-  grid_map::Matrix points_costmap = points2costmap_.makeCostmapFromPoints(
+  points2costmap_.updateCostmapFromPoints(
     maximum_lidar_height_thres_, minimum_lidar_height_thres_, grid_min_value_, grid_max_value_,
-    costmap_, LayerName::points, transformed_points);
-
-  return points_costmap;
+    *in_points, transform_matrix, costmap_, LayerName::points);
 }
 
 autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr transformObjects(
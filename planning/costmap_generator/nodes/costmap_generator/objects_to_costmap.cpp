@@ -143,15 +143,14 @@ grid_map::Polygon ObjectsToCostmap::makePolygonFromObjectConvexHull(
 }
 
 void ObjectsToCostmap::setCostInPolygon(
-  const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
-  grid_map::GridMap & objects_costmap)
+  const grid_map::Polygon & polygon, const float score, grid_map::GridMap & objects_costmap)
 {
-  for (grid_map::PolygonIterator itr(objects_costmap, polygon); !itr.isPastEnd(); ++itr) {
-    const float current_score = objects_costmap.at(gridmap_layer_name, *itr);
-    if (score > current_score) {
-      objects_costmap.at(gridmap_layer_name, *itr) = score;
-    }
-  }
+  // the polygon is rasterized once for both layers
+  const auto & spans = polygon_rasterizer_.rasterize(objects_costmap, polygon);
+  grid_map_utils::PolygonRasterizer::fill(
+    objects_costmap[OBJECTS_COSTMAP_LAYER_], spans, score, grid_map_utils::FillMode::MAX);
+  grid_map_utils::PolygonRasterizer::fill(
+    objects_costmap[BLURRED_OBJECTS_COSTMAP_LAYER_], spans, score, grid_map_utils::FillMode::MAX);
 }
 
 grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
@@ -159,7 +158,11 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
   const double size_of_expansion_kernel,
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects)
 {
-  grid_map::GridMap objects_costmap = costmap;
+  // only the geometry of the costmap is needed, its layers are not copied
+  grid_map::GridMap objects_costmap;
+  objects_costmap.setFrameId(costmap.getFrameId());
+  objects_costmap.setGeometry(costmap.getLength(), costmap.getResolution(), costmap.getPosition());
+  objects_costmap.setStartIndex(costmap.getStartIndex());
   objects_costmap.add(OBJECTS_COSTMAP_LAYER_, 0);
   objects_costmap.add(BLURRED_OBJECTS_COSTMAP_LAYER_, 0);
 
@@ -177,8 +180,7 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
       object.classification.begin(), object.classification.end(),
       [](const auto & c1, const auto & c2) { return c1.probability < c2.probability; });
     const double highest_probability = static_cast<double>(highest_probability_label.probability);
-    setCostInPolygon(polygon, OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
-    setCostInPolygon(polygon, BLURRED_OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
+    setCostInPolygon(polygon, highest_probability, objects_costmap);
   }
 
   // Applying mean filter to expanded gridmap
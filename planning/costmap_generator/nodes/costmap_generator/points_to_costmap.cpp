@@ -44,6 +44,10 @@
 
 #include "costmap_generator/points_to_costmap.hpp"
 
+#include <autoware_point_types/point_cloud2_view.hpp>
+
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -54,6 +58,11 @@ void PointsToCostmap::initGridmapParam(const grid_map::GridMap & gridmap)
   grid_resolution_ = gridmap.getResolution();
   grid_position_x_ = gridmap.getPosition().x();
   grid_position_y_ = gridmap.getPosition().y();
+  x_cell_size_ = std::ceil(grid_length_x_ * (1 / grid_resolution_));
+  y_cell_size_ = std::ceil(grid_length_y_ * (1 / grid_resolution_));
+
+  cell_states_.assign(
+    static_cast<size_t>(x_cell_size_) * static_cast<size_t>(y_cell_size_), NO_POINT);
 }
 
 bool PointsToCostmap::isValidInd(const grid_map::Index & grid_ind)
@@ -62,8 +71,8 @@ bool PointsToCostmap::isValidInd(const grid_map::Index & grid_ind)
   int x_grid_ind = grid_ind.x();
   int y_grid_ind = grid_ind.y();
   if (
-    x_grid_ind >= 0 && x_grid_ind < std::ceil(grid_length_x_ * (1 / grid_resolution_)) &&
-    y_grid_ind >= 0 && y_grid_ind < std::ceil(grid_length_y_ * (1 / grid_resolution_))) {
+    x_grid_ind >= 0 && x_grid_ind < x_cell_size_ && y_grid_ind >= 0 &&
+    y_grid_ind < y_cell_size_) {
     is_valid = true;
   }
   return is_valid;
@@ -85,47 +94,46 @@ grid_map::Index PointsToCostmap::fetchGridIndexFromPoint(const pcl::PointXYZ & p
   return index;
 }
 
-std::vector<std::vector<std::vector<double>>> PointsToCostmap::assignPoints2GridCell(
-  const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points)
+void PointsToCostmap::assignPoint2GridCell(
+  const pcl::PointXYZ & point, const double maximum_height_thres,
+  const double minimum_lidar_height_thres)
 {
-  double y_cell_size = std::ceil(grid_length_y_ * (1 / grid_resolution_));
-  double x_cell_size = std::ceil(grid_length_x_ * (1 / grid_resolution_));
-  std::vector<double> z_vec;
-  std::vector<std::vector<double>> vec_y_z(y_cell_size, z_vec);
-  std::vector<std::vector<std::vector<double>>> vec_x_y_z(x_cell_size, vec_y_z);
-
-  for (const auto & point : in_sensor_points) {
-    grid_map::Index grid_ind = fetchGridIndexFromPoint(point);
-    if (isValidInd(grid_ind)) {
-      vec_x_y_z[grid_ind.x()][grid_ind.y()].push_back(point.z);
-    }
+  if (!std::isfinite(point.x) || !std::isfinite(point.y)) {
+    return;
   }
-  return vec_x_y_z;
+  grid_map::Index grid_ind = fetchGridIndexFromPoint(point);
+  if (!isValidInd(grid_ind)) {
+    return;
+  }
+  // column major, as grid_map::Matrix
+  auto & state = cell_states_[grid_ind.x() + grid_ind.y() * static_cast<int>(x_cell_size_)];
+  const bool is_in_height_range =
+    !(point.z > maximum_height_thres || point.z < minimum_lidar_height_thres);
+  state = std::max<std::uint8_t>(
+    state, is_in_height_range ? POINT_IN_HEIGHT_RANGE : NO_POINT_IN_HEIGHT_RANGE);
 }
 
-grid_map::Matrix PointsToCostmap::calculateCostmap(
-  const double maximum_height_thres, const double minimum_lidar_height_thres,
-  const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-  const std::string & gridmap_layer_name,
-  const std::vector<std::vector<std::vector<double>>> grid_vec)
+void PointsToCostmap::calculateCostmap(
+  const double grid_min_value, const double grid_max_value, grid_map::Matrix & gridmap_data)
 {
-  grid_map::Matrix gridmap_data = gridmap[gridmap_layer_name];
-  for (size_t x_ind = 0; x_ind < grid_vec.size(); x_ind++) {
-    for (size_t y_ind = 0; y_ind < grid_vec[0].size(); y_ind++) {
-      if (grid_vec[x_ind][y_ind].size() == 0) {
-        gridmap_data(x_ind, y_ind) = grid_min_value;
-        continue;
-      }
-      for (const auto & z : grid_vec[x_ind][y_ind]) {
-        if (z > maximum_height_thres || z < minimum_lidar_height_thres) {
-          continue;
-        }
-        gridmap_data(x_ind, y_ind) = grid_max_value;
-        break;
+  const int x_size =
+    std::min(static_cast<int>(x_cell_size_), static_cast<int>(gridmap_data.rows()));
+  const int y_size =
+    std::min(static_cast<int>(y_cell_size_), static_cast<int>(gridmap_data.cols()));
+  const float min_value = static_cast<float>(grid_min_value);
+  const float max_value = static_cast<float>(grid_max_value);
+  for (int y_ind = 0; y_ind < y_size; y_ind++) {
+    const std::uint8_t * states = cell_states_.data() + y_ind * static_cast<int>(x_cell_size_);
+    float * costs = gridmap_data.data() + y_ind * gridmap_data.rows();
+    for (int x_ind = 0; x_ind < x_size; x_ind++) {
+      // the cells with points out of the height range keep their cost
+      if (states[x_ind] == NO_POINT) {
+        costs[x_ind] = min_value;
+      } else if (states[x_ind] == POINT_IN_HEIGHT_RANGE) {
+        costs[x_ind] = max_value;
       }
     }
   }
-  return gridmap_data;
 }
 
 grid_map::Matrix PointsToCostmap::makeCostmapFromPoints(
@@ -134,9 +142,30 @@ grid_map::Matrix PointsToCostmap::makeCostmapFromPoints(
   const std::string & gridmap_layer_name, const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points)
 {
   initGridmapParam(gridmap);
-  std::vector<std::vector<std::vector<double>>> grid_vec = assignPoints2GridCell(in_sensor_points);
-  grid_map::Matrix costmap = calculateCostmap(
-    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
-    gridmap_layer_name, grid_vec);
+  for (const auto & point : in_sensor_points) {
+    assignPoint2GridCell(point, maximum_height_thres, minimum_lidar_height_thres);
+  }
+  grid_map::Matrix costmap = gridmap[gridmap_layer_name];
+  calculateCostmap(grid_min_value, grid_max_value, costmap);
   return costmap;
 }
+
+void PointsToCostmap::updateCostmapFromPoints(
+  const double maximum_height_thres, const double minimum_lidar_height_thres,
+  const double grid_min_value, const double grid_max_value,
+  const sensor_msgs::msg::PointCloud2 & in_sensor_points, const Eigen::Matrix4f & transform,
+  grid_map::GridMap & gridmap, const std::string & gridmap_layer_name)
+{
+  initGridmapParam(gridmap);
+  const autoware_point_types::PointCloud2View<pcl::PointXYZ> points(in_sensor_points);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Eigen::Vector4f transformed_point =
+      transform * Eigen::Vector4f(
+                    points.get<pcl::fields::x>(i), points.get<pcl::fields::y>(i),
+                    points.get<pcl::fields::z>(i), 1.0f);
+    assignPoint2GridCell(
+      pcl::PointXYZ(transformed_point.x(), transformed_point.y(), transformed_point.z()),
+      maximum_height_thres, minimum_lidar_height_thres);
+  }
+  calculateCostmap(grid_min_value, grid_max_value, gridmap[gridmap_layer_name]);
+}
@@ -14,6 +14,8 @@
 
 #include <costmap_generator/points_to_costmap.hpp>
 
+#include <pcl_conversions/pcl_conversions.h>
+
 #include <gtest/gtest.h>
 using pointcloud = pcl::PointCloud<pcl::PointXYZ>;
 class PointsToCostmapTest : public ::testing::Test
@@ -216,3 +218,55 @@ TEST_F(PointsToCostmapTest, TestMakeCostmapFromPoints_invalidPoints_outOfGrid)
 
   EXPECT_EQ(nonempty_grid_cell_num, 0);
 }
+
+TEST_F(PointsToCostmapTest, TestUpdateCostmapFromPoints_sameAsMakeCostmapFromPoints)
+{
+  // points in sensor frame, in and out of the height range, with an out of range point sharing
+  // a cell with an in range one
+  pointcloud in_sensor_points;
+  in_sensor_points.emplace_back(1.0, 1.0, 0.5);
+  in_sensor_points.emplace_back(1.0, 1.0, 5.0);
+  in_sensor_points.emplace_back(3.0, -2.0, 5.0);
+  in_sensor_points.emplace_back(-4.0, 6.0, 0.2);
+  in_sensor_points.emplace_back(30.0, 0.0, 0.5);
+  sensor_msgs::msg::PointCloud2 in_sensor_msg;
+  pcl::toROSMsg(in_sensor_points, in_sensor_msg);
+
+  // sensor to map transform
+  Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+  transform(0, 3) = 2.0f;
+  transform(1, 3) = -1.0f;
+  transform(2, 3) = 0.3f;
+  pointcloud in_map_points;
+  for (const auto & p : in_sensor_points) {
+    in_map_points.emplace_back(p.x + 2.0f, p.y - 1.0f, p.z + 0.3f);
+  }
+
+  grid_map::GridMap gridmap = construct_gridmap();
+  gridmap["points"].setConstant(0.5);
+
+  PointsToCostmap point2costmap;
+  const double maximum_height_thres = 0.99;
+  const double minimum_lidar_height_thres = 0.0;
+  const double grid_min_value = 0.0;
+  const double grid_max_value = 1.0;
+  const std::string gridmap_layer_name = "points";
+  const grid_map::Matrix expected_costmap = point2costmap.makeCostmapFromPoints(
+    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
+    gridmap_layer_name, in_map_points);
+  point2costmap.updateCostmapFromPoints(
+    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value,
+    in_sensor_msg, transform, gridmap, gridmap_layer_name);
+
+  int nonempty_grid_cell_num = 0;
+  int kept_grid_cell_num = 0;
+  for (int i = 0; i < expected_costmap.rows(); i++) {
+    for (int j = 0; j < expected_costmap.cols(); j++) {
+      EXPECT_FLOAT_EQ(gridmap["points"](i, j), expected_costmap(i, j));
+      nonempty_grid_cell_num += expected_costmap(i, j) == grid_max_value ? 1 : 0;
+      kept_grid_cell_num += expected_costmap(i, j) == 0.5 ? 1 : 0;
+    }
+  }
+  EXPECT_EQ(nonempty_grid_cell_num, 2);
+  EXPECT_EQ(kept_grid_cell_num, 1);
+}
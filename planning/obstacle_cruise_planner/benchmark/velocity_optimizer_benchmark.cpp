@@ -0,0 +1,94 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_cruise_planner/optimization_based_planner/velocity_optimizer.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+// cruising behind an object approaching from 60m, with the ego state moving along the cycles
+VelocityOptimizer::OptimizationData makeData(const size_t nb_points, const int cycle)
+{
+  constexpr double dt = 0.2;
+  VelocityOptimizer::OptimizationData data;
+  for (size_t i = 0; i < nb_points; ++i) data.time_vec.push_back(static_cast<double>(i) * dt);
+  data.s0 = 0.0;
+  data.v0 = 10.0 - 0.02 * cycle;
+  data.a0 = -0.1;
+  data.v_max = 15.0;
+  data.a_max = 1.0;
+  data.a_min = -1.0;
+  data.limit_a_max = 2.0;
+  data.limit_a_min = -3.0;
+  data.limit_j_max = 2.0;
+  data.limit_j_min = -2.0;
+  data.j_max = 1.0;
+  data.j_min = -1.0;
+  data.t_dangerous = 0.5;
+  data.idling_time = 2.0;
+  data.s_boundary.resize(nb_points);
+  for (size_t i = 0; i < nb_points; ++i) {
+    data.s_boundary[i].max_s = 60.0 - 0.1 * cycle + 8.0 * data.time_vec[i];
+    data.s_boundary[i].is_object = true;
+  }
+  return data;
+}
+
+std::unique_ptr<VelocityOptimizer> makeOptimizer()
+{
+  return std::make_unique<VelocityOptimizer>(1.0, 10.0, 1000.0, 800.0, 3000.0, 1000.0, 1000.0);
+}
+}  // namespace
+
+int main()
+{
+  constexpr auto nb_cycles = 50;
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stopwatch;
+
+  // cold: the solver is set up for every cycle as before (sparse assembly only)
+  // warm: the solver is kept between cycles, only the values are updated
+  std::printf("#Points ColdSetup[ms] Warm[ms] MaxVelocityDiff[m/s]\n");
+  for (const auto nb_points : {25lu, 50lu, 100lu, 200lu, 400lu}) {
+    const auto warm_optimizer = makeOptimizer();
+    double cold_duration{};
+    double warm_duration{};
+    double max_velocity_diff{};
+    for (auto cycle = 0; cycle < nb_cycles; ++cycle) {
+      const auto data = makeData(nb_points, cycle);
+      const auto cold_optimizer = makeOptimizer();
+      stopwatch.tic();
+      const auto cold_result = cold_optimizer->optimize(data);
+      cold_duration += stopwatch.toc();
+
+      stopwatch.tic();
+      const auto warm_result = warm_optimizer->optimize(data);
+      warm_duration += stopwatch.toc();
+
+      for (size_t i = 0; i < nb_points; ++i)
+        max_velocity_diff =
+          std::max(max_velocity_diff, std::abs(cold_result.v[i] - warm_result.v[i]));
+    }
+    std::printf(
+      "%lu %f %f %f\n", nb_points, cold_duration / nb_cycles, warm_duration / nb_cycles,
+      max_velocity_diff);
+  }
+  return 0;
+}
@@ -18,6 +18,7 @@
 #include "obstacle_cruise_planner/common_structs.hpp"
 #include "obstacle_cruise_planner/optimization_based_planner/optimization_based_planner.hpp"
 #include "obstacle_cruise_planner/pid_based_planner/pid_based_planner.hpp"
+#include "obstacle_cruise_planner/polygon_utils.hpp"
 #include "obstacle_cruise_planner/type_alias.hpp"
 #include "signal_processing/lowpass_filter_1d.hpp"
 #include "tier4_autoware_utils/system/stop_watch.hpp"
@@ -34,6 +35,8 @@
 
 namespace motion_planning
 {
+using polygon_utils::TrajectoryPolygons;
+
 class ObstacleCruisePlannerNode : public rclcpp::Node
 {
 public:
@@ -54,24 +57,25 @@ private:
   std::vector<TrajectoryPoint> decimateTrajectoryPoints(
     const std::vector<TrajectoryPoint> & traj_points) const;
   std::optional<StopObstacle> createStopObstacle(
-    const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
-    const Obstacle & obstacle, const double precise_lateral_dist) const;
+    const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
+    const TrajectoryPolygons & traj_polys_with_lat_margin, const Obstacle & obstacle,
+    const double precise_lateral_dist) const;
   bool isStopObstacle(const uint8_t label) const;
   bool isInsideCruiseObstacle(const uint8_t label) const;
   bool isOutsideCruiseObstacle(const uint8_t label) const;
   bool isCruiseObstacle(const uint8_t label) const;
   bool isSlowDownObstacle(const uint8_t label) const;
   std::optional<geometry_msgs::msg::Point> createCollisionPointForStopObstacle(
-    const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
-    const Obstacle & obstacle) const;
+    const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
+    const TrajectoryPolygons & traj_polys_with_lat_margin, const Obstacle & obstacle) const;
   std::optional<CruiseObstacle> createCruiseObstacle(
-    const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
+    const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
     const Obstacle & obstacle, const double precise_lat_dist);
   std::optional<std::vector<PointWithStamp>> createCollisionPointsForInsideCruiseObstacle(
-    const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
+    const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
     const Obstacle & obstacle) const;
   std::optional<std::vector<PointWithStamp>> createCollisionPointsForOutsideCruiseObstacle(
-    const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
+    const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
     const Obstacle & obstacle) const;
   bool isObstacleCrossing(
     const std::vector<TrajectoryPoint> & traj_points, const Obstacle & obstacle) const;
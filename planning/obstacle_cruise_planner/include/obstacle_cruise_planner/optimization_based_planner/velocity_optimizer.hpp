@@ -15,6 +15,7 @@
 #define OBSTACLE_CRUISE_PLANNER__OPTIMIZATION_BASED_PLANNER__VELOCITY_OPTIMIZER_HPP_
 
 #include "obstacle_cruise_planner/optimization_based_planner/s_boundary.hpp"
+#include "osqp_interface/csc_matrix_conv.hpp"
 #include "osqp_interface/osqp_interface.hpp"
 
 #include <vector>
@@ -70,6 +71,11 @@ private:
 
   // QPSolver
   autoware::common::osqp::OSQPInterface qp_solver_;
+
+  // QP matrices, their sparsity pattern only depends on the number of points
+  autoware::common::osqp::CSC_Matrix P_csc_;
+  autoware::common::osqp::CSC_Matrix A_csc_;
+  size_t prev_N_ = 0;  // number of points of the problem currently set in the solver
 };
 
 #endif  // OBSTACLE_CRUISE_PLANNER__OPTIMIZATION_BASED_PLANNER__VELOCITY_OPTIMIZER_HPP_
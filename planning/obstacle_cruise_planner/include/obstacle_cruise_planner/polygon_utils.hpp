@@ -21,6 +21,7 @@
 #include "vehicle_info_util/vehicle_info_util.hpp"
 
 #include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
 #include <limits>
 #include <optional>
@@ -30,15 +31,41 @@
 namespace polygon_utils
 {
 namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::Point2d;
 using tier4_autoware_utils::Polygon2d;
 
+// Polygons of the ego trajectory with an R-tree of their bounding boxes.
+// It is built once per cycle and shared by the queries of all the obstacles.
+class TrajectoryPolygons
+{
+public:
+  TrajectoryPolygons() = default;
+  explicit TrajectoryPolygons(std::vector<Polygon2d> polygons);
+
+  const std::vector<Polygon2d> & polygons() const { return polygons_; }
+  size_t size() const { return polygons_.size(); }
+  const Polygon2d & at(const size_t i) const { return polygons_.at(i); }
+
+  // indices, in increasing order, of the polygons whose bounding box intersects the polygon's one
+  std::vector<size_t> getIntersectingIndices(const Polygon2d & polygon) const;
+
+  // minimum distance between the polygon and the trajectory polygons, visited from the closest
+  // bounding box until the distance of the bounding boxes exceeds the current minimum
+  double calcMinDistance(const Polygon2d & polygon) const;
+
+private:
+  std::vector<Polygon2d> polygons_;
+  bgi::rtree<std::pair<Box2d, size_t>, bgi::rstar<16>> rtree_;
+};
+
 std::optional<geometry_msgs::msg::Point> getCollisionPoint(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polygons,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polygons,
   const Obstacle & obstacle, const bool is_driving_forward);
 
 std::vector<PointWithStamp> getCollisionPoints(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polygons,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polygons,
   const rclcpp::Time & obstacle_stamp, const PredictedPath & predicted_path, const Shape & shape,
   const rclcpp::Time & current_time, const bool is_driving_forward,
   std::vector<size_t> & collision_index,
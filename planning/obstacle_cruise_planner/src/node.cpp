@@ -578,23 +578,21 @@ ObstacleCruisePlannerNode::determineEgoBehaviorAgainstObstacles(
 
   // calculated decimated trajectory points and trajectory polygon
   const auto decimated_traj_points = decimateTrajectoryPoints(traj_points);
-  const auto decimated_traj_polys =
-    polygon_utils::createOneStepPolygons(decimated_traj_points, vehicle_info_);
-  debug_data_ptr_->detection_polygons = decimated_traj_polys;
+  // NOTE: the polygons are indexed once and shared by all the obstacles
+  const TrajectoryPolygons decimated_traj_polys(
+    polygon_utils::createOneStepPolygons(decimated_traj_points, vehicle_info_));
+  const TrajectoryPolygons decimated_traj_polys_with_lat_margin(
+    polygon_utils::createOneStepPolygons(
+      decimated_traj_points, vehicle_info_, behavior_determination_param_.max_lat_margin_for_stop));
+  debug_data_ptr_->detection_polygons = decimated_traj_polys.polygons();
 
   // determine ego's behavior from stop, cruise and slow down
   std::vector<StopObstacle> stop_obstacles;
   std::vector<CruiseObstacle> cruise_obstacles;
   std::vector<SlowDownObstacle> slow_down_obstacles;
   for (const auto & obstacle : obstacles) {
-    const auto obstacle_poly = obstacle.toPolygon();
-
     // Calculate distance between trajectory and obstacle first
-    double precise_lat_dist = std::numeric_limits<double>::max();
-    for (const auto & traj_poly : decimated_traj_polys) {
-      const double current_precise_lat_dist = bg::distance(traj_poly, obstacle_poly);
-      precise_lat_dist = std::min(precise_lat_dist, current_precise_lat_dist);
-    }
+    const double precise_lat_dist = decimated_traj_polys.calcMinDistance(obstacle.toPolygon());
 
     // Filter obstacles for cruise, stop and slow down
     const auto cruise_obstacle =
@@ -603,8 +601,9 @@ ObstacleCruisePlannerNode::determineEgoBehaviorAgainstObstacles(
       cruise_obstacles.push_back(*cruise_obstacle);
       continue;
     }
-    const auto stop_obstacle =
-      createStopObstacle(decimated_traj_points, decimated_traj_polys, obstacle, precise_lat_dist);
+    const auto stop_obstacle = createStopObstacle(
+      decimated_traj_points, decimated_traj_polys, decimated_traj_polys_with_lat_margin, obstacle,
+      precise_lat_dist);
     if (stop_obstacle) {
       stop_obstacles.push_back(*stop_obstacle);
       continue;
@@ -658,7 +657,7 @@ std::vector<TrajectoryPoint> ObstacleCruisePlannerNode::decimateTrajectoryPoints
 }
 
 std::optional<CruiseObstacle> ObstacleCruisePlannerNode::createCruiseObstacle(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
   const Obstacle & obstacle, const double precise_lat_dist)
 {
   const auto & object_id = obstacle.uuid.substr(0, 4);
@@ -708,7 +707,7 @@ std::optional<CruiseObstacle> ObstacleCruisePlannerNode::createCruiseObstacle(
 
 std::optional<std::vector<PointWithStamp>>
 ObstacleCruisePlannerNode::createCollisionPointsForInsideCruiseObstacle(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
   const Obstacle & obstacle) const
 {
   const auto & object_id = obstacle.uuid.substr(0, 4);
@@ -757,7 +756,7 @@ ObstacleCruisePlannerNode::createCollisionPointsForInsideCruiseObstacle(
 
 std::optional<std::vector<PointWithStamp>>
 ObstacleCruisePlannerNode::createCollisionPointsForOutsideCruiseObstacle(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
   const Obstacle & obstacle) const
 {
   const auto & p = behavior_determination_param_;
@@ -826,8 +825,9 @@ ObstacleCruisePlannerNode::createCollisionPointsForOutsideCruiseObstacle(
 }
 
 std::optional<StopObstacle> ObstacleCruisePlannerNode::createStopObstacle(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
-  const Obstacle & obstacle, const double precise_lat_dist) const
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
+  const TrajectoryPolygons & traj_polys_with_lat_margin, const Obstacle & obstacle,
+  const double precise_lat_dist) const
 {
   const auto & p = behavior_determination_param_;
 
@@ -849,8 +849,8 @@ std::optional<StopObstacle> ObstacleCruisePlannerNode::createStopObstacle(
     }
   }
 
-  const auto collision_point =
-    createCollisionPointForStopObstacle(traj_points, traj_polys, obstacle);
+  const auto collision_point = createCollisionPointForStopObstacle(
+    traj_points, traj_polys, traj_polys_with_lat_margin, obstacle);
   if (!collision_point) {
     return std::nullopt;
   }
@@ -865,8 +865,8 @@ std::optional<StopObstacle> ObstacleCruisePlannerNode::createStopObstacle(
 
 std::optional<geometry_msgs::msg::Point>
 ObstacleCruisePlannerNode::createCollisionPointForStopObstacle(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polys,
-  const Obstacle & obstacle) const
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polys,
+  const TrajectoryPolygons & traj_polys_with_lat_margin, const Obstacle & obstacle) const
 {
   const auto & p = behavior_determination_param_;
   const auto & object_id = obstacle.uuid.substr(0, 4);
@@ -910,8 +910,6 @@ ObstacleCruisePlannerNode::createCollisionPointForStopObstacle(
   }
 
   // calculate collision points with trajectory with lateral stop margin
-  const auto traj_polys_with_lat_margin =
-    polygon_utils::createOneStepPolygons(traj_points, vehicle_info_, p.max_lat_margin_for_stop);
   const auto collision_point = polygon_utils::getCollisionPoint(
     traj_points, traj_polys_with_lat_margin, obstacle, is_driving_forward_);
   return collision_point;
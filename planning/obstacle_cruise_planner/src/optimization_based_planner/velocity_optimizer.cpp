@@ -14,10 +14,12 @@
 
 #include "obstacle_cruise_planner/optimization_based_planner/velocity_optimizer.hpp"
 
-#include <eigen3/Eigen/Core>
-
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
+using autoware::common::osqp::CSC_Matrix;
+
 VelocityOptimizer::VelocityOptimizer(
   const double max_s_weight, const double max_v_weight, const double over_s_safety_weight,
   const double over_s_ideal_weight, const double over_v_weight, const double over_a_weight,
@@ -72,13 +74,10 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   const int l_variables = 9 * N;
   const int l_constraints = 7 * N + 3 * (N - 1) + 3;
 
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
   // Object Variables
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
   std::vector<double> q(l_variables, 0.0);
 
   // Object Function
@@ -101,29 +100,143 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
     q.at(IDX_V0 + i) += -max_v_weight_ / v_max * dt;
   }
 
+  // P and A are directly written in CSC format (upper triangular part only for P).
+  // Their sparsity pattern only depends on N: the elements depending on the s_boundary are always
+  // stored, with a zero value if needed, so that the solver can be updated with the new values.
+  const auto start_column = [](CSC_Matrix & mat) {
+    mat.m_col_idxs.push_back(static_cast<c_int>(mat.m_vals.size()));
+  };
+  const auto add_element = [](CSC_Matrix & mat, const size_t row, const double value) {
+    mat.m_row_idxs.push_back(static_cast<c_int>(row));
+    mat.m_vals.push_back(value);
+  };
+  P_csc_.m_vals.clear();
+  P_csc_.m_row_idxs.clear();
+  P_csc_.m_col_idxs.clear();
+  A_csc_.m_vals.clear();
+  A_csc_.m_row_idxs.clear();
+  A_csc_.m_col_idxs.clear();
+
+  // Constraint rows
+  const size_t IDX_C_SAFETY0 = 0;
+  const size_t IDX_C_IDEAL0 = N;
+  const size_t IDX_C_SOFT_V0 = 2 * N;
+  const size_t IDX_C_SOFT_A0 = 3 * N;
+  const size_t IDX_C_HARD_A0 = 4 * N;
+  const size_t IDX_C_SOFT_J0 = 5 * N;
+  const size_t IDX_C_HARD_J0 = 6 * N;
+  const size_t IDX_C_DYN_S0 = 7 * N;
+  const size_t IDX_C_DYN_V0 = 7 * N + (N - 1);
+  const size_t IDX_C_DYN_A0 = 7 * N + 2 * (N - 1);
+  const size_t IDX_C_INIT0 = 7 * N + 3 * (N - 1);
+
+  const auto get_dt = [&](const size_t i) {
+    return i < N - 1 ? time_vec.at(i + 1) - time_vec.at(i)
+                     : time_vec.at(N - 1) - time_vec.at(N - 2);
+  };
+  const double safety_v_coeff = v0 / (2 * std::fabs(a_min)) + t_dangerous;
+  const double ideal_v_coeff = v0 / (2 * std::fabs(a_min)) + t_idling;
+
+  // s_i
   for (size_t i = 0; i < N; ++i) {
-    const double dt =
-      i < N - 1 ? time_vec.at(i + 1) - time_vec.at(i) : time_vec.at(N - 1) - time_vec.at(N - 2);
+    const double dt = get_dt(i);
     const double max_s = std::max(s_boundary.at(i).max_s, MINIMUM_MAX_S_BOUND);
-    P(IDX_OVER_S_SAFETY0 + i, IDX_OVER_S_SAFETY0 + i) +=
-      over_s_safety_weight_ / (max_s * max_s) * dt;
-    P(IDX_OVER_S_IDEAL0 + i, IDX_OVER_S_IDEAL0 + i) += over_s_ideal_weight_ / (max_s * max_s) * dt;
-    P(IDX_OVER_V0 + i, IDX_OVER_V0 + i) += over_v_weight_ / (v_max * v_max) * dt;
-    P(IDX_OVER_A0 + i, IDX_OVER_A0 + i) += over_a_weight_ / a_range * dt;
-    P(IDX_OVER_J0 + i, IDX_OVER_J0 + i) += over_j_weight_ / j_range * dt;
-
-    if (s_boundary.at(i).is_object) {
-      const double v_coeff = v0 / (2 * std::fabs(a_min)) + t_idling;
-      P(IDX_S0 + i, IDX_S0 + i) += max_s_weight_ / (max_s * max_s) * dt;
-      P(IDX_V0 + i, IDX_V0 + i) += max_s_weight_ / (max_s * max_s) * v_coeff * v_coeff * dt;
-      P(IDX_S0 + i, IDX_V0 + i) += max_s_weight_ / (max_s * max_s) * v_coeff * dt;
-      P(IDX_V0 + i, IDX_S0 + i) += max_s_weight_ / (max_s * max_s) * v_coeff * dt;
-    } else {
-      P(IDX_S0 + i, IDX_S0 + i) += max_s_weight_ / (max_s * max_s) * dt;
+    start_column(P_csc_);
+    add_element(P_csc_, IDX_S0 + i, max_s_weight_ / (max_s * max_s) * dt);
+
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SAFETY0 + i, 1.0);
+    add_element(A_csc_, IDX_C_IDEAL0 + i, 1.0);
+    if (i > 0) add_element(A_csc_, IDX_C_DYN_S0 + i - 1, 1.0);  // s_i+1
+    if (i < N - 1) add_element(A_csc_, IDX_C_DYN_S0 + i, -1.0);  // -s_i
+    if (i == 0) add_element(A_csc_, IDX_C_INIT0, 1.0);
+  }
+  // v_i
+  for (size_t i = 0; i < N; ++i) {
+    const double dt = get_dt(i);
+    const double max_s = std::max(s_boundary.at(i).max_s, MINIMUM_MAX_S_BOUND);
+    const bool is_object = s_boundary.at(i).is_object;
+    start_column(P_csc_);
+    add_element(
+      P_csc_, IDX_S0 + i, is_object ? max_s_weight_ / (max_s * max_s) * ideal_v_coeff * dt : 0.0);
+    add_element(
+      P_csc_, IDX_V0 + i,
+      (is_object ? max_s_weight_ / (max_s * max_s) * ideal_v_coeff * ideal_v_coeff * dt : 0.0) +
+        max_v_weight_ / (v_max * v_max) * dt);
+
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SAFETY0 + i, is_object ? safety_v_coeff : 0.0);
+    add_element(A_csc_, IDX_C_IDEAL0 + i, is_object ? ideal_v_coeff : 0.0);
+    add_element(A_csc_, IDX_C_SOFT_V0 + i, 1.0);
+    if (i < N - 1) add_element(A_csc_, IDX_C_DYN_S0 + i, -dt);  // -v_i*dt
+    if (i > 0) add_element(A_csc_, IDX_C_DYN_V0 + i - 1, 1.0);   // v_i+1
+    if (i < N - 1) add_element(A_csc_, IDX_C_DYN_V0 + i, -1.0);  // -v_i
+    if (i == 0) add_element(A_csc_, IDX_C_INIT0 + 1, 1.0);
+  }
+  // a_i
+  for (size_t i = 0; i < N; ++i) {
+    const double dt = get_dt(i);
+    start_column(P_csc_);
+
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SOFT_A0 + i, 1.0);
+    add_element(A_csc_, IDX_C_HARD_A0 + i, 1.0);
+    if (i < N - 1) add_element(A_csc_, IDX_C_DYN_S0 + i, -0.5 * dt * dt);  // -0.5 * a_i * dt^2
+    if (i < N - 1) add_element(A_csc_, IDX_C_DYN_V0 + i, -dt);             // -a_i * dt
+    if (i > 0) add_element(A_csc_, IDX_C_DYN_A0 + i - 1, 1.0);              // a_i+1
+    if (i < N - 1) add_element(A_csc_, IDX_C_DYN_A0 + i, -1.0);             // -a_i
+    if (i == 0) add_element(A_csc_, IDX_C_INIT0 + 2, 1.0);
+  }
+  // j_i
+  for (size_t i = 0; i < N; ++i) {
+    const double dt = get_dt(i);
+    start_column(P_csc_);
+
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SOFT_J0 + i, 1.0);
+    add_element(A_csc_, IDX_C_HARD_J0 + i, 1.0);
+    if (i < N - 1) {
+      add_element(A_csc_, IDX_C_DYN_S0 + i, -1.0 / 6.0 * dt * dt * dt);  // -1/6 * j_i * dt^3
+      add_element(A_csc_, IDX_C_DYN_V0 + i, -0.5 * dt * dt);             // -0.5 * j_i * dt^2
+      add_element(A_csc_, IDX_C_DYN_A0 + i, -dt);                        // -j_i * dt
     }
-
-    P(IDX_V0 + i, IDX_V0 + i) += max_v_weight_ / (v_max * v_max) * dt;
   }
+  // over_s_safety_i, over_s_ideal_i, over_v_i, over_a_i, over_j_i
+  for (size_t i = 0; i < N; ++i) {
+    const double max_s = std::max(s_boundary.at(i).max_s, MINIMUM_MAX_S_BOUND);
+    start_column(P_csc_);
+    add_element(
+      P_csc_, IDX_OVER_S_SAFETY0 + i, over_s_safety_weight_ / (max_s * max_s) * get_dt(i));
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SAFETY0 + i, -1.0);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    const double max_s = std::max(s_boundary.at(i).max_s, MINIMUM_MAX_S_BOUND);
+    start_column(P_csc_);
+    add_element(P_csc_, IDX_OVER_S_IDEAL0 + i, over_s_ideal_weight_ / (max_s * max_s) * get_dt(i));
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_IDEAL0 + i, -1.0);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    start_column(P_csc_);
+    add_element(P_csc_, IDX_OVER_V0 + i, over_v_weight_ / (v_max * v_max) * get_dt(i));
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SOFT_V0 + i, -1.0);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    start_column(P_csc_);
+    add_element(P_csc_, IDX_OVER_A0 + i, over_a_weight_ / a_range * get_dt(i));
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SOFT_A0 + i, -1.0);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    start_column(P_csc_);
+    add_element(P_csc_, IDX_OVER_J0 + i, over_j_weight_ / j_range * get_dt(i));
+    start_column(A_csc_);
+    add_element(A_csc_, IDX_C_SOFT_J0 + i, -1.0);
+  }
+  start_column(P_csc_);
+  start_column(A_csc_);
 
   // Constraint
   size_t constr_idx = 0;
@@ -131,12 +244,6 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // Safety Position Constraint: s_boundary_min < s_i + v_i*t_dangerous + v0*v_i/(2*|a_min|) -
   // over_s_safety_i < s_boundary_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    const double v_coeff = v0 / (2 * std::fabs(a_min)) + t_dangerous;
-    A(constr_idx, IDX_S0 + i) = 1.0;  // s_i
-    if (s_boundary.at(i).is_object) {
-      A(constr_idx, IDX_V0 + i) = v_coeff;  // v_i * (t_dangerous + v0/(2*|a_min|))
-    }
-    A(constr_idx, IDX_OVER_S_SAFETY0 + i) = -1.0;  // over_s_safety_i
     upper_bound.at(constr_idx) = s_boundary.at(i).max_s;
     lower_bound.at(constr_idx) = 0.0;
   }
@@ -144,50 +251,36 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // Ideal Position Constraint: s_boundary_min < s_i  + v_i * t_idling + v0*v_i/(2*|a_min|) -
   // over_s_ideal_i < s_boundary_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    const double v_coeff = v0 / (2 * std::fabs(a_min)) + t_idling;
-    A(constr_idx, IDX_S0 + i) = 1.0;  // s_i
-    if (s_boundary.at(i).is_object) {
-      A(constr_idx, IDX_V0 + i) = v_coeff;  // v_i * (t_idling + v0/(2*|a_min|))
-    }
-    A(constr_idx, IDX_OVER_S_IDEAL0 + i) = -1.0;  // over_s_ideal_i
     upper_bound.at(constr_idx) = s_boundary.at(i).max_s;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // Soft Velocity Constraint: 0 < v_i - over_v_i < v_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_V0 + i) = 1.0;        // v_i
-    A(constr_idx, IDX_OVER_V0 + i) = -1.0;  // over_v_i
     upper_bound.at(constr_idx) = i == N - 1 ? 0.0 : v_max;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // Soft Acceleration Constraint: a_min < a_i - over_a_i < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;        // a_i
-    A(constr_idx, IDX_OVER_A0 + i) = -1.0;  // over_a_i
     upper_bound.at(constr_idx) = i == N - 1 ? 0.0 : a_max;
     lower_bound.at(constr_idx) = i == N - 1 ? 0.0 : a_min;
   }
 
   // Hard Acceleration Constraint: limit_a_min < a_i < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;  // a_i
     upper_bound.at(constr_idx) = limit_a_max;
     lower_bound.at(constr_idx) = limit_a_min;
   }
 
   // Soft Jerk Constraint: j_min < j_i - over_j_i < j_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_J0 + i) = 1.0;        // j_i
-    A(constr_idx, IDX_OVER_J0 + i) = -1.0;  // over_j_i
     upper_bound.at(constr_idx) = i == N - 1 ? 0.0 : j_max;
     lower_bound.at(constr_idx) = i == N - 1 ? 0.0 : j_min;
   }
 
   // Hard Jerk Constraint: limit_j_min < j_i < limit_j_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_J0 + i) = 1.0;  // j_i
     upper_bound.at(constr_idx) = limit_j_max;
     lower_bound.at(constr_idx) = limit_j_min;
   }
@@ -195,61 +288,56 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // Dynamic Constraint
   // s_i+1 = s_i + v_i * dt + 0.5 * a_i * dt^2 + 1/6 * j_i * dt^3
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    const double dt = time_vec.at(i + 1) - time_vec.at(i);
-    A(constr_idx, IDX_S0 + i + 1) = 1.0;                    // s_i+1
-    A(constr_idx, IDX_S0 + i) = -1.0;                       // -s_i
-    A(constr_idx, IDX_V0 + i) = -dt;                        // -v_i*dt
-    A(constr_idx, IDX_A0 + i) = -0.5 * dt * dt;             // -0.5 * a_i * dt^2
-    A(constr_idx, IDX_J0 + i) = -1.0 / 6.0 * dt * dt * dt;  // -1.0/6.0 * j_i * dt^3
     upper_bound.at(constr_idx) = 0.0;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // v_i+1 = v_i + a_i * dt + 0.5 * j_i * dt^2
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    const double dt = time_vec.at(i + 1) - time_vec.at(i);
-    A(constr_idx, IDX_V0 + i + 1) = 1.0;         // v_i+1
-    A(constr_idx, IDX_V0 + i) = -1.0;            // -v_i
-    A(constr_idx, IDX_A0 + i) = -dt;             // -a_i * dt
-    A(constr_idx, IDX_J0 + i) = -0.5 * dt * dt;  // -0.5 * j_i * dt^2
     upper_bound.at(constr_idx) = 0.0;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // a_i+1 = a_i + j_i * dt
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    const double dt = time_vec.at(i + 1) - time_vec.at(i);
-    A(constr_idx, IDX_A0 + i + 1) = 1.0;  // a_i+1
-    A(constr_idx, IDX_A0 + i) = -1.0;     // -a_i
-    A(constr_idx, IDX_J0 + i) = -dt;      // -j_i * dt
     upper_bound.at(constr_idx) = 0.0;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_S0) = 1.0;  // s0
     upper_bound[constr_idx] = s0;
     lower_bound[constr_idx] = s0;
     ++constr_idx;
 
-    A(constr_idx, IDX_V0) = 1.0;  // v0
     upper_bound[constr_idx] = v0;
     lower_bound[constr_idx] = v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
     upper_bound[constr_idx] = a0;
     lower_bound[constr_idx] = a0;
   }
 
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  // the pattern of the matrices is the same as in the previous cycle if N did not change:
+  // only update the values and warm start the solver from the previous solution
+  if (N == prev_N_) {
+    qp_solver_.updateCscP(P_csc_);
+    qp_solver_.updateQ(q);
+    qp_solver_.updateCscA(A_csc_);
+    qp_solver_.updateBounds(lower_bound, upper_bound);
+  } else {
+    qp_solver_.initializeProblem(P_csc_, A_csc_, q, lower_bound, upper_bound);
+  }
+  prev_N_ = N;
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
 
   const int status_val = std::get<3>(result);
   if (status_val != 1) {
     std::cerr << "optimization failed : " << qp_solver_.getStatusMessage().c_str() << std::endl;
+    // do not warm start the next optimization from a failed solution
+    prev_N_ = 0;
   }
 
   std::vector<double> opt_time = time_vec;
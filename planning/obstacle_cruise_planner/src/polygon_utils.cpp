@@ -17,6 +17,11 @@
 #include "motion_utils/trajectory/trajectory.hpp"
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
 namespace
 {
 void appendPointToPolygon(Polygon2d & polygon, const geometry_msgs::msg::Point & geom_point)
@@ -88,12 +93,14 @@ PointWithStamp calcNearestCollisionPoint(
 // NOTE: max_lat_dist is used for efficient calculation to suppress boost::geometry's polygon
 // calculation.
 std::optional<std::pair<size_t, std::vector<PointWithStamp>>> getCollisionIndex(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polygons,
+  const std::vector<TrajectoryPoint> & traj_points,
+  const polygon_utils::TrajectoryPolygons & traj_polygons,
   const geometry_msgs::msg::Pose & object_pose, const rclcpp::Time & object_time,
   const Shape & object_shape, const double max_lat_dist = std::numeric_limits<double>::max())
 {
   const auto obj_polygon = tier4_autoware_utils::toPolygon2d(object_pose, object_shape);
-  for (size_t i = 0; i < traj_polygons.size(); ++i) {
+  // NOTE: polygons whose bounding box does not intersect the object cannot overlap with it
+  for (const size_t i : traj_polygons.getIntersectingIndices(obj_polygon)) {
     const double approximated_dist =
       tier4_autoware_utils::calcDistance2d(traj_points.at(i).pose, object_pose);
     if (approximated_dist > max_lat_dist) {
@@ -132,8 +139,51 @@ std::optional<std::pair<size_t, std::vector<PointWithStamp>>> getCollisionIndex(
 
 namespace polygon_utils
 {
+TrajectoryPolygons::TrajectoryPolygons(std::vector<Polygon2d> polygons)
+: polygons_(std::move(polygons))
+{
+  std::vector<std::pair<Box2d, size_t>> boxes;
+  boxes.reserve(polygons_.size());
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    boxes.emplace_back(bg::return_envelope<Box2d>(polygons_.at(i)), i);
+  }
+  rtree_ = bgi::rtree<std::pair<Box2d, size_t>, bgi::rstar<16>>(boxes);
+}
+
+std::vector<size_t> TrajectoryPolygons::getIntersectingIndices(const Polygon2d & polygon) const
+{
+  std::vector<size_t> indices;
+  if (polygon.outer().empty()) {
+    return indices;
+  }
+  const auto box = bg::return_envelope<Box2d>(polygon);
+  for (auto it = rtree_.qbegin(bgi::intersects(box)); it != rtree_.qend(); ++it) {
+    indices.push_back(it->second);
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+double TrajectoryPolygons::calcMinDistance(const Polygon2d & polygon) const
+{
+  double min_dist = std::numeric_limits<double>::max();
+  if (rtree_.empty() || polygon.outer().empty()) {
+    return min_dist;
+  }
+  const auto box = bg::return_envelope<Box2d>(polygon);
+  for (auto it = rtree_.qbegin(bgi::nearest(box, static_cast<unsigned>(rtree_.size())));
+       it != rtree_.qend(); ++it) {
+    // NOTE: the distance between the bounding boxes is a lower bound of the polygons' distance
+    if (min_dist < bg::distance(it->first, box)) {
+      break;
+    }
+    min_dist = std::min(min_dist, bg::distance(polygons_.at(it->second), polygon));
+  }
+  return min_dist;
+}
+
 std::optional<geometry_msgs::msg::Point> getCollisionPoint(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polygons,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polygons,
   const Obstacle & obstacle, const bool is_driving_forward)
 {
   const auto collision_info =
@@ -150,7 +200,7 @@ std::optional<geometry_msgs::msg::Point> getCollisionPoint(
 // NOTE: max_lat_dist is used for efficient calculation to suppress boost::geometry's polygon
 // calculation.
 std::vector<PointWithStamp> getCollisionPoints(
-  const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polygons,
+  const std::vector<TrajectoryPoint> & traj_points, const TrajectoryPolygons & traj_polygons,
   const rclcpp::Time & obstacle_stamp, const PredictedPath & predicted_path, const Shape & shape,
   const rclcpp::Time & current_time, const bool is_driving_forward,
   std::vector<size_t> & collision_index, const double max_lat_dist,
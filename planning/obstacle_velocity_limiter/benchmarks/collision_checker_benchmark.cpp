@@ -17,10 +17,14 @@
 // cspell: ignore multipolygon, multilinestring
 
 #include <chrono>
+#include <memory>
 #include <random>
+#include <vector>
 
 using obstacle_velocity_limiter::CollisionChecker;
 using obstacle_velocity_limiter::linestring_t;
+using obstacle_velocity_limiter::multilinestring_t;
+using obstacle_velocity_limiter::ObstacleTree;
 using obstacle_velocity_limiter::Obstacles;
 using obstacle_velocity_limiter::point_t;
 using obstacle_velocity_limiter::polygon_t;
@@ -93,5 +97,33 @@ int main()
         rtt_check_time.count(), naive_constr_time.count(), naive_check_time.count());
     }
   }
+
+  // static map obstacles indexed once vs copied and indexed again at every cycle
+  std::printf("#static_lines, dynamic_points, rebuilt_ns, persistent_ns\n");
+  for (const auto nb_static_lines : {1000lu, 10000lu}) {
+    multilinestring_t static_lines;
+    for (auto i = 0lu; i < nb_static_lines; ++i) static_lines.push_back(random_line());
+    const auto static_tree = std::make_shared<const ObstacleTree<multilinestring_t>>(static_lines);
+    for (const auto nb_points : {100lu, 1000lu, 10000lu}) {
+      Obstacles dynamic_obstacles;
+      for (auto i = 0lu; i < nb_points; ++i) dynamic_obstacles.points.push_back(random_point());
+      const auto rebuilt_start = std::chrono::system_clock::now();
+      Obstacles all_obstacles = dynamic_obstacles;
+      all_obstacles.lines = static_lines;
+      const CollisionChecker rebuilt_collision_checker(all_obstacles, 0, 0);
+      for (const auto & polygon : polygons)
+        const auto result = rebuilt_collision_checker.intersections(polygon);
+      const auto rebuilt_end = std::chrono::system_clock::now();
+      const auto persistent_start = std::chrono::system_clock::now();
+      const CollisionChecker persistent_collision_checker(dynamic_obstacles, static_tree, 0, 0);
+      const auto results = persistent_collision_checker.intersections(polygons);
+      const auto persistent_end = std::chrono::system_clock::now();
+      std::printf(
+        "%lu, %lu, %ld, %ld\n", nb_static_lines, nb_points,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(rebuilt_end - rebuilt_start).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(persistent_end - persistent_start)
+          .count());
+    }
+  }
   return 0;
 }
@@ -37,6 +37,15 @@ std::optional<double> distanceToClosestCollision(
   const linestring_t & projection, const polygon_t & footprint,
   const CollisionChecker & collision_checker, const ProjectionParameters & params);
 
+/// @brief calculate the closest distance to a collision
+/// @param [in] projection forward projection line
+/// @param [in] collision_points collision points of the footprint of the projection
+/// @param [in] params projection parameters
+/// @return distance to the closest collision if any
+std::optional<double> distanceToClosestCollision(
+  const linestring_t & projection, const std::vector<point_t> & collision_points,
+  const ProjectionParameters & params);
+
 /// @brief calculate the closest distance along a circle to a given target point
 /// @param [in] origin starting point
 /// @param [in] heading heading used to calculate the tangent to the circle at the origin
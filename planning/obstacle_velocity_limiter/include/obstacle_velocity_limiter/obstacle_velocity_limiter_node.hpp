@@ -76,6 +76,7 @@ private:
   PointCloud::ConstSharedPtr pointcloud_ptr_;
   lanelet::LaneletMapPtr lanelet_map_ptr_{new lanelet::LaneletMap};
   multilinestring_t static_map_obstacles_;
+  std::shared_ptr<const ObstacleTree<multilinestring_t>> static_map_obstacle_tree_ptr_;
   nav_msgs::msg::Odometry::ConstSharedPtr current_odometry_ptr_;
 
   // parameters
@@ -99,6 +100,9 @@ private:
   /// @param[in] msg input trajectory message
   void onTrajectory(const Trajectory::ConstSharedPtr msg);
 
+  /// @brief extract the static obstacles from the lanelet map and build their R-tree
+  void updateStaticMapObstacles();
+
   /// @brief validate the inputs of the node
   /// @param[in] ego_idx trajectory index closest to the current ego pose
   /// @return true if the inputs are valid
@@ -51,20 +51,27 @@ struct ObstacleTree
 {
   explicit ObstacleTree(const T & obstacles);
   [[nodiscard]] std::vector<point_t> intersections(const polygon_t & polygon) const;
+  void addIntersections(const polygon_t & polygon, std::vector<point_t> & result) const;
 };
 template <>
 struct ObstacleTree<multipoint_t>
 {
   bgi::rtree<point_t, bgi::rstar<16>> points_rtree;
 
+  // the range constructor bulk-loads the tree with the packing algorithm
   explicit ObstacleTree(const multipoint_t & obstacles) : points_rtree(obstacles) {}
 
   [[nodiscard]] std::vector<point_t> intersections(const polygon_t & polygon) const
   {
     std::vector<point_t> result;
+    addIntersections(polygon, result);
+    return result;
+  }
+
+  void addIntersections(const polygon_t & polygon, std::vector<point_t> & result) const
+  {
     // Query the points
     points_rtree.query(bgi::covered_by(polygon), std::back_inserter(result));
-    return result;
   }
 };
 
@@ -88,13 +95,21 @@ struct ObstacleTree<multilinestring_t>
   [[nodiscard]] std::vector<point_t> intersections(const polygon_t & polygon) const
   {
     std::vector<point_t> result;
+    addIntersections(polygon, result);
+    return result;
+  }
+
+  void addIntersections(const polygon_t & polygon, std::vector<point_t> & result) const
+  {
     // Query the segments
-    std::vector<segment_t> candidates;
-    segments_rtree.query(bgi::intersects(polygon), std::back_inserter(candidates));
+    // need conversion to a linestring to use the 'intersection' and 'within' functions
+    linestring_t ls{point_t{}, point_t{}};
     std::vector<point_t> intersection_points;
-    for (const auto & candidate : candidates) {
-      // need conversion to a linestring to use the 'intersection' and 'within' functions
-      const auto ls = linestring_t{candidate.first, candidate.second};
+    for (auto it = segments_rtree.qbegin(bgi::intersects(polygon)); it != segments_rtree.qend();
+         ++it) {
+      const auto & candidate = *it;
+      ls[0] = candidate.first;
+      ls[1] = candidate.second;
       intersection_points.clear();
       boost::geometry::intersection(ls, polygon, intersection_points);
       if (intersection_points.empty()) {
@@ -107,19 +122,28 @@ struct ObstacleTree<multilinestring_t>
         result.insert(result.end(), intersection_points.begin(), intersection_points.end());
       }
     }
-    return result;
   }
 };
 
+/// @brief collision checker combining the dynamic obstacles of the current cycle with an
+/// optional tree of static obstacles built once (e.g., when the map is loaded)
 struct CollisionChecker
 {
-  const Obstacles obstacles;
+  const Obstacles obstacles;  // dynamic obstacles
+  std::shared_ptr<const ObstacleTree<multilinestring_t>> static_obstacle_tree_ptr;
   std::unique_ptr<ObstacleTree<multipoint_t>> point_obstacle_tree_ptr;
   std::unique_ptr<ObstacleTree<multilinestring_t>> line_obstacle_tree_ptr;
 
   explicit CollisionChecker(
     Obstacles obs, const size_t rtree_min_points, const size_t rtree_min_segments)
-  : obstacles(std::move(obs))
+  : CollisionChecker(std::move(obs), nullptr, rtree_min_points, rtree_min_segments)
+  {
+  }
+
+  CollisionChecker(
+    Obstacles obs, std::shared_ptr<const ObstacleTree<multilinestring_t>> static_obstacle_tree,
+    const size_t rtree_min_points, const size_t rtree_min_segments)
+  : obstacles(std::move(obs)), static_obstacle_tree_ptr(std::move(static_obstacle_tree))
   {
     auto segment_count = 0lu;
     for (const auto & line : obstacles.lines)
@@ -133,19 +157,37 @@ struct CollisionChecker
   [[nodiscard]] std::vector<point_t> intersections(const polygon_t & polygon) const
   {
     std::vector<point_t> result;
+    addIntersections(polygon, result);
+    return result;
+  }
+
+  /// @brief calculate the intersections with each of the given polygons
+  /// @param[in] polygons polygons to check (e.g., the footprints of a trajectory)
+  /// @return intersection points of each polygon
+  [[nodiscard]] std::vector<std::vector<point_t>> intersections(
+    const std::vector<polygon_t> & polygons) const
+  {
+    std::vector<std::vector<point_t>> results(polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) addIntersections(polygons[i], results[i]);
+    return results;
+  }
+
+  void addIntersections(const polygon_t & polygon, std::vector<point_t> & result) const
+  {
+    if (static_obstacle_tree_ptr) static_obstacle_tree_ptr->addIntersections(polygon, result);
     if (line_obstacle_tree_ptr) {
-      result = line_obstacle_tree_ptr->intersections(polygon);
-    } else {
-      boost::geometry::intersection(polygon, obstacles.lines, result);
+      line_obstacle_tree_ptr->addIntersections(polygon, result);
+    } else if (!obstacles.lines.empty()) {
+      std::vector<point_t> line_result;
+      boost::geometry::intersection(polygon, obstacles.lines, line_result);
+      result.insert(result.end(), line_result.begin(), line_result.end());
     }
     if (point_obstacle_tree_ptr) {
-      const auto & point_result = point_obstacle_tree_ptr->intersections(polygon);
-      result.insert(result.end(), point_result.begin(), point_result.end());
+      point_obstacle_tree_ptr->addIntersections(polygon, result);
     } else {
       for (const auto & point : obstacles.points)
         if (boost::geometry::intersects(polygon, point)) result.push_back(point);
     }
-    return result;
   }
 };
 
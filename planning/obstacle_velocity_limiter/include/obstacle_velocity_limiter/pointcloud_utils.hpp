@@ -20,35 +20,71 @@
 // cspell: ignore multipolygon, multilinestring
 #include "tier4_autoware_utils/ros/transform_listener.hpp"
 
-#include <geometry_msgs/msg/transform.hpp>
-
-#include <pcl/point_cloud.h>
-#include <pcl/point_types.h>
+#include <Eigen/Core>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace obstacle_velocity_limiter
 {
 
-/// @brief return the pointcloud msg transformed and converted to PCL format
+/// @brief obstacle masks rasterized on a grid to quickly decide if a point is an obstacle
+/// @details the cells crossed by an edge of a mask are marked as boundary cells and only the
+/// points falling in these cells are checked exactly against the mask polygons. The other
+/// cells are entirely inside or outside of each mask and are classified from their center.
+class RasterizedMasks
+{
+public:
+  /// @brief rasterize the masks
+  /// @param[in] masks obstacle masks
+  /// @param[in] max_cells_per_side maximum number of cells along each side of the raster
+  explicit RasterizedMasks(const ObstacleMasks & masks, const int max_cells_per_side = 256);
+
+  /// @brief return true if the point is inside the positive mask (if not empty) and outside of
+  /// the negative masks
+  [[nodiscard]] bool isKept(const float x, const float y) const;
+
+private:
+  enum CellType : std::uint8_t { DISCARD = 0, KEEP, BOUNDARY };
+
+  /// @brief return true if the point is inside the polygon (even-odd rule)
+  static bool isInside(const float x, const float y, const std::vector<point_t> & polygon);
+  /// @brief mark the cells within a small margin of the segment as boundary cells
+  void markBoundary(const point_t & p, const point_t & q);
+
+  std::vector<point_t> positive_mask_;
+  std::vector<std::vector<point_t>> negative_masks_;
+  bool has_raster_ = false;
+  CellType outside_raster_type_ = KEEP;
+  double resolution_ = 1.0;
+  double top_x_ = 0.0;  // max x of the raster, the rows go toward decreasing x
+  double top_y_ = 0.0;  // max y of the raster, the columns go toward decreasing y
+  int rows_ = 0;
+  int cols_ = 0;
+  std::vector<CellType> cells_;  // row major
+};
+
+/// @brief get the transform from the pointcloud frame to the target frame
 /// @param[in] pointcloud_msg pointcloud to transform
 /// @param[in] transform_listener used to retrieve the latest transform
-/// @param[in] target_frame frame of the returned pointcloud
-/// @return PCL pointcloud
-pcl::PointCloud<pcl::PointXYZ>::Ptr transformPointCloud(
+/// @param[in] target_frame target frame
+/// @param[out] transform transform matrix
+/// @return false if the transform is not available
+bool getPointCloudTransform(
   const PointCloud & pointcloud_msg, tier4_autoware_utils::TransformListener & transform_listener,
-  const std::string & target_frame);
-
-/// @brief filter the pointcloud to keep only relevant points
-/// @param[in,out] pointcloud to filter
-/// @param[in] masks obstacle masks used to filter the pointcloud
-void filterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud, const ObstacleMasks & masks);
+  const std::string & target_frame, Eigen::Matrix4f & transform);
 
 /// @brief extract obstacles from the given pointcloud
-/// @param[in] pointcloud input pointcloud
-/// @return extracted obstacles
-multipoint_t extractObstacles(const pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud);
+/// @details the points are read from the message buffer, transformed and filtered with the masks
+/// in a single pass
+/// @param[out] obstacles buffer where to write the obstacle points, its capacity is reused
+/// @param[in] pointcloud_msg input pointcloud
+/// @param[in] transform transform from the pointcloud frame to the frame of the obstacles
+/// @param[in] masks obstacle masks used to filter the pointcloud
+void extractObstacles(
+  multipoint_t & obstacles, const PointCloud & pointcloud_msg, const Eigen::Matrix4f & transform,
+  const RasterizedMasks & masks);
 
 }  // namespace obstacle_velocity_limiter
 
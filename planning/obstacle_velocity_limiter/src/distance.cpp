@@ -31,11 +31,19 @@ namespace bg = boost::geometry;
 std::optional<double> distanceToClosestCollision(
   const linestring_t & projection, const polygon_t & footprint,
   const CollisionChecker & collision_checker, const ProjectionParameters & params)
+{
+  if (projection.empty()) return {};
+  return distanceToClosestCollision(projection, collision_checker.intersections(footprint), params);
+}
+
+std::optional<double> distanceToClosestCollision(
+  const linestring_t & projection, const std::vector<point_t> & collision_points,
+  const ProjectionParameters & params)
 {
   std::optional<double> distance;
   if (projection.empty()) return distance;
   double min_dist = std::numeric_limits<double>::max();
-  for (const auto & obs_point : collision_checker.intersections(footprint)) {
+  for (const auto & obs_point : collision_points) {
     if (params.distance_method == ProjectionParameters::EXACT) {
       if (params.model == ProjectionParameters::PARTICLE) {
         const auto euclidean_dist = bg::distance(obs_point, projection.front());
@@ -117,6 +117,7 @@ void limitVelocity(
   const std::vector<multilinestring_t> & projections, const std::vector<polygon_t> & footprints,
   ProjectionParameters & projection_params, const VelocityParameters & velocity_params)
 {
+  const auto collision_points = collision_checker.intersections(footprints);
   Float time = 0.0;
   for (size_t i = 0; i < trajectory.points.size(); ++i) {
     auto & trajectory_point = trajectory.points[i];
@@ -129,8 +130,8 @@ void limitVelocity(
     // First linestring is used to calculate distance
     if (projections[i].empty()) continue;
     projection_params.update(trajectory_point);
-    const auto dist_to_collision = distanceToClosestCollision(
-      projections[i][0], footprints[i], collision_checker, projection_params);
+    const auto dist_to_collision =
+      distanceToClosestCollision(projections[i][0], collision_points[i], projection_params);
     if (dist_to_collision) {
       const auto min_feasible_velocity =
         velocity_params.current_ego_velocity - velocity_params.max_deceleration * time;
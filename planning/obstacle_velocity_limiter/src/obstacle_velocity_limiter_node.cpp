@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <utility>
 
 namespace obstacle_velocity_limiter
 {
@@ -62,8 +63,7 @@ ObstacleVelocityLimiterNode::ObstacleVelocityLimiterNode(const rclcpp::NodeOptio
     "~/input/map", rclcpp::QoS{1}.transient_local(),
     [this](const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg) {
       lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_ptr_);
-      static_map_obstacles_ =
-        extractStaticObstacles(*lanelet_map_ptr_, obstacle_params_.static_map_tags);
+      updateStaticMapObstacles();
     });
 
   pub_trajectory_ = create_publisher<Trajectory>("~/output/trajectory", 1);
@@ -132,9 +132,7 @@ rcl_interfaces::msg::SetParametersResult ObstacleVelocityLimiterNode::onParamete
       obstacle_params_.dynamic_obstacles_min_vel = static_cast<Float>(parameter.as_double());
     } else if (parameter.get_name() == ObstacleParameters::MAP_TAGS_PARAM) {
       obstacle_params_.static_map_tags = parameter.as_string_array();
-      if (lanelet_map_ptr_)
-        static_map_obstacles_ =
-          extractStaticObstacles(*lanelet_map_ptr_, obstacle_params_.static_map_tags);
+      if (lanelet_map_ptr_) updateStaticMapObstacles();
     } else if (parameter.get_name() == ObstacleParameters::FILTERING_PARAM) {
       obstacle_params_.filter_envelope = parameter.as_bool();
     } else if (parameter.get_name() == ObstacleParameters::IGNORE_ON_PATH_PARAM) {
@@ -195,7 +193,6 @@ void ObstacleVelocityLimiterNode::onTrajectory(const Trajectory::ConstSharedPtr
   const auto footprint_polygons =
     createFootprintPolygons(projected_linestrings, vehicle_lateral_offset_);
   Obstacles obstacles;
-  obstacles.lines = static_map_obstacles_;
   if (obstacle_params_.dynamic_source != ObstacleParameters::STATIC_ONLY) {
     if (obstacle_params_.filter_envelope)
       obstacle_masks.positive_mask = createEnvelopePolygon(footprint_polygons);
@@ -203,11 +200,12 @@ void ObstacleVelocityLimiterNode::onTrajectory(const Trajectory::ConstSharedPtr
       obstacles, *occupancy_grid_ptr_, *pointcloud_ptr_, obstacle_masks, transform_listener_,
       original_traj.header.frame_id, obstacle_params_);
   }
+  const CollisionChecker collision_checker(
+    std::move(obstacles), static_map_obstacle_tree_ptr_, obstacle_params_.rtree_min_points,
+    obstacle_params_.rtree_min_segments);
   limitVelocity(
-    downsampled_traj,
-    CollisionChecker(
-      obstacles, obstacle_params_.rtree_min_points, obstacle_params_.rtree_min_segments),
-    projected_linestrings, footprint_polygons, projection_params_, velocity_params_);
+    downsampled_traj, collision_checker, projected_linestrings, footprint_polygons,
+    projection_params_, velocity_params_);
   auto safe_trajectory = copyDownsampledVelocity(
     downsampled_traj, original_traj, start_idx, preprocessing_params_.downsample_factor);
   safe_trajectory.header.stamp = now();
@@ -223,12 +221,23 @@ void ObstacleVelocityLimiterNode::onTrajectory(const Trajectory::ConstSharedPtr
       createProjectedLines(downsampled_traj, projection_params_);
     const auto safe_footprint_polygons =
       createFootprintPolygons(safe_projected_linestrings, vehicle_lateral_offset_);
+    auto debug_obstacles = collision_checker.obstacles;
+    debug_obstacles.lines.insert(
+      debug_obstacles.lines.begin(), static_map_obstacles_.begin(), static_map_obstacles_.end());
     pub_debug_markers_->publish(makeDebugMarkers(
-      obstacles, projected_linestrings, safe_projected_linestrings, footprint_polygons,
+      debug_obstacles, projected_linestrings, safe_projected_linestrings, footprint_polygons,
       safe_footprint_polygons, obstacle_masks, occupancy_grid_ptr_->info.origin.position.z));
   }
 }
 
+void ObstacleVelocityLimiterNode::updateStaticMapObstacles()
+{
+  static_map_obstacles_ =
+    extractStaticObstacles(*lanelet_map_ptr_, obstacle_params_.static_map_tags);
+  static_map_obstacle_tree_ptr_ =
+    std::make_shared<const ObstacleTree<multilinestring_t>>(static_map_obstacles_);
+}
+
 bool ObstacleVelocityLimiterNode::validInputs(const boost::optional<size_t> & ego_idx)
 {
   constexpr auto one_sec = rcutils_duration_value_t(1000);
@@ -87,9 +87,9 @@ void addSensorObstacles(
     const auto obstacle_lines = extractObstacles(grid_map, occupancy_grid);
     obstacles.lines.insert(obstacles.lines.end(), obstacle_lines.begin(), obstacle_lines.end());
   } else if (obstacle_params.dynamic_source == ObstacleParameters::POINTCLOUD) {
-    auto pcd = transformPointCloud(pointcloud, transform_listener, target_frame);
-    filterPointCloud(pcd, masks);
-    obstacles.points = extractObstacles(pcd);
+    Eigen::Matrix4f transform;
+    if (getPointCloudTransform(pointcloud, transform_listener, target_frame, transform))
+      extractObstacles(obstacles.points, pointcloud, transform, RasterizedMasks(masks));
   }
 }
 }  // namespace obstacle_velocity_limiter
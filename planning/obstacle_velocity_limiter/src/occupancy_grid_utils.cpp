@@ -21,7 +21,7 @@
 #include <grid_map_core/iterators/GridMapIterator.hpp>
 #include <grid_map_cv/GridMapCvConverter.hpp>
 #include <grid_map_ros/GridMapRosConverter.hpp>
-#include <grid_map_utils/polygon_iterator.hpp>
+#include <grid_map_utils/polygon_rasterizer.hpp>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/opencv.hpp>
 
@@ -36,20 +36,19 @@ void maskPolygons(grid_map::GridMap & grid_map, const ObstacleMasks & obstacle_m
   };
 
   auto & layer = grid_map["layer"];
+  grid_map_utils::PolygonRasterizer rasterizer;
 
   if (!obstacle_masks.positive_mask.outer().empty()) {
     const auto layer_copy = grid_map["layer"];
     layer.setConstant(0.0);
-    grid_map::Position position;
-    for (grid_map_utils::PolygonIterator iterator(grid_map, convert(obstacle_masks.positive_mask));
-         !iterator.isPastEnd(); ++iterator)
-      layer((*iterator)(0), (*iterator)(1)) = layer_copy((*iterator)(0), (*iterator)(1));
+    for (const auto & span :
+         rasterizer.rasterize(grid_map, convert(obstacle_masks.positive_mask)))
+      layer.row(span.row).segment(span.col, span.length) =
+        layer_copy.row(span.row).segment(span.col, span.length);
   }
 
   for (const auto & negative_mask : obstacle_masks.negative_masks)
-    for (grid_map_utils::PolygonIterator iterator(grid_map, convert(negative_mask));
-         !iterator.isPastEnd(); ++iterator)
-      layer((*iterator)(0), (*iterator)(1)) = 0.0;
+    rasterizer.fill(layer, grid_map, convert(negative_mask), 0.0, grid_map_utils::FillMode::ASSIGN);
 }
 
 void threshold(grid_map::GridMap & grid_map, const float threshold)
@@ -17,90 +17,188 @@
 #include "obstacle_velocity_limiter/types.hpp"
 // cspell: ignore multipolygon, multilinestring
 
-#include <pcl_ros/transforms.hpp>
+#include <autoware_point_types/point_cloud2_view.hpp>
+#include <grid_map_core/GridMap.hpp>
+#include <grid_map_core/Polygon.hpp>
+#include <grid_map_utils/polygon_rasterizer.hpp>
 
-#include <pcl/Vertices.h>
-#include <pcl/filters/crop_hull.h>
-#include <pcl_conversions/pcl_conversions.h>
+#include <pcl/point_types.h>
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_eigen/tf2_eigen.h>
 #else
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 namespace obstacle_velocity_limiter
 {
 
-pcl::PointCloud<pcl::PointXYZ>::Ptr transformPointCloud(
-  const PointCloud & pointcloud_msg, tier4_autoware_utils::TransformListener & transform_listener,
-  const std::string & target_frame)
+RasterizedMasks::RasterizedMasks(const ObstacleMasks & masks, const int max_cells_per_side)
 {
-  const auto & header = pointcloud_msg.header;
-  const auto transform = transform_listener.getTransform(
-    target_frame, header.frame_id, header.stamp, rclcpp::Duration::from_nanoseconds(0));
-  const Eigen::Matrix4f transform_matrix =
-    tf2::transformToEigen(transform->transform).matrix().cast<float>();
-
-  PointCloud transformed_msg;
-  pcl_ros::transformPointCloud(transform_matrix, pointcloud_msg, transformed_msg);
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(transformed_msg, transformed_pointcloud);
-  return pcl::PointCloud<pcl::PointXYZ>::Ptr(
-    new pcl::PointCloud<pcl::PointXYZ>(std::move(transformed_pointcloud)));
+  // vertices are rounded to float like the points, as done when filtering with pcl::CropHull
+  constexpr auto to_float_polygon = [](const polygon_t & polygon) {
+    std::vector<point_t> vertices;
+    vertices.reserve(polygon.outer().size());
+    for (const auto & p : polygon.outer())
+      vertices.emplace_back(static_cast<float>(p.x()), static_cast<float>(p.y()));
+    return vertices;
+  };
+  positive_mask_ = to_float_polygon(masks.positive_mask);
+  for (const auto & negative_mask : masks.negative_masks)
+    if (!negative_mask.outer().empty()) negative_masks_.push_back(to_float_polygon(negative_mask));
+  if (positive_mask_.empty() && negative_masks_.empty()) return;
+
+  // the raster covers the positive mask, or the negative masks if there is no positive mask
+  auto min_x = std::numeric_limits<double>::max();
+  auto min_y = std::numeric_limits<double>::max();
+  auto max_x = std::numeric_limits<double>::lowest();
+  auto max_y = std::numeric_limits<double>::lowest();
+  const auto extend_bounds = [&](const std::vector<point_t> & polygon) {
+    for (const auto & p : polygon) {
+      min_x = std::min(min_x, p.x());
+      min_y = std::min(min_y, p.y());
+      max_x = std::max(max_x, p.x());
+      max_y = std::max(max_y, p.y());
+    }
+  };
+  if (!positive_mask_.empty()) {
+    extend_bounds(positive_mask_);
+    outside_raster_type_ = DISCARD;
+  } else {
+    for (const auto & negative_mask : negative_masks_) extend_bounds(negative_mask);
+  }
+  // fall back to exact tests for all points
+  if (!std::isfinite(min_x + min_y + max_x + max_y)) return;
+
+  resolution_ = std::max(max_x - min_x, max_y - min_y) / max_cells_per_side;
+  if (!(resolution_ > 0.0)) resolution_ = 1.0;
+  rows_ = static_cast<int>((max_x - min_x) / resolution_) + 1;
+  cols_ = static_cast<int>((max_y - min_y) / resolution_) + 1;
+  top_x_ = min_x + rows_ * resolution_;
+  top_y_ = min_y + cols_ * resolution_;
+  cells_.assign(static_cast<size_t>(rows_) * cols_, positive_mask_.empty() ? KEEP : DISCARD);
+  has_raster_ = true;
+
+  // classify the cells from their center
+  grid_map::GridMap grid_map;
+  grid_map.setGeometry(
+    grid_map::Length(rows_ * resolution_, cols_ * resolution_), resolution_,
+    grid_map::Position(top_x_ - rows_ * resolution_ / 2.0, top_y_ - cols_ * resolution_ / 2.0));
+  grid_map_utils::PolygonRasterizer rasterizer;
+  const auto fill = [&](const std::vector<point_t> & polygon, const CellType type) {
+    grid_map::Polygon grid_map_polygon;
+    for (const auto & p : polygon) grid_map_polygon.addVertex(grid_map::Position(p.x(), p.y()));
+    for (const auto & span : rasterizer.rasterize(grid_map, grid_map_polygon))
+      std::fill_n(cells_.begin() + span.row * cols_ + span.col, span.length, type);
+  };
+  if (!positive_mask_.empty()) fill(positive_mask_, KEEP);
+  for (const auto & negative_mask : negative_masks_) fill(negative_mask, DISCARD);
+
+  // cells crossed by an edge need exact tests
+  const auto mark_edges = [&](const std::vector<point_t> & polygon) {
+    for (size_t i = 0; i < polygon.size(); ++i)
+      markBoundary(polygon[i], polygon[(i + 1) % polygon.size()]);
+  };
+  mark_edges(positive_mask_);
+  for (const auto & negative_mask : negative_masks_) mark_edges(negative_mask);
 }
 
-void filterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud, const ObstacleMasks & masks)
+void RasterizedMasks::markBoundary(const point_t & p, const point_t & q)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr polygon_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  if (!masks.positive_mask.outer().empty()) {
-    for (const auto & p : masks.positive_mask.outer())
-      polygon_cloud_ptr->push_back(pcl::PointXYZ(p.x(), p.y(), 0));
-    std::vector<pcl::Vertices> polygons_idx(1);
-    polygons_idx.front().vertices.resize(masks.positive_mask.outer().size());
-    std::iota(polygons_idx.front().vertices.begin(), polygons_idx.front().vertices.end(), 0);
-    pcl::CropHull<pcl::PointXYZ> crop;
-    crop.setInputCloud(pointcloud);
-    crop.setDim(2);
-    crop.setHullCloud(polygon_cloud_ptr);
-    crop.setHullIndices(polygons_idx);
-    crop.setCropOutside(true);
-    crop.filter(*pointcloud);
+  // margin covering rounding errors when calculating the cell of a point
+  const auto margin = 1e-3 * resolution_;
+  const auto to_index = [&](const double distance, const int size) {
+    const auto index = std::floor(distance / resolution_);
+    return static_cast<int>(std::clamp(index, -1.0, static_cast<double>(size)));
+  };
+  const auto edge_min_x = std::min(p.x(), q.x());
+  const auto edge_max_x = std::max(p.x(), q.x());
+  const auto first_row = std::max(0, to_index(top_x_ - edge_max_x - margin, rows_));
+  const auto last_row = std::min(rows_ - 1, to_index(top_x_ - edge_min_x + margin, rows_));
+  for (auto row = first_row; row <= last_row; ++row) {
+    // part of the edge within the row
+    const auto from_x = std::max(edge_min_x, top_x_ - (row + 1) * resolution_ - margin);
+    const auto to_x = std::min(edge_max_x, top_x_ - row * resolution_ + margin);
+    if (from_x > to_x) continue;
+    auto min_y = std::min(p.y(), q.y());
+    auto max_y = std::max(p.y(), q.y());
+    if (p.x() != q.x()) {
+      const auto slope = (q.y() - p.y()) / (q.x() - p.x());
+      const auto from_y = p.y() + (from_x - p.x()) * slope;
+      const auto to_y = p.y() + (to_x - p.x()) * slope;
+      min_y = std::min(from_y, to_y);
+      max_y = std::max(from_y, to_y);
+    }
+    const auto first_col = std::max(0, to_index(top_y_ - max_y - margin, cols_));
+    const auto last_col = std::min(cols_ - 1, to_index(top_y_ - min_y + margin, cols_));
+    for (auto col = first_col; col <= last_col; ++col) cells_[row * cols_ + col] = BOUNDARY;
   }
+}
 
-  pcl::PointCloud<pcl::PointXYZ>::Ptr mask_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  std::vector<pcl::Vertices> masks_idx(masks.negative_masks.size());
-  size_t start_idx = 0;
-  for (size_t i = 0; i < masks.negative_masks.size(); ++i) {
-    const auto & polygon_mask = masks.negative_masks[i];
-    const auto mask_size = polygon_mask.outer().size();
-    for (const auto & p : polygon_mask.outer())
-      mask_cloud_ptr->push_back(pcl::PointXYZ(p.x(), p.y(), 0));
-    auto & mask_idx = masks_idx[i];
-    mask_idx.vertices.resize(mask_size);
-    std::iota(mask_idx.vertices.begin(), mask_idx.vertices.end(), start_idx);
-    start_idx += mask_size;
+bool RasterizedMasks::isInside(const float x, const float y, const std::vector<point_t> & polygon)
+{
+  // same crossing test as pcl::CropHull
+  bool is_inside = false;
+  auto prev = polygon.back();
+  for (const auto & curr : polygon) {
+    const auto & left = curr.x() > prev.x() ? prev : curr;
+    const auto & right = curr.x() > prev.x() ? curr : prev;
+    if (
+      (curr.x() < x) == (x <= prev.x()) &&
+      (y - left.y()) * (right.x() - left.x()) < (right.y() - left.y()) * (x - left.x()))
+      is_inside = !is_inside;
+    prev = curr;
   }
-  pcl::CropHull<pcl::PointXYZ> crop_masks;
-  crop_masks.setInputCloud(pointcloud);
-  crop_masks.setDim(2);
-  crop_masks.setHullCloud(mask_cloud_ptr);
-  crop_masks.setHullIndices(masks_idx);
-  crop_masks.setCropOutside(false);
-  crop_masks.filter(*pointcloud);
+  return is_inside;
 }
 
-multipoint_t extractObstacles(const pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_ptr)
+bool RasterizedMasks::isKept(const float x, const float y) const
 {
-  multipoint_t obstacles;
-  if (pointcloud_ptr->empty()) return obstacles;
-  obstacles.reserve(pointcloud_ptr->size());
+  if (has_raster_) {
+    const auto row = std::floor((top_x_ - x) / resolution_);
+    const auto col = std::floor((top_y_ - y) / resolution_);
+    if (!(row >= 0.0 && row < rows_ && col >= 0.0 && col < cols_))
+      return outside_raster_type_ == KEEP;
+    const auto type = cells_[static_cast<int>(row) * cols_ + static_cast<int>(col)];
+    if (type != BOUNDARY) return type == KEEP;
+  }
+  if (!positive_mask_.empty() && !isInside(x, y, positive_mask_)) return false;
+  for (const auto & negative_mask : negative_masks_)
+    if (isInside(x, y, negative_mask)) return false;
+  return true;
+}
 
-  for (const auto & point : *pointcloud_ptr) {
-    obstacles.push_back({point_t{point.x, point.y}});
+bool getPointCloudTransform(
+  const PointCloud & pointcloud_msg, tier4_autoware_utils::TransformListener & transform_listener,
+  const std::string & target_frame, Eigen::Matrix4f & transform)
+{
+  const auto & header = pointcloud_msg.header;
+  const auto transform_stamped = transform_listener.getTransform(
+    target_frame, header.frame_id, header.stamp, rclcpp::Duration::from_nanoseconds(0));
+  if (!transform_stamped) return false;
+  transform = tf2::transformToEigen(transform_stamped->transform).matrix().cast<float>();
+  return true;
+}
+
+void extractObstacles(
+  multipoint_t & obstacles, const PointCloud & pointcloud_msg, const Eigen::Matrix4f & transform,
+  const RasterizedMasks & masks)
+{
+  obstacles.clear();
+  const autoware_point_types::PointCloud2View<pcl::PointXYZ> points(pointcloud_msg);
+  obstacles.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Eigen::Vector4f point =
+      transform * Eigen::Vector4f(
+                    points.get<pcl::fields::x>(i), points.get<pcl::fields::y>(i),
+                    points.get<pcl::fields::z>(i), 1.0f);
+    if (!std::isfinite(point.x()) || !std::isfinite(point.y())) continue;
+    if (masks.isKept(point.x(), point.y())) obstacles.emplace_back(point.x(), point.y());
   }
-  return obstacles;
 }
 
 }  // namespace obstacle_velocity_limiter
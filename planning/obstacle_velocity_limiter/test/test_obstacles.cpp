@@ -20,6 +20,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
 TEST(TestObstacles, ObstacleTreePoints)
 {
   /*
@@ -76,3 +81,67 @@ TEST(TestObstacles, ObstacleTreeLines)
       std::cout << boost::geometry::wkt(point) << std::endl;
   */
 }
+
+TEST(TestObstacles, CollisionCheckerStaticTree)
+{
+  using obstacle_velocity_limiter::CollisionChecker;
+  using obstacle_velocity_limiter::linestring_t;
+  using obstacle_velocity_limiter::multilinestring_t;
+  using obstacle_velocity_limiter::ObstacleTree;
+  using obstacle_velocity_limiter::Obstacles;
+  using obstacle_velocity_limiter::point_t;
+  using obstacle_velocity_limiter::polygon_t;
+
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> position_dist(-20.0, 20.0);
+  std::uniform_real_distribution<double> size_dist(0.5, 5.0);
+  multilinestring_t static_lines;
+  for (auto i = 0; i < 50; ++i) {
+    linestring_t line;
+    point_t p(position_dist(engine), position_dist(engine));
+    for (auto j = 0; j < 4; ++j) {
+      line.push_back(p);
+      p = point_t(p.x() + size_dist(engine) - 2.5, p.y() + size_dist(engine) - 2.5);
+    }
+    static_lines.push_back(line);
+  }
+  Obstacles dynamic_obstacles;
+  for (auto i = 0; i < 10; ++i)
+    dynamic_obstacles.lines.push_back(
+      {point_t(position_dist(engine), position_dist(engine)),
+       point_t(position_dist(engine), position_dist(engine))});
+  for (auto i = 0; i < 200; ++i)
+    dynamic_obstacles.points.emplace_back(position_dist(engine), position_dist(engine));
+  std::vector<polygon_t> footprints(50);
+  for (auto & footprint : footprints) {
+    const auto x = position_dist(engine);
+    const auto y = position_dist(engine);
+    const auto w = size_dist(engine);
+    const auto h = size_dist(engine);
+    footprint.outer() = {{x, y}, {x, y + h}, {x + w, y + h}, {x + w, y}, {x, y}};
+  }
+
+  // static obstacles in a persistent tree give the same result as rebuilding them in each checker
+  Obstacles all_obstacles = dynamic_obstacles;
+  all_obstacles.lines.insert(all_obstacles.lines.end(), static_lines.begin(), static_lines.end());
+  const CollisionChecker rebuilt_checker(all_obstacles, 0lu, 0lu);
+  const CollisionChecker checker(
+    dynamic_obstacles, std::make_shared<const ObstacleTree<multilinestring_t>>(static_lines), 0lu,
+    0lu);
+  const auto less = [](const point_t & p1, const point_t & p2) {
+    return p1.x() < p2.x() || (p1.x() == p2.x() && p1.y() < p2.y());
+  };
+  const auto batched_results = checker.intersections(footprints);
+  ASSERT_EQ(batched_results.size(), footprints.size());
+  for (size_t i = 0; i < footprints.size(); ++i) {
+    auto expected = rebuilt_checker.intersections(footprints[i]);
+    auto result = batched_results[i];
+    std::sort(expected.begin(), expected.end(), less);
+    std::sort(result.begin(), result.end(), less);
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t j = 0; j < result.size(); ++j) {
+      EXPECT_EQ(result[j].x(), expected[j].x());
+      EXPECT_EQ(result[j].y(), expected[j].y());
+    }
+  }
+}
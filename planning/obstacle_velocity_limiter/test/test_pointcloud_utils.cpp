@@ -0,0 +1,89 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_velocity_limiter/pointcloud_utils.hpp"
+#include "obstacle_velocity_limiter/types.hpp"
+// cspell: ignore multipolygon, multilinestring
+
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+TEST(TestPointcloudUtils, rasterizedMasks)
+{
+  using obstacle_velocity_limiter::point_t;
+  using obstacle_velocity_limiter::polygon_t;
+  using obstacle_velocity_limiter::RasterizedMasks;
+
+  obstacle_velocity_limiter::ObstacleMasks masks;
+  EXPECT_TRUE(RasterizedMasks(masks).isKept(0.0, 0.0));
+
+  masks.positive_mask.outer() = {{0.0, 0.0}, {0.0, 10.0}, {10.0, 10.0}, {10.0, 0.0}, {0.0, 0.0}};
+  polygon_t negative_mask;
+  negative_mask.outer() = {{2.0, 2.0}, {2.0, 5.0}, {8.0, 2.0}, {2.0, 2.0}};
+  masks.negative_masks.push_back(negative_mask);
+  negative_mask.outer() = {{-5.0, 8.0}, {-5.0, 15.0}, {5.0, 15.0}, {5.0, 8.0}, {-5.0, 8.0}};
+  masks.negative_masks.push_back(negative_mask);
+
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<float> dist(-2.0, 12.0);
+  for (const auto max_cells_per_side : {1, 3, 16, 256}) {
+    const RasterizedMasks rasterized_masks(masks, max_cells_per_side);
+    for (auto i = 0; i < 10000; ++i) {
+      const auto x = dist(engine);
+      const auto y = dist(engine);
+      const point_t point(x, y);
+      bool expected = boost::geometry::within(point, masks.positive_mask);
+      for (const auto & mask : masks.negative_masks)
+        expected = expected && !boost::geometry::within(point, mask);
+      EXPECT_EQ(rasterized_masks.isKept(x, y), expected) << x << " " << y;
+    }
+  }
+}
+
+TEST(TestPointcloudUtils, extractObstacles)
+{
+  obstacle_velocity_limiter::ObstacleMasks masks;
+  masks.positive_mask.outer() = {{0.0, 0.0}, {0.0, 10.0}, {10.0, 10.0}, {10.0, 0.0}, {0.0, 0.0}};
+  const obstacle_velocity_limiter::RasterizedMasks rasterized_masks(masks);
+
+  pcl::PointCloud<pcl::PointXYZ> pointcloud;
+  pointcloud.emplace_back(1.0, 1.0, 0.0);
+  pointcloud.emplace_back(-3.0, 1.0, 0.0);
+  pointcloud.emplace_back(5.0, 8.5, 0.0);
+  pointcloud.emplace_back(std::numeric_limits<float>::quiet_NaN(), 1.0, 0.0);
+  obstacle_velocity_limiter::PointCloud pointcloud_msg;
+  pcl::toROSMsg(pointcloud, pointcloud_msg);
+
+  // translation by (2, 1)
+  Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+  transform(0, 3) = 2.0f;
+  transform(1, 3) = 1.0f;
+
+  obstacle_velocity_limiter::multipoint_t obstacles = {{100.0, 100.0}};
+  obstacle_velocity_limiter::extractObstacles(
+    obstacles, pointcloud_msg, transform, rasterized_masks);
+  ASSERT_EQ(obstacles.size(), 2lu);
+  EXPECT_DOUBLE_EQ(obstacles[0].x(), 3.0);
+  EXPECT_DOUBLE_EQ(obstacles[0].y(), 2.0);
+  EXPECT_DOUBLE_EQ(obstacles[1].x(), 7.0);
+  EXPECT_DOUBLE_EQ(obstacles[1].y(), 9.5);
+}
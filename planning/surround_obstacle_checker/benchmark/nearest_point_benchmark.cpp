@@ -0,0 +1,149 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "surround_obstacle_checker/nearest_point.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <pcl/common/transforms.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <utility>
+
+namespace
+{
+namespace bg = boost::geometry;
+using Point2d = bg::model::d2::point_xy<double>;
+using Polygon2d = bg::model::polygon<Point2d>;
+using Obstacle = std::pair<double, geometry_msgs::msg::Point>;
+
+vehicle_info_util::VehicleInfo makeVehicleInfo()
+{
+  vehicle_info_util::VehicleInfo vehicle_info;
+  vehicle_info.max_longitudinal_offset_m = 3.8;
+  vehicle_info.min_longitudinal_offset_m = -1.0;
+  vehicle_info.max_lateral_offset_m = 0.9;
+  vehicle_info.min_lateral_offset_m = -0.9;
+  return vehicle_info;
+}
+
+// previous implementation: conversion to pcl, transform of the whole cloud, polygon distance
+Obstacle getNearestPointReference(
+  const sensor_msgs::msg::PointCloud2 & pointcloud, const Eigen::Affine3f & isometry,
+  const vehicle_info_util::VehicleInfo & vehicle_info)
+{
+  Polygon2d ego_polygon;
+  ego_polygon.outer().emplace_back(
+    vehicle_info.max_longitudinal_offset_m, vehicle_info.max_lateral_offset_m);
+  ego_polygon.outer().emplace_back(
+    vehicle_info.max_longitudinal_offset_m, vehicle_info.min_lateral_offset_m);
+  ego_polygon.outer().emplace_back(
+    vehicle_info.min_longitudinal_offset_m, vehicle_info.min_lateral_offset_m);
+  ego_polygon.outer().emplace_back(
+    vehicle_info.min_longitudinal_offset_m, vehicle_info.max_lateral_offset_m);
+  bg::correct(ego_polygon);
+
+  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
+  pcl::fromROSMsg(pointcloud, transformed_pointcloud);
+  pcl::transformPointCloud(transformed_pointcloud, transformed_pointcloud, isometry);
+
+  geometry_msgs::msg::Point nearest_point;
+  auto minimum_distance = std::numeric_limits<double>::max();
+  for (const auto & p : transformed_pointcloud) {
+    const auto distance_to_object = bg::distance(ego_polygon, Point2d(p.x, p.y));
+    if (distance_to_object < minimum_distance) {
+      nearest_point.x = p.x;
+      nearest_point.y = p.y;
+      nearest_point.z = p.z;
+      minimum_distance = distance_to_object;
+    }
+  }
+  return std::make_pair(minimum_distance, nearest_point);
+}
+
+// points around the vehicle in the frame of a lidar mounted on its roof, some of them invalid
+sensor_msgs::msg::PointCloud2 makePointCloud(const size_t nb_points, std::mt19937 & gen)
+{
+  std::uniform_real_distribution<float> xy_distribution(-30.0f, 30.0f);
+  std::uniform_real_distribution<float> z_distribution(-2.0f, 1.0f);
+  std::uniform_int_distribution<int> nan_distribution(0, 99);
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  cloud.reserve(nb_points);
+  for (size_t i = 0; i < nb_points; ++i) {
+    if (nan_distribution(gen) == 0) {
+      const auto nan = std::numeric_limits<float>::quiet_NaN();
+      cloud.emplace_back(nan, nan, nan);
+    } else {
+      cloud.emplace_back(xy_distribution(gen), xy_distribution(gen), z_distribution(gen));
+    }
+  }
+  cloud.is_dense = false;
+  sensor_msgs::msg::PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  return msg;
+}
+}  // namespace
+
+int main()
+{
+  constexpr auto nb_iterations = 20;
+  const auto vehicle_info = makeVehicleInfo();
+  const surround_obstacle_checker::EgoRectangle ego_rectangle(vehicle_info);
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> yaw_distribution(-0.1f, 0.1f);
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stopwatch;
+
+  std::printf("#Points Reference[ms] NearestPoint[ms] MaxDistanceDiff[m] PointMismatches\n");
+  for (const auto nb_points : {1000lu, 10000lu, 100000lu, 300000lu}) {
+    double reference_duration{};
+    double duration{};
+    double max_distance_diff{};
+    int nb_mismatches{};
+    for (auto i = 0; i < nb_iterations; ++i) {
+      const auto pointcloud = makePointCloud(nb_points, gen);
+      const Eigen::Affine3f isometry =
+        Eigen::Translation3f(1.2f, 0.0f, 2.0f) *
+        Eigen::AngleAxisf(yaw_distribution(gen), Eigen::Vector3f::UnitZ());
+
+      stopwatch.tic();
+      const auto reference = getNearestPointReference(pointcloud, isometry, vehicle_info);
+      reference_duration += stopwatch.toc();
+
+      stopwatch.tic();
+      const auto result =
+        surround_obstacle_checker::getNearestPoint(pointcloud, isometry, ego_rectangle);
+      duration += stopwatch.toc();
+
+      max_distance_diff = std::max(max_distance_diff, std::abs(reference.first - result.first));
+      if (
+        reference.second.x != result.second.x || reference.second.y != result.second.y ||
+        reference.second.z != result.second.z)
+        ++nb_mismatches;
+    }
+    std::printf(
+      "%lu %f %f %e %d\n", nb_points, reference_duration / nb_iterations, duration / nb_iterations,
+      max_distance_diff, nb_mismatches);
+  }
+  return 0;
+}
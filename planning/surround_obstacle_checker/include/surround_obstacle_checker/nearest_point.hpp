@@ -0,0 +1,81 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURROUND_OBSTACLE_CHECKER__NEAREST_POINT_HPP_
+#define SURROUND_OBSTACLE_CHECKER__NEAREST_POINT_HPP_
+
+#include <vehicle_info_util/vehicle_info_util.hpp>
+
+#include <geometry_msgs/msg/point.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#define EIGEN_MPL2_ONLY
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <cmath>
+#include <utility>
+
+namespace surround_obstacle_checker
+{
+/**
+ * @brief footprint of the ego vehicle in the base_link frame, stored as its center and half sizes
+ */
+struct EgoRectangle
+{
+  explicit EgoRectangle(const vehicle_info_util::VehicleInfo & vehicle_info)
+  : center_x(0.5 * (vehicle_info.max_longitudinal_offset_m +
+                    vehicle_info.min_longitudinal_offset_m)),
+    center_y(0.5 * (vehicle_info.max_lateral_offset_m + vehicle_info.min_lateral_offset_m)),
+    half_length(
+      0.5 * std::abs(
+              vehicle_info.max_longitudinal_offset_m - vehicle_info.min_longitudinal_offset_m)),
+    half_width(
+      0.5 * std::abs(vehicle_info.max_lateral_offset_m - vehicle_info.min_lateral_offset_m))
+  {
+  }
+
+  /// @brief squared distance from the point to the rectangle, 0 inside and NaN for a NaN point
+  double squaredDistance(const double x, const double y) const
+  {
+    // max(a, 0) written as (a + |a|) / 2 so that the loops calling it have no branch
+    const double ax = std::abs(x - center_x) - half_length;
+    const double ay = std::abs(y - center_y) - half_width;
+    const double dx = 0.5 * (ax + std::abs(ax));
+    const double dy = 0.5 * (ay + std::abs(ay));
+    return dx * dx + dy * dy;
+  }
+
+  double center_x;
+  double center_y;
+  double half_length;
+  double half_width;
+};
+
+/**
+ * @brief find the point of the cloud nearest to the ego rectangle
+ * @details the points are read from the message buffer and transformed to base_link on the fly.
+ * Points with a non-finite coordinate are ignored and ties keep the first point of the cloud.
+ * @param [in] pointcloud point cloud in its original frame
+ * @param [in] transform transform from the frame of the cloud to base_link
+ * @param [in] ego_rectangle footprint of the ego vehicle in base_link
+ * @return distance to the nearest point and its position in base_link, or the max double and a
+ * default point if the cloud has no valid point
+ */
+std::pair<double, geometry_msgs::msg::Point> getNearestPoint(
+  const sensor_msgs::msg::PointCloud2 & pointcloud, const Eigen::Affine3f & transform,
+  const EgoRectangle & ego_rectangle);
+}  // namespace surround_obstacle_checker
+
+#endif  // SURROUND_OBSTACLE_CHECKER__NEAREST_POINT_HPP_
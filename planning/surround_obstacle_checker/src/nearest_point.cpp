@@ -0,0 +1,87 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "surround_obstacle_checker/nearest_point.hpp"
+
+#include <autoware_point_types/point_cloud2_view.hpp>
+
+#include <pcl/point_types.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+
+namespace surround_obstacle_checker
+{
+std::pair<double, geometry_msgs::msg::Point> getNearestPoint(
+  const sensor_msgs::msg::PointCloud2 & pointcloud, const Eigen::Affine3f & transform,
+  const EgoRectangle & ego_rectangle)
+{
+  // the points are processed by blocks stored as structure of arrays so that the transform and
+  // the distance loops have no branch and can be vectorized by the compiler
+  constexpr std::size_t block_size = 256;
+  std::array<float, block_size> xs;
+  std::array<float, block_size> ys;
+  std::array<float, block_size> zs;
+  std::array<double, block_size> squared_distances;
+
+  const autoware_point_types::PointCloud2View<pcl::PointXYZ> points(pointcloud);
+  const Eigen::Matrix4f & m = transform.matrix();
+  // same operation order as pcl::transformPointCloud
+  const auto transform_x = [&](const float x, const float y, const float z) {
+    return m(0, 0) * x + (m(0, 1) * y + (m(0, 2) * z + m(0, 3)));
+  };
+  const auto transform_y = [&](const float x, const float y, const float z) {
+    return m(1, 0) * x + (m(1, 1) * y + (m(1, 2) * z + m(1, 3)));
+  };
+  const auto transform_z = [&](const float x, const float y, const float z) {
+    return m(2, 0) * x + (m(2, 1) * y + (m(2, 2) * z + m(2, 3)));
+  };
+
+  // NaN and infinite distances never compare lower so invalid points are skipped
+  auto min_squared_distance = std::numeric_limits<double>::max();
+  auto nearest_index = points.size();
+  for (std::size_t begin = 0; begin < points.size(); begin += block_size) {
+    const auto n = std::min(block_size, points.size() - begin);
+    for (std::size_t i = 0; i < n; ++i) {
+      xs[i] = points.get<pcl::fields::x>(begin + i);
+      ys[i] = points.get<pcl::fields::y>(begin + i);
+      zs[i] = points.get<pcl::fields::z>(begin + i);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      const float x = transform_x(xs[i], ys[i], zs[i]);
+      const float y = transform_y(xs[i], ys[i], zs[i]);
+      squared_distances[i] = ego_rectangle.squaredDistance(x, y);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      if (squared_distances[i] < min_squared_distance) {
+        min_squared_distance = squared_distances[i];
+        nearest_index = begin + i;
+      }
+    }
+  }
+
+  geometry_msgs::msg::Point nearest_point;
+  if (nearest_index == points.size()) {
+    return std::make_pair(std::numeric_limits<double>::max(), nearest_point);
+  }
+
+  const auto p = points[nearest_index];
+  nearest_point.x = transform_x(p.x, p.y, p.z);
+  nearest_point.y = transform_y(p.x, p.y, p.z);
+  nearest_point.z = transform_z(p.x, p.y, p.z);
+  return std::make_pair(std::sqrt(min_squared_distance), nearest_point);
+}
+}  // namespace surround_obstacle_checker
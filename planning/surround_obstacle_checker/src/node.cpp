@@ -14,6 +14,8 @@
 
 #include "surround_obstacle_checker/node.hpp"
 
+#include "surround_obstacle_checker/nearest_point.hpp"
+
 #include <autoware_auto_tf2/tf2_autoware_auto_msgs.hpp>
 
 #include <boost/assert.hpp>
@@ -23,9 +25,6 @@
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 
-#include <pcl/common/transforms.h>
-#include <pcl/point_cloud.h>
-#include <pcl_conversions/pcl_conversions.h>
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_eigen/tf2_eigen.h>
 #else
@@ -336,32 +335,14 @@ boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByPoint
   const auto transform_stamped =
     getTransform("base_link", pointcloud_ptr_->header.frame_id, pointcloud_ptr_->header.stamp, 0.5);
 
-  geometry_msgs::msg::Point nearest_point;
-  auto minimum_distance = std::numeric_limits<double>::max();
-
   if (!transform_stamped) {
     return {};
   }
 
-  Eigen::Affine3f isometry = tf2::transformToEigen(transform_stamped.get().transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(*pointcloud_ptr_, transformed_pointcloud);
-  pcl::transformPointCloud(transformed_pointcloud, transformed_pointcloud, isometry);
-
-  const auto ego_polygon = createSelfPolygon(vehicle_info_);
-
-  for (const auto & p : transformed_pointcloud) {
-    Point2d boost_point(p.x, p.y);
+  const Eigen::Affine3f isometry =
+    tf2::transformToEigen(transform_stamped.get().transform).cast<float>();
 
-    const auto distance_to_object = bg::distance(ego_polygon, boost_point);
-
-    if (distance_to_object < minimum_distance) {
-      nearest_point = createPoint(p.x, p.y, p.z);
-      minimum_distance = distance_to_object;
-    }
-  }
-
-  return std::make_pair(minimum_distance, nearest_point);
+  return getNearestPoint(*pointcloud_ptr_, isometry, EgoRectangle(vehicle_info_));
 }
 
 boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByDynamicObject() const
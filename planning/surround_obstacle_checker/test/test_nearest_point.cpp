@@ -0,0 +1,150 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "surround_obstacle_checker/nearest_point.hpp"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <gtest/gtest.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace
+{
+namespace bg = boost::geometry;
+using Point2d = bg::model::d2::point_xy<double>;
+using Polygon2d = bg::model::polygon<Point2d>;
+using surround_obstacle_checker::EgoRectangle;
+using surround_obstacle_checker::getNearestPoint;
+
+Polygon2d makeEgoPolygon(const vehicle_info_util::VehicleInfo & vehicle_info)
+{
+  Polygon2d ego_polygon;
+  ego_polygon.outer().emplace_back(
+    vehicle_info.max_longitudinal_offset_m, vehicle_info.max_lateral_offset_m);
+  ego_polygon.outer().emplace_back(
+    vehicle_info.max_longitudinal_offset_m, vehicle_info.min_lateral_offset_m);
+  ego_polygon.outer().emplace_back(
+    vehicle_info.min_longitudinal_offset_m, vehicle_info.min_lateral_offset_m);
+  ego_polygon.outer().emplace_back(
+    vehicle_info.min_longitudinal_offset_m, vehicle_info.max_lateral_offset_m);
+  bg::correct(ego_polygon);
+  return ego_polygon;
+}
+
+sensor_msgs::msg::PointCloud2 toMsg(const pcl::PointCloud<pcl::PointXYZ> & cloud)
+{
+  sensor_msgs::msg::PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  return msg;
+}
+
+// distance from the polygon to the nearest finite point, transformed one by one
+double getNearestDistanceBruteForce(
+  const pcl::PointCloud<pcl::PointXYZ> & cloud, const Eigen::Affine3f & transform,
+  const Polygon2d & ego_polygon)
+{
+  auto minimum_distance = std::numeric_limits<double>::max();
+  for (const auto & p : cloud) {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+      continue;
+    }
+    const Eigen::Vector3f q = transform * p.getVector3fMap();
+    minimum_distance = std::min(minimum_distance, bg::distance(ego_polygon, Point2d(q.x(), q.y())));
+  }
+  return minimum_distance;
+}
+}  // namespace
+
+TEST(NearestPoint, EmptyCloud)
+{
+  vehicle_info_util::VehicleInfo vehicle_info;
+  vehicle_info.max_longitudinal_offset_m = 3.8;
+  vehicle_info.min_longitudinal_offset_m = -1.0;
+  vehicle_info.max_lateral_offset_m = 0.9;
+  vehicle_info.min_lateral_offset_m = -0.9;
+  const EgoRectangle ego_rectangle(vehicle_info);
+
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  auto result = getNearestPoint(toMsg(cloud), Eigen::Affine3f::Identity(), ego_rectangle);
+  EXPECT_EQ(result.first, std::numeric_limits<double>::max());
+
+  // a cloud with only invalid points behaves like an empty one
+  const auto nan = std::numeric_limits<float>::quiet_NaN();
+  cloud.emplace_back(nan, nan, nan);
+  cloud.emplace_back(std::numeric_limits<float>::infinity(), 0.0f, 0.0f);
+  cloud.is_dense = false;
+  result = getNearestPoint(toMsg(cloud), Eigen::Affine3f::Identity(), ego_rectangle);
+  EXPECT_EQ(result.first, std::numeric_limits<double>::max());
+}
+
+TEST(NearestPoint, RandomCloudsMatchBruteForce)
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> longitudinal_distribution(0.5, 5.0);
+  std::uniform_real_distribution<double> lateral_distribution(0.3, 1.5);
+  std::uniform_real_distribution<float> xy_distribution(-20.0f, 20.0f);
+  std::uniform_real_distribution<float> z_distribution(-2.0f, 2.0f);
+  std::uniform_real_distribution<float> yaw_distribution(-3.14f, 3.14f);
+  std::uniform_int_distribution<int> size_distribution(1, 2000);
+  std::uniform_int_distribution<int> nan_distribution(0, 49);
+
+  for (int iteration = 0; iteration < 200; ++iteration) {
+    // random ego rectangle, not necessarily centered on base_link
+    vehicle_info_util::VehicleInfo vehicle_info;
+    vehicle_info.max_longitudinal_offset_m = longitudinal_distribution(gen);
+    vehicle_info.min_longitudinal_offset_m = -0.5 * longitudinal_distribution(gen);
+    vehicle_info.max_lateral_offset_m = lateral_distribution(gen);
+    vehicle_info.min_lateral_offset_m = -lateral_distribution(gen);
+    const EgoRectangle ego_rectangle(vehicle_info);
+    const auto ego_polygon = makeEgoPolygon(vehicle_info);
+
+    // the block size of the search is 256, sizes around it are covered
+    pcl::PointCloud<pcl::PointXYZ> cloud;
+    const int nb_points = size_distribution(gen);
+    for (int i = 0; i < nb_points; ++i) {
+      if (nan_distribution(gen) == 0) {
+        const auto nan = std::numeric_limits<float>::quiet_NaN();
+        cloud.emplace_back(nan, nan, nan);
+      } else {
+        cloud.emplace_back(xy_distribution(gen), xy_distribution(gen), z_distribution(gen));
+      }
+    }
+    cloud.is_dense = false;
+
+    const Eigen::Affine3f transform =
+      Eigen::Translation3f(xy_distribution(gen) * 0.1f, xy_distribution(gen) * 0.1f, 2.0f) *
+      Eigen::AngleAxisf(yaw_distribution(gen), Eigen::Vector3f::UnitZ());
+
+    const auto expected = getNearestDistanceBruteForce(cloud, transform, ego_polygon);
+    const auto result = getNearestPoint(toMsg(cloud), transform, ego_rectangle);
+    if (expected == std::numeric_limits<double>::max()) {
+      EXPECT_EQ(result.first, expected) << "iteration " << iteration;
+      continue;
+    }
+    EXPECT_NEAR(result.first, expected, 1e-4) << "iteration " << iteration;
+
+    // the returned point is in base_link and lies at the returned distance
+    const auto point_distance =
+      bg::distance(ego_polygon, Point2d(result.second.x, result.second.y));
+    EXPECT_NEAR(point_distance, result.first, 1e-4) << "iteration " << iteration;
+  }
+}
@@ -27,8 +27,11 @@
 #include <std_msgs/msg/header.hpp>
 #include <tier4_debug_msgs/msg/float32_stamped.hpp>
 
+#include <boost/circular_buffer.hpp>
+
 #include <cv_bridge/cv_bridge.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -54,7 +57,13 @@ protected:
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr sky_blockage_ratio_pub_;
 
 private:
+  // one bit per pixel of the no return mask
+  using BinaryMask = std::vector<std::uint64_t>;
+
   void onBlockageChecker(DiagnosticStatusWrapper & stat);
+  const PointCloud2 & toPointXYZIRADRTLayout(const PointCloud2 & input);
+  void updateDepthImages(const PointCloud2 & input);
+  void updateTimeSeriesBlockageMask();
   Updater updater_{this};
   uint vertical_bins_;
   std::vector<double> angle_range_deg_;
@@ -72,6 +81,22 @@ private:
   uint buffering_frames_ = 100;
   uint buffering_interval_ = 5;
 
+  // empty pointcloud with the PointXYZIRADRT fields and buffers reused across frames
+  PointCloud2 point_layout_;
+  PointCloud2 converted_input_;
+  cv::Mat erode_element_;
+  cv::Mat lidar_depth_map_;
+  cv::Mat lidar_depth_map_8u_;
+  cv::Mat return_mask_;
+  cv::Mat no_return_mask_;
+  cv::Mat erosion_dst_;
+  cv::Mat no_return_mask_result_;
+  // the last buffering_frames no return masks and, for each pixel, the number of them in which it
+  // has no return, updated when a mask is pushed or evicted
+  boost::circular_buffer<BinaryMask> no_return_mask_buffer_;
+  std::vector<std::uint16_t> no_return_count_;
+  uint frame_count_ = 0;
+
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
   explicit BlockageDiagComponent(const rclcpp::NodeOptions & options);
@@ -61,6 +61,7 @@
 #include <vector>
 
 // ROS includes
+#include "autoware_point_types/point_cloud2_view.hpp"
 #include "autoware_point_types/types.hpp"
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
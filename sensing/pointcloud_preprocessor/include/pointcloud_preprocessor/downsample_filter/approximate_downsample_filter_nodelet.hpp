@@ -53,7 +53,7 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <tier4_pcl_extensions/voxel_grid_nearest_centroid.hpp>
+#include <tier4_pcl_extensions/flat_voxel_grid_nearest_centroid.hpp>
 
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
@@ -30,6 +30,7 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -61,7 +62,26 @@ protected:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr noise_cloud_pub_;
 
 private:
+  // indexes of the points kept and removed in one ring, reused across frames
+  struct RingBuffer
+  {
+    std::vector<std::uint32_t> segment;
+    std::vector<std::uint32_t> output;
+    std::vector<std::uint32_t> noise;
+    std::vector<float> deleted_azimuths;
+  };
+
   void onVisibilityChecker(DiagnosticStatusWrapper & stat);
+  const PointCloud2 & toPointXYZIRADRTLayout(const PointCloud2 & input);
+  void filterWeakFirstRing(
+    const PointCloud2 & input, const std::uint32_t * ring_begin, const std::uint32_t * ring_end,
+    const std::uint8_t roi_mode, const int ring_id, const float min_azimuth,
+    const float max_azimuth, const std::uint32_t horizontal_res, RingBuffer & buffer,
+    cv::Mat & frequency_image) const;
+  void filterRing(
+    const PointCloud2 & input, const std::uint32_t * ring_begin, const std::uint32_t * ring_end,
+    RingBuffer & buffer) const;
+
   Updater updater_{this};
   double visibility_ = -1.0f;
   double weak_first_distance_ratio_;
@@ -83,6 +103,15 @@ private:
   float max_azimuth_deg_;
   float max_distance_;
 
+  // empty pointcloud with the PointXYZIRADRT fields and buffers reused across frames
+  PointCloud2 point_layout_;
+  PointCloud2 converted_input_;
+  // point indexes sorted by ring, weak first returns in [0, vertical_bins) and other returns in
+  // [vertical_bins, 2 * vertical_bins)
+  std::vector<std::uint32_t> ring_offsets_;
+  std::vector<std::uint32_t> ring_indices_;
+  std::vector<RingBuffer> ring_buffers_;
+
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
   explicit DualReturnOutlierFilterComponent(const rclcpp::NodeOptions & options);
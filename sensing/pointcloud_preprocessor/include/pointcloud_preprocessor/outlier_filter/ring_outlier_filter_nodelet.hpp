@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RING_OUTLIER_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RING_OUTLIER_FILTER_NODELET_HPP_
 
+#include "autoware_point_types/point_cloud2_view.hpp"
+#include "autoware_point_types/ring_azimuth_index.hpp"
 #include "autoware_point_types/types.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
@@ -24,7 +26,10 @@
 
 namespace pointcloud_preprocessor
 {
+using autoware_point_types::PointCloud2View;
 using autoware_point_types::PointXYZI;
+using autoware_point_types::PointXYZIRADRT;
+using autoware_point_types::RingAzimuthIndex;
 using point_cloud_msg_wrapper::PointCloud2Modifier;
 
 class RingOutlierFilterComponent : public pointcloud_preprocessor::Filter
@@ -38,6 +43,9 @@ private:
   double object_length_threshold_;
   int num_points_threshold_;
 
+  // points of every ring in the order of the message, reused across callbacks
+  RingAzimuthIndex ring_index_;
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
@@ -45,15 +53,17 @@ private:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
   bool isCluster(
-    sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
+    const PointCloud2View<PointXYZIRADRT> & input_view,
     const std::vector<std::size_t> & tmp_indices)
   {
-    PointXYZI * front_pt = reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_indices.front()]);
-    PointXYZI * back_pt = reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_indices.back()]);
-
-    const auto x_diff = front_pt->x - back_pt->x;
-    const auto y_diff = front_pt->y - back_pt->y;
-    const auto z_diff = front_pt->z - back_pt->z;
+    const auto front_idx = tmp_indices.front();
+    const auto back_idx = tmp_indices.back();
+    const auto x_diff =
+      input_view.get<pcl::fields::x>(front_idx) - input_view.get<pcl::fields::x>(back_idx);
+    const auto y_diff =
+      input_view.get<pcl::fields::y>(front_idx) - input_view.get<pcl::fields::y>(back_idx);
+    const auto z_diff =
+      input_view.get<pcl::fields::z>(front_idx) - input_view.get<pcl::fields::z>(back_idx);
     return static_cast<int>(tmp_indices.size()) > num_points_threshold_ ||
            (x_diff * x_diff) + (y_diff * y_diff) + (z_diff * z_diff) >=
              object_length_threshold_ * object_length_threshold_;
@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 
+#include "pointcloud_preprocessor/vector_map_filter/lanelet_raster_mask.hpp"
+
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -69,6 +71,10 @@ private:
   float voxel_size_x_;
   float voxel_size_y_;
 
+  bool use_raster_mask_;
+  double raster_mask_resolution_;
+  std::unique_ptr<LaneletRasterMask> raster_mask_;
+
   void pointcloudCallback(const PointCloud2ConstPtr msg);
 
   void mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg);
@@ -88,6 +94,8 @@ private:
 
   bool pointWithinLanelets(const Point2d & point, const lanelet::ConstLanelets & joint_lanelets);
 
+  void filterByRasterMask(const PointCloud2ConstPtr & cloud_msg);
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
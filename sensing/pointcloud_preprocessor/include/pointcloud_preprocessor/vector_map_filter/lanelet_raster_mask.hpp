@@ -0,0 +1,99 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET_RASTER_MASK_HPP_
+#define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET_RASTER_MASK_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief bitmask of the cells whose center is inside a lanelet, split in square tiles
+ * @details tiles are rasterized the first time one of their cells is queried. When max_tile_count
+ * tiles are cached, the cache is cleared before the next tile is rasterized.
+ */
+class LaneletRasterMask
+{
+public:
+  LaneletRasterMask(
+    const lanelet::ConstLanelets & lanelets, const double resolution,
+    const int tile_size = 256, const size_t max_tile_count = 1024);
+
+  /// @brief return true if the cell containing the point (map frame) is inside a lanelet
+  bool isInside(const double x, const double y)
+  {
+    const auto cell_x = static_cast<std::int64_t>(std::floor(x * inv_resolution_));
+    const auto cell_y = static_cast<std::int64_t>(std::floor(y * inv_resolution_));
+    const std::int64_t tile_x = floorDiv(cell_x, tile_size_);
+    const std::int64_t tile_y = floorDiv(cell_y, tile_size_);
+    if (!last_tile_ || tile_x != last_tile_x_ || tile_y != last_tile_y_) {
+      last_tile_ = &getTile(tile_x, tile_y);
+      last_tile_x_ = tile_x;
+      last_tile_y_ = tile_y;
+    }
+    if (last_tile_->empty()) return false;
+    const auto local_x = cell_x - tile_x * tile_size_;
+    const auto local_y = cell_y - tile_y * tile_size_;
+    const auto bit = static_cast<std::size_t>(local_y * tile_size_ + local_x);
+    return ((*last_tile_)[bit >> 6] >> (bit & 63)) & 1U;
+  }
+
+  size_t getTileCount() const { return tiles_.size(); }
+
+private:
+  // one bit per cell, row major, empty if no lanelet overlaps the tile
+  using Tile = std::vector<std::uint64_t>;
+
+  struct Box
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  static std::int64_t floorDiv(const std::int64_t a, const std::int64_t b)
+  {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+  }
+
+  const Tile & getTile(const std::int64_t tile_x, const std::int64_t tile_y);
+  void rasterizeTile(const std::int64_t tile_x, const std::int64_t tile_y, Tile & tile);
+
+  double resolution_;
+  double inv_resolution_;
+  std::int64_t tile_size_;
+  size_t max_tile_count_;
+
+  std::vector<lanelet::BasicPolygon2d> polygons_;
+  std::vector<Box> bounding_boxes_;
+
+  std::unordered_map<std::uint64_t, Tile> tiles_;
+  const Tile * last_tile_{nullptr};
+  std::int64_t last_tile_x_{0};
+  std::int64_t last_tile_y_{0};
+
+  // scan line crossings, reused across rows
+  std::vector<double> crossings_;
+};
+
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET_RASTER_MASK_HPP_
@@ -16,15 +16,27 @@
 
 #include "autoware_point_types/types.hpp"
 
-#include <boost/circular_buffer.hpp>
-
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
 
 namespace pointcloud_preprocessor
 {
 using autoware_point_types::PointXYZIRADRT;
 using diagnostic_msgs::msg::DiagnosticStatus;
 
+namespace
+{
+template <class T>
+T readField(const uint8_t * point, const size_t offset)
+{
+  T value;
+  std::memcpy(&value, point + offset, sizeof(T));
+  return value;
+}
+}  // namespace
+
 BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options)
 : Filter("BlockageDiag", options)
 {
@@ -61,6 +73,11 @@ BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&BlockageDiagComponent::paramCallback, this, _1));
+
+  pcl::toROSMsg(pcl::PointCloud<PointXYZIRADRT>(), point_layout_);
+  erode_element_ = cv::getStructuringElement(
+    cv::MORPH_RECT, cv::Size(2 * erode_kernel_ + 1, 2 * erode_kernel_ + 1),
+    cv::Point(erode_kernel_, erode_kernel_));
 }
 
 void BlockageDiagComponent::onBlockageChecker(DiagnosticStatusWrapper & stat)
@@ -105,6 +122,100 @@ void BlockageDiagComponent::onBlockageChecker(DiagnosticStatusWrapper & stat)
   stat.summary(level, msg);
 }
 
+const sensor_msgs::msg::PointCloud2 & BlockageDiagComponent::toPointXYZIRADRTLayout(
+  const PointCloud2 & input)
+{
+  if (
+    !input.is_bigendian && input.point_step == point_layout_.point_step &&
+    input.fields == point_layout_.fields) {
+    return input;
+  }
+  pcl::PointCloud<PointXYZIRADRT> pcl_input;
+  pcl::fromROSMsg(input, pcl_input);
+  pcl::toROSMsg(pcl_input, converted_input_);
+  return converted_input_;
+}
+
+void BlockageDiagComponent::updateDepthImages(const PointCloud2 & input)
+{
+  lidar_depth_map_.setTo(0);
+  return_mask_.setTo(0);
+  const bool is_pandar_qt = lidar_model_ == "PandarQT";
+  if (!is_pandar_qt && lidar_model_ != "Pandar40P") {
+    return;
+  }
+
+  const uint horizontal_bins = static_cast<uint>(lidar_depth_map_.cols);
+  const uint vertical_bins = static_cast<uint>(lidar_depth_map_.rows);
+  const size_t nb_points = static_cast<size_t>(input.width) * input.height;
+  for (size_t i = 0; i < nb_points; ++i) {
+    const uint8_t * point = input.data.data() + i * input.point_step;
+    const double azimuth_deg =
+      readField<float>(point, offsetof(PointXYZIRADRT, azimuth)) / 100.0;
+    if (!((azimuth_deg > angle_range_deg_[0]) && (azimuth_deg < angle_range_deg_[1]))) {
+      continue;
+    }
+    const uint ring = readField<uint16_t>(point, offsetof(PointXYZIRADRT, ring));
+    const auto col = static_cast<uint>((azimuth_deg - angle_range_deg_[0]));
+    if (ring >= vertical_bins || col >= horizontal_bins) {
+      continue;
+    }
+    const uint row = is_pandar_qt ? vertical_bins - ring - 1 : ring;
+    const float distance = readField<float>(point, offsetof(PointXYZIRADRT, distance));
+    lidar_depth_map_.at<uint16_t>(row, col) +=
+      static_cast<uint16_t>(6250.0 / distance);  // make image clearly
+    return_mask_.at<uint8_t>(row, col) = 255;
+  }
+}
+
+void BlockageDiagComponent::updateTimeSeriesBlockageMask()
+{
+  const size_t nb_pixels = no_return_mask_.total();
+  if (
+    no_return_mask_buffer_.capacity() != buffering_frames_ ||
+    no_return_count_.size() != nb_pixels) {
+    no_return_mask_buffer_.set_capacity(buffering_frames_);
+    no_return_mask_buffer_.clear();
+    no_return_count_.assign(nb_pixels, 0);
+  }
+
+  frame_count_++;
+  if (frame_count_ >= buffering_interval_) {
+    frame_count_ = 0;
+    BinaryMask mask;
+    if (no_return_mask_buffer_.full() && !no_return_mask_buffer_.empty()) {
+      // remove the oldest mask from the counts and reuse its memory
+      mask = std::move(no_return_mask_buffer_.front());
+      no_return_mask_buffer_.pop_front();
+      for (size_t word = 0; word < mask.size(); ++word) {
+        for (uint64_t bits = mask[word]; bits != 0; bits &= bits - 1) {
+          --no_return_count_[word * 64 + __builtin_ctzll(bits)];
+        }
+      }
+    }
+    mask.assign((nb_pixels + 63) / 64, 0);
+    const uint8_t * no_return = no_return_mask_.ptr<uint8_t>();
+    for (size_t i = 0; i < nb_pixels; ++i) {
+      if (no_return[i] != 0) {
+        mask[i / 64] |= uint64_t{1} << (i % 64);
+        ++no_return_count_[i];
+      }
+    }
+    no_return_mask_buffer_.push_back(std::move(mask));
+  }
+
+  // a pixel is blocked if it had no return in all the buffered masks but one
+  no_return_mask_result_.setTo(0);
+  if (no_return_mask_buffer_.empty()) {
+    return;
+  }
+  const size_t min_count = no_return_mask_buffer_.size() - 1;
+  uint8_t * result = no_return_mask_result_.ptr<uint8_t>();
+  for (size_t i = 0; i < nb_pixels; ++i) {
+    result[i] = no_return_count_[i] >= min_count ? 255 : 0;
+  }
+}
+
 void BlockageDiagComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
@@ -112,11 +223,8 @@ void BlockageDiagComponent::filter(
   std::scoped_lock lock(mutex_);
   uint horizontal_bins = static_cast<uint>((angle_range_deg_[1] - angle_range_deg_[0]));
   uint vertical_bins = vertical_bins_;
-  pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_input(new pcl::PointCloud<PointXYZIRADRT>);
-  pcl::fromROSMsg(*input, *pcl_input);
-  cv::Mat lidar_depth_map(cv::Size(horizontal_bins, vertical_bins), CV_16UC1, cv::Scalar(0));
-  cv::Mat lidar_depth_map_8u(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-  if (pcl_input->points.empty()) {
+  const auto & cloud = toPointXYZIRADRTLayout(*input);
+  if (cloud.width * cloud.height == 0) {
     ground_blockage_ratio_ = 1.0f;
     sky_blockage_ratio_ = 1.0f;
     if (ground_blockage_count_ <= 2 * blockage_count_threshold_) {
@@ -130,68 +238,26 @@ void BlockageDiagComponent::filter(
     sky_blockage_range_deg_[0] = angle_range_deg_[0];
     sky_blockage_range_deg_[1] = angle_range_deg_[1];
   } else {
-    for (const auto & p : pcl_input->points) {
-      if ((p.azimuth / 100.0 > angle_range_deg_[0]) && (p.azimuth / 100.0 < angle_range_deg_[1])) {
-        if (lidar_model_ == "Pandar40P") {
-          lidar_depth_map.at<uint16_t>(
-            p.ring, static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) +=
-            static_cast<uint16_t>(6250.0 / p.distance);  // make image clearly
-          lidar_depth_map_8u.at<uint8_t>(
-            p.ring, static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) = 255;
-        } else if (lidar_model_ == "PandarQT") {
-          lidar_depth_map.at<uint16_t>(
-            vertical_bins - p.ring - 1,
-            static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) +=
-            static_cast<uint16_t>(6250.0 / p.distance);
-          lidar_depth_map_8u.at<uint8_t>(
-            vertical_bins - p.ring - 1,
-            static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) = 255;
-        }
-      }
-    }
-    lidar_depth_map.convertTo(lidar_depth_map, CV_8UC1, 1.0 / 100.0);
-    cv::Mat no_return_mask;
-    cv::inRange(lidar_depth_map_8u, 0, 1, no_return_mask);
-
-    cv::Mat erosion_dst;
-    cv::Mat element = cv::getStructuringElement(
-      cv::MORPH_RECT, cv::Size(2 * erode_kernel_ + 1, 2 * erode_kernel_ + 1),
-      cv::Point(erode_kernel_, erode_kernel_));
-    cv::erode(no_return_mask, erosion_dst, element);
-    cv::dilate(erosion_dst, no_return_mask, element);
-
-    static boost::circular_buffer<cv::Mat> no_return_mask_buffer(buffering_frames_);
-
-    cv::Mat no_return_mask_result(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-    cv::Mat time_series_blockage_mask(
-      cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-    cv::Mat no_return_mask_binarized(
-      cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-
-    static uint frame_count;
-    frame_count++;
+    // the images are only reallocated when their size changes
+    const cv::Size image_size(horizontal_bins, vertical_bins);
+    lidar_depth_map_.create(image_size, CV_16UC1);
+    return_mask_.create(image_size, CV_8UC1);
+    no_return_mask_result_.create(image_size, CV_8UC1);
+    updateDepthImages(cloud);
+
+    cv::inRange(return_mask_, 0, 1, no_return_mask_);
+    cv::erode(no_return_mask_, erosion_dst_, erode_element_);
+    cv::dilate(erosion_dst_, no_return_mask_, erode_element_);
+
     if (buffering_interval_ != 0) {
-      no_return_mask_binarized = no_return_mask / 255;
-      if (frame_count == buffering_interval_) {
-        no_return_mask_buffer.push_back(no_return_mask_binarized);
-        frame_count = 0;
-      }
-      for (const auto & binary_mask : no_return_mask_buffer) {
-        time_series_blockage_mask += binary_mask;
-      }
-      cv::inRange(
-        time_series_blockage_mask, no_return_mask_buffer.size() - 1, no_return_mask_buffer.size(),
-        no_return_mask_result);
+      updateTimeSeriesBlockageMask();
     } else {
-      no_return_mask.copyTo(no_return_mask_result);
+      no_return_mask_.copyTo(no_return_mask_result_);
     }
-    cv::Mat ground_no_return_mask;
-    cv::Mat sky_no_return_mask;
-    no_return_mask_result(cv::Rect(0, 0, horizontal_bins, horizontal_ring_id_))
-      .copyTo(sky_no_return_mask);
-    no_return_mask_result(
-      cv::Rect(0, horizontal_ring_id_, horizontal_bins, vertical_bins - horizontal_ring_id_))
-      .copyTo(ground_no_return_mask);
+    const cv::Mat sky_no_return_mask =
+      no_return_mask_result_(cv::Rect(0, 0, horizontal_bins, horizontal_ring_id_));
+    const cv::Mat ground_no_return_mask = no_return_mask_result_(
+      cv::Rect(0, horizontal_ring_id_, horizontal_bins, vertical_bins - horizontal_ring_id_));
     ground_blockage_ratio_ =
       static_cast<float>(cv::countNonZero(ground_no_return_mask)) /
       static_cast<float>(horizontal_bins * (vertical_bins - horizontal_ring_id_));
@@ -224,19 +290,25 @@ void BlockageDiagComponent::filter(
       sky_blockage_count_ = 0;
     }
 
-    cv::Mat lidar_depth_colorized;
-    cv::applyColorMap(lidar_depth_map, lidar_depth_colorized, cv::COLORMAP_JET);
-    sensor_msgs::msg::Image::SharedPtr lidar_depth_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", lidar_depth_colorized).toImageMsg();
-    lidar_depth_msg->header = input->header;
-    lidar_depth_map_pub_.publish(lidar_depth_msg);
-
-    cv::Mat blockage_mask_colorized;
-    cv::applyColorMap(no_return_mask_result, blockage_mask_colorized, cv::COLORMAP_JET);
-    sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized).toImageMsg();
-    blockage_mask_msg->header = input->header;
-    blockage_mask_pub_.publish(blockage_mask_msg);
+    // debug images are only made when someone listens to them
+    if (lidar_depth_map_pub_.getNumSubscribers() > 0) {
+      lidar_depth_map_.convertTo(lidar_depth_map_8u_, CV_8UC1, 1.0 / 100.0);
+      cv::Mat lidar_depth_colorized;
+      cv::applyColorMap(lidar_depth_map_8u_, lidar_depth_colorized, cv::COLORMAP_JET);
+      sensor_msgs::msg::Image::SharedPtr lidar_depth_msg =
+        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", lidar_depth_colorized).toImageMsg();
+      lidar_depth_msg->header = input->header;
+      lidar_depth_map_pub_.publish(lidar_depth_msg);
+    }
+
+    if (blockage_mask_pub_.getNumSubscribers() > 0) {
+      cv::Mat blockage_mask_colorized;
+      cv::applyColorMap(no_return_mask_result_, blockage_mask_colorized, cv::COLORMAP_JET);
+      sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
+        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized).toImageMsg();
+      blockage_mask_msg->header = input->header;
+      blockage_mask_pub_.publish(blockage_mask_msg);
+    }
   }
 
   tier4_debug_msgs::msg::Float32Stamped ground_blockage_ratio_msg;
@@ -249,7 +321,7 @@ void BlockageDiagComponent::filter(
   sky_blockage_ratio_msg.stamp = now();
   sky_blockage_ratio_pub_->publish(sky_blockage_ratio_msg);
 
-  pcl::toROSMsg(*pcl_input, output);
+  output = cloud;
   output.header = input->header;
 }
 rcl_interfaces::msg::SetParametersResult BlockageDiagComponent::paramCallback(
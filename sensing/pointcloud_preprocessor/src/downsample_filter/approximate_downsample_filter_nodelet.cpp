@@ -82,7 +82,7 @@ void ApproximateDownsampleFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
   pcl_output->points.reserve(pcl_input->points.size());
-  pcl::VoxelGridNearestCentroid<pcl::PointXYZ> filter;
+  pcl::FlatVoxelGridNearestCentroid<pcl::PointXYZ> filter;
   filter.setInputCloud(pcl_input);
   filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
   filter.filter(*pcl_output);
@@ -23,6 +23,10 @@
 #include <pcl/segmentation/segment_differences.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -32,6 +36,29 @@ using autoware_point_types::PointXYZIRADRT;
 using autoware_point_types::ReturnType;
 using diagnostic_msgs::msg::DiagnosticStatus;
 
+namespace
+{
+constexpr uint32_t horizontal_bins = 36;
+
+template <class T>
+T readField(const sensor_msgs::msg::PointCloud2 & cloud, const uint32_t index, const size_t offset)
+{
+  T value;
+  std::memcpy(&value, cloud.data.data() + index * cloud.point_step + offset, sizeof(T));
+  return value;
+}
+
+float getAzimuth(const sensor_msgs::msg::PointCloud2 & cloud, const uint32_t index)
+{
+  return readField<float>(cloud, index, offsetof(PointXYZIRADRT, azimuth));
+}
+
+float getDistance(const sensor_msgs::msg::PointCloud2 & cloud, const uint32_t index)
+{
+  return readField<float>(cloud, index, offsetof(PointXYZIRADRT, distance));
+}
+}  // namespace
+
 DualReturnOutlierFilterComponent::DualReturnOutlierFilterComponent(
   const rclcpp::NodeOptions & options)
 : Filter("DualReturnOutlierFilter", options)
@@ -78,6 +105,8 @@ DualReturnOutlierFilterComponent::DualReturnOutlierFilterComponent(
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&DualReturnOutlierFilterComponent::paramCallback, this, _1));
+
+  pcl::toROSMsg(pcl::PointCloud<PointXYZIRADRT>(), point_layout_);
 }
 
 void DualReturnOutlierFilterComponent::onVisibilityChecker(DiagnosticStatusWrapper & stat)
@@ -111,19 +140,180 @@ void DualReturnOutlierFilterComponent::onVisibilityChecker(DiagnosticStatusWrapp
   stat.summary(level, msg);
 }
 
+const sensor_msgs::msg::PointCloud2 & DualReturnOutlierFilterComponent::toPointXYZIRADRTLayout(
+  const PointCloud2 & input)
+{
+  if (
+    !input.is_bigendian && input.point_step == point_layout_.point_step &&
+    input.fields == point_layout_.fields) {
+    return input;
+  }
+  pcl::PointCloud<PointXYZIRADRT> pcl_input;
+  pcl::fromROSMsg(input, pcl_input);
+  pcl::toROSMsg(pcl_input, converted_input_);
+  return converted_input_;
+}
+
+void DualReturnOutlierFilterComponent::filterWeakFirstRing(
+  const PointCloud2 & input, const uint32_t * ring_begin, const uint32_t * ring_end,
+  const uint8_t roi_mode, const int ring_id, const float min_azimuth, const float max_azimuth,
+  const uint32_t horizontal_res, RingBuffer & buffer, cv::Mat & frequency_image) const
+{
+  auto & temp_segment = buffer.segment;
+  auto & deleted_azimuths = buffer.deleted_azimuths;
+  const float max_azimuth_diff = max_azimuth_diff_;
+  const auto is_in_xyz_roi = [&](const uint32_t index) {
+    const float x = readField<float>(input, index, offsetof(PointXYZIRADRT, x));
+    const float y = readField<float>(input, index, offsetof(PointXYZIRADRT, y));
+    const float z = readField<float>(input, index, offsetof(PointXYZIRADRT, z));
+    return x > x_min_ && x < x_max_ && y > y_min_ && y < y_max_ && z > z_min_ && z < z_max_;
+  };
+
+  bool keep_next = false;
+  for (auto iter = ring_begin + 1; iter != ring_end - 1; ++iter) {
+    const float distance = getDistance(input, *iter);
+    const float next_distance = getDistance(input, *(iter + 1));
+    const float azimuth = getAzimuth(input, *iter);
+    const float min_dist = std::min(distance, next_distance);
+    const float max_dist = std::max(distance, next_distance);
+    float azimuth_diff = getAzimuth(input, *(iter + 1)) - azimuth;
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+
+    if (max_dist < min_dist * weak_first_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
+      temp_segment.push_back(*iter);
+      keep_next = true;
+    } else if (keep_next) {
+      temp_segment.push_back(*iter);
+      keep_next = false;
+      // Analyze segment points here
+    } else {
+      // Log the deleted azimuth for analysis
+      switch (roi_mode) {
+        case 1:  // base_link xyz-ROI
+        {
+          if (is_in_xyz_roi(*iter)) {
+            deleted_azimuths.push_back(azimuth < 0.f ? 0.f : azimuth);
+            buffer.noise.push_back(*iter);
+          }
+          break;
+        }
+        case 2: {
+          if (azimuth > min_azimuth && azimuth < max_azimuth && distance < max_distance_) {
+            deleted_azimuths.push_back(azimuth < 0.f ? 0.f : azimuth);
+            buffer.noise.push_back(*iter);
+          }
+          break;
+        }
+        default: {
+          deleted_azimuths.push_back(azimuth < 0.f ? 0.f : azimuth);
+          buffer.noise.push_back(*iter);
+          break;
+        }
+      }
+    }
+  }
+  if (deleted_azimuths.empty()) {
+    return;
+  }
+
+  // Analyze last segment points here
+  std::array<int, horizontal_bins> noise_frequency{};
+  uint current_deleted_index = 0;
+  uint current_temp_segment_index = 0;
+  for (uint i = 0; i < noise_frequency.size() - 1; i++) {
+    const uint bin_end = (i + static_cast<uint>(min_azimuth / horizontal_res) + 1) * horizontal_res;
+    while ((uint)deleted_azimuths[current_deleted_index] < bin_end &&
+           current_deleted_index < (deleted_azimuths.size() - 1)) {
+      noise_frequency[i] = noise_frequency[i] + 1;
+      current_deleted_index++;
+    }
+    if (temp_segment.empty()) {
+      continue;
+    }
+    while (true) {
+      const uint32_t index = temp_segment[current_temp_segment_index];
+      const float azimuth = getAzimuth(input, index);
+      if (
+        !((azimuth < 0.f ? 0.f : azimuth) < bin_end &&
+          current_temp_segment_index < (temp_segment.size() - 1))) {
+        break;
+      }
+      if (noise_frequency[i] < weak_first_local_noise_threshold_) {
+        buffer.output.push_back(index);
+      } else {
+        switch (roi_mode) {
+          case 1: {
+            // NOTE: kept as is to give the same output as before, the y condition is never met
+            const float x = readField<float>(input, index, offsetof(PointXYZIRADRT, x));
+            const float y = readField<float>(input, index, offsetof(PointXYZIRADRT, y));
+            const float z = readField<float>(input, index, offsetof(PointXYZIRADRT, z));
+            if (x < x_max_ && x > x_min_ && y > y_max_ && y < y_min_ && z < z_max_ && z > z_min_) {
+              noise_frequency[i] = noise_frequency[i] + 1;
+              buffer.noise.push_back(index);
+            }
+            break;
+          }
+          case 2: {
+            if (
+              azimuth < max_azimuth && azimuth > min_azimuth &&
+              getDistance(input, index) < max_distance_) {
+              noise_frequency[i] = noise_frequency[i] + 1;
+              buffer.noise.push_back(index);
+            }
+            break;
+          }
+          default: {
+            noise_frequency[i] = noise_frequency[i] + 1;
+            buffer.noise.push_back(index);
+            break;
+          }
+        }
+      }
+      current_temp_segment_index++;
+      frequency_image.at<uchar>(ring_id, i) = noise_frequency[i];
+    }
+  }
+}
+
+void DualReturnOutlierFilterComponent::filterRing(
+  const PointCloud2 & input, const uint32_t * ring_begin, const uint32_t * ring_end,
+  RingBuffer & buffer) const
+{
+  const float max_azimuth_diff = max_azimuth_diff_;
+  bool keep_next = false;
+  for (auto iter = ring_begin + 1; iter != ring_end - 1; ++iter) {
+    const float distance = getDistance(input, *iter);
+    const float next_distance = getDistance(input, *(iter + 1));
+    const float min_dist = std::min(distance, next_distance);
+    const float max_dist = std::max(distance, next_distance);
+    float azimuth_diff = getAzimuth(input, *(iter + 1)) - getAzimuth(input, *iter);
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+
+    if (max_dist < min_dist * general_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
+      buffer.output.push_back(*iter);
+      keep_next = true;
+    } else if (keep_next) {
+      buffer.output.push_back(*iter);
+      keep_next = false;
+    } else {
+      buffer.noise.push_back(*iter);
+    }
+  }
+}
+
 void DualReturnOutlierFilterComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_input(new pcl::PointCloud<PointXYZIRADRT>);
-  pcl::fromROSMsg(*input, *pcl_input);
+  const auto & cloud = toPointXYZIRADRTLayout(*input);
+  const uint32_t nb_points = cloud.width * cloud.height;
 
-  uint32_t vertical_bins = vertical_bins_;
-  uint32_t horizontal_bins = 36;
+  const uint32_t vertical_bins = vertical_bins_;
+  const uint8_t roi_mode = roi_mode_map_[roi_mode_];
   float max_azimuth = 36000.0f;
   float min_azimuth = 0.0f;
-  switch (roi_mode_map_[roi_mode_]) {
+  switch (roi_mode) {
     case 2: {
       max_azimuth = max_azimuth_deg_ * 100.0;
       min_azimuth = min_azimuth_deg_ * 100.0;
@@ -139,180 +329,76 @@ void DualReturnOutlierFilterComponent::filter(
 
   uint32_t horizontal_res = static_cast<uint32_t>((max_azimuth - min_azimuth) / horizontal_bins);
 
-  pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_output(new pcl::PointCloud<PointXYZIRADRT>);
-  pcl_output->points.reserve(pcl_input->points.size());
-
-  std::vector<pcl::PointCloud<PointXYZIRADRT>> pcl_input_ring_array;
-  std::vector<pcl::PointCloud<PointXYZIRADRT>> weak_first_pcl_input_ring_array;
-
-  pcl::PointCloud<PointXYZIRADRT>::Ptr noise_output(new pcl::PointCloud<PointXYZIRADRT>);
-  noise_output->points.reserve(pcl_input->points.size());
-  pcl_input_ring_array.resize(
-    vertical_bins);  // TODO(davidw): this is for Pandar 40 only, make dynamic
-  weak_first_pcl_input_ring_array.resize(vertical_bins);
-
-  // Split into 36 x 10 degree bins x 40 lines (TODO: change to dynamic)
-  for (const auto & p : pcl_input->points) {
-    if (p.return_type == ReturnType::DUAL_WEAK_FIRST) {
-      weak_first_pcl_input_ring_array.at(p.ring).push_back(p);
-    } else {
-      pcl_input_ring_array.at(p.ring).push_back(p);
-    }
+  // Split into rings (weak first returns first) with a stable counting sort of the point indexes
+  // TODO(davidw): vertical_bins is for Pandar 40 only, make dynamic
+  const uint32_t nb_rings = 2 * vertical_bins;
+  const auto get_ring = [&](const uint32_t index) -> uint32_t {
+    const auto ring = readField<uint16_t>(cloud, index, offsetof(PointXYZIRADRT, ring));
+    if (ring >= vertical_bins) return nb_rings;  // out of range, ignored
+    const auto return_type =
+      readField<uint8_t>(cloud, index, offsetof(PointXYZIRADRT, return_type));
+    return return_type == ReturnType::DUAL_WEAK_FIRST ? ring : vertical_bins + ring;
+  };
+  ring_offsets_.assign(nb_rings + 2, 0);
+  for (uint32_t i = 0; i < nb_points; ++i) {
+    ++ring_offsets_[get_ring(i) + 1];
+  }
+  std::partial_sum(ring_offsets_.begin(), ring_offsets_.end(), ring_offsets_.begin());
+  ring_indices_.resize(ring_offsets_.back());
+  for (uint32_t i = 0; i < nb_points; ++i) {
+    ring_indices_[ring_offsets_[get_ring(i)]++] = i;
   }
+  // restore the beginning of each ring
+  for (uint32_t ring = nb_rings + 1; ring > 0; --ring) {
+    ring_offsets_[ring] = ring_offsets_[ring - 1];
+  }
+  ring_offsets_[0] = 0;
 
-  float max_azimuth_diff = max_azimuth_diff_;
   cv::Mat frequency_image(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-
-  for (const auto & weak_first_single_ring : weak_first_pcl_input_ring_array) {
-    if (weak_first_single_ring.points.size() < 2) {
+  ring_buffers_.resize(nb_rings);
+#pragma omp parallel for schedule(dynamic)
+  for (int ring = 0; ring < static_cast<int>(nb_rings); ++ring) {
+    auto & buffer = ring_buffers_[ring];
+    buffer.segment.clear();
+    buffer.output.clear();
+    buffer.noise.clear();
+    buffer.deleted_azimuths.clear();
+    const uint32_t * ring_begin = ring_indices_.data() + ring_offsets_[ring];
+    const uint32_t * ring_end = ring_indices_.data() + ring_offsets_[ring + 1];
+    if (ring_end - ring_begin < 2) {
       continue;
     }
-    std::vector<float> deleted_azimuths;
-    std::vector<float> deleted_distances;
-    pcl::PointCloud<PointXYZIRADRT> temp_segment;
-
-    bool keep_next = false;
-    uint ring_id = weak_first_single_ring.points.front().ring;
-    for (auto iter = std::begin(weak_first_single_ring) + 1;
-         iter != std::end(weak_first_single_ring) - 1; ++iter) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      if (max_dist < min_dist * weak_first_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
-        temp_segment.points.push_back(*iter);
-        keep_next = true;
-      } else if (keep_next) {
-        temp_segment.points.push_back(*iter);
-        keep_next = false;
-        // Analyze segment points here
-      } else {
-        // Log the deleted azimuth and its distance for analysis
-        switch (roi_mode_map_[roi_mode_]) {
-          case 1:  // base_link xyz-ROI
-          {
-            if (
-              iter->x > x_min_ && iter->x < x_max_ && iter->y > y_min_ && iter->y < y_max_ &&
-              iter->z > z_min_ && iter->z < z_max_) {
-              deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-              deleted_distances.push_back(iter->distance);
-              noise_output->points.push_back(*iter);
-            }
-            break;
-          }
-          case 2: {
-            if (
-              iter->azimuth > min_azimuth && iter->azimuth < max_azimuth &&
-              iter->distance < max_distance_) {
-              deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-              noise_output->points.push_back(*iter);
-              deleted_distances.push_back(iter->distance);
-            }
-            break;
-          }
-          default: {
-            deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-            deleted_distances.push_back(iter->distance);
-            noise_output->points.push_back(*iter);
-            break;
-          }
-        }
-      }
-    }
-    // Analyze last segment points here
-    std::vector<int> noise_frequency(horizontal_bins, 0);
-    uint current_deleted_index = 0;
-    uint current_temp_segment_index = 0;
-    for (uint i = 0; i < noise_frequency.size() - 1; i++) {
-      if (deleted_azimuths.size() == 0) {
-        continue;
-      }
-      while ((uint)deleted_azimuths[current_deleted_index] <
-               ((i + static_cast<uint>(min_azimuth / horizontal_res) + 1) * horizontal_res) &&
-             current_deleted_index < (deleted_azimuths.size() - 1)) {
-        noise_frequency[i] = noise_frequency[i] + 1;
-        current_deleted_index++;
-      }
-      if (temp_segment.points.size() > 0) {
-        while ((temp_segment.points[current_temp_segment_index].azimuth < 0.f
-                  ? 0.f
-                  : temp_segment.points[current_temp_segment_index].azimuth) <
-                 ((i + 1 + static_cast<uint>(min_azimuth / horizontal_res)) * horizontal_res) &&
-               current_temp_segment_index < (temp_segment.points.size() - 1)) {
-          if (noise_frequency[i] < weak_first_local_noise_threshold_) {
-            pcl_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-          } else {
-            switch (roi_mode_map_[roi_mode_]) {
-              case 1: {
-                if (
-                  temp_segment.points[current_temp_segment_index].x < x_max_ &&
-                  temp_segment.points[current_temp_segment_index].x > x_min_ &&
-                  temp_segment.points[current_temp_segment_index].y > y_max_ &&
-                  temp_segment.points[current_temp_segment_index].y < y_min_ &&
-                  temp_segment.points[current_temp_segment_index].z < z_max_ &&
-                  temp_segment.points[current_temp_segment_index].z > z_min_) {
-                  noise_frequency[i] = noise_frequency[i] + 1;
-                  noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-                }
-                break;
-              }
-              case 2: {
-                if (
-                  temp_segment.points[current_temp_segment_index].azimuth < max_azimuth &&
-                  temp_segment.points[current_temp_segment_index].azimuth > min_azimuth &&
-                  temp_segment.points[current_temp_segment_index].distance < max_distance_) {
-                  noise_frequency[i] = noise_frequency[i] + 1;
-                  noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-                }
-                break;
-              }
-              default: {
-                noise_frequency[i] = noise_frequency[i] + 1;
-                noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-                break;
-              }
-            }
-          }
-          current_temp_segment_index++;
-          frequency_image.at<uchar>(ring_id, i) = noise_frequency[i];
-        }
-      }
+    if (ring < static_cast<int>(vertical_bins)) {
+      filterWeakFirstRing(
+        cloud, ring_begin, ring_end, roi_mode, ring, min_azimuth, max_azimuth, horizontal_res,
+        buffer, frequency_image);
+    } else {
+      filterRing(cloud, ring_begin, ring_end, buffer);
     }
   }
 
-  // Ring outlier filter for normal points
-  for (const auto & input_ring : pcl_input_ring_array) {
-    if (input_ring.size() < 2) {
-      continue;
-    }
-    pcl::PointCloud<PointXYZIRADRT> temp_segment;
-    bool keep_next = false;
-    // uint ring_id = input_ring.points.front().ring;
-    for (auto iter = std::begin(input_ring) + 1; iter != std::end(input_ring) - 1; ++iter) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      if (max_dist < min_dist * general_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
-        temp_segment.points.push_back(*iter);
-        keep_next = true;
-      } else if (keep_next) {
-        temp_segment.points.push_back(*iter);
-        keep_next = false;
-        // Analyze segment points here
-      } else {
-        // Log the deleted azimuth and its distance for analysis
-        // deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-        // deleted_distances.push_back(iter->distance);
-        noise_output->points.push_back(*iter);
+  // Gather the points in ring order, weak first returns first as in the original implementation
+  const auto gather = [&](const auto get_indices, PointCloud2 & gathered) {
+    size_t nb_gathered = 0;
+    for (const auto & buffer : ring_buffers_) nb_gathered += get_indices(buffer).size();
+    gathered.fields = point_layout_.fields;
+    gathered.is_bigendian = false;
+    gathered.is_dense = true;
+    gathered.point_step = point_layout_.point_step;
+    gathered.height = 1;
+    gathered.width = nb_gathered;
+    gathered.row_step = gathered.width * gathered.point_step;
+    gathered.data.resize(gathered.row_step);
+    auto * dst = gathered.data.data();
+    for (const auto & buffer : ring_buffers_) {
+      for (const auto index : get_indices(buffer)) {
+        std::memcpy(dst, cloud.data.data() + index * cloud.point_step, cloud.point_step);
+        dst += cloud.point_step;
       }
     }
-    for (const auto & tmp_p : temp_segment.points) {
-      pcl_output->points.push_back(tmp_p);
-    }
-  }
+  };
+  sensor_msgs::msg::PointCloud2 noise_output_msg;
+  gather([](const RingBuffer & buffer) -> const auto & { return buffer.noise; }, noise_output_msg);
 
   // Threshold for diagnostics (tunable)
   cv::Mat binary_image;
@@ -336,13 +422,11 @@ void DualReturnOutlierFilterComponent::filter(
   visibility_pub_->publish(visibility_msg);
 
   // Publish noise points
-  sensor_msgs::msg::PointCloud2 noise_output_msg;
-  pcl::toROSMsg(*noise_output, noise_output_msg);
   noise_output_msg.header = input->header;
   noise_cloud_pub_->publish(noise_output_msg);
 
   // Publish filtered pointcloud
-  pcl::toROSMsg(*pcl_output, output);
+  gather([](const RingBuffer & buffer) -> const auto & { return buffer.output; }, output);
   output.header = input->header;
 }
 
@@ -50,17 +50,9 @@ void RingOutlierFilterComponent::filter(
 {
   std::scoped_lock lock(mutex_);
   stop_watch_ptr_->toc("processing_time", true);
-  std::unordered_map<uint16_t, std::vector<std::size_t>> input_ring_map;
-  input_ring_map.reserve(128);
-  sensor_msgs::msg::PointCloud2::SharedPtr input_ptr =
-    std::make_shared<sensor_msgs::msg::PointCloud2>(*input);
-
-  const auto ring_offset =
-    input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Ring)).offset;
-  for (std::size_t idx = 0U; idx < input_ptr->data.size(); idx += input_ptr->point_step) {
-    input_ring_map[*reinterpret_cast<uint16_t *>(&input_ptr->data[idx + ring_offset])].push_back(
-      idx);
-  }
+  // read the points in place, and group them by ring keeping the order of the message
+  const PointCloud2View<PointXYZIRADRT> input_view(*input);
+  ring_index_.build(input_view);
 
   PointCloud2Modifier<PointXYZI> output_modifier{output, input->header.frame_id};
   output_modifier.reserve(input->width);
@@ -68,32 +60,38 @@ void RingOutlierFilterComponent::filter(
   std::vector<std::size_t> tmp_indices;
   tmp_indices.reserve(input->width);
 
-  const auto azimuth_offset =
-    input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Azimuth)).offset;
-  const auto distance_offset =
-    input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Distance)).offset;
-  for (const auto & ring_indices : input_ring_map) {
-    if (ring_indices.second.size() < 2) {
+  const auto push_cluster = [&]() {
+    if (isCluster(input_view, tmp_indices)) {
+      for (const auto & tmp_idx : tmp_indices) {
+        output_modifier.push_back(PointXYZI{
+          input_view.get<pcl::fields::x>(tmp_idx), input_view.get<pcl::fields::y>(tmp_idx),
+          input_view.get<pcl::fields::z>(tmp_idx),
+          input_view.get<pcl::fields::intensity>(tmp_idx)});
+      }
+    }
+    tmp_indices.clear();
+  };
+
+  for (std::size_t ring = 0; ring < ring_index_.getNumRings(); ++ring) {
+    const auto * ring_begin = ring_index_.ringBegin(ring);
+    const auto * ring_end = ring_index_.ringEnd(ring);
+    if (ring_end - ring_begin < 2) {
       continue;
     }
 
-    for (size_t idx = 0U; idx < ring_indices.second.size() - 1; ++idx) {
-      const auto & current_idx = ring_indices.second.at(idx);
-      const auto & next_idx = ring_indices.second.at(idx + 1);
+    for (const auto * it = ring_begin; it + 1 != ring_end; ++it) {
+      const std::size_t current_idx = *it;
+      const std::size_t next_idx = *(it + 1);
       tmp_indices.emplace_back(current_idx);
 
       // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08)
-      const auto current_pt_azimuth =
-        *reinterpret_cast<float *>(&input_ptr->data[current_idx + azimuth_offset]);
-      const auto next_pt_azimuth =
-        *reinterpret_cast<float *>(&input_ptr->data[next_idx + azimuth_offset]);
+      const auto current_pt_azimuth = input_view.get<pcl::fields::azimuth>(current_idx);
+      const auto next_pt_azimuth = input_view.get<pcl::fields::azimuth>(next_idx);
       float azimuth_diff = next_pt_azimuth - current_pt_azimuth;
       azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
 
-      const auto current_pt_distance =
-        *reinterpret_cast<float *>(&input_ptr->data[current_idx + distance_offset]);
-      const auto next_pt_distance =
-        *reinterpret_cast<float *>(&input_ptr->data[next_idx + distance_offset]);
+      const auto current_pt_distance = input_view.get<pcl::fields::distance>(current_idx);
+      const auto next_pt_distance = input_view.get<pcl::fields::distance>(next_idx);
 
       if (
         std::max(current_pt_distance, next_pt_distance) <
@@ -101,24 +99,12 @@ void RingOutlierFilterComponent::filter(
         azimuth_diff < 100.f) {
         continue;
       }
-      if (isCluster(input_ptr, tmp_indices)) {
-        for (const auto & tmp_idx : tmp_indices) {
-          output_modifier.push_back(
-            std::move(*reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_idx])));
-        }
-      }
-      tmp_indices.clear();
+      push_cluster();
     }
     if (tmp_indices.empty()) {
       continue;
     }
-    if (isCluster(input_ptr, tmp_indices)) {
-      for (const auto & tmp_idx : tmp_indices) {
-        output_modifier.push_back(
-          std::move(*reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_idx])));
-      }
-    }
-    tmp_indices.clear();
+    push_cluster();
   }
   // add processing time for debug
   if (debug_publisher_) {
@@ -24,6 +24,7 @@
 #include <lanelet2_core/geometry/Polygon.h>
 #include <tf2_ros/create_timer_ros.h>
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -41,6 +42,8 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
   {
     voxel_size_x_ = declare_parameter("voxel_size_x", 0.04);
     voxel_size_y_ = declare_parameter("voxel_size_y", 0.04);
+    use_raster_mask_ = declare_parameter("use_raster_mask", false);
+    raster_mask_resolution_ = declare_parameter("raster_mask_resolution", 0.2);
   }
 
   // Set publisher
@@ -216,11 +219,94 @@ pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointC
   return filtered_cloud;
 }
 
+void Lanelet2MapFilterComponent::filterByRasterMask(const PointCloud2ConstPtr & cloud_msg)
+{
+  // the points are transformed to map frame on the fly and the kept ones are copied untouched,
+  // so that the output keeps the frame and the fields of the input
+  Eigen::Affine3d cloud_to_map = Eigen::Affine3d::Identity();
+  if (cloud_msg->header.frame_id != "map") {
+    try {
+      const auto transform_stamped = tf_buffer_->lookupTransform(
+        "map", cloud_msg->header.frame_id, cloud_msg->header.stamp,
+        rclcpp::Duration::from_seconds(1.0));
+      cloud_to_map = tf2::transformToEigen(transform_stamped.transform);
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR_STREAM_THROTTLE(
+        this->get_logger(), *this->get_clock(), std::chrono::milliseconds(10000).count(),
+        "Failed transform from " << cloud_msg->header.frame_id << " to map: " << ex.what());
+      return;
+    }
+  }
+
+  int x_offset = -1;
+  int y_offset = -1;
+  int z_offset = -1;
+  for (const auto & field : cloud_msg->fields) {
+    if (field.datatype != sensor_msgs::msg::PointField::FLOAT32) {
+      continue;
+    }
+    if (field.name == "x") x_offset = static_cast<int>(field.offset);
+    if (field.name == "y") y_offset = static_cast<int>(field.offset);
+    if (field.name == "z") z_offset = static_cast<int>(field.offset);
+  }
+  if (x_offset < 0 || y_offset < 0 || z_offset < 0 || cloud_msg->is_bigendian) {
+    RCLCPP_ERROR_THROTTLE(
+      this->get_logger(), *this->get_clock(), std::chrono::milliseconds(10000).count(),
+      "Input pointcloud needs float32 x, y and z fields.");
+    return;
+  }
+
+  auto output = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  output->header = cloud_msg->header;
+  output->fields = cloud_msg->fields;
+  output->is_bigendian = false;
+  output->is_dense = true;
+  output->point_step = cloud_msg->point_step;
+  output->height = 1;
+  output->data.resize(
+    static_cast<size_t>(cloud_msg->width) * cloud_msg->height * cloud_msg->point_step);
+
+  const Eigen::Matrix3d rotation = cloud_to_map.linear();
+  const Eigen::Vector3d translation = cloud_to_map.translation();
+  const size_t point_step = cloud_msg->point_step;
+  uint8_t * output_data = output->data.data();
+  size_t nb_output_points = 0;
+  for (uint32_t row = 0; row < cloud_msg->height; ++row) {
+    const uint8_t * row_data = cloud_msg->data.data() + row * cloud_msg->row_step;
+    for (uint32_t col = 0; col < cloud_msg->width; ++col) {
+      const uint8_t * point_data = row_data + col * point_step;
+      float x, y, z;
+      std::memcpy(&x, point_data + x_offset, sizeof(float));
+      std::memcpy(&y, point_data + y_offset, sizeof(float));
+      std::memcpy(&z, point_data + z_offset, sizeof(float));
+      if (std::isnan(x) || std::isnan(y) || std::isnan(z)) {
+        continue;
+      }
+      const double map_x = rotation(0, 0) * x + rotation(0, 1) * y + rotation(0, 2) * z +
+                           translation.x();
+      const double map_y = rotation(1, 0) * x + rotation(1, 1) * y + rotation(1, 2) * z +
+                           translation.y();
+      if (raster_mask_->isInside(map_x, map_y)) {
+        std::memcpy(output_data + nb_output_points * point_step, point_data, point_step);
+        ++nb_output_points;
+      }
+    }
+  }
+  output->width = nb_output_points;
+  output->row_step = nb_output_points * point_step;
+  output->data.resize(output->row_step);
+  filtered_pointcloud_pub_->publish(std::move(output));
+}
+
 void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cloud_msg)
 {
   if (!lanelet_map_ptr_) {
     return;
   }
+  if (use_raster_mask_) {
+    filterByRasterMask(cloud_msg);
+    return;
+  }
   // transform pointcloud to map frame
   PointCloud2Ptr input_transformed_cloud_ptr(new sensor_msgs::msg::PointCloud2);
   if (!transformPointCloud("map", cloud_msg, input_transformed_cloud_ptr.get())) {
@@ -265,6 +351,10 @@ void Lanelet2MapFilterComponent::mapCallback(
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+  if (use_raster_mask_) {
+    // the tiles of the previous map are released with its mask
+    raster_mask_ = std::make_unique<LaneletRasterMask>(road_lanelets_, raster_mask_resolution_);
+  }
 }
 
 }  // namespace pointcloud_preprocessor
@@ -0,0 +1,124 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/vector_map_filter/lanelet_raster_mask.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace pointcloud_preprocessor
+{
+LaneletRasterMask::LaneletRasterMask(
+  const lanelet::ConstLanelets & lanelets, const double resolution, const int tile_size,
+  const size_t max_tile_count)
+: resolution_(resolution),
+  inv_resolution_(1.0 / resolution),
+  tile_size_(tile_size),
+  max_tile_count_(std::max<size_t>(max_tile_count, 1))
+{
+  polygons_.reserve(lanelets.size());
+  bounding_boxes_.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    auto polygon = lanelet.polygon2d().basicPolygon();
+    if (polygon.size() < 3) {
+      continue;
+    }
+    Box box{
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (const auto & p : polygon) {
+      box.min_x = std::min(box.min_x, p.x());
+      box.min_y = std::min(box.min_y, p.y());
+      box.max_x = std::max(box.max_x, p.x());
+      box.max_y = std::max(box.max_y, p.y());
+    }
+    polygons_.push_back(std::move(polygon));
+    bounding_boxes_.push_back(box);
+  }
+}
+
+const LaneletRasterMask::Tile & LaneletRasterMask::getTile(
+  const std::int64_t tile_x, const std::int64_t tile_y)
+{
+  const auto key = (static_cast<std::uint64_t>(tile_x) << 32) ^
+                   (static_cast<std::uint64_t>(tile_y) & 0xFFFFFFFFULL);
+  if (tiles_.size() >= max_tile_count_ && tiles_.count(key) == 0) {
+    // the tiles far from the vehicle are not queried anymore, they are rasterized again if needed
+    tiles_.clear();
+    last_tile_ = nullptr;
+  }
+  const auto [it, inserted] = tiles_.try_emplace(key);
+  if (inserted) {
+    rasterizeTile(tile_x, tile_y, it->second);
+  }
+  return it->second;
+}
+
+void LaneletRasterMask::rasterizeTile(
+  const std::int64_t tile_x, const std::int64_t tile_y, Tile & tile)
+{
+  const std::int64_t first_cell_x = tile_x * tile_size_;
+  const std::int64_t first_cell_y = tile_y * tile_size_;
+  const double tile_min_x = static_cast<double>(first_cell_x) * resolution_;
+  const double tile_min_y = static_cast<double>(first_cell_y) * resolution_;
+  const double tile_max_x = tile_min_x + static_cast<double>(tile_size_) * resolution_;
+  const double tile_max_y = tile_min_y + static_cast<double>(tile_size_) * resolution_;
+
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    const auto & box = bounding_boxes_[i];
+    if (
+      box.max_x < tile_min_x || box.min_x > tile_max_x || box.max_y < tile_min_y ||
+      box.min_y > tile_max_y) {
+      continue;
+    }
+    if (tile.empty()) {
+      tile.assign((tile_size_ * tile_size_ + 63) / 64, 0);
+    }
+
+    // fill the cells whose center is inside the polygon (even-odd rule), row by row
+    const auto & polygon = polygons_[i];
+    const auto row_begin = std::max<std::int64_t>(
+      0, static_cast<std::int64_t>(std::ceil(box.min_y * inv_resolution_ - 0.5)) - first_cell_y);
+    const auto row_end = std::min<std::int64_t>(
+      tile_size_ - 1,
+      static_cast<std::int64_t>(std::floor(box.max_y * inv_resolution_ - 0.5)) - first_cell_y);
+    for (std::int64_t row = row_begin; row <= row_end; ++row) {
+      const double y = (static_cast<double>(first_cell_y + row) + 0.5) * resolution_;
+      crossings_.clear();
+      for (size_t j = 0, k = polygon.size() - 1; j < polygon.size(); k = j++) {
+        const auto & p = polygon[j];
+        const auto & q = polygon[k];
+        if ((p.y() > y) != (q.y() > y)) {
+          crossings_.push_back(p.x() + (y - p.y()) * (q.x() - p.x()) / (q.y() - p.y()));
+        }
+      }
+      std::sort(crossings_.begin(), crossings_.end());
+      for (size_t j = 0; j + 1 < crossings_.size(); j += 2) {
+        const auto col_begin = std::max<std::int64_t>(
+          0, static_cast<std::int64_t>(std::ceil(crossings_[j] * inv_resolution_ - 0.5)) -
+               first_cell_x);
+        const auto col_end = std::min<std::int64_t>(
+          tile_size_ - 1,
+          static_cast<std::int64_t>(std::floor(crossings_[j + 1] * inv_resolution_ - 0.5)) -
+            first_cell_x);
+        for (std::int64_t col = col_begin; col <= col_end; ++col) {
+          const auto bit = static_cast<std::size_t>(row * tile_size_ + col);
+          tile[bit >> 6] |= std::uint64_t{1} << (bit & 63);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace pointcloud_preprocessor
@@ -0,0 +1,136 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/vector_map_filter/lanelet_raster_mask.hpp"
+
+#include <boost/geometry.hpp>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/geometry/Polygon.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using pointcloud_preprocessor::LaneletRasterMask;
+
+constexpr double resolution = 0.2;
+// small tiles of 3.2 m, so that the lanelets cross several tile boundaries
+constexpr int tile_size = 16;
+
+lanelet::LineString3d createLineString(const std::vector<std::pair<double, double>> & points)
+{
+  lanelet::LineString3d line_string(lanelet::utils::getId());
+  for (const auto & [x, y] : points) {
+    line_string.push_back(lanelet::Point3d(lanelet::utils::getId(), x, y, 0.0));
+  }
+  return line_string;
+}
+
+// a bent lanelet crossing the origin, and a lanelet in the negative quadrant
+// NOTE: the vertices are not on the cell centers, so that no cell center is on a boundary
+lanelet::ConstLanelets createLanelets()
+{
+  lanelet::ConstLanelets lanelets;
+  lanelets.push_back(lanelet::Lanelet(
+    lanelet::utils::getId(), createLineString({{-5.03, 1.07}, {0.11, 2.93}, {6.17, 1.21}}),
+    createLineString({{-5.07, -2.13}, {0.13, -0.91}, {6.09, -3.01}})));
+  lanelets.push_back(lanelet::Lanelet(
+    lanelet::utils::getId(), createLineString({{-9.91, -4.03}, {-3.37, -4.47}}),
+    createLineString({{-9.87, -7.93}, {-3.29, -6.61}})));
+  return lanelets;
+}
+
+// reference: the cell center of the point is within a lanelet polygon
+bool isCellCenterWithin(const lanelet::ConstLanelets & lanelets, const double x, const double y)
+{
+  // same rounding of the cell as the mask
+  const double inv_resolution = 1.0 / resolution;
+  const lanelet::BasicPoint2d center(
+    (std::floor(x * inv_resolution) + 0.5) * resolution,
+    (std::floor(y * inv_resolution) + 0.5) * resolution);
+  for (const auto & lanelet : lanelets) {
+    if (boost::geometry::within(center, lanelet.polygon2d().basicPolygon())) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+TEST(LaneletRasterMaskTest, CellCentersAcrossOriginAndTiles)
+{
+  const auto lanelets = createLanelets();
+  LaneletRasterMask mask(lanelets, resolution, tile_size);
+
+  size_t inside_count = 0;
+  for (int iy = -60; iy < 60; ++iy) {
+    for (int ix = -60; ix < 60; ++ix) {
+      const double x = (ix + 0.5) * resolution;
+      const double y = (iy + 0.5) * resolution;
+      const bool expected = isCellCenterWithin(lanelets, x, y);
+      EXPECT_EQ(mask.isInside(x, y), expected) << "x: " << x << ", y: " << y;
+      inside_count += expected;
+    }
+  }
+  EXPECT_GT(inside_count, 0U);
+  // tiles of the negative and positive coordinates
+  EXPECT_GE(mask.getTileCount(), 4U);
+}
+
+TEST(LaneletRasterMaskTest, RandomPoints)
+{
+  const auto lanelets = createLanelets();
+  LaneletRasterMask mask(lanelets, resolution, tile_size);
+
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<double> position_random(-12.0, 12.0);
+  for (size_t i = 0; i < 20000; ++i) {
+    const double x = position_random(random_generator);
+    const double y = position_random(random_generator);
+    EXPECT_EQ(mask.isInside(x, y), isCellCenterWithin(lanelets, x, y))
+      << "x: " << x << ", y: " << y;
+  }
+
+  // points on the tile boundaries
+  for (const double x : {-3.2, 0.0, 3.2}) {
+    for (const double y : {-6.4, -3.2, 0.0, 1.6}) {
+      EXPECT_EQ(mask.isInside(x, y), isCellCenterWithin(lanelets, x, y))
+        << "x: " << x << ", y: " << y;
+    }
+  }
+}
+
+TEST(LaneletRasterMaskTest, BoundedTileCount)
+{
+  const auto lanelets = createLanelets();
+  LaneletRasterMask mask(lanelets, resolution, tile_size, 2);
+
+  // the tiles are rasterized again after the cache is cleared
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int iy = -60; iy < 60; ++iy) {
+      for (int ix = -60; ix < 60; ++ix) {
+        const double x = (ix + 0.5) * resolution;
+        const double y = (iy + 0.5) * resolution;
+        EXPECT_EQ(mask.isInside(x, y), isCellCenterWithin(lanelets, x, y));
+        EXPECT_LE(mask.getTileCount(), 2U);
+      }
+    }
+  }
+}
@@ -0,0 +1,389 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_PCL_EXTENSIONS__FLAT_VOXEL_GRID_NEAREST_CENTROID_HPP_
+#define TIER4_PCL_EXTENSIONS__FLAT_VOXEL_GRID_NEAREST_CENTROID_HPP_
+
+#include <pcl/pcl_config.h>
+
+#if PCL_VERSION < PCL_VERSION_CALC(1, 12, 0)
+#include <pcl/filters/boost.h>
+#endif
+
+#include <pcl/filters/voxel_grid.h>
+#include <pcl/kdtree/kdtree_flann.h>
+#include <pcl/point_types.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace pcl
+{
+/** \brief Same filter as VoxelGridNearestCentroid, each occupied voxel is approximated with the
+ * closest point to its centroid, with a flat voxel structure.
+ * The point indexes are radix sorted by voxel index into one array, so that the centroids and the
+ * closest points are computed in contiguous passes, optionally in parallel over the voxels.
+ * The output is the same as VoxelGridNearestCentroid, voxels are sorted by voxel index.
+ * \note Only the xyz centroid is computed, even if downsample_all_data_ is set.
+ */
+template <typename PointT>
+class FlatVoxelGridNearestCentroid : public VoxelGrid<PointT>
+{
+protected:
+  using VoxelGrid<PointT>::filter_name_;
+  using VoxelGrid<PointT>::getClassName;
+  using VoxelGrid<PointT>::input_;
+  using VoxelGrid<PointT>::indices_;
+  using VoxelGrid<PointT>::filter_limit_negative_;
+  using VoxelGrid<PointT>::filter_limit_min_;
+  using VoxelGrid<PointT>::filter_limit_max_;
+  using VoxelGrid<PointT>::filter_field_name_;
+
+  using VoxelGrid<PointT>::downsample_all_data_;
+  using VoxelGrid<PointT>::leaf_layout_;
+  using VoxelGrid<PointT>::save_leaf_layout_;
+  using VoxelGrid<PointT>::leaf_size_;
+  using VoxelGrid<PointT>::min_b_;
+  using VoxelGrid<PointT>::max_b_;
+  using VoxelGrid<PointT>::inverse_leaf_size_;
+  using VoxelGrid<PointT>::div_b_;
+  // cspell: ignore divb
+  using VoxelGrid<PointT>::divb_mul_;
+
+  typedef typename Filter<PointT>::PointCloud PointCloud;
+  typedef typename PointCloud::Ptr PointCloudPtr;
+  typedef typename PointCloud::ConstPtr PointCloudConstPtr;
+
+public:
+  typedef pcl::shared_ptr<VoxelGrid<PointT>> Ptr;
+  typedef pcl::shared_ptr<const VoxelGrid<PointT>> ConstPtr;
+
+  /** \brief Occupied voxel, its points are point_indices[begin, begin + nr_points)
+   * \note Unlike VoxelGridNearestCentroid::Leaf, the points are not copied into the leaf and the
+   *       centroid is a fixed-size Eigen::Vector4f, see \ref getPointIndices.
+   */
+  struct Leaf
+  {
+    /** \brief Get the number of points contained by this voxel.
+     * \return number of points
+     */
+    int getPointCount() const { return nr_points; }
+
+    /** \brief Voxel index in the grid */
+    std::uint32_t index = 0;
+
+    /** \brief First point of the voxel in the sorted point indexes */
+    std::uint32_t begin = 0;
+
+    /** \brief Number of points contained by voxel */
+    int nr_points = 0;
+
+    /** \brief 3D voxel centroid, the last coefficient is 0 */
+    Eigen::Vector4f centroid = Eigen::Vector4f::Zero();
+
+    /** \brief Index in the input cloud of the closest point to the centroid */
+    std::uint32_t nearest_point = 0;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /** \brief Pointer to FlatVoxelGridNearestCentroid leaf structure */
+  typedef Leaf * LeafPtr;
+
+  /** \brief Const pointer to FlatVoxelGridNearestCentroid leaf structure */
+  typedef const Leaf * LeafConstPtr;
+
+  /** \brief Constructor.
+   * Sets \ref leaf_size_ to 0 and \ref searchable_ to false.
+   */
+  FlatVoxelGridNearestCentroid()
+  : searchable_(true), min_points_per_voxel_(1), nr_threads_(1), voxel_centroids_(), kdtree_()
+  {
+    downsample_all_data_ = false;
+    save_leaf_layout_ = false;
+    leaf_size_.setZero();
+    min_b_.setZero();
+    max_b_.setZero();
+    filter_name_ = "FlatVoxelGridNearestCentroid";
+  }
+
+  /** \brief Set the minimum number of points required for a cell to be used.
+   * \param[in] min_points_per_voxel the minimum number of points for required
+   *                                 for a voxel to be used
+   */
+  inline void setMinPointPerVoxel(int min_points_per_voxel)
+  {
+    if (min_points_per_voxel > 1) {
+      min_points_per_voxel_ = min_points_per_voxel;
+    } else {
+      min_points_per_voxel_ = 1;
+    }
+  }
+
+  /** \brief Get the minimum number of points required for a cell to be used.
+   * \return the minimum number of points for required for a voxel to be used
+   */
+  inline int getMinPointPerVoxel() { return min_points_per_voxel_; }
+
+  /** \brief Set the number of threads used over the voxels, 0 to use all the hardware threads.
+   * \note Only used if compiled with OpenMP.
+   */
+  inline void setNumberOfThreads(unsigned int nr_threads) { nr_threads_ = nr_threads; }
+
+  /** \brief Filter cloud and initializes voxel structure.
+   * \param[out] output cloud containing centroids of voxels containing a sufficient number of
+   * points \param[in] searchable flag if voxel structure is searchable, if true then kdtree is
+   * built
+   */
+  inline void filter(PointCloud & output, bool searchable = false)
+  {
+    searchable_ = searchable;
+    applyFilter(output);
+
+    voxel_centroids_ = PointCloudPtr(new PointCloud(output));
+
+    if (searchable_ && voxel_centroids_->size() > 0) {
+      // Initiates kdtree of the centroids of voxels containing a sufficient number of points
+      kdtree_.setInputCloud(voxel_centroids_);
+    }
+  }
+
+  /** \brief Initializes voxel structure.
+   * \param[in] searchable flag if voxel structure is searchable, if true then kdtree is built
+   */
+  inline void filter(bool searchable = false)
+  {
+    searchable_ = searchable;
+    voxel_centroids_ = PointCloudPtr(new PointCloud);
+    applyFilter(*voxel_centroids_);
+
+    if (searchable_ && voxel_centroids_->size() > 0) {
+      // Initiates kdtree of the centroids of voxels containing a sufficient number of points
+      kdtree_.setInputCloud(voxel_centroids_);
+    }
+  }
+
+  /** \brief Get the voxel with the given index.
+   * \param[in] index the index of the leaf structure node
+   * \return const pointer to leaf structure
+   */
+  inline LeafConstPtr getLeaf(int index)
+  {
+    const auto leaf_iter = std::lower_bound(
+      leaves_.begin(), leaves_.end(), static_cast<std::uint32_t>(index),
+      [](const Leaf & leaf, const std::uint32_t i) { return leaf.index < i; });
+    if (leaf_iter != leaves_.end() && leaf_iter->index == static_cast<std::uint32_t>(index)) {
+      return &(*leaf_iter);
+    }
+    return NULL;
+  }
+
+  /** \brief Get the voxel containing point p.
+   * \param[in] p the point to get the leaf structure at
+   * \return const pointer to leaf structure
+   */
+  inline LeafConstPtr getLeaf(PointT & p)
+  {
+    Eigen::Vector3f point(p.x, p.y, p.z);
+    return getLeaf(point);
+  }
+
+  /** \brief Get the voxel containing point p.
+   * \param[in] p the point to get the leaf structure at
+   * \return const pointer to leaf structure
+   */
+  inline LeafConstPtr getLeaf(Eigen::Vector3f & p)
+  {
+    // Generate index associated with p
+    int ijk0 = static_cast<int>(floor(p[0] * inverse_leaf_size_[0]) - min_b_[0]);
+    int ijk1 = static_cast<int>(floor(p[1] * inverse_leaf_size_[1]) - min_b_[1]);
+    int ijk2 = static_cast<int>(floor(p[2] * inverse_leaf_size_[2]) - min_b_[2]);
+    if (
+      ijk0 < 0 || ijk1 < 0 || ijk2 < 0 || ijk0 >= div_b_[0] || ijk1 >= div_b_[1] ||
+      ijk2 >= div_b_[2]) {
+      return NULL;
+    }
+
+    // Compute the centroid leaf index
+    return getLeaf(ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2]);
+  }
+
+  /** \brief Get the occupied voxels sorted by voxel index
+   * \return a vector containing all leaves
+   */
+  inline const std::vector<Leaf, Eigen::aligned_allocator<Leaf>> & getLeaves() { return leaves_; }
+
+  /** \brief Get the input point indexes sorted by voxel, see \ref Leaf::begin */
+  inline const std::vector<std::uint32_t> & getPointIndices() { return point_indices_; }
+
+  /** \brief Get a pointcloud containing the voxel centroids
+   * \note Only voxels containing a sufficient number of points are used.
+   * \return a map containing all leaves
+   */
+  inline PointCloudPtr getCentroids() { return voxel_centroids_; }
+
+  /** \brief Search for the k-nearest occupied voxels for the given query point.
+   * \note Only voxels containing a sufficient number of points are used.
+   * \param[in] point the given query point
+   * \param[in] k the number of neighbors to search for
+   * \param[out] k_leaves the resultant leaves of the neighboring points
+   * \param[out] k_sqr_distances the resultant squared distances to the neighboring points
+   * \return number of neighbors found
+   */
+  int nearestKSearch(
+    const PointT & point, int k, std::vector<LeafConstPtr> & k_leaves,
+    std::vector<float> & k_sqr_distances)
+  {
+    k_leaves.clear();
+
+    // Check if kdtree has been built
+    if (!searchable_) {
+      PCL_WARN("%s: Not Searchable", this->getClassName().c_str());
+      return 0;
+    }
+
+    // Find k-nearest neighbors in the occupied voxel centroid cloud
+    std::vector<int> k_indices;
+    k = kdtree_.nearestKSearch(point, k, k_indices, k_sqr_distances);
+
+    // Find leaves corresponding to neighbors
+    k_leaves.reserve(k);
+    for (const int index : k_indices) {
+      k_leaves.push_back(&leaves_[voxel_centroids_leaf_indices_[index]]);
+    }
+    return k;
+  }
+
+  /** \brief Search for the k-nearest occupied voxels for the given query point.
+   * \note Only voxels containing a sufficient number of points are used.
+   * \param[in] cloud the given query point
+   * \param[in] index the index
+   * \param[in] k the number of neighbors to search for
+   * \param[out] k_leaves the resultant leaves of the neighboring points
+   * \param[out] k_sqr_distances the resultant squared distances to the neighboring points
+   * \return number of neighbors found
+   */
+  inline int nearestKSearch(
+    const PointCloud & cloud, int index, int k, std::vector<LeafConstPtr> & k_leaves,
+    std::vector<float> & k_sqr_distances)
+  {
+    if (index >= static_cast<int>(cloud.points.size()) || index < 0) {
+      return 0;
+    }
+    return nearestKSearch(cloud.points[index], k, k_leaves, k_sqr_distances);
+  }
+
+  /** \brief Search for all the nearest occupied voxels of the query point in a given radius.
+   * \note Only voxels containing a sufficient number of points are used.
+   * \param[in] point the given query point
+   * \param[in] radius the radius of the sphere bounding all of p_q's neighbors
+   * \param[out] k_leaves the resultant leaves of the neighboring points
+   * \param[out] k_sqr_distances the resultant squared distances to the neighboring points
+   * \param[in] max_nn
+   * \return number of neighbors found
+   */
+  int radiusSearch(
+    const PointT & point, double radius, std::vector<LeafConstPtr> & k_leaves,
+    std::vector<float> & k_sqr_distances, unsigned int max_nn = 0)
+  {
+    k_leaves.clear();
+
+    // Check if kdtree has been built
+    if (!searchable_) {
+      PCL_WARN("%s: Not Searchable", this->getClassName().c_str());
+      return 0;
+    }
+
+    // Find neighbors within radius in the occupied voxel centroid cloud
+    std::vector<int> k_indices;
+    int k = kdtree_.radiusSearch(point, radius, k_indices, k_sqr_distances, max_nn);
+
+    // Find leaves corresponding to neighbors
+    k_leaves.reserve(k);
+    for (const int index : k_indices) {
+      k_leaves.push_back(&leaves_[voxel_centroids_leaf_indices_[index]]);
+    }
+    return k;
+  }
+
+  /** \brief Search for all the nearest occupied voxels of the query point in a given radius.
+   * \note Only voxels containing a sufficient number of points are used.
+   * \param[in] cloud the given query point
+   * \param[in] index a valid index in cloud representing a valid (i.e., finite) query point
+   * \param[in] radius the radius of the sphere bounding all of p_q's neighbors
+   * \param[out] k_leaves the resultant leaves of the neighboring points
+   * \param[out] k_sqr_distances the resultant squared distances to the neighboring points
+   * \param[in] max_nn
+   * \return number of neighbors found
+   */
+  inline int radiusSearch(
+    const PointCloud & cloud, int index, double radius, std::vector<LeafConstPtr> & k_leaves,
+    std::vector<float> & k_sqr_distances, unsigned int max_nn = 0)
+  {
+    if (index >= static_cast<int>(cloud.points.size()) || index < 0) {
+      return 0;
+    }
+    return radiusSearch(cloud.points[index], radius, k_leaves, k_sqr_distances, max_nn);
+  }
+
+protected:
+  /** \brief Filter cloud and initializes voxel structure.
+   * \param[out] output cloud containing centroids of voxels containing a sufficient
+   *                    number of points
+   */
+  void applyFilter(PointCloud & output);
+
+  /** \brief Sort \ref sort_keys_ (voxel index in the high 32 bits, point index in the low 32
+   *         bits) by voxel index, with a stable LSD radix sort on the bytes that are used. */
+  void radixSortByVoxel(const std::uint32_t max_voxel_index);
+
+  /** \brief Flag to determine if voxel structure is searchable. */
+  bool searchable_;
+
+  /** \brief Minimum points contained with in a voxel to allow it to be useable. */
+  int min_points_per_voxel_;
+
+  /** \brief Number of threads used over the voxels. */
+  unsigned int nr_threads_;
+
+  /** \brief Occupied voxels sorted by voxel index (includes voxels with less than
+   *         a sufficient number of points). */
+  std::vector<Leaf, Eigen::aligned_allocator<Leaf>> leaves_;
+
+  /** \brief Input point indexes sorted by voxel index. */
+  std::vector<std::uint32_t> point_indices_;
+
+  /** \brief Radix sort buffers, reused across calls. */
+  std::vector<std::uint64_t> sort_keys_;
+  std::vector<std::uint64_t> sort_buffer_;
+
+  /** \brief Point cloud containing centroids of voxels containing atleast
+   *         minimum number of points. */
+  PointCloudPtr voxel_centroids_;
+
+  /** \brief Positions in \ref leaves_ of the leaves associated with each point in
+   *         \ref voxel_centroids_ (used for searching). */
+  std::vector<int> voxel_centroids_leaf_indices_;
+
+  /** \brief KdTree generated using \ref voxel_centroids_ (used for searching). */
+  KdTreeFLANN<PointT> kdtree_;
+};
+}  // namespace pcl
+
+#ifdef PCL_NO_PRECOMPILE
+#include "tier4_pcl_extensions/flat_voxel_grid_nearest_centroid_impl.hpp"
+#endif
+
+#endif  // TIER4_PCL_EXTENSIONS__FLAT_VOXEL_GRID_NEAREST_CENTROID_HPP_
@@ -0,0 +1,250 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_PCL_EXTENSIONS__FLAT_VOXEL_GRID_NEAREST_CENTROID_IMPL_HPP_
+#define TIER4_PCL_EXTENSIONS__FLAT_VOXEL_GRID_NEAREST_CENTROID_IMPL_HPP_
+
+#include "tier4_pcl_extensions/flat_voxel_grid_nearest_centroid.hpp"
+
+#include <pcl/common/common.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT>
+void pcl::FlatVoxelGridNearestCentroid<PointT>::radixSortByVoxel(
+  const std::uint32_t max_voxel_index)
+{
+  sort_buffer_.resize(sort_keys_.size());
+  for (int shift = 32; shift < 64; shift += 8) {
+    // skip the bytes which are 0 for all the voxels
+    if ((static_cast<std::uint64_t>(max_voxel_index) << 32) >> shift == 0) {
+      break;
+    }
+    std::array<std::size_t, 257> offsets{};
+    for (const auto key : sort_keys_) {
+      ++offsets[((key >> shift) & 0xFF) + 1];
+    }
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+    for (const auto key : sort_keys_) {
+      sort_buffer_[offsets[(key >> shift) & 0xFF]++] = key;
+    }
+    sort_keys_.swap(sort_buffer_);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT>
+void pcl::FlatVoxelGridNearestCentroid<PointT>::applyFilter(PointCloud & output)
+{
+  // Has the input dataset been set already?
+  if (!input_) {
+    PCL_WARN("[pcl::%s::applyFilter] No input dataset given!\n", getClassName().c_str());
+    output.width = output.height = 0;
+    output.points.clear();
+    return;
+  }
+
+  // Copy the header (and thus the frame_id) + allocate enough space for points
+  output.height = 1;       // downsampling breaks the organized structure
+  output.is_dense = true;  // we filter out invalid points
+  output.points.clear();
+  leaves_.clear();
+  point_indices_.clear();
+  voxel_centroids_leaf_indices_.clear();
+
+  Eigen::Vector4f min_p, max_p;
+  // Get the minimum and maximum dimensions
+  if (!filter_field_name_.empty()) {  // If we don't want to process the entire cloud...
+    getMinMax3D<PointT>(
+      input_, filter_field_name_, static_cast<float>(filter_limit_min_),
+      static_cast<float>(filter_limit_max_), min_p, max_p, filter_limit_negative_);
+  } else {
+    getMinMax3D<PointT>(*input_, min_p, max_p);
+  }
+
+  // Check that the leaf size is not too small, given the size of the data
+  std::int64_t dx = static_cast<std::int64_t>((max_p[0] - min_p[0]) * inverse_leaf_size_[0]) + 1;
+  std::int64_t dy = static_cast<std::int64_t>((max_p[1] - min_p[1]) * inverse_leaf_size_[1]) + 1;
+  std::int64_t dz = static_cast<std::int64_t>((max_p[2] - min_p[2]) * inverse_leaf_size_[2]) + 1;
+
+  if ((dx * dy * dz) > std::numeric_limits<std::int32_t>::max()) {
+    PCL_WARN(
+      "[pcl::%s::applyFilter] Leaf size is too small for the input dataset. Integer indices would "
+      "overflow.",  // NOLINT
+      getClassName().c_str());
+    output.clear();
+    return;
+  }
+
+  // Compute the minimum and maximum bounding box values
+  min_b_[0] = static_cast<int>(floor(min_p[0] * inverse_leaf_size_[0]));
+  max_b_[0] = static_cast<int>(floor(max_p[0] * inverse_leaf_size_[0]));
+  min_b_[1] = static_cast<int>(floor(min_p[1] * inverse_leaf_size_[1]));
+  max_b_[1] = static_cast<int>(floor(max_p[1] * inverse_leaf_size_[1]));
+  min_b_[2] = static_cast<int>(floor(min_p[2] * inverse_leaf_size_[2]));
+  max_b_[2] = static_cast<int>(floor(max_p[2] * inverse_leaf_size_[2]));
+
+  // Compute the number of divisions needed along all axis
+  div_b_ = max_b_ - min_b_ + Eigen::Vector4i::Ones();
+  div_b_[3] = 0;
+
+  // cspell: ignore divb
+  // Set up the division multiplier
+  divb_mul_ = Eigen::Vector4i(1, div_b_[0], div_b_[0] * div_b_[1], 0);
+
+  // Get the distance field offset if we don't want to process the entire cloud
+  std::vector<pcl::PCLPointField> fields;
+  int distance_idx = -1;
+  if (!filter_field_name_.empty()) {
+    distance_idx = pcl::getFieldIndex<PointT>(filter_field_name_, fields);
+    if (distance_idx == -1) {
+      PCL_WARN(
+        "[pcl::%s::applyFilter] Invalid filter field name. Index is %d.\n", getClassName().c_str(),
+        distance_idx);
+    }
+  }
+
+  // First pass: compute the voxel index of every valid point
+  const auto & points = input_->points;
+  sort_keys_.clear();
+  sort_keys_.reserve(points.size());
+  std::uint32_t max_voxel_index = 0;
+  for (std::size_t cp = 0; cp < points.size(); ++cp) {
+    const auto & point = points[cp];
+    if (!input_->is_dense) {
+      // Check if the point is invalid
+      if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+        continue;
+      }
+    }
+
+    if (distance_idx != -1) {
+      // Get the distance value
+      const std::uint8_t * pt_data = reinterpret_cast<const std::uint8_t *>(&point);
+      float distance_value = 0;
+      memcpy(&distance_value, pt_data + fields[distance_idx].offset, sizeof(float));
+
+      if (filter_limit_negative_) {
+        // Use a threshold for cutting out points which inside the interval
+        if ((distance_value < filter_limit_max_) && (distance_value > filter_limit_min_)) {
+          continue;
+        }
+      } else {
+        // Use a threshold for cutting out points which are too close/far away
+        if ((distance_value > filter_limit_max_) || (distance_value < filter_limit_min_)) {
+          continue;
+        }
+      }
+    }
+
+    int ijk0 =
+      static_cast<int>(floor(point.x * inverse_leaf_size_[0]) - static_cast<float>(min_b_[0]));
+    int ijk1 =
+      static_cast<int>(floor(point.y * inverse_leaf_size_[1]) - static_cast<float>(min_b_[1]));
+    int ijk2 =
+      static_cast<int>(floor(point.z * inverse_leaf_size_[2]) - static_cast<float>(min_b_[2]));
+
+    // Compute the centroid leaf index
+    const auto idx =
+      static_cast<std::uint32_t>(ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2]);
+    max_voxel_index = std::max(max_voxel_index, idx);
+    sort_keys_.push_back((static_cast<std::uint64_t>(idx) << 32) | cp);
+  }
+
+  // Sort the points by voxel, points of the same voxel stay in input order
+  radixSortByVoxel(max_voxel_index);
+  point_indices_.resize(sort_keys_.size());
+  for (std::size_t i = 0; i < sort_keys_.size(); ++i) {
+    const auto voxel_index = static_cast<std::uint32_t>(sort_keys_[i] >> 32);
+    point_indices_[i] = static_cast<std::uint32_t>(sort_keys_[i] & 0xFFFFFFFF);
+    if (leaves_.empty() || leaves_.back().index != voxel_index) {
+      Leaf leaf;
+      leaf.index = voxel_index;
+      leaf.begin = static_cast<std::uint32_t>(i);
+      leaves_.push_back(leaf);
+    }
+    ++leaves_.back().nr_points;
+  }
+
+  // Second pass: compute the centroid and the closest point of each voxel
+  const auto nr_leaves = static_cast<std::int64_t>(leaves_.size());
+#ifdef _OPENMP
+  const int nr_threads = nr_threads_ == 0 ? omp_get_num_procs() : static_cast<int>(nr_threads_);
+#pragma omp parallel for num_threads(nr_threads) schedule(static, 256)
+#endif
+  for (std::int64_t l = 0; l < nr_leaves; ++l) {
+    Leaf & leaf = leaves_[l];
+    const std::uint32_t * leaf_points = point_indices_.data() + leaf.begin;
+    Eigen::Vector4f centroid = Eigen::Vector4f::Zero();
+    for (int i = 0; i < leaf.nr_points; ++i) {
+      const auto & p = points[leaf_points[i]];
+      centroid += Eigen::Vector4f(p.x, p.y, p.z, 0);
+    }
+    centroid /= static_cast<float>(leaf.nr_points);
+    leaf.centroid = centroid;
+
+    float min_squared_distance = std::numeric_limits<float>::max();
+    for (int i = 0; i < leaf.nr_points; ++i) {
+      const auto & p = points[leaf_points[i]];
+      const float squared_distance = (p.x - centroid[0]) * (p.x - centroid[0]) +
+                                     (p.y - centroid[1]) * (p.y - centroid[1]) +
+                                     (p.z - centroid[2]) * (p.z - centroid[2]);
+      if (squared_distance < min_squared_distance || i == 0) {
+        min_squared_distance = squared_distance;
+        leaf.nearest_point = leaf_points[i];
+      }
+    }
+  }
+
+  // Third pass: output the voxels containing sufficient points, in voxel index order
+  output.points.reserve(leaves_.size());
+  if (searchable_) {
+    voxel_centroids_leaf_indices_.reserve(leaves_.size());
+  }
+  int cp = 0;
+  if (save_leaf_layout_) {
+    leaf_layout_.assign(div_b_[0] * div_b_[1] * div_b_[2], -1);
+  }
+  for (std::int64_t l = 0; l < nr_leaves; ++l) {
+    const Leaf & leaf = leaves_[l];
+    if (leaf.nr_points < min_points_per_voxel_) {
+      continue;
+    }
+    if (save_leaf_layout_) {
+      leaf_layout_[leaf.index] = cp++;
+    }
+    output.push_back(points[leaf.nearest_point]);
+
+    // Stores the leaf positions for fast access searching
+    if (searchable_) {
+      voxel_centroids_leaf_indices_.push_back(static_cast<int>(l));
+    }
+  }
+  output.width = static_cast<std::uint32_t>(output.points.size());
+}
+
+#define PCL_INSTANTIATE_FlatVoxelGridNearestCentroid(T) \
+  template class PCL_EXPORTS pcl::FlatVoxelGridNearestCentroid<T>;
+
+#endif  // TIER4_PCL_EXTENSIONS__FLAT_VOXEL_GRID_NEAREST_CENTROID_IMPL_HPP_
@@ -1,4 +1,4 @@
-// Copyright 2021 Tier IV, Inc.
+// Copyright 2022 Tier IV, Inc.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,11 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef OBJECT_ASSOCIATION_MERGER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_HPP_
-#define OBJECT_ASSOCIATION_MERGER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_HPP_
+#include "tier4_pcl_extensions/flat_voxel_grid_nearest_centroid_impl.hpp"
 
-#include "object_association_merger/data_association/solver/gnn_solver_interface.hpp"
-#include "object_association_merger/data_association/solver/mu_successive_shortest_path.hpp"
-#include "object_association_merger/data_association/solver/successive_shortest_path.hpp"
+#include <pcl/filters/impl/voxel_grid.hpp>
 
-#endif  // OBJECT_ASSOCIATION_MERGER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_HPP_
+#ifndef PCL_NO_PRECOMPILE
+#include <pcl/impl/instantiate.hpp>
+
+#include <pcl/point_types.h>
+
+// Instantiations of specific point types
+PCL_INSTANTIATE(FlatVoxelGridNearestCentroid, PCL_XYZ_POINT_TYPES)
+
+#endif  // PCL_NO_PRECOMPILE
@@ -0,0 +1,124 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_pcl_extensions/flat_voxel_grid_nearest_centroid.hpp"
+#include "tier4_pcl_extensions/voxel_grid_nearest_centroid.hpp"
+
+#include <gtest/gtest.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace
+{
+using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
+
+// random points around the origin, with duplicated points and points on the voxel boundaries
+PointCloud::Ptr createRandomCloud(const size_t size, const bool with_nan)
+{
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<float> position_random(-20.0f, 20.0f);
+  std::uniform_int_distribution<int> boundary_random(-40, 40);
+  PointCloud::Ptr cloud(new PointCloud);
+  for (size_t i = 0; i < size; ++i) {
+    pcl::PointXYZ p;
+    if (i % 10 == 0) {
+      p.x = 0.5f * static_cast<float>(boundary_random(random_generator));
+      p.y = 0.5f * static_cast<float>(boundary_random(random_generator));
+      p.z = 0.5f * static_cast<float>(boundary_random(random_generator)) / 10.0f;
+    } else if (i % 10 == 1 && i > 1) {
+      p = cloud->points.back();
+    } else {
+      p.x = position_random(random_generator);
+      p.y = position_random(random_generator);
+      p.z = position_random(random_generator) / 10.0f;
+    }
+    if (with_nan && i % 100 == 5) {
+      p.x = std::numeric_limits<float>::quiet_NaN();
+    }
+    cloud->push_back(p);
+  }
+  cloud->is_dense = !with_nan;
+  return cloud;
+}
+
+void expectSameOutput(
+  const PointCloud::Ptr & cloud, const float leaf_size, const int min_points_per_voxel,
+  const unsigned int nr_threads)
+{
+  pcl::VoxelGridNearestCentroid<pcl::PointXYZ> reference_filter;
+  reference_filter.setInputCloud(cloud);
+  reference_filter.setLeafSize(leaf_size, leaf_size, leaf_size);
+  reference_filter.setMinPointPerVoxel(min_points_per_voxel);
+  PointCloud reference_output;
+  reference_filter.filter(reference_output);
+
+  pcl::FlatVoxelGridNearestCentroid<pcl::PointXYZ> filter;
+  filter.setInputCloud(cloud);
+  filter.setLeafSize(leaf_size, leaf_size, leaf_size);
+  filter.setMinPointPerVoxel(min_points_per_voxel);
+  filter.setNumberOfThreads(nr_threads);
+  PointCloud output;
+  filter.filter(output);
+
+  ASSERT_EQ(output.size(), reference_output.size());
+  ASSERT_EQ(output.width, reference_output.width);
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_EQ(output.points[i].x, reference_output.points[i].x) << "point " << i;
+    EXPECT_EQ(output.points[i].y, reference_output.points[i].y) << "point " << i;
+    EXPECT_EQ(output.points[i].z, reference_output.points[i].z) << "point " << i;
+  }
+
+  // same voxels with the same number of points
+  for (const auto & p : cloud->points) {
+    if (!std::isfinite(p.x)) {
+      continue;
+    }
+    auto point = p;
+    const auto reference_leaf = reference_filter.getLeaf(point);
+    const auto leaf = filter.getLeaf(point);
+    ASSERT_NE(reference_leaf, nullptr);
+    ASSERT_NE(leaf, nullptr);
+    EXPECT_EQ(leaf->getPointCount(), reference_leaf->getPointCount());
+    EXPECT_FLOAT_EQ(leaf->centroid[0], reference_leaf->centroid[0]);
+    EXPECT_FLOAT_EQ(leaf->centroid[1], reference_leaf->centroid[1]);
+    EXPECT_FLOAT_EQ(leaf->centroid[2], reference_leaf->centroid[2]);
+  }
+}
+}  // namespace
+
+TEST(FlatVoxelGridNearestCentroidTest, SameOutputAsVoxelGridNearestCentroid)
+{
+  const auto cloud = createRandomCloud(20000, false);
+  expectSameOutput(cloud, 0.5f, 1, 1);
+  expectSameOutput(cloud, 0.5f, 3, 1);
+  expectSameOutput(cloud, 2.0f, 1, 1);
+  expectSameOutput(cloud, 0.1f, 1, 1);
+}
+
+TEST(FlatVoxelGridNearestCentroidTest, SameOutputInParallel)
+{
+  const auto cloud = createRandomCloud(20000, false);
+  expectSameOutput(cloud, 0.5f, 1, 0);
+  expectSameOutput(cloud, 0.5f, 1, 4);
+}
+
+TEST(FlatVoxelGridNearestCentroidTest, SameOutputWithInvalidPoints)
+{
+  const auto cloud = createRandomCloud(20000, true);
+  expectSameOutput(cloud, 0.5f, 1, 1);
+}
@@ -0,0 +1,172 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dummy_perception_publisher/box_bvh.hpp"
+#include "dummy_perception_publisher/signed_distance_function.hpp"
+
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2/LinearMath/Transform.h>
+#include <tf2/LinearMath/Vector3.h>
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+// same values as EgoCentricPointCloudCreator
+constexpr double horizontal_theta_step = (0.1 / 180.0) * M_PI;
+constexpr double visible_range = 100.0;
+constexpr size_t scan_chunk_size = 256;
+constexpr int num_cycles = 10;
+
+struct Object
+{
+  double length;
+  double width;
+  tf2::Transform tf_base_link2object;
+};
+
+// vehicles around the ego vehicle within the visible range
+std::vector<Object> createObjects(const size_t size)
+{
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<> position_random(-visible_range, visible_range);
+  std::uniform_real_distribution<> yaw_random(-M_PI, M_PI);
+  std::vector<Object> objects;
+  while (objects.size() < size) {
+    const double x = position_random(random_generator);
+    const double y = position_random(random_generator);
+    if (std::hypot(x, y) < 5.0) {
+      continue;
+    }
+    const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), yaw_random(random_generator));
+    objects.push_back({4.0, 1.8, tf2::Transform(q, tf2::Vector3(x, y, 0.0))});
+  }
+  return objects;
+}
+
+struct ScanHit
+{
+  size_t index;
+  double dist;
+};
+
+// previous EgoCentricPointCloudCreator: sphere tracing on the composite signed distance function,
+// which evaluates all the objects on each step
+std::vector<ScanHit> scanReference(const std::vector<Object> & objects, const size_t n_scan)
+{
+  std::vector<std::shared_ptr<signed_distance_function::AbstractSignedDistanceFunction>> sdf_ptrs;
+  for (const auto & object : objects) {
+    sdf_ptrs.push_back(std::make_shared<signed_distance_function::BoxSDF>(
+      object.length, object.width, object.tf_base_link2object));
+  }
+  const auto composite_sdf = signed_distance_function::CompositeSDF(sdf_ptrs);
+
+  std::vector<ScanHit> hits(n_scan, {0, std::numeric_limits<double>::infinity()});
+  double angle = 0.0;
+  for (size_t i = 0; i < n_scan; ++i) {
+    angle += horizontal_theta_step;
+    const auto dist = composite_sdf.getSphereTracingDist(0.0, 0.0, angle, visible_range);
+    if (std::isfinite(dist)) {
+      hits.at(i) = {composite_sdf.nearest_sdf_index(dist * cos(angle), dist * sin(angle)), dist};
+    }
+  }
+  return hits;
+}
+
+// EgoCentricPointCloudCreator: nearest hit in the hierarchy of the boxes for chunks of columns
+std::vector<ScanHit> scan(const std::vector<Object> & objects, const size_t n_scan)
+{
+  std::vector<box_bvh::Box> boxes;
+  for (const auto & object : objects) {
+    boxes.emplace_back(object.length, object.width, -1.0, 1.0, object.tf_base_link2object);
+  }
+  const auto bvh = box_bvh::BoxBVH(std::move(boxes));
+
+  std::vector<ScanHit> hits(n_scan, {0, std::numeric_limits<double>::infinity()});
+  const size_t n_chunk = (n_scan + scan_chunk_size - 1) / scan_chunk_size;
+#pragma omp parallel for schedule(dynamic)
+  for (int chunk = 0; chunk < static_cast<int>(n_chunk); ++chunk) {
+    const size_t scan_begin = static_cast<size_t>(chunk) * scan_chunk_size;
+    const size_t scan_end = std::min(n_scan, scan_begin + scan_chunk_size);
+    for (size_t i = scan_begin; i < scan_end; ++i) {
+      const double angle = static_cast<double>(i + 1) * horizontal_theta_step;
+      const auto hit = bvh.castRay2d(0.0, 0.0, std::cos(angle), std::sin(angle), visible_range);
+      if (hit.isHit()) {
+        hits.at(i) = {hit.index, hit.dist};
+      }
+    }
+  }
+  return hits;
+}
+}  // namespace
+
+int main()
+{
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+  const auto n_scan = static_cast<size_t>(std::floor(2 * M_PI / horizontal_theta_step));
+
+  std::printf(
+    "#objects, sphere tracing [ms], bvh [ms], hit columns (sphere tracing), hit columns (bvh), "
+    "object mismatches, max dist diff [m]\n");
+  for (const size_t size : {10, 30, 100, 300, 1000}) {
+    const auto objects = createObjects(size);
+
+    std::vector<ScanHit> reference_hits;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_hits = scanReference(objects, n_scan);
+    }
+    const double reference_time = stop_watch.toc() / num_cycles;
+
+    std::vector<ScanHit> hits;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      hits = scan(objects, n_scan);
+    }
+    const double time = stop_watch.toc() / num_cycles;
+
+    // sphere tracing misses some grazing rays within its number of iterations
+    size_t num_reference_hits = 0;
+    size_t num_hits = 0;
+    size_t num_mismatches = 0;
+    double max_dist_diff = 0.0;
+    for (size_t i = 0; i < n_scan; ++i) {
+      const bool is_reference_hit = std::isfinite(reference_hits.at(i).dist);
+      const bool is_hit = std::isfinite(hits.at(i).dist);
+      num_reference_hits += is_reference_hit;
+      num_hits += is_hit;
+      if (!is_reference_hit || !is_hit) {
+        continue;
+      }
+      if (reference_hits.at(i).index != hits.at(i).index) {
+        num_mismatches++;
+        continue;
+      }
+      max_dist_diff =
+        std::max(max_dist_diff, std::abs(reference_hits.at(i).dist - hits.at(i).dist));
+    }
+
+    std::printf(
+      "%zu, %.3f, %.3f, %zu, %zu, %zu, %.3e\n", size, reference_time, time, num_reference_hits,
+      num_hits, num_mismatches, max_dist_diff);
+  }
+  return 0;
+}
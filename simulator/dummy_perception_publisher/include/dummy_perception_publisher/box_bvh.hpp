@@ -0,0 +1,134 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DUMMY_PERCEPTION_PUBLISHER__BOX_BVH_HPP_
+#define DUMMY_PERCEPTION_PUBLISHER__BOX_BVH_HPP_
+
+#include <tf2/LinearMath/Transform.h>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace box_bvh
+{
+
+// box of an object: oriented footprint in xy and the range of z
+// NOTE: The footprint of a cylinder is its circle, and its bounding box is the one of the circle.
+class Box
+{
+public:
+  // same convention as signed_distance_function::BoxSDF: tf_global_to_local is the pose of the box
+  Box(
+    double length, double width, double min_z, double max_z,
+    const tf2::Transform & tf_global_to_local);
+
+  // vertical cylinder with the center of its circle at the origin of tf_global_to_local
+  static Box createCylinder(
+    double diameter, double min_z, double max_z, const tf2::Transform & tf_global_to_local);
+
+  // distance from the origin along the unit direction to the boundary of the footprint, or
+  // infinity if the ray does not hit it. A ray starting inside the footprint hits its exit point.
+  double intersectRay2d(double x, double y, double dir_x, double dir_y) const;
+
+  // same as intersectRay2d for a 3d ray, with the range of z
+  double intersectRay3d(
+    double x, double y, double z, double dir_x, double dir_y, double dir_z) const;
+
+  double min_x() const { return min_x_; }
+  double max_x() const { return max_x_; }
+  double min_y() const { return min_y_; }
+  double max_y() const { return max_y_; }
+  double min_z() const { return min_z_; }
+  double max_z() const { return max_z_; }
+  bool is_cylinder() const { return is_cylinder_; }
+
+private:
+  // clip [t_min, t_max] with the footprint for the ray in the local frame
+  bool clipByFootprint(
+    double x, double y, double dir_x, double dir_y, double & t_min, double & t_max) const;
+
+  double center_x_;
+  double center_y_;
+  double cos_yaw_;
+  double sin_yaw_;
+  double half_length_;
+  double half_width_;
+  double min_z_;
+  double max_z_;
+  bool is_cylinder_{false};
+  // axis aligned bounding box of the footprint
+  double min_x_;
+  double max_x_;
+  double min_y_;
+  double max_y_;
+};
+
+struct RayHit
+{
+  size_t index{std::numeric_limits<size_t>::max()};
+  double dist{std::numeric_limits<double>::infinity()};
+  bool isHit() const { return index != std::numeric_limits<size_t>::max(); }
+};
+
+// bounding volume hierarchy of boxes for the nearest hit of rays
+// NOTE: The boxes are split at the median of their centers along the longer axis, so the depth is
+//       log2 of the number of boxes. The hierarchy is rebuilt for each set of boxes.
+class BoxBVH
+{
+public:
+  explicit BoxBVH(std::vector<Box> boxes);
+
+  // nearest box hit by the ray of the footprints closer than max_dist
+  RayHit castRay2d(
+    double x, double y, double dir_x, double dir_y,
+    double max_dist = std::numeric_limits<double>::infinity()) const;
+
+  // nearest box hit by the 3d ray closer than max_dist
+  RayHit castRay3d(
+    double x, double y, double z, double dir_x, double dir_y, double dir_z,
+    double max_dist = std::numeric_limits<double>::infinity()) const;
+
+  const std::vector<Box> & boxes() const { return boxes_; }
+
+private:
+  struct Node
+  {
+    double min_x;
+    double max_x;
+    double min_y;
+    double max_y;
+    double min_z;
+    double max_z;
+    // leaf: boxes [begin, end) of box_indices_, inner node: children at left and left + 1
+    size_t begin;
+    size_t end;
+    size_t left;
+    bool is_leaf;
+  };
+
+  void build(size_t node_index, size_t begin, size_t end);
+  template <bool Is3d, typename IntersectBox>
+  RayHit castRay(
+    const double origin[3], const double dir[3], double max_dist,
+    const IntersectBox & intersect_box) const;
+
+  std::vector<Box> boxes_;
+  std::vector<size_t> box_indices_;
+  std::vector<Node> nodes_;
+};
+
+}  // namespace box_bvh
+
+#endif  // DUMMY_PERCEPTION_PUBLISHER__BOX_BVH_HPP_
@@ -37,6 +37,7 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <vector>
@@ -48,6 +49,8 @@ struct ObjectInfo
   double length;
   double width;
   double height;
+  // autoware_auto_perception_msgs::msg::Shape::type
+  uint8_t shape_type;
   double std_dev_x;
   double std_dev_y;
   double std_dev_z;
@@ -0,0 +1,318 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dummy_perception_publisher/box_bvh.hpp"
+
+#include <tf2/LinearMath/Quaternion.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr size_t max_leaf_size = 4;
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+// clip [t_min, t_max] with the slab min_value <= origin + t * dir <= max_value
+// return false if the interval becomes empty
+bool clipBySlab(
+  const double origin, const double dir, const double min_value, const double max_value,
+  double & t_min, double & t_max)
+{
+  if (dir == 0.0) {
+    return min_value <= origin && origin <= max_value;
+  }
+  const double inv_dir = 1.0 / dir;
+  double t_near = (min_value - origin) * inv_dir;
+  double t_far = (max_value - origin) * inv_dir;
+  if (t_near > t_far) {
+    std::swap(t_near, t_far);
+  }
+  t_min = std::max(t_min, t_near);
+  t_max = std::min(t_max, t_far);
+  return t_min <= t_max;
+}
+
+// clip [t_min, t_max] with the disk x^2 + y^2 <= radius^2 of the ray origin + t * dir in xy
+// return false if the interval becomes empty
+bool clipByDisk(
+  const double x, const double y, const double dir_x, const double dir_y, const double radius,
+  double & t_min, double & t_max)
+{
+  const double a = dir_x * dir_x + dir_y * dir_y;
+  const double c = x * x + y * y - radius * radius;
+  if (a == 0.0) {
+    return c <= 0.0;
+  }
+  const double half_b = x * dir_x + y * dir_y;
+  const double discriminant = half_b * half_b - a * c;
+  if (discriminant < 0.0) {
+    return false;
+  }
+  const double sqrt_discriminant = std::sqrt(discriminant);
+  t_min = std::max(t_min, (-half_b - sqrt_discriminant) / a);
+  t_max = std::min(t_max, (-half_b + sqrt_discriminant) / a);
+  return t_min <= t_max;
+}
+
+// distance to the boundary of the intersection [t_min, t_max] of the ray with a convex volume
+double toHitDist(const double t_min, const double t_max)
+{
+  if (t_max < 0.0) {
+    return infinity;
+  }
+  return t_min >= 0.0 ? t_min : t_max;
+}
+}  // namespace
+
+namespace box_bvh
+{
+
+Box::Box(
+  double length, double width, double min_z, double max_z,
+  const tf2::Transform & tf_global_to_local)
+: center_x_(tf_global_to_local.getOrigin().x()),
+  center_y_(tf_global_to_local.getOrigin().y()),
+  half_length_(0.5 * length),
+  half_width_(0.5 * width),
+  min_z_(min_z),
+  max_z_(max_z)
+{
+  const auto & basis = tf_global_to_local.getBasis();
+  const double yaw = std::atan2(basis[1][0], basis[0][0]);
+  cos_yaw_ = std::cos(yaw);
+  sin_yaw_ = std::sin(yaw);
+
+  const double extent_x = std::abs(cos_yaw_) * half_length_ + std::abs(sin_yaw_) * half_width_;
+  const double extent_y = std::abs(sin_yaw_) * half_length_ + std::abs(cos_yaw_) * half_width_;
+  min_x_ = center_x_ - extent_x;
+  max_x_ = center_x_ + extent_x;
+  min_y_ = center_y_ - extent_y;
+  max_y_ = center_y_ + extent_y;
+}
+
+Box Box::createCylinder(
+  double diameter, double min_z, double max_z, const tf2::Transform & tf_global_to_local)
+{
+  // the circle does not depend on the yaw, and its bounding box is the one of the square
+  const tf2::Transform tf_global_to_center(
+    tf2::Quaternion::getIdentity(), tf_global_to_local.getOrigin());
+  Box cylinder(diameter, diameter, min_z, max_z, tf_global_to_center);
+  cylinder.is_cylinder_ = true;
+  return cylinder;
+}
+
+bool Box::clipByFootprint(
+  double x, double y, double dir_x, double dir_y, double & t_min, double & t_max) const
+{
+  // ray in the local frame of the box
+  const double dx = x - center_x_;
+  const double dy = y - center_y_;
+  const double local_x = cos_yaw_ * dx + sin_yaw_ * dy;
+  const double local_y = -sin_yaw_ * dx + cos_yaw_ * dy;
+  const double local_dir_x = cos_yaw_ * dir_x + sin_yaw_ * dir_y;
+  const double local_dir_y = -sin_yaw_ * dir_x + cos_yaw_ * dir_y;
+
+  if (is_cylinder_) {
+    return clipByDisk(local_x, local_y, local_dir_x, local_dir_y, half_length_, t_min, t_max);
+  }
+  return clipBySlab(local_x, local_dir_x, -half_length_, half_length_, t_min, t_max) &&
+         clipBySlab(local_y, local_dir_y, -half_width_, half_width_, t_min, t_max);
+}
+
+double Box::intersectRay2d(double x, double y, double dir_x, double dir_y) const
+{
+  double t_min = -infinity;
+  double t_max = infinity;
+  if (!clipByFootprint(x, y, dir_x, dir_y, t_min, t_max)) {
+    return infinity;
+  }
+  return toHitDist(t_min, t_max);
+}
+
+double Box::intersectRay3d(
+  double x, double y, double z, double dir_x, double dir_y, double dir_z) const
+{
+  double t_min = -infinity;
+  double t_max = infinity;
+  if (
+    !clipByFootprint(x, y, dir_x, dir_y, t_min, t_max) ||
+    !clipBySlab(z, dir_z, min_z_, max_z_, t_min, t_max)) {
+    return infinity;
+  }
+  return toHitDist(t_min, t_max);
+}
+
+BoxBVH::BoxBVH(std::vector<Box> boxes) : boxes_(std::move(boxes))
+{
+  box_indices_.resize(boxes_.size());
+  for (size_t i = 0; i < boxes_.size(); ++i) {
+    box_indices_[i] = i;
+  }
+  if (!boxes_.empty()) {
+    nodes_.reserve(2 * boxes_.size());
+    nodes_.emplace_back();
+    build(0, 0, boxes_.size());
+  }
+}
+
+// fill the node of node_index with the boxes [begin, end) of box_indices_
+void BoxBVH::build(size_t node_index, size_t begin, size_t end)
+{
+  Node node{};
+  node.min_x = node.min_y = node.min_z = infinity;
+  node.max_x = node.max_y = node.max_z = -infinity;
+  double min_center_x = infinity;
+  double max_center_x = -infinity;
+  double min_center_y = infinity;
+  double max_center_y = -infinity;
+  for (size_t i = begin; i < end; ++i) {
+    const auto & box = boxes_[box_indices_[i]];
+    node.min_x = std::min(node.min_x, box.min_x());
+    node.max_x = std::max(node.max_x, box.max_x());
+    node.min_y = std::min(node.min_y, box.min_y());
+    node.max_y = std::max(node.max_y, box.max_y());
+    node.min_z = std::min(node.min_z, box.min_z());
+    node.max_z = std::max(node.max_z, box.max_z());
+    const double center_x = 0.5 * (box.min_x() + box.max_x());
+    const double center_y = 0.5 * (box.min_y() + box.max_y());
+    min_center_x = std::min(min_center_x, center_x);
+    max_center_x = std::max(max_center_x, center_x);
+    min_center_y = std::min(min_center_y, center_y);
+    max_center_y = std::max(max_center_y, center_y);
+  }
+  node.begin = begin;
+  node.end = end;
+  node.is_leaf = end - begin <= max_leaf_size;
+  if (node.is_leaf) {
+    nodes_[node_index] = node;
+    return;
+  }
+
+  // split at the median of the centers along the longer axis
+  const bool split_x = (max_center_x - min_center_x) >= (max_center_y - min_center_y);
+  const auto center = [&](const size_t box_index) {
+    const auto & box = boxes_[box_index];
+    return split_x ? box.min_x() + box.max_x() : box.min_y() + box.max_y();
+  };
+  const size_t mid = begin + (end - begin) / 2;
+  std::nth_element(
+    box_indices_.begin() + begin, box_indices_.begin() + mid, box_indices_.begin() + end,
+    [&](const size_t a, const size_t b) { return center(a) < center(b); });
+
+  // NOTE: nodes_ may be reallocated by the children, so that the node is stored before them
+  node.left = nodes_.size();
+  nodes_[node_index] = node;
+  nodes_.resize(nodes_.size() + 2);
+  build(node.left, begin, mid);
+  build(node.left + 1, mid, end);
+}
+
+template <bool Is3d, typename IntersectBox>
+RayHit BoxBVH::castRay(
+  const double origin[3], const double dir[3], const double max_dist,
+  const IntersectBox & intersect_box) const
+{
+  if (nodes_.empty()) {
+    return RayHit{};
+  }
+  RayHit hit;
+  hit.dist = max_dist;
+
+  // entry distance of the ray into the bounding box of the node
+  const auto intersect_node = [&](const Node & node) {
+    double t_min = 0.0;
+    double t_max = hit.dist;
+    if (
+      !clipBySlab(origin[0], dir[0], node.min_x, node.max_x, t_min, t_max) ||
+      !clipBySlab(origin[1], dir[1], node.min_y, node.max_y, t_min, t_max) ||
+      (Is3d && !clipBySlab(origin[2], dir[2], node.min_z, node.max_z, t_min, t_max))) {
+      return infinity;
+    }
+    return t_min;
+  };
+
+  // the depth is log2 of the number of boxes, so that the stack does not overflow in practice
+  constexpr size_t max_stack_size = 64;
+  std::pair<size_t, double> stack[max_stack_size];
+  size_t stack_size = 0;
+  const double root_dist = intersect_node(nodes_.front());
+  if (root_dist != infinity) {
+    stack[stack_size++] = {0, root_dist};
+  }
+
+  while (stack_size > 0) {
+    const auto [node_index, entry_dist] = stack[--stack_size];
+    if (entry_dist > hit.dist) {
+      continue;
+    }
+    const auto & node = nodes_[node_index];
+    if (node.is_leaf) {
+      for (size_t i = node.begin; i < node.end; ++i) {
+        const size_t box_index = box_indices_[i];
+        const double dist = intersect_box(boxes_[box_index]);
+        if (dist < hit.dist) {
+          hit.index = box_index;
+          hit.dist = dist;
+        }
+      }
+      continue;
+    }
+
+    // visit the nearer child first
+    const double left_dist = intersect_node(nodes_[node.left]);
+    const double right_dist = intersect_node(nodes_[node.left + 1]);
+    const bool is_left_nearer = left_dist <= right_dist;
+    const std::pair<size_t, double> near{
+      is_left_nearer ? node.left : node.left + 1, std::min(left_dist, right_dist)};
+    const std::pair<size_t, double> far{
+      is_left_nearer ? node.left + 1 : node.left, std::max(left_dist, right_dist)};
+    if (far.second != infinity && stack_size < max_stack_size) {
+      stack[stack_size++] = far;
+    }
+    if (near.second != infinity && stack_size < max_stack_size) {
+      stack[stack_size++] = near;
+    }
+  }
+
+  if (!hit.isHit()) {
+    hit.dist = infinity;
+  }
+  return hit;
+}
+
+RayHit BoxBVH::castRay2d(
+  double x, double y, double dir_x, double dir_y, double max_dist) const
+{
+  const double origin[3] = {x, y, 0.0};
+  const double dir[3] = {dir_x, dir_y, 0.0};
+  return castRay<false>(origin, dir, max_dist, [&](const Box & box) {
+    return box.intersectRay2d(x, y, dir_x, dir_y);
+  });
+}
+
+RayHit BoxBVH::castRay3d(
+  double x, double y, double z, double dir_x, double dir_y, double dir_z, double max_dist) const
+{
+  const double origin[3] = {x, y, z};
+  const double dir[3] = {dir_x, dir_y, dir_z};
+  return castRay<true>(origin, dir, max_dist, [&](const Box & box) {
+    return box.intersectRay3d(x, y, z, dir_x, dir_y, dir_z);
+  });
+}
+
+}  // namespace box_bvh
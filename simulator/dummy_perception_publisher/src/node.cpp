@@ -38,6 +38,7 @@ ObjectInfo::ObjectInfo(
 : length(object.shape.dimensions.x),
   width(object.shape.dimensions.y),
   height(object.shape.dimensions.z),
+  shape_type(object.shape.type),
   std_dev_x(std::sqrt(object.initial_state.pose_covariance.covariance[0])),
   std_dev_y(std::sqrt(object.initial_state.pose_covariance.covariance[7])),
   std_dev_z(std::sqrt(object.initial_state.pose_covariance.covariance[14])),
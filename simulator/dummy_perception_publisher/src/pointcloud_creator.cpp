@@ -12,18 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "dummy_perception_publisher/box_bvh.hpp"
 #include "dummy_perception_publisher/node.hpp"
-#include "dummy_perception_publisher/signed_distance_function.hpp"
+
+#include <autoware_auto_perception_msgs/msg/shape.hpp>
 
 #include <pcl/impl/point_types.hpp>
 
-#include <pcl/filters/voxel_grid_occlusion_estimation.h>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2/LinearMath/Vector3.h>
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -36,6 +40,10 @@ static constexpr double vertical_max_theta = (15.0 / 180.0) * M_PI;
 static constexpr double horizontal_theta_step = (0.1 / 180.0) * M_PI;
 static constexpr double horizontal_min_theta = (-180.0 / 180.0) * M_PI;
 static constexpr double horizontal_max_theta = (180.0 / 180.0) * M_PI;
+// same as the leaf size of the voxel grid used for the occlusion before
+static constexpr double occlusion_margin = 0.25;
+// number of scan columns sharing a random generator
+static constexpr size_t scan_chunk_size = 256;
 
 pcl::PointXYZ getPointWrtBaseLink(
   const tf2::Transform & tf_base_link2moved_object, double x, double y, double z)
@@ -44,6 +52,26 @@ pcl::PointXYZ getPointWrtBaseLink(
   return pcl::PointXYZ(p_wrt_base.x(), p_wrt_base.y(), p_wrt_base.z());
 }
 
+box_bvh::BoxBVH createBoxBVH(
+  const std::vector<ObjectInfo> & obj_infos, const tf2::Transform & tf_base_link2map)
+{
+  std::vector<box_bvh::Box> boxes;
+  boxes.reserve(obj_infos.size());
+  for (const auto & obj_info : obj_infos) {
+    const auto tf_base_link2moved_object = tf_base_link2map * obj_info.tf_map2moved_object;
+    const double min_z = -1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z();
+    const double max_z = 1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z();
+    if (obj_info.shape_type == autoware_auto_perception_msgs::msg::Shape::CYLINDER) {
+      boxes.push_back(box_bvh::Box::createCylinder(
+        obj_info.length, min_z, max_z, tf_base_link2moved_object));
+    } else {
+      boxes.emplace_back(
+        obj_info.length, obj_info.width, min_z, max_z, tf_base_link2moved_object);
+    }
+  }
+  return box_bvh::BoxBVH(std::move(boxes));
+}
+
 }  // namespace
 
 void ObjectCentricPointCloudCreator::create_object_pointcloud(
@@ -164,32 +192,35 @@ std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> ObjectCentricPointCloudCreator:
     return pointclouds_tmp;
   }
 
-  pcl::PointCloud<pcl::PointXYZ>::Ptr ray_traced_merged_pointcloud_ptr(
-    new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::VoxelGridOcclusionEstimation<pcl::PointXYZ> ray_tracing_filter;
-  ray_tracing_filter.setInputCloud(merged_pointcloud_tmp);
-  ray_tracing_filter.setLeafSize(0.25, 0.25, 0.25);
-  ray_tracing_filter.initializeVoxelGrid();
-  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds;
-  for (size_t i = 0; i < pointclouds_tmp.size(); ++i) {
+  // a point is occluded if the ray from the sensor hits a box before it
+  const auto bvh = createBoxBVH(obj_infos, tf_base_link2map);
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds(pointclouds_tmp.size());
+  const int n_obj = static_cast<int>(pointclouds_tmp.size());
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < n_obj; ++i) {
     pcl::PointCloud<pcl::PointXYZ>::Ptr ray_traced_pointcloud_ptr(
       new pcl::PointCloud<pcl::PointXYZ>);
-    for (size_t j = 0; j < pointclouds_tmp.at(i)->size(); ++j) {
-      Eigen::Vector3i grid_coordinates = ray_tracing_filter.getGridCoordinates(
-        pointclouds_tmp.at(i)->at(j).x, pointclouds_tmp.at(i)->at(j).y,
-        pointclouds_tmp.at(i)->at(j).z);
-      int grid_state;
-      if (ray_tracing_filter.occlusionEstimation(grid_state, grid_coordinates) != 0) {
-        RCLCPP_ERROR(rclcpp::get_logger("dummy_perception_publisher"), "ray tracing failed");
-      }
-      if (grid_state == 1) {  // occluded
+    for (const auto & pt : *pointclouds_tmp.at(i)) {
+      const double dist = std::sqrt(pt.x * pt.x + pt.y * pt.y + pt.z * pt.z);
+      if (dist < occlusion_margin) {
+        ray_traced_pointcloud_ptr->push_back(pt);
         continue;
-      } else {  // not occluded
-        ray_traced_pointcloud_ptr->push_back(pointclouds_tmp.at(i)->at(j));
-        ray_traced_merged_pointcloud_ptr->push_back(pointclouds_tmp.at(i)->at(j));
       }
+      const auto hit = bvh.castRay3d(
+        0.0, 0.0, 0.0, pt.x / dist, pt.y / dist, pt.z / dist, dist - occlusion_margin);
+      if (!hit.isHit()) {  // not occluded
+        ray_traced_pointcloud_ptr->push_back(pt);
+      }
+    }
+    pointclouds.at(i) = ray_traced_pointcloud_ptr;
+  }
+
+  pcl::PointCloud<pcl::PointXYZ>::Ptr ray_traced_merged_pointcloud_ptr(
+    new pcl::PointCloud<pcl::PointXYZ>);
+  for (const auto & cloud : pointclouds) {
+    for (const auto & pt : *cloud) {
+      ray_traced_merged_pointcloud_ptr->push_back(pt);
     }
-    pointclouds.push_back(ray_traced_pointcloud_ptr);
   }
   merged_pointcloud = ray_traced_merged_pointcloud_ptr;
   return pointclouds;
@@ -199,60 +230,67 @@ std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> EgoCentricPointCloudCreator::cr
   const std::vector<ObjectInfo> & obj_infos, const tf2::Transform & tf_base_link2map,
   std::mt19937 & random_generator, pcl::PointCloud<pcl::PointXYZ>::Ptr & merged_pointcloud) const
 {
-  std::vector<std::shared_ptr<signed_distance_function::AbstractSignedDistanceFunction>> sdf_ptrs;
-  for (const auto & obj_info : obj_infos) {
-    const auto sdf_ptr = std::make_shared<signed_distance_function::BoxSDF>(
-      obj_info.length, obj_info.width, tf_base_link2map * obj_info.tf_map2moved_object);
-    sdf_ptrs.push_back(sdf_ptr);
-  }
-  const auto composite_sdf = signed_distance_function::CompositeSDF(sdf_ptrs);
+  const auto bvh = createBoxBVH(obj_infos, tf_base_link2map);
 
   std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds(obj_infos.size());
   for (size_t i = 0; i < obj_infos.size(); ++i) {
     pointclouds.at(i) = (pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>));
   }
 
-  std::vector<double> min_zs(obj_infos.size());
-  std::vector<double> max_zs(obj_infos.size());
-
-  for (size_t idx = 0; idx < obj_infos.size(); ++idx) {
-    const auto & obj_info = obj_infos.at(idx);
-    const auto tf_base_link2moved_object = tf_base_link2map * obj_info.tf_map2moved_object;
-    const double min_z = -1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z();
-    const double max_z = 1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z();
-    min_zs.at(idx) = min_z;
-    max_zs.at(idx) = max_z;
+  // The scan columns are split into chunks with their own random generator seeded in order, so
+  // that the point cloud does not depend on the number of threads.
+  const auto n_scan = static_cast<size_t>(std::floor(2 * M_PI / horizontal_theta_step));
+  const size_t n_chunk = (n_scan + scan_chunk_size - 1) / scan_chunk_size;
+  std::vector<std::mt19937::result_type> chunk_seeds(n_chunk);
+  for (auto & seed : chunk_seeds) {
+    seed = random_generator();
   }
+  std::vector<std::vector<std::pair<size_t, pcl::PointXYZ>>> chunk_points(n_chunk);
 
-  double angle = 0.0;
-  const auto n_scan = static_cast<size_t>(std::floor(2 * M_PI / horizontal_theta_step));
-  for (size_t i = 0; i < n_scan; ++i) {
-    angle += horizontal_theta_step;
-    const auto dist = composite_sdf.getSphereTracingDist(0.0, 0.0, angle, visible_range_);
+#pragma omp parallel for schedule(dynamic)
+  for (int chunk = 0; chunk < static_cast<int>(n_chunk); ++chunk) {
+    std::mt19937 chunk_random_generator(chunk_seeds.at(chunk));
+    auto & points = chunk_points.at(chunk);
+    const size_t scan_begin = static_cast<size_t>(chunk) * scan_chunk_size;
+    const size_t scan_end = std::min(n_scan, scan_begin + scan_chunk_size);
+    for (size_t i = scan_begin; i < scan_end; ++i) {
+      const double angle = static_cast<double>(i + 1) * horizontal_theta_step;
+      const double cos_angle = std::cos(angle);
+      const double sin_angle = std::sin(angle);
+      const auto hit = bvh.castRay2d(0.0, 0.0, cos_angle, sin_angle, visible_range_);
+      if (!hit.isHit()) {
+        continue;
+      }
 
-    if (std::isfinite(dist)) {
-      const auto x_hit = dist * cos(angle);
-      const auto y_hit = dist * sin(angle);
-      const auto idx_hit = composite_sdf.nearest_sdf_index(x_hit, y_hit);
-      const auto obj_info_here = obj_infos.at(idx_hit);
-      const auto min_z_here = min_zs.at(idx_hit);
-      const auto max_z_here = max_zs.at(idx_hit);
+      const auto x_hit = hit.dist * cos_angle;
+      const auto y_hit = hit.dist * sin_angle;
+      const auto & obj_info_here = obj_infos.at(hit.index);
+      const auto min_z_here = bvh.boxes().at(hit.index).min_z();
+      const auto max_z_here = bvh.boxes().at(hit.index).max_z();
       std::normal_distribution<> x_random(0.0, obj_info_here.std_dev_x);
       std::normal_distribution<> y_random(0.0, obj_info_here.std_dev_y);
       std::normal_distribution<> z_random(0.0, obj_info_here.std_dev_z);
 
       for (double vertical_theta = vertical_min_theta;
            vertical_theta <= vertical_max_theta + epsilon; vertical_theta += vertical_theta_step) {
-        const double z = dist * std::tan(vertical_theta);
+        const double z = hit.dist * std::tan(vertical_theta);
         if (min_z_here <= z && z <= max_z_here + epsilon) {
-          pointclouds.at(idx_hit)->push_back(pcl::PointXYZ(
-            x_hit + x_random(random_generator), y_hit + y_random(random_generator),
-            z + z_random(random_generator)));
+          points.emplace_back(
+            hit.index, pcl::PointXYZ(
+                         x_hit + x_random(chunk_random_generator),
+                         y_hit + y_random(chunk_random_generator),
+                         z + z_random(chunk_random_generator)));
         }
       }
     }
   }
 
+  for (const auto & points : chunk_points) {
+    for (const auto & [idx_hit, point] : points) {
+      pointclouds.at(idx_hit)->push_back(point);
+    }
+  }
+
   for (const auto & cloud : pointclouds) {
     for (const auto & pt : *cloud) {
       merged_pointcloud->push_back(pt);
@@ -0,0 +1,152 @@
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dummy_perception_publisher/box_bvh.hpp"
+
+#include <gtest/gtest.h>
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2/LinearMath/Transform.h>
+#include <tf2/LinearMath/Vector3.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST(BoxBVHTest, Box)
+{
+  const double eps = 1e-5;
+
+  {
+    // test with identity transform
+    const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), 0.0);
+    const auto tf_global2local = tf2::Transform(q);
+    const auto box = box_bvh::Box(1., 2., -1.0, 1.0, tf_global2local);
+    ASSERT_NEAR(box.intersectRay2d(2.0, 0.0, -1.0, 0.0), 1.5, eps);
+    ASSERT_NEAR(box.intersectRay2d(1.0, 1.5, -sqrt(0.5), -sqrt(0.5)), sqrt(2.0) * 0.5, eps);
+    ASSERT_TRUE(std::isinf(box.intersectRay2d(2.0, 0.0, 1.0, 0.0)));
+    ASSERT_TRUE(std::isinf(box.intersectRay2d(2.0, 1.5, -1.0, 0.0)));
+    // ray from the inside hits the exit point
+    ASSERT_NEAR(box.intersectRay2d(0.0, 0.0, 0.0, 1.0), 1.0, eps);
+
+    ASSERT_NEAR(box.intersectRay3d(2.0, 0.0, 0.5, -1.0, 0.0, 0.0), 1.5, eps);
+    ASSERT_TRUE(std::isinf(box.intersectRay3d(2.0, 0.0, 1.5, -1.0, 0.0, 0.0)));
+    ASSERT_NEAR(box.intersectRay3d(0.0, 0.0, 3.0, 0.0, 0.0, -1.0), 2.0, eps);
+  }
+
+  {
+    // test with rotation (90 deg) and translation
+    const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), M_PI * 0.5);
+    const auto tf_global2local = tf2::Transform(q, tf2::Vector3(1.0, 1.0, 0.0));
+    const auto box = box_bvh::Box(1., 2., -1.0, 1.0, tf_global2local);
+    ASSERT_NEAR(box.intersectRay2d(0.0, 1.0, 1.0, 0.0), 0.0, eps);
+    ASSERT_NEAR(box.intersectRay2d(1.0, 0.0, 0.0, 1.0), 0.5, eps);
+    ASSERT_NEAR(box.min_x(), 0.0, eps);
+    ASSERT_NEAR(box.max_x(), 2.0, eps);
+    ASSERT_NEAR(box.min_y(), 0.5, eps);
+    ASSERT_NEAR(box.max_y(), 1.5, eps);
+  }
+}
+
+TEST(BoxBVHTest, Cylinder)
+{
+  const double eps = 1e-5;
+
+  // the yaw of the pose does not change the cylinder
+  const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), M_PI * 0.25);
+  const auto tf_global2local = tf2::Transform(q, tf2::Vector3(1.0, 1.0, 0.0));
+  const auto cylinder = box_bvh::Box::createCylinder(2.0, -1.0, 1.0, tf_global2local);
+  ASSERT_TRUE(cylinder.is_cylinder());
+  ASSERT_NEAR(cylinder.intersectRay2d(-1.0, 1.0, 1.0, 0.0), 1.0, eps);
+  ASSERT_NEAR(cylinder.intersectRay2d(1.0, 1.0, 0.0, 1.0), 1.0, eps);
+  // a ray through the corner of the bounding square misses the circle
+  ASSERT_TRUE(std::isinf(cylinder.intersectRay2d(0.1, -0.1, -sqrt(0.5), sqrt(0.5))));
+  // a ray from the corner of the bounding square hits the circle after sqrt(2) - 1
+  ASSERT_NEAR(cylinder.intersectRay2d(0.0, 0.0, sqrt(0.5), sqrt(0.5)), sqrt(2.0) - 1.0, eps);
+
+  ASSERT_NEAR(cylinder.intersectRay3d(-1.0, 1.0, 0.5, 1.0, 0.0, 0.0), 1.0, eps);
+  ASSERT_TRUE(std::isinf(cylinder.intersectRay3d(-1.0, 1.0, 1.5, 1.0, 0.0, 0.0)));
+  ASSERT_NEAR(cylinder.intersectRay3d(1.0, 1.0, 3.0, 0.0, 0.0, -1.0), 2.0, eps);
+  ASSERT_NEAR(cylinder.min_x(), 0.0, eps);
+  ASSERT_NEAR(cylinder.max_x(), 2.0, eps);
+  ASSERT_NEAR(cylinder.min_y(), 0.0, eps);
+  ASSERT_NEAR(cylinder.max_y(), 2.0, eps);
+}
+
+TEST(BoxBVHTest, BoxBVH)
+{
+  {
+    // no boxes
+    const auto bvh = box_bvh::BoxBVH({});
+    ASSERT_FALSE(bvh.castRay2d(0.0, 0.0, 1.0, 0.0).isHit());
+    ASSERT_FALSE(bvh.castRay3d(0.0, 0.0, 0.0, 1.0, 0.0, 0.0).isHit());
+  }
+
+  // nearest hit of the hierarchy is the same as the one of all the boxes and cylinders
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<> position_random(-50.0, 50.0);
+  std::uniform_real_distribution<> size_random(0.5, 5.0);
+  std::uniform_real_distribution<> angle_random(-M_PI, M_PI);
+  std::vector<box_bvh::Box> boxes;
+  for (size_t i = 0; i < 100; ++i) {
+    const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), angle_random(random_generator));
+    const auto tf_global2local = tf2::Transform(
+      q, tf2::Vector3(position_random(random_generator), position_random(random_generator), 0.0));
+    if (i % 4 == 0) {
+      boxes.push_back(
+        box_bvh::Box::createCylinder(size_random(random_generator), -1.0, 1.0, tf_global2local));
+    } else {
+      boxes.emplace_back(
+        size_random(random_generator), size_random(random_generator), -1.0, 1.0, tf_global2local);
+    }
+  }
+  const auto bvh = box_bvh::BoxBVH(boxes);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const double angle = angle_random(random_generator);
+    const double pitch = 0.1 * angle_random(random_generator);
+    const double dir_x = std::cos(angle) * std::cos(pitch);
+    const double dir_y = std::sin(angle) * std::cos(pitch);
+    const double dir_z = std::sin(pitch);
+    const double max_dist = 40.0;
+
+    double expected_dist_2d = max_dist;
+    double expected_dist_3d = max_dist;
+    for (const auto & box : boxes) {
+      expected_dist_2d = std::min(
+        expected_dist_2d, box.intersectRay2d(0.0, 0.0, std::cos(angle), std::sin(angle)));
+      expected_dist_3d =
+        std::min(expected_dist_3d, box.intersectRay3d(0.0, 0.0, 0.0, dir_x, dir_y, dir_z));
+    }
+
+    const auto hit_2d = bvh.castRay2d(0.0, 0.0, std::cos(angle), std::sin(angle), max_dist);
+    if (expected_dist_2d < max_dist) {
+      ASSERT_TRUE(hit_2d.isHit());
+      ASSERT_DOUBLE_EQ(hit_2d.dist, expected_dist_2d);
+      ASSERT_DOUBLE_EQ(
+        boxes.at(hit_2d.index).intersectRay2d(0.0, 0.0, std::cos(angle), std::sin(angle)),
+        expected_dist_2d);
+    } else {
+      ASSERT_FALSE(hit_2d.isHit());
+    }
+
+    const auto hit_3d = bvh.castRay3d(0.0, 0.0, 0.0, dir_x, dir_y, dir_z, max_dist);
+    if (expected_dist_3d < max_dist) {
+      ASSERT_TRUE(hit_3d.isHit());
+      ASSERT_DOUBLE_EQ(hit_3d.dist, expected_dist_3d);
+    } else {
+      ASSERT_FALSE(hit_3d.isHit());
+    }
+  }
+}
@@ -0,0 +1,134 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "system_error_monitor/diagnostics_filter.hpp"
+
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+using diagnostic_msgs::msg::DiagnosticStatus;
+
+constexpr int num_cycles = 10;
+constexpr size_t num_modules = 8;  // control, localization, map, perception, ...
+constexpr size_t num_nodes_per_group = 10;
+
+// aggregated diagnostics: /autoware/<module>/<group>/<node> with the raw diagnostics below them
+std::vector<DiagnosticStatus> createDiagnostics(const size_t num_groups_per_module)
+{
+  std::vector<DiagnosticStatus> diagnostics;
+  const auto add = [&](const std::string & name) {
+    DiagnosticStatus diag;
+    diag.name = name;
+    diagnostics.push_back(diag);
+  };
+
+  add("/autoware");
+  for (size_t module = 0; module < num_modules; ++module) {
+    const auto module_name = "/autoware/module_" + std::to_string(module);
+    add(module_name);
+    for (size_t group = 0; group < num_groups_per_module; ++group) {
+      const auto group_name = module_name + "/group_" + std::to_string(group);
+      add(group_name);
+      for (size_t node = 0; node < num_nodes_per_group; ++node) {
+        const auto node_name = group_name + "/node_" + std::to_string(node);
+        add(node_name);
+        add(node_name + "/status");
+      }
+    }
+  }
+  return diagnostics;
+}
+
+// required modules of the error monitor: the modules and the groups
+std::vector<DiagnosticStatus> createRequiredModules(const size_t num_groups_per_module)
+{
+  std::vector<DiagnosticStatus> required_modules;
+  for (size_t module = 0; module < num_modules; ++module) {
+    DiagnosticStatus diag;
+    diag.name = "/autoware/module_" + std::to_string(module);
+    required_modules.push_back(diag);
+    for (size_t group = 0; group < num_groups_per_module; ++group) {
+      DiagnosticStatus group_diag;
+      group_diag.name = diag.name + "/group_" + std::to_string(group);
+      required_modules.push_back(group_diag);
+    }
+  }
+  return required_modules;
+}
+}  // namespace
+
+int main()
+{
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+
+  std::printf(
+    "#diagnostics, required modules, reference [ms], trie build [ms], trie lookups [ms], "
+    "mismatches\n");
+  for (const size_t num_groups_per_module : {1, 5, 20, 50}) {
+    const auto diagnostics = createDiagnostics(num_groups_per_module);
+    const auto required_modules = createRequiredModules(num_groups_per_module);
+
+    // previous AutowareErrorMonitor::judgeHazardStatus(): the leaves are extracted again for each
+    // required module
+    std::vector<std::vector<DiagnosticStatus>> reference_leaf_children;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      reference_leaf_children.clear();
+      for (const auto & required_module : required_modules) {
+        reference_leaf_children.push_back(
+          diagnostics_filter::extractLeafChildrenDiagnostics(required_module, diagnostics));
+      }
+    }
+    const double reference_time = stop_watch.toc() / num_cycles;
+
+    stop_watch.tic();
+    diagnostics_filter::DiagnosticsNameTrie trie;
+    for (int i = 0; i < num_cycles; ++i) {
+      trie = diagnostics_filter::DiagnosticsNameTrie(diagnostics);
+    }
+    const double build_time = stop_watch.toc() / num_cycles;
+
+    std::vector<std::vector<DiagnosticStatus>> leaf_children;
+    stop_watch.tic();
+    for (int i = 0; i < num_cycles; ++i) {
+      leaf_children.clear();
+      for (const auto & required_module : required_modules) {
+        leaf_children.push_back(trie.extractLeafChildrenDiagnostics(required_module));
+      }
+    }
+    const double lookup_time = stop_watch.toc() / num_cycles;
+
+    size_t num_mismatches = 0;
+    for (size_t i = 0; i < required_modules.size(); ++i) {
+      const auto & reference = reference_leaf_children.at(i);
+      const auto & result = leaf_children.at(i);
+      bool is_same = reference.size() == result.size();
+      for (size_t j = 0; is_same && j < result.size(); ++j) {
+        is_same = reference.at(j).name == result.at(j).name;
+      }
+      num_mismatches += is_same ? 0 : 1;
+    }
+
+    std::printf(
+      "%zu, %zu, %.3f, %.3f, %.3f, %zu\n", diagnostics.size(), required_modules.size(),
+      reference_time, build_time, lookup_time, num_mismatches);
+  }
+  return 0;
+}
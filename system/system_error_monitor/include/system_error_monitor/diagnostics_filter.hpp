@@ -18,6 +18,7 @@
 #include <diagnostic_msgs/msg/diagnostic_status.hpp>
 
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -98,6 +99,90 @@ inline std::vector<diagnostic_msgs::msg::DiagnosticStatus> extractLeafChildrenDi
   return leaf_children_diagnostics;
 }
 
+// Trie of the names of the leaf diagnostics split by slash, built once for each DiagnosticArray.
+// Each node keeps the indices of the leaf diagnostics under it, so that the leaf children of a
+// parent are found in O(depth + results) instead of scanning all the diagnostics.
+class DiagnosticsNameTrie
+{
+public:
+  DiagnosticsNameTrie() : nodes_(1) {}
+
+  explicit DiagnosticsNameTrie(
+    const std::vector<diagnostic_msgs::msg::DiagnosticStatus> & diagnostics)
+  : nodes_(1), leaf_diagnostics_(extractLeafDiagnostics(diagnostics))
+  {
+    for (size_t leaf_index = 0; leaf_index < leaf_diagnostics_.size(); ++leaf_index) {
+      const auto & name = leaf_diagnostics_.at(leaf_index).name;
+      // each slash except a leading one ends the name of an ancestor, as in isChild()
+      size_t node_index = 0;
+      size_t begin = 0;
+      for (auto slash = name.find('/'); slash != std::string::npos;
+           slash = name.find('/', begin)) {
+        node_index = findOrAddChild(node_index, name.substr(begin, slash - begin));
+        if (slash > 0) {
+          nodes_.at(node_index).leaf_indices.push_back(leaf_index);
+        }
+        begin = slash + 1;
+      }
+    }
+  }
+
+  // same as extractLeafChildrenDiagnostics(parent, diagnostics)
+  std::vector<diagnostic_msgs::msg::DiagnosticStatus> extractLeafChildrenDiagnostics(
+    const diagnostic_msgs::msg::DiagnosticStatus & parent) const
+  {
+    std::vector<diagnostic_msgs::msg::DiagnosticStatus> leaf_children_diagnostics;
+
+    const auto & name = parent.name;
+    size_t node_index = 0;
+    size_t begin = 0;
+    while (true) {
+      const auto slash = name.find('/', begin);
+      const auto & children = nodes_.at(node_index).children;
+      const auto child = children.find(
+        name.substr(begin, slash == std::string::npos ? std::string::npos : slash - begin));
+      if (child == children.end()) {
+        return leaf_children_diagnostics;
+      }
+      node_index = child->second;
+      if (slash == std::string::npos) {
+        break;
+      }
+      begin = slash + 1;
+    }
+
+    const auto & leaf_indices = nodes_.at(node_index).leaf_indices;
+    leaf_children_diagnostics.reserve(leaf_indices.size());
+    for (const auto leaf_index : leaf_indices) {
+      leaf_children_diagnostics.push_back(leaf_diagnostics_.at(leaf_index));
+    }
+
+    return leaf_children_diagnostics;
+  }
+
+private:
+  struct Node
+  {
+    std::unordered_map<std::string, size_t> children;
+    // leaf diagnostics under the node in the order of the DiagnosticArray
+    std::vector<size_t> leaf_indices;
+  };
+
+  size_t findOrAddChild(const size_t node_index, const std::string & segment)
+  {
+    const auto child = nodes_.at(node_index).children.find(segment);
+    if (child != nodes_.at(node_index).children.end()) {
+      return child->second;
+    }
+    nodes_.emplace_back();
+    nodes_.at(node_index).children.emplace(segment, nodes_.size() - 1);
+    return nodes_.size() - 1;
+  }
+
+  std::vector<Node> nodes_;
+  std::vector<diagnostic_msgs::msg::DiagnosticStatus> leaf_diagnostics_;
+};
+
 }  // namespace diagnostics_filter
 
 #endif  // SYSTEM_ERROR_MONITOR__DIAGNOSTICS_FILTER_HPP_
@@ -15,6 +15,8 @@
 #ifndef SYSTEM_ERROR_MONITOR__SYSTEM_ERROR_MONITOR_CORE_HPP_
 #define SYSTEM_ERROR_MONITOR__SYSTEM_ERROR_MONITOR_CORE_HPP_
 
+#include "system_error_monitor/diagnostics_filter.hpp"
+
 #include <rclcpp/create_timer.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -111,6 +113,7 @@ private:
   const size_t diag_buffer_size_ = 100;
   std::unordered_map<std::string, DiagBuffer> diag_buffer_map_;
   diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr diag_array_;
+  diagnostics_filter::DiagnosticsNameTrie diag_name_trie_;
   autoware_auto_system_msgs::msg::AutowareState::ConstSharedPtr autoware_state_;
   tier4_control_msgs::msg::GateMode::ConstSharedPtr current_gate_mode_;
   autoware_auto_vehicle_msgs::msg::ControlModeReport::ConstSharedPtr control_mode_;
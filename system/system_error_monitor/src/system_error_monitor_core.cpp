@@ -335,6 +335,9 @@ void AutowareErrorMonitor::onDiagArray(
   const diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr msg)
 {
   diag_array_ = msg;
+  if (params_.add_leaf_diagnostics) {
+    diag_name_trie_ = diagnostics_filter::DiagnosticsNameTrie(msg->status);
+  }
 
   const auto & header = msg->header;
 
@@ -513,8 +516,7 @@ void AutowareErrorMonitor::appendHazardDiag(
   target_diagnostics_ref.push_back(hazard_diag);
 
   if (params_.add_leaf_diagnostics) {
-    for (const auto & diag :
-         diagnostics_filter::extractLeafChildrenDiagnostics(hazard_diag, diag_array_->status)) {
+    for (const auto & diag : diag_name_trie_.extractLeafChildrenDiagnostics(hazard_diag)) {
       target_diagnostics_ref.push_back(diag);
     }
   }
@@ -0,0 +1,434 @@
+//
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "accel_brake_map_calibrator/calibrator_core.hpp"
+
+#include <Eigen/Dense>
+#include <tier4_autoware_utils/system/stop_watch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using accel_brake_map_calibrator::CalibratorCore;
+using accel_brake_map_calibrator::CalibratorParam;
+using accel_brake_map_calibrator::Map;
+using accel_brake_map_calibrator::MapGrid;
+using raw_vehicle_cmd_converter::AccelMap;
+using raw_vehicle_cmd_converter::BrakeMap;
+
+struct Sample
+{
+  double velocity;
+  double accel_pedal;
+  double brake_pedal;
+  double measured_acc;
+};
+
+// previous implementation: nested vector maps, a vector of dynamic Eigen matrices for the four cell
+// covariances and bounds-checked loops for the consistency of the maps
+class ReferenceCalibrator
+{
+public:
+  ReferenceCalibrator(
+    const AccelMap & accel_map, const BrakeMap & brake_map, const CalibratorParam & param)
+  : param_(param),
+    accel_vel_index_(accel_map.getVelIdx()),
+    brake_vel_index_(brake_map.getVelIdx()),
+    accel_pedal_index_(accel_map.getThrottleIdx()),
+    brake_pedal_index_(brake_map.getBrakeIdx()),
+    accel_map_value_(accel_map.getAccelMap()),
+    brake_map_value_(brake_map.getBrakeMap()),
+    update_accel_map_value_(accel_map_value_),
+    update_brake_map_value_(brake_map_value_),
+    covariance_(param.initial_covariance)
+  {
+    const std::size_t cols = accel_map_value_.at(0).size();
+    map_offset_vec_.assign(
+      accel_map_value_.size() + brake_map_value_.size() - 1, std::vector<double>(cols, 0.0));
+    covariance_vec_.assign(map_offset_vec_.size(), std::vector<double>(cols, covariance_));
+    accel_map_offset_vec_.assign(accel_map_value_.size(), std::vector<double>(cols, 0.0));
+    brake_map_offset_vec_.assign(brake_map_value_.size(), std::vector<double>(cols, 0.0));
+    accel_covariance_mat_.assign(
+      accel_map_value_.size() - 1,
+      std::vector<Eigen::MatrixXd>(cols - 1, Eigen::MatrixXd::Identity(4, 4) * covariance_));
+    brake_covariance_mat_.assign(
+      brake_map_value_.size() - 1,
+      std::vector<Eigen::MatrixXd>(cols - 1, Eigen::MatrixXd::Identity(4, 4) * covariance_));
+    const auto genConstMat = [](const Map & map, const double val) {
+      return Eigen::MatrixXd::Constant(map.size(), map.at(0).size(), val);
+    };
+    accel_data_mean_mat_ = genConstMat(accel_map_value_, 0.0);
+    brake_data_mean_mat_ = genConstMat(brake_map_value_, 0.0);
+    accel_data_covariance_mat_ = genConstMat(accel_map_value_, covariance_);
+    brake_data_covariance_mat_ = genConstMat(brake_map_value_, covariance_);
+    accel_data_num_ = genConstMat(accel_map_value_, 1);
+    brake_data_num_ = genConstMat(brake_map_value_, 1);
+  }
+
+  bool update(const Sample & sample)
+  {
+    const bool accel_mode = sample.accel_pedal > std::numeric_limits<double>::epsilon();
+    const double pedal = accel_mode ? sample.accel_pedal : sample.brake_pedal;
+    int pedal_index = 0;
+    int vel_index = 0;
+    if (!indexValueSearch(
+          accel_mode ? accel_pedal_index_ : brake_pedal_index_, pedal, param_.pedal_diff_threshold,
+          &pedal_index)) {
+      return false;
+    }
+    if (!indexValueSearch(
+          accel_mode ? accel_vel_index_ : brake_vel_index_, sample.velocity,
+          param_.velocity_diff_threshold, &vel_index)) {
+      return false;
+    }
+    auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
+    const double map_acc = update_map_value.at(pedal_index).at(vel_index);
+    if (param_.update_method == accel_brake_map_calibrator::UPDATE_OFFSET_EACH_CELL) {
+      updateEachValOffset(accel_mode, pedal_index, vel_index, sample.measured_acc, map_acc);
+    } else if (param_.update_method == accel_brake_map_calibrator::UPDATE_OFFSET_TOTAL) {
+      updateTotalMapOffset(sample.measured_acc, map_acc);
+    } else {
+      updateFourCellAroundOffset(
+        accel_mode, pedal_index, vel_index, pedal, sample.velocity, sample.measured_acc);
+    }
+    if (pedal_index == 0) {
+      auto & another_map_value = accel_mode ? update_brake_map_value_ : update_accel_map_value_;
+      another_map_value.at(0).at(vel_index) = update_map_value.at(0).at(vel_index);
+      if (param_.update_method == accel_brake_map_calibrator::UPDATE_OFFSET_FOUR_CELL_AROUND) {
+        another_map_value.at(0).at(vel_index + 1) = update_map_value.at(0).at(vel_index + 1);
+      }
+    }
+    takeConsistency(&update_accel_map_value_, true);
+    takeConsistency(&update_brake_map_value_, false);
+    return true;
+  }
+
+  const Map & getUpdatedAccelMap() const { return update_accel_map_value_; }
+  const Map & getUpdatedBrakeMap() const { return update_brake_map_value_; }
+
+private:
+  bool indexValueSearch(
+    const std::vector<double> value_index, const double value, const double value_thresh,
+    int * searched_index)
+  {
+    if (param_.update_method == accel_brake_map_calibrator::UPDATE_OFFSET_FOUR_CELL_AROUND) {
+      if (value < 0) {
+        return false;
+      }
+      double old_diff_value = -999;
+      for (std::size_t i = 0; i < value_index.size(); i++) {
+        const double diff_value = value_index.at(i) - value;
+        if (diff_value <= 0 && old_diff_value < diff_value) {
+          *searched_index = i;
+          old_diff_value = diff_value;
+        } else {
+          return true;
+        }
+      }
+    } else {
+      for (std::size_t i = 0; i < value_index.size(); i++) {
+        if (std::fabs(value_index.at(i) - value) <= value_thresh) {
+          *searched_index = i;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  int getUnifiedIndexFromAccelBrakeIndex(const bool accel_map, const std::size_t index)
+  {
+    return accel_map ? index + brake_map_value_.size() - 1 : brake_map_value_.size() - index - 1;
+  }
+
+  void updateEachValOffset(
+    const bool accel_mode, const int pedal_index, const int vel_index, const double measured_acc,
+    const double map_acc)
+  {
+    const int ped_idx = getUnifiedIndexFromAccelBrakeIndex(accel_mode, pedal_index);
+    double map_offset = map_offset_vec_.at(ped_idx).at(vel_index);
+    double covariance = covariance_vec_.at(ped_idx).at(vel_index);
+    const double phi = 1.0;
+    const double ff = param_.forgetting_factor;
+    covariance =
+      (covariance - (covariance * phi * phi * covariance) / (ff + phi * covariance * phi)) / ff;
+    const double coef = (covariance * phi) / (ff + phi * covariance * phi);
+    map_offset = map_offset + coef * (measured_acc - map_acc);
+    map_offset_vec_.at(ped_idx).at(vel_index) = map_offset;
+    covariance_vec_.at(ped_idx).at(vel_index) = covariance;
+    auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
+    const auto & map_value = accel_mode ? accel_map_value_ : brake_map_value_;
+    update_map_value.at(pedal_index).at(vel_index) =
+      map_value.at(pedal_index).at(vel_index) + map_offset;
+  }
+
+  void updateTotalMapOffset(const double measured_acc, const double map_acc)
+  {
+    const double phi = 1.0;
+    const double ff = param_.forgetting_factor;
+    covariance_ =
+      (covariance_ - (covariance_ * phi * phi * covariance_) / (ff + phi * covariance_ * phi)) / ff;
+    const double coef = (covariance_ * phi) / (ff + phi * covariance_ * phi);
+    map_offset_ = map_offset_ + coef * (measured_acc - map_acc);
+    for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
+      for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
+        update_accel_map_value_.at(ped_idx).at(vel_idx) =
+          accel_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
+      }
+    }
+    for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
+      for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
+        update_brake_map_value_.at(ped_idx).at(vel_idx) =
+          brake_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
+      }
+    }
+  }
+
+  void updateFourCellAroundOffset(
+    const bool accel_mode, const int pedal_index, const int vel_index, const double pedal,
+    const double velocity, const double measured_acc)
+  {
+    auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
+    const auto & map_value = accel_mode ? accel_map_value_ : brake_map_value_;
+    const auto & pedal_index_ = accel_mode ? accel_pedal_index_ : brake_pedal_index_;
+    const auto & vel_index_ = accel_mode ? accel_vel_index_ : brake_vel_index_;
+    auto & map_offset_vec = accel_mode ? accel_map_offset_vec_ : brake_map_offset_vec_;
+    auto & covariance_mat = accel_mode ? accel_covariance_mat_ : brake_covariance_mat_;
+    auto & data_mean_mat = accel_mode ? accel_data_mean_mat_ : brake_data_mean_mat_;
+    auto & data_covariance_mat =
+      accel_mode ? accel_data_covariance_mat_ : brake_data_covariance_mat_;
+    auto & data_weighted_num = accel_mode ? accel_data_num_ : brake_data_num_;
+    const int pl = pedal_index;
+    const int ph = pedal_index + 1;
+    const int vl = vel_index;
+    const int vh = vel_index + 1;
+
+    const double rx = (pedal - pedal_index_.at(pl)) / (pedal_index_.at(ph) - pedal_index_.at(pl));
+    const double ry = (velocity - vel_index_.at(vl)) / (vel_index_.at(vh) - vel_index_.at(vl));
+    Eigen::Vector4d phi(4);
+    phi << (1 - rx) * (1 - ry), rx * (1 - ry), (1 - rx) * ry, rx * ry;
+    Eigen::Vector4d theta(4);
+    theta << update_map_value.at(pl).at(vl), update_map_value.at(ph).at(vl),
+      update_map_value.at(pl).at(vh), update_map_value.at(ph).at(vh);
+    Eigen::Vector4d weighted_sum(4);
+    weighted_sum << data_weighted_num(pl, vl), data_weighted_num(ph, vl),
+      data_weighted_num(pl, vh), data_weighted_num(ph, vh);
+    Eigen::Vector4d sigma(4);
+    sigma << data_covariance_mat(pl, vl), data_covariance_mat(ph, vl),
+      data_covariance_mat(pl, vh), data_covariance_mat(ph, vh);
+    Eigen::Vector4d mean(4);
+    mean << data_mean_mat(pl, vl), data_mean_mat(ph, vl), data_mean_mat(pl, vh),
+      data_mean_mat(ph, vh);
+    Eigen::VectorXd map_offset(4);
+    map_offset << map_offset_vec.at(pl).at(vl), map_offset_vec.at(ph).at(vl),
+      map_offset_vec.at(pl).at(vh), map_offset_vec.at(ph).at(vh);
+
+    Eigen::MatrixXd covariance = covariance_mat.at(pl).at(vl);
+    const double ff = param_.forgetting_factor;
+    Eigen::RowVectorXd phiT = phi.transpose();
+    const double rk = phiT * covariance * phi;
+    const Eigen::MatrixXd G = covariance * phi / (ff + rk);
+    const double beta = rk > 0 ? (ff - (1 - ff) / rk) : 1;
+    covariance = covariance - covariance * phi * phiT * covariance / (1 / beta + rk);
+    const double eta_hat = phiT * theta;
+    const double error_map_offset = measured_acc - eta_hat;
+    const Eigen::VectorXd updated_map_offset = map_offset + G * error_map_offset;
+    for (int i = 0; i < 4; i++) {
+      const double pre_mean = mean(i);
+      mean(i) = (weighted_sum(i) * pre_mean + error_map_offset) / (weighted_sum(i) + 1);
+      sigma(i) =
+        (weighted_sum(i) * (sigma(i) + pre_mean * pre_mean) + error_map_offset * error_map_offset) /
+          (weighted_sum(i) + 1) -
+        mean(i) * mean(i);
+      weighted_sum(i) = weighted_sum(i) + 1;
+    }
+    const int ped[4] = {pl, ph, pl, ph};
+    const int vel[4] = {vl, vl, vh, vh};
+    for (int i = 0; i < 4; i++) {
+      map_offset_vec.at(ped[i]).at(vel[i]) = updated_map_offset(i);
+      data_covariance_mat(ped[i], vel[i]) = sigma(i);
+      data_weighted_num(ped[i], vel[i]) = weighted_sum(i);
+      data_mean_mat(ped[i], vel[i]) = mean(i);
+      update_map_value.at(ped[i]).at(vel[i]) = map_value.at(ped[i]).at(vel[i]) + map_offset(i);
+    }
+    covariance_mat.at(pl).at(vl) = covariance;
+  }
+
+  void takeConsistency(Map * map, const bool accel)
+  {
+    const double bit = std::pow(1e-01, param_.precision);
+    for (std::size_t ped_idx = 0; ped_idx < map->size() - 1; ped_idx++) {
+      for (std::size_t vel_idx = 0; vel_idx < map->at(0).size() - 1; vel_idx++) {
+        const double current_acc = map->at(ped_idx).at(vel_idx);
+        const double next_ped_acc = map->at(ped_idx + 1).at(vel_idx);
+        const double next_vel_acc = map->at(ped_idx).at(vel_idx + 1);
+        if (current_acc <= next_vel_acc) {
+          map->at(ped_idx).at(vel_idx + 1) = current_acc - bit;
+        }
+        if (accel ? current_acc >= next_ped_acc : current_acc <= next_ped_acc) {
+          map->at(ped_idx + 1).at(vel_idx) = current_acc + (accel ? bit : -bit);
+        }
+      }
+    }
+  }
+
+  CalibratorParam param_;
+  std::vector<double> accel_vel_index_;
+  std::vector<double> brake_vel_index_;
+  std::vector<double> accel_pedal_index_;
+  std::vector<double> brake_pedal_index_;
+  Map accel_map_value_;
+  Map brake_map_value_;
+  Map update_accel_map_value_;
+  Map update_brake_map_value_;
+  double map_offset_ = 0.0;
+  double covariance_;
+  Map map_offset_vec_;
+  Map covariance_vec_;
+  Map accel_map_offset_vec_;
+  Map brake_map_offset_vec_;
+  std::vector<std::vector<Eigen::MatrixXd>> accel_covariance_mat_;
+  std::vector<std::vector<Eigen::MatrixXd>> brake_covariance_mat_;
+  Eigen::MatrixXd accel_data_mean_mat_;
+  Eigen::MatrixXd brake_data_mean_mat_;
+  Eigen::MatrixXd accel_data_covariance_mat_;
+  Eigen::MatrixXd brake_data_covariance_mat_;
+  Eigen::MatrixXd accel_data_num_;
+  Eigen::MatrixXd brake_data_num_;
+};
+
+std::vector<double> linspace(const double max, const std::size_t size)
+{
+  std::vector<double> values(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i] = max * static_cast<double>(i) / static_cast<double>(size - 1);
+  }
+  return values;
+}
+
+// maps of size x size cells over the pedal range [0, 0.5] and the velocity range [0, 14]
+void writeMaps(const std::size_t size, const std::string & dir)
+{
+  const auto pedal_index = linspace(0.5, size);
+  const auto vel_index = linspace(14.0, size);
+  MapGrid accel(size, size, 0.0);
+  MapGrid brake(size, size, 0.0);
+  for (std::size_t p = 0; p < size; ++p) {
+    for (std::size_t v = 0; v < size; ++v) {
+      accel(p, v) = 0.3 + 6.0 * pedal_index[p] - 0.05 * vel_index[v];
+      brake(p, v) = 0.3 - 10.0 * pedal_index[p] - 0.05 * vel_index[v];
+    }
+  }
+  accel_brake_map_calibrator::writeMapToCSV(vel_index, pedal_index, accel, 3, dir + "/accel.csv");
+  accel_brake_map_calibrator::writeMapToCSV(vel_index, pedal_index, brake, 3, dir + "/brake.csv");
+}
+
+std::vector<Sample> generateSamples(
+  const std::vector<double> & pedal_index, const std::vector<double> & vel_index,
+  const std::size_t num, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<std::size_t> pedal_cell(0, pedal_index.size() - 1);
+  std::uniform_real_distribution<double> noise(-0.02, 0.02);
+  std::uniform_real_distribution<double> velocity(0.1, vel_index.back());
+  std::normal_distribution<double> acc(0.0, 1.0);
+  std::bernoulli_distribution accel_mode(0.6);
+  std::vector<Sample> samples(num);
+  for (auto & sample : samples) {
+    const double pedal = std::max(0.0, pedal_index[pedal_cell(gen)] + noise(gen));
+    const bool accel = accel_mode(gen);
+    sample.velocity = velocity(gen);
+    sample.accel_pedal = accel ? pedal : 0.0;
+    sample.brake_pedal = accel ? 0.0 : pedal;
+    sample.measured_acc = (accel ? 6.0 : -10.0) * pedal - 0.05 * sample.velocity + acc(gen) * 0.2;
+  }
+  return samples;
+}
+
+double maxDifference(const MapGrid & grid, const Map & map)
+{
+  double max_diff = 0.0;
+  for (std::size_t p = 0; p < grid.rows(); ++p) {
+    for (std::size_t v = 0; v < grid.cols(); ++v) {
+      max_diff = std::max(max_diff, std::abs(grid(p, v) - map.at(p).at(v)));
+    }
+  }
+  return max_diff;
+}
+}  // namespace
+
+int main()
+{
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+  std::mt19937 gen(0);
+  constexpr std::size_t num_samples = 20000;
+  const auto dir = std::filesystem::temp_directory_path().string();
+  const char * method_names[] = {"each_cell", "total", "four_cell_around"};
+
+  std::printf(
+    "#map_size method num_updated reference_ms core_ms speedup max_accel_diff max_brake_diff\n");
+  for (const std::size_t size : {11, 21, 41, 81}) {
+    writeMaps(size, dir);
+    AccelMap accel_map;
+    BrakeMap brake_map;
+    if (
+      !accel_map.readAccelMapFromCSV(dir + "/accel.csv") ||
+      !brake_map.readBrakeMapFromCSV(dir + "/brake.csv")) {
+      std::printf("failed to read the maps in %s\n", dir.c_str());
+      return 1;
+    }
+    const auto samples =
+      generateSamples(accel_map.getThrottleIdx(), accel_map.getVelIdx(), num_samples, gen);
+
+    for (const int method :
+         {accel_brake_map_calibrator::UPDATE_OFFSET_EACH_CELL,
+          accel_brake_map_calibrator::UPDATE_OFFSET_TOTAL,
+          accel_brake_map_calibrator::UPDATE_OFFSET_FOUR_CELL_AROUND}) {
+      CalibratorParam param;
+      param.update_method = method;
+
+      ReferenceCalibrator reference(accel_map, brake_map, param);
+      stop_watch.tic();
+      for (const auto & sample : samples) {
+        reference.update(sample);
+      }
+      const double reference_ms = stop_watch.toc();
+
+      CalibratorCore core(accel_map, brake_map, param);
+      std::size_t num_updated = 0;
+      stop_watch.tic();
+      for (const auto & sample : samples) {
+        num_updated += core.update(
+          sample.velocity, sample.accel_pedal, sample.brake_pedal, sample.measured_acc);
+      }
+      const double core_ms = stop_watch.toc();
+
+      std::printf(
+        "%zu %s %zu %.2f %.2f %.1f %.3e %.3e\n", size, method_names[method], num_updated,
+        reference_ms, core_ms, reference_ms / core_ms,
+        maxDifference(core.getUpdatedAccelMap(), reference.getUpdatedAccelMap()),
+        maxDifference(core.getUpdatedBrakeMap(), reference.getUpdatedBrakeMap()));
+    }
+  }
+  return 0;
+}
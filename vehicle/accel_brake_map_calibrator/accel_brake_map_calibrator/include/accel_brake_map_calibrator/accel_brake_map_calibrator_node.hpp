@@ -17,6 +17,7 @@
 #ifndef ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_CALIBRATOR_NODE_HPP_
 #define ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_CALIBRATOR_NODE_HPP_
 
+#include "accel_brake_map_calibrator/calibrator_core.hpp"
 #include "diagnostic_updater/diagnostic_updater.hpp"
 #include "raw_vehicle_cmd_converter/accel_map.hpp"
 #include "raw_vehicle_cmd_converter/brake_map.hpp"
@@ -24,7 +25,6 @@
 #include "tf2/utils.h"
 #include "tier4_autoware_utils/ros/transform_listener.hpp"
 
-#include <Eigen/Dense>
 #include <motion_utils/motion_utils.hpp>
 
 #include "autoware_auto_vehicle_msgs/msg/steering_report.hpp"
@@ -71,8 +71,6 @@ using visualization_msgs::msg::MarkerArray;
 
 using tier4_vehicle_msgs::srv::UpdateAccelBrakeMap;
 
-using Map = std::vector<std::vector<double>>;
-
 struct DataStamped
 {
   DataStamped(const double _data, const rclcpp::Time & _data_time)
@@ -195,12 +193,9 @@ private:
   double update_suggest_thresh_;
 
   // Accel / Brake Map update
+  std::unique_ptr<CalibratorCore> calibrator_;
   Map accel_map_value_;
   Map brake_map_value_;
-  Map update_accel_map_value_;
-  Map update_brake_map_value_;
-  Map accel_offset_covariance_value_;
-  Map brake_offset_covariance_value_;
   std::vector<Map> map_value_data_;
   std::vector<double> accel_vel_index_;
   std::vector<double> brake_vel_index_;
@@ -219,30 +214,12 @@ private:
   int too_large_pedal_spd_count_ = 0;
   int update_fail_count_ = 0;
 
-  // for map update
-  double map_offset_ = 0.0;
-  double map_coef_ = 1.0;
-  double covariance_;
-  const double forgetting_factor_ = 0.999;
-  const double coef_update_skip_thresh_ = 0.1;
-
   // output log
   std::ofstream output_log_;
 
   bool getCurrentPitchFromTF(double * pitch);
   void timerCallback();
   void timerCallbackOutputCSV();
-  void executeUpdate(
-    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-    const int brake_pedal_index, const int brake_vel_index);
-  bool updateFourCellAroundOffset(
-    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-    const int brake_pedal_index, const int brake_vel_index, const double measured_acc);
-  bool updateEachValOffset(
-    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-    const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
-    const double map_acc);
-  void updateTotalMapOffset(const double measured_acc, const double map_acc);
   void callbackActuation(
     const std_msgs::msg::Header header, const double accel, const double brake);
   void callbackActuationCommand(const ActuationCommandStamped::ConstSharedPtr msg);
@@ -261,14 +238,9 @@ private:
     const TwistStamped::ConstSharedPtr & prev_twist,
     const TwistStamped::ConstSharedPtr & current_twist);
   double getJerk();
-  bool indexValueSearch(
-    const std::vector<double> value_index, const double value, const double value_thresh,
-    int * searched_index);
   int nearestValueSearch(const std::vector<double> value_index, const double value);
   int nearestPedalSearch();
   int nearestVelSearch();
-  void takeConsistencyOfAccelMap();
-  void takeConsistencyOfBrakeMap();
   bool updateAccelBrakeMap();
   void publishFloat32(const std::string publish_type, const double val);
   void publishUpdateSuggestFlag();
@@ -286,7 +258,6 @@ private:
   std::vector<double> getMapColumnFromUnifiedIndex(
     const Map & accel_map_value, const Map & brake_map_value, const std::size_t index);
   double getPedalValueFromUnifiedIndex(const std::size_t index);
-  int getUnifiedIndexFromAccelBrakeIndex(const bool accel_map, const std::size_t index);
   void pushDataToQue(
     const TwistStamped::ConstSharedPtr & data, const std::size_t max_size,
     std::queue<TwistStamped::ConstSharedPtr> * que);
@@ -302,17 +273,6 @@ private:
   bool isTimeout(const builtin_interfaces::msg::Time & stamp, const double timeout_sec);
   bool isTimeout(const DataStampedPtr & data_stamped, const double timeout_sec);
 
-  /* for covariance calculation */
-  // mean value on each cell (counting method depends on the update algorithm)
-  Eigen::MatrixXd accel_data_mean_mat_;
-  Eigen::MatrixXd brake_data_mean_mat_;
-  // calculated variance on each cell
-  Eigen::MatrixXd accel_data_covariance_mat_;
-  Eigen::MatrixXd brake_data_covariance_mat_;
-  // number of data on each cell (counting method depends on the update algorithm)
-  Eigen::MatrixXd accel_data_num_;
-  Eigen::MatrixXd brake_data_num_;
-
   OccupancyGrid getOccMsg(
     const std::string frame_id, const double height, const double width, const double resolution,
     const std::vector<int8_t> & map_value);
@@ -327,8 +287,8 @@ private:
   void publishCountMap();
   void publishIndex();
   bool writeMapToCSV(
-    std::vector<double> vel_index, std::vector<double> pedal_index, Map value_map,
-    std::string filename);
+    const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+    const MapGrid & value_map, const std::string & filename);
   void addIndexToCSV(std::ofstream * csv_file);
   void addLogToCSV(
     std::ofstream * csv_file, const double & timestamp, const double velocity, const double accel,
@@ -358,12 +318,6 @@ private:
 
   enum GET_PITCH_METHOD { TF = 0, FILE = 1, NONE = 2 };
 
-  enum UPDATE_METHOD {
-    UPDATE_OFFSET_EACH_CELL = 0,
-    UPDATE_OFFSET_TOTAL = 1,
-    UPDATE_OFFSET_FOUR_CELL_AROUND = 2,
-  };
-
   enum ACCEL_BRAKE_SOURCE {
     STATUS = 0,
     COMMAND = 1,
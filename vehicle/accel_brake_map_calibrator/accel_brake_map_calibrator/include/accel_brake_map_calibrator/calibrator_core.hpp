@@ -0,0 +1,176 @@
+//
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef ACCEL_BRAKE_MAP_CALIBRATOR__CALIBRATOR_CORE_HPP_
+#define ACCEL_BRAKE_MAP_CALIBRATOR__CALIBRATOR_CORE_HPP_
+
+#include "raw_vehicle_cmd_converter/accel_map.hpp"
+#include "raw_vehicle_cmd_converter/brake_map.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace accel_brake_map_calibrator
+{
+
+using Map = std::vector<std::vector<double>>;
+
+enum UPDATE_METHOD {
+  UPDATE_OFFSET_EACH_CELL = 0,
+  UPDATE_OFFSET_TOTAL = 1,
+  UPDATE_OFFSET_FOUR_CELL_AROUND = 2,
+};
+
+/**
+ * @brief map stored in a contiguous row-major array
+ * @details rows are pedal indices and columns are velocity indices, as in the csv maps.
+ */
+class MapGrid
+{
+public:
+  MapGrid() = default;
+  MapGrid(const std::size_t rows, const std::size_t cols, const double value)
+  : rows_(rows), cols_(cols), values_(rows * cols, value)
+  {
+  }
+  explicit MapGrid(const Map & map);
+
+  std::size_t rows() const { return rows_; }
+  std::size_t cols() const { return cols_; }
+  double & operator()(const std::size_t row, const std::size_t col)
+  {
+    return values_[row * cols_ + col];
+  }
+  double operator()(const std::size_t row, const std::size_t col) const
+  {
+    return values_[row * cols_ + col];
+  }
+  double * data() { return values_.data(); }
+  const double * data() const { return values_.data(); }
+
+  Map toMap() const;
+
+private:
+  std::size_t rows_{0};
+  std::size_t cols_{0};
+  std::vector<double> values_;
+};
+
+struct CalibratorParam
+{
+  int update_method{UPDATE_OFFSET_EACH_CELL};
+  double initial_covariance{0.05};
+  double velocity_diff_threshold{0.556};
+  double pedal_diff_threshold{0.03};
+  int precision{3};
+  double forgetting_factor{0.999};
+};
+
+/**
+ * @brief online estimation of the accel / brake map offsets, independent from ROS
+ * @details each update takes one pitch compensated acceleration with the velocity and the delayed
+ * pedals it was measured at, so that the same core runs in the node and on recorded logs. All the
+ * maps and estimator states are flat arrays allocated at construction.
+ */
+class CalibratorCore
+{
+public:
+  CalibratorCore(
+    const raw_vehicle_cmd_converter::AccelMap & accel_map,
+    const raw_vehicle_cmd_converter::BrakeMap & brake_map, const CalibratorParam & param);
+
+  /**
+   * @brief update the map with an acceleration measured at the given velocity and pedals
+   * @param [in] measured_acc acceleration without the gravity component of the pitch
+   * @param [out] unified_pedal_index row of the updated cell in the unified (brake + accel) map
+   * @param [out] vel_index column of the updated cell
+   * @return false if the pedal or the velocity does not match the map index
+   */
+  bool update(
+    const double velocity, const double accel_pedal, const double brake_pedal,
+    const double measured_acc, int * unified_pedal_index = nullptr, int * vel_index = nullptr);
+
+  const MapGrid & getUpdatedAccelMap() const { return update_accel_map_value_; }
+  const MapGrid & getUpdatedBrakeMap() const { return update_brake_map_value_; }
+  const MapGrid & getAccelOffsetCovariance() const { return accel_offset_covariance_value_; }
+  const MapGrid & getBrakeOffsetCovariance() const { return brake_offset_covariance_value_; }
+
+  // accel_map=true: accel_map; accel_map=false: brake_map
+  int getUnifiedIndexFromAccelBrakeIndex(const bool accel_map, const std::size_t index) const;
+
+private:
+  bool indexValueSearch(
+    const std::vector<double> & value_index, const double value, const double value_thresh,
+    int * searched_index) const;
+  void updateEachValOffset(
+    const bool accel_mode, const int pedal_index, const int vel_index, const double measured_acc,
+    const double map_acc);
+  void updateTotalMapOffset(const double measured_acc, const double map_acc);
+  void updateFourCellAroundOffset(
+    const bool accel_mode, const int pedal_index, const int vel_index, const double pedal,
+    const double velocity, const double measured_acc);
+  void takeConsistencyOfAccelMap();
+  void takeConsistencyOfBrakeMap();
+
+  CalibratorParam param_;
+
+  std::vector<double> accel_vel_index_;
+  std::vector<double> brake_vel_index_;
+  std::vector<double> accel_pedal_index_;
+  std::vector<double> brake_pedal_index_;
+
+  MapGrid accel_map_value_;
+  MapGrid brake_map_value_;
+  MapGrid update_accel_map_value_;
+  MapGrid update_brake_map_value_;
+  MapGrid accel_offset_covariance_value_;
+  MapGrid brake_offset_covariance_value_;
+
+  // UPDATE_OFFSET_TOTAL
+  double map_offset_{0.0};
+  double covariance_;
+
+  // UPDATE_OFFSET_EACH_CELL: offset and covariance of each cell of the unified map
+  MapGrid map_offset_vec_;
+  MapGrid covariance_vec_;
+
+  // UPDATE_OFFSET_FOUR_CELL_AROUND: offset of each cell and 4x4 covariance (column-major) of each
+  // group of four cells, stored at the index of its lower left cell
+  MapGrid accel_map_offset_vec_;
+  MapGrid brake_map_offset_vec_;
+  std::vector<double> accel_covariance_mat_;
+  std::vector<double> brake_covariance_mat_;
+  // mean value, variance and number of data on each cell
+  MapGrid accel_data_mean_mat_;
+  MapGrid brake_data_mean_mat_;
+  MapGrid accel_data_covariance_mat_;
+  MapGrid brake_data_covariance_mat_;
+  MapGrid accel_data_num_;
+  MapGrid brake_data_num_;
+};
+
+/**
+ * @brief write the map in the csv format read by raw_vehicle_cmd_converter
+ * @return false if the file cannot be opened
+ */
+bool writeMapToCSV(
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const MapGrid & value_map, const int precision, const std::string & filename);
+
+}  // namespace accel_brake_map_calibrator
+
+#endif  // ACCEL_BRAKE_MAP_CALIBRATOR__CALIBRATOR_CORE_HPP_
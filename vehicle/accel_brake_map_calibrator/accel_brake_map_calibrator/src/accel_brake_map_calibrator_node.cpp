@@ -35,7 +35,7 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   transform_listener_ = std::make_shared<tier4_autoware_utils::TransformListener>(this);
   // get parameter
   update_hz_ = declare_parameter<double>("update_hz", 10.0);
-  covariance_ = declare_parameter<double>("initial_covariance", 0.05);
+  const double initial_covariance = declare_parameter<double>("initial_covariance", 0.05);
   velocity_min_threshold_ = declare_parameter<double>("velocity_min_threshold", 0.1);
   velocity_diff_threshold_ = declare_parameter<double>("velocity_diff_threshold", 0.556);
   pedal_diff_threshold_ = declare_parameter<double>("pedal_diff_threshold", 0.03);
@@ -143,41 +143,20 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   brake_vel_index_ = brake_map_.getVelIdx();
   accel_pedal_index_ = accel_map_.getThrottleIdx();
   brake_pedal_index_ = brake_map_.getBrakeIdx();
-  update_accel_map_value_.resize((accel_map_value_.size()));
-  update_brake_map_value_.resize((brake_map_value_.size()));
-  for (auto & m : update_accel_map_value_) {
-    m.resize(accel_map_value_.at(0).size());
-  }
-  for (auto & m : update_brake_map_value_) {
-    m.resize(brake_map_value_.at(0).size());
-  }
-  accel_offset_covariance_value_.resize((accel_map_value_.size()));
-  brake_offset_covariance_value_.resize((brake_map_value_.size()));
-  for (auto & m : accel_offset_covariance_value_) {
-    m.resize(accel_map_value_.at(0).size(), covariance_);
-  }
-  for (auto & m : brake_offset_covariance_value_) {
-    m.resize(brake_map_value_.at(0).size(), covariance_);
-  }
   map_value_data_.resize(accel_map_value_.size() + brake_map_value_.size() - 1);
   for (auto & m : map_value_data_) {
     m.resize(accel_map_value_.at(0).size());
   }
 
-  std::copy(accel_map_value_.begin(), accel_map_value_.end(), update_accel_map_value_.begin());
-  std::copy(brake_map_value_.begin(), brake_map_value_.end(), update_brake_map_value_.begin());
-
-  // initialize matrix for covariance calculation
+  // initialize map update
   {
-    const auto genConstMat = [](const Map & map, const auto val) {
-      return Eigen::MatrixXd::Constant(map.size(), map.at(0).size(), val);
-    };
-    accel_data_mean_mat_ = genConstMat(accel_map_value_, map_offset_);
-    brake_data_mean_mat_ = genConstMat(brake_map_value_, map_offset_);
-    accel_data_covariance_mat_ = genConstMat(accel_map_value_, covariance_);
-    brake_data_covariance_mat_ = genConstMat(brake_map_value_, covariance_);
-    accel_data_num_ = genConstMat(accel_map_value_, 1);
-    brake_data_num_ = genConstMat(brake_map_value_, 1);
+    CalibratorParam calibrator_param;
+    calibrator_param.update_method = update_method_;
+    calibrator_param.initial_covariance = initial_covariance;
+    calibrator_param.velocity_diff_threshold = velocity_diff_threshold_;
+    calibrator_param.pedal_diff_threshold = pedal_diff_threshold_;
+    calibrator_param.precision = precision_;
+    calibrator_ = std::make_unique<CalibratorCore>(accel_map_, brake_map_, calibrator_param);
   }
 
   // publisher
@@ -338,8 +317,11 @@ void AccelBrakeMapCalibrator::timerCallback()
 
   /* publish map  & debug_values*/
   publishMap(accel_map_value_, brake_map_value_, "original");
-  publishMap(update_accel_map_value_, update_brake_map_value_, "update");
-  publishOffsetCovMap(accel_offset_covariance_value_, brake_offset_covariance_value_);
+  publishMap(
+    calibrator_->getUpdatedAccelMap().toMap(), calibrator_->getUpdatedBrakeMap().toMap(), "update");
+  publishOffsetCovMap(
+    calibrator_->getAccelOffsetCovariance().toMap(),
+    calibrator_->getBrakeOffsetCovariance().toMap());
   publishCountMap();
   publishIndex();
   publishUpdateSuggestFlag();
@@ -422,19 +404,23 @@ void AccelBrakeMapCalibrator::timerCallbackOutputCSV()
 {
   // write accel/ brake map to file
   const auto ros_time = std::to_string(this->now().seconds());
-  writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, output_accel_file_);
-  writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, output_brake_file_);
+  const auto & update_accel_map_value = calibrator_->getUpdatedAccelMap();
+  const auto & update_brake_map_value = calibrator_->getUpdatedBrakeMap();
+  writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value, output_accel_file_);
+  writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value, output_brake_file_);
   if (progress_file_output_) {
     writeMapToCSV(
-      accel_vel_index_, accel_pedal_index_, update_accel_map_value_,
+      accel_vel_index_, accel_pedal_index_, update_accel_map_value,
       output_accel_file_ + "_" + ros_time);
     writeMapToCSV(
-      brake_vel_index_, brake_pedal_index_, update_brake_map_value_,
+      brake_vel_index_, brake_pedal_index_, update_brake_map_value,
       output_brake_file_ + "_" + ros_time);
     writeMapToCSV(
-      accel_vel_index_, accel_pedal_index_, accel_map_value_, output_accel_file_ + "_original");
+      accel_vel_index_, accel_pedal_index_, MapGrid(accel_map_value_),
+      output_accel_file_ + "_original");
     writeMapToCSV(
-      brake_vel_index_, brake_pedal_index_, brake_map_value_, output_brake_file_ + "_original");
+      brake_vel_index_, brake_pedal_index_, MapGrid(brake_map_value_),
+      output_brake_file_ + "_original");
   }
 
   // update newest accel / brake map
@@ -565,8 +551,10 @@ bool AccelBrakeMapCalibrator::callbackUpdateMapService(
   const auto accel_map_file = update_map_dir + "/accel_map.csv";
   const auto brake_map_file = update_map_dir + "/brake_map.csv";
   if (
-    writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, accel_map_file) &&
-    writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, brake_map_file)) {
+    writeMapToCSV(
+      accel_vel_index_, accel_pedal_index_, calibrator_->getUpdatedAccelMap(), accel_map_file) &&
+    writeMapToCSV(
+      brake_vel_index_, brake_pedal_index_, calibrator_->getUpdatedBrakeMap(), brake_map_file)) {
     res->success = true;
     res->message =
       "Data has been successfully saved on " + update_map_dir + "/(accel/brake)_map.csv";
@@ -618,43 +606,6 @@ double AccelBrakeMapCalibrator::getJerk()
   return std::min(std::max(-max_jerk_, jerk), max_jerk_);
 }
 
-bool AccelBrakeMapCalibrator::indexValueSearch(
-  const std::vector<double> value_index, const double value, const double value_thresh,
-  int * searched_index)
-{
-  if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
-    /*  return lower left index.
-    +-------+   +:grid
-    |    *  |   *:given data
-    |       |   o:index to return
-    o-------+
-    */
-    if (value < 0) {
-      std::cerr << "error : invalid value." << std::endl;
-      return false;
-    }
-    double old_diff_value = -999;  // TODO(Hirano)
-    for (std::size_t i = 0; i < value_index.size(); i++) {
-      const double diff_value = value_index.at(i) - value;
-      if (diff_value <= 0 && old_diff_value < diff_value) {
-        *searched_index = i;
-        old_diff_value = diff_value;
-      } else {
-        return true;
-      }
-    }
-  } else {
-    for (std::size_t i = 0; i < value_index.size(); i++) {
-      const double diff_value = std::fabs(value_index.at(i) - value);
-      if (diff_value <= value_thresh) {
-        *searched_index = i;
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
 int AccelBrakeMapCalibrator::nearestValueSearch(
   const std::vector<double> value_index, const double value)
 {
@@ -688,7 +639,7 @@ int AccelBrakeMapCalibrator::nearestPedalSearch()
     nearest_idx = nearestValueSearch(brake_pedal_index_, delayed_brake_pedal_ptr_->data);
   }
 
-  return getUnifiedIndexFromAccelBrakeIndex(accel_mode, nearest_idx);
+  return calibrator_->getUnifiedIndexFromAccelBrakeIndex(accel_mode, nearest_idx);
 }
 
 int AccelBrakeMapCalibrator::nearestVelSearch()
@@ -697,385 +648,23 @@ int AccelBrakeMapCalibrator::nearestVelSearch()
   return nearestValueSearch(accel_vel_index_, current_vel);
 }
 
-void AccelBrakeMapCalibrator::takeConsistencyOfAccelMap()
-{
-  const double bit = std::pow(1e-01, precision_);
-  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
-      const double current_acc = update_accel_map_value_.at(ped_idx).at(vel_idx);
-      const double next_ped_acc = update_accel_map_value_.at(ped_idx + 1).at(vel_idx);
-      const double next_vel_acc = update_accel_map_value_.at(ped_idx).at(vel_idx + 1);
-
-      if (current_acc <= next_vel_acc) {
-        // the higher the velocity, the lower the acceleration
-        update_accel_map_value_.at(ped_idx).at(vel_idx + 1) = current_acc - bit;
-      }
-
-      if (current_acc >= next_ped_acc) {
-        // the higher the accel pedal, the higher the acceleration
-        update_accel_map_value_.at(ped_idx + 1).at(vel_idx) = current_acc + bit;
-      }
-    }
-  }
-}
-
-void AccelBrakeMapCalibrator::takeConsistencyOfBrakeMap()
-{
-  const double bit = std::pow(1e-01, precision_);
-  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
-      const double current_acc = update_brake_map_value_.at(ped_idx).at(vel_idx);
-      const double next_ped_acc = update_brake_map_value_.at(ped_idx + 1).at(vel_idx);
-      const double next_vel_acc = update_brake_map_value_.at(ped_idx).at(vel_idx + 1);
-
-      if (current_acc <= next_vel_acc) {
-        // the higher the velocity, the lower the acceleration
-        update_brake_map_value_.at(ped_idx).at(vel_idx + 1) = current_acc - bit;
-      }
-
-      if (current_acc <= next_ped_acc) {
-        // the higher the brake pedal, the lower the acceleration
-        update_brake_map_value_.at(ped_idx + 1).at(vel_idx) = current_acc - bit;
-      }
-    }
-  }
-}
-
 bool AccelBrakeMapCalibrator::updateAccelBrakeMap()
-{
-  // get pedal index
-  bool accel_mode = false;
-  int accel_pedal_index = 0;
-  int brake_pedal_index = 0;
-  int accel_vel_index = 0;
-  int brake_vel_index = 0;
-
-  if (delayed_accel_pedal_ptr_->data > std::numeric_limits<double>::epsilon()) {
-    accel_mode = true;
-  } else {
-    accel_mode = false;
-  }
-
-  if (
-    accel_mode && !indexValueSearch(
-                    accel_pedal_index_, delayed_accel_pedal_ptr_->data, pedal_diff_threshold_,
-                    &accel_pedal_index)) {
-    // not match accel pedal output to pedal value in index
-    return false;
-  }
-
-  if (
-    !accel_mode && !indexValueSearch(
-                     brake_pedal_index_, delayed_brake_pedal_ptr_->data, pedal_diff_threshold_,
-                     &brake_pedal_index)) {
-    // not match accel pedal output to pedal value in index
-    return false;
-  }
-
-  if (
-    accel_mode &&
-    !indexValueSearch(
-      accel_vel_index_, twist_ptr_->twist.linear.x, velocity_diff_threshold_, &accel_vel_index)) {
-    // not match current velocity to velocity value in index
-    return false;
-  }
-
-  if (
-    !accel_mode &&
-    !indexValueSearch(
-      brake_vel_index_, twist_ptr_->twist.linear.x, velocity_diff_threshold_, &brake_vel_index)) {
-    // not match current velocity to velocity value in index
-    return false;
-  }
-
-  // update map
-  executeUpdate(accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index);
-
-  // when update 0 pedal index, update another map
-  if (accel_mode && accel_pedal_index == 0) {
-    // copy accel map value to brake map value
-    update_brake_map_value_.at(accel_pedal_index).at(accel_vel_index) =
-      update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index);
-    if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
-      update_brake_map_value_.at(accel_pedal_index).at(accel_vel_index + 1) =
-        update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index + 1);
-    }
-  } else if (!accel_mode && brake_pedal_index == 0) {
-    // copy brake map value to accel map value
-    update_accel_map_value_.at(brake_pedal_index).at(brake_vel_index) =
-      update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
-    if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
-      update_accel_map_value_.at(brake_pedal_index).at(brake_vel_index + 1) =
-        update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index + 1);
-    }
-  }
-
-  // take consistency of map
-  takeConsistencyOfAccelMap();
-  takeConsistencyOfBrakeMap();
-
-  return true;
-}
-
-void AccelBrakeMapCalibrator::executeUpdate(
-  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-  const int brake_pedal_index, const int brake_vel_index)
 {
   const double measured_acc = acceleration_ - getPitchCompensatedAcceleration();
-  const double map_acc = accel_mode
-                           ? update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index)
-                           : update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
-  RCLCPP_DEBUG_STREAM(get_logger(), "measured_acc: " << measured_acc << ", map_acc: " << map_acc);
-
-  if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL) {
-    updateEachValOffset(
-      accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index,
-      measured_acc, map_acc);
-  } else if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_TOTAL) {
-    updateTotalMapOffset(measured_acc, map_acc);
-  } else if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
-    updateFourCellAroundOffset(
-      accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index,
-      measured_acc);
+  int unified_pedal_index = 0;
+  int vel_index = 0;
+  if (!calibrator_->update(
+        twist_ptr_->twist.linear.x, delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data,
+        measured_acc, &unified_pedal_index, &vel_index)) {
+    // not match pedal output or current velocity to value in index
+    return false;
   }
 
   // add accel data to map
-  accel_mode ? map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(true, accel_pedal_index))
-                 .at(accel_vel_index)
-                 .emplace_back(measured_acc)
-             : map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(false, brake_pedal_index))
-                 .at(brake_vel_index)
-                 .emplace_back(measured_acc);
-}
-
-bool AccelBrakeMapCalibrator::updateFourCellAroundOffset(
-  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-  const int brake_pedal_index, const int brake_vel_index, const double measured_acc)
-{
-  // pre-defined
-  static Map accel_map_offset_vec_(
-    accel_map_value_.size(), std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static Map brake_map_offset_vec_(
-    brake_map_value_.size(), std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static std::vector<std::vector<Eigen::MatrixXd>> accel_covariance_mat_(
-    accel_map_value_.size() - 1,
-    std::vector<Eigen::MatrixXd>(
-      accel_map_value_.at(0).size() - 1, Eigen::MatrixXd::Identity(4, 4) * covariance_));
-  static std::vector<std::vector<Eigen::MatrixXd>> brake_covariance_mat_(
-    brake_map_value_.size() - 1,
-    std::vector<Eigen::MatrixXd>(
-      accel_map_value_.at(0).size() - 1, Eigen::MatrixXd::Identity(4, 4) * covariance_));
-
-  auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
-  auto & offset_covariance_value =
-    accel_mode ? accel_offset_covariance_value_ : brake_offset_covariance_value_;
-  const auto & map_value = accel_mode ? accel_map_value_ : brake_map_value_;
-  const auto & pedal_index = accel_mode ? accel_pedal_index : brake_pedal_index;
-  const auto & pedal_index_ = accel_mode ? accel_pedal_index_ : brake_pedal_index_;
-  const auto & vel_index = accel_mode ? accel_vel_index : brake_vel_index;
-  const auto & vel_index_ = accel_mode ? accel_vel_index_ : brake_vel_index_;
-  const auto & delayed_pedal =
-    accel_mode ? delayed_accel_pedal_ptr_->data : delayed_brake_pedal_ptr_->data;
-  auto & map_offset_vec = accel_mode ? accel_map_offset_vec_ : brake_map_offset_vec_;
-  auto & covariance_mat = accel_mode ? accel_covariance_mat_ : brake_covariance_mat_;
-  auto & data_mean_mat = accel_mode ? accel_data_mean_mat_ : brake_data_mean_mat_;
-  auto & data_covariance_mat = accel_mode ? accel_data_covariance_mat_ : brake_data_covariance_mat_;
-  auto & data_weighted_num = accel_mode ? accel_data_num_ : brake_data_num_;
-
-  const double zll = update_map_value.at(pedal_index + 0).at(vel_index + 0);
-  const double zhl = update_map_value.at(pedal_index + 1).at(vel_index + 0);
-  const double zlh = update_map_value.at(pedal_index + 0).at(vel_index + 1);
-  const double zhh = update_map_value.at(pedal_index + 1).at(vel_index + 1);
-
-  const double xl = pedal_index_.at(pedal_index + 0);
-  const double xh = pedal_index_.at(pedal_index + 1);
-  const double rx = (delayed_pedal - xl) / (xh - xl);
-  const double yl = vel_index_.at(vel_index + 0);
-  const double yh = vel_index_.at(vel_index + 1);
-  const double ry = (twist_ptr_->twist.linear.x - yl) / (yh - yl);
-
-  Eigen::Vector4d phi(4);
-  phi << (1 - rx) * (1 - ry), rx * (1 - ry), (1 - rx) * ry, rx * ry;
-
-  Eigen::Vector4d theta(4);
-  theta << zll, zhl, zlh, zhh;
-
-  Eigen::Vector4d weighted_sum(4);
-  weighted_sum << data_weighted_num(pedal_index + 0, vel_index + 0),
-    data_weighted_num(pedal_index + 1, vel_index + 0),
-    data_weighted_num(pedal_index + 0, vel_index + 1),
-    data_weighted_num(pedal_index + 1, vel_index + 1);
-
-  Eigen::Vector4d sigma(4);
-  sigma << data_covariance_mat(pedal_index + 0, vel_index + 0),
-    data_covariance_mat(pedal_index + 1, vel_index + 0),
-    data_covariance_mat(pedal_index + 0, vel_index + 1),
-    data_covariance_mat(pedal_index + 1, vel_index + 1);
-
-  Eigen::Vector4d mean(4);
-  mean << data_mean_mat(pedal_index + 0, vel_index + 0),
-    data_mean_mat(pedal_index + 1, vel_index + 0), data_mean_mat(pedal_index + 0, vel_index + 1),
-    data_mean_mat(pedal_index + 1, vel_index + 1);
-
-  const int vel_idx_l = vel_index + 0;
-  const int vel_idx_h = vel_index + 1;
-  const int ped_idx_l = pedal_index + 0;
-  const int ped_idx_h = pedal_index + 1;
-
-  Eigen::VectorXd map_offset(4);
-  map_offset(0) = map_offset_vec.at(ped_idx_l).at(vel_idx_l);
-  map_offset(1) = map_offset_vec.at(ped_idx_h).at(vel_idx_l);
-  map_offset(2) = map_offset_vec.at(ped_idx_l).at(vel_idx_h);
-  map_offset(3) = map_offset_vec.at(ped_idx_h).at(vel_idx_h);
-
-  Eigen::VectorXd updated_map_offset(4);
-
-  Eigen::MatrixXd covariance = covariance_mat.at(ped_idx_l).at(vel_idx_l);
-
-  /* calculate adaptive map offset */
-  Eigen::MatrixXd G(4, 4);
-  Eigen::RowVectorXd phiT(4);
-  phiT = phi.transpose();
-  double rk = phiT * covariance * phi;
-
-  G = covariance * phi / (forgetting_factor_ + rk);
-  double beta = rk > 0 ? (forgetting_factor_ - (1 - forgetting_factor_) / rk) : 1;
-  covariance = covariance - covariance * phi * phiT * covariance / (1 / beta + rk);  // anti-windup
-  double eta_hat = phiT * theta;
-
-  const double error_map_offset = measured_acc - eta_hat;
-  updated_map_offset = map_offset + G * error_map_offset;
-
-  for (int i = 0; i < 4; i++) {
-    const double pre_mean = mean(i);
-    mean(i) = (weighted_sum(i) * pre_mean + error_map_offset) / (weighted_sum(i) + 1);
-    sigma(i) =
-      (weighted_sum(i) * (sigma(i) + pre_mean * pre_mean) + error_map_offset * error_map_offset) /
-        (weighted_sum(i) + 1) -
-      mean(i) * mean(i);
-    weighted_sum(i) = weighted_sum(i) + 1;
-  }
-
-  /* input calculated result and update map */
-  map_offset_vec.at(ped_idx_l).at(vel_idx_l) = updated_map_offset(0);
-  map_offset_vec.at(ped_idx_h).at(vel_idx_l) = updated_map_offset(1);
-  map_offset_vec.at(ped_idx_l).at(vel_idx_h) = updated_map_offset(2);
-  map_offset_vec.at(ped_idx_h).at(vel_idx_h) = updated_map_offset(3);
-
-  data_covariance_mat(ped_idx_l, vel_idx_l) = sigma(0);
-  data_covariance_mat(ped_idx_h, vel_idx_l) = sigma(1);
-  data_covariance_mat(ped_idx_l, vel_idx_h) = sigma(2);
-  data_covariance_mat(ped_idx_h, vel_idx_h) = sigma(3);
-
-  data_weighted_num(ped_idx_l, vel_idx_l) = weighted_sum(0);
-  data_weighted_num(ped_idx_h, vel_idx_l) = weighted_sum(1);
-  data_weighted_num(ped_idx_l, vel_idx_h) = weighted_sum(2);
-  data_weighted_num(ped_idx_h, vel_idx_h) = weighted_sum(3);
-
-  data_mean_mat(ped_idx_l, vel_idx_l) = mean(0);
-  data_mean_mat(ped_idx_h, vel_idx_l) = mean(1);
-  data_mean_mat(ped_idx_l, vel_idx_h) = mean(2);
-  data_mean_mat(ped_idx_h, vel_idx_h) = mean(3);
-
-  covariance_mat.at(ped_idx_l).at(vel_idx_l) = covariance;
-
-  update_map_value.at(pedal_index + 0).at(vel_index + 0) =
-    map_value.at(pedal_index + 0).at(vel_index + 0) + map_offset(0);
-  update_map_value.at(pedal_index + 1).at(vel_index + 0) =
-    map_value.at(pedal_index + 1).at(vel_index + 0) + map_offset(1);
-  update_map_value.at(pedal_index + 0).at(vel_index + 1) =
-    map_value.at(pedal_index + 0).at(vel_index + 1) + map_offset(2);
-  update_map_value.at(pedal_index + 1).at(vel_index + 1) =
-    map_value.at(pedal_index + 1).at(vel_index + 1) + map_offset(3);
-
-  offset_covariance_value.at(pedal_index + 0).at(vel_index + 0) = std::sqrt(sigma(0));
-  offset_covariance_value.at(pedal_index + 1).at(vel_index + 1) = std::sqrt(sigma(1));
-  offset_covariance_value.at(pedal_index + 0).at(vel_index + 0) = std::sqrt(sigma(2));
-  offset_covariance_value.at(pedal_index + 1).at(vel_index + 1) = std::sqrt(sigma(3));
-
-  return true;
-}
-
-bool AccelBrakeMapCalibrator::updateEachValOffset(
-  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-  const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
-  const double map_acc)
-{
-  // pre-defined
-  static Map map_offset_vec_(
-    accel_map_value_.size() + brake_map_value_.size() - 1,
-    std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static Map covariance_vec_(
-    accel_map_value_.size() + brake_map_value_.size() - 1,
-    std::vector<double>(accel_map_value_.at(0).size(), covariance_));
-
-  const int vel_idx = accel_mode ? accel_vel_index : brake_vel_index;
-  int ped_idx = accel_mode ? accel_pedal_index : brake_pedal_index;
-  ped_idx = getUnifiedIndexFromAccelBrakeIndex(accel_mode, ped_idx);
-  double map_offset = map_offset_vec_.at(ped_idx).at(vel_idx);
-  double covariance = covariance_vec_.at(ped_idx).at(vel_idx);
-
-  /* calculate adaptive map offset */
-  const double phi = 1.0;
-  covariance = (covariance - (covariance * phi * phi * covariance) /
-                               (forgetting_factor_ + phi * covariance * phi)) /
-               forgetting_factor_;
-
-  const double coef = (covariance * phi) / (forgetting_factor_ + phi * covariance * phi);
-
-  const double error_map_offset = measured_acc - map_acc;
-  map_offset = map_offset + coef * error_map_offset;
-
-  RCLCPP_DEBUG_STREAM(
-    get_logger(), "index: " << ped_idx << ", " << vel_idx
-                            << ": map_offset_ = " << map_offset_vec_.at(ped_idx).at(vel_idx)
-                            << " -> " << map_offset << "\t"
-                            << " covariance = " << covariance);
-
-  /* input calculated result and update map */
-  map_offset_vec_.at(ped_idx).at(vel_idx) = map_offset;
-  covariance_vec_.at(ped_idx).at(vel_idx) = covariance;
-  if (accel_mode) {
-    update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index) =
-      accel_map_value_.at(accel_pedal_index).at(accel_vel_index) + map_offset;
-  } else {
-    update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index) =
-      brake_map_value_.at(brake_pedal_index).at(brake_vel_index) + map_offset;
-  }
+  map_value_data_.at(unified_pedal_index).at(vel_index).emplace_back(measured_acc);
   return true;
 }
 
-void AccelBrakeMapCalibrator::updateTotalMapOffset(const double measured_acc, const double map_acc)
-{
-  /* calculate adaptive map offset */
-  const double phi = 1.0;
-  covariance_ = (covariance_ - (covariance_ * phi * phi * covariance_) /
-                                 (forgetting_factor_ + phi * covariance_ * phi)) /
-                forgetting_factor_;
-
-  const double coef = (covariance_ * phi) / (forgetting_factor_ + phi * covariance_ * phi);
-  const double error_map_offset = measured_acc - map_acc;
-  map_offset_ = map_offset_ + coef * error_map_offset;
-
-  RCLCPP_DEBUG_STREAM(
-    get_logger(), "map_offset_ = " << map_offset_ << "\t"
-                                   << "covariance = " << covariance_);
-
-  /* update map */
-  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
-      update_accel_map_value_.at(ped_idx).at(vel_idx) =
-        accel_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
-    }
-  }
-  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
-      update_brake_map_value_.at(ped_idx).at(vel_idx) =
-        brake_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
-    }
-  }
-}
-
 std::vector<double> AccelBrakeMapCalibrator::getMapColumnFromUnifiedIndex(
   const Map & accel_map_value, const Map & brake_map_value, const std::size_t index)
 {
@@ -1099,19 +688,6 @@ double AccelBrakeMapCalibrator::getPedalValueFromUnifiedIndex(const std::size_t
   }
 }
 
-int AccelBrakeMapCalibrator::getUnifiedIndexFromAccelBrakeIndex(
-  const bool accel_map, const std::size_t index)
-{
-  // accel_map=true: accel_map; accel_map=false: brake_map
-  if (accel_map) {
-    // accel map
-    return index + brake_map_value_.size() - 1;
-  } else {
-    // brake map
-    return brake_map_value_.size() - index - 1;
-  }
-}
-
 double AccelBrakeMapCalibrator::getPitchCompensatedAcceleration()
 {
   // It works correctly only when the velocity is positive.
@@ -1625,40 +1201,18 @@ void AccelBrakeMapCalibrator::publishUpdateSuggestFlag()
 }
 
 bool AccelBrakeMapCalibrator::writeMapToCSV(
-  std::vector<double> vel_index, std::vector<double> pedal_index, Map value_map,
-  std::string filename)
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const MapGrid & value_map, const std::string & filename)
 {
   if (update_success_count_ == 0) {
     return false;
   }
 
-  std::ofstream csv_file(filename);
-
-  if (!csv_file.is_open()) {
+  if (!accel_brake_map_calibrator::writeMapToCSV(
+        vel_index, pedal_index, value_map, precision_, filename)) {
     RCLCPP_WARN(get_logger(), "Failed to open csv file : %s", filename.c_str());
     return false;
   }
-
-  csv_file << "default,";
-  for (std::size_t v = 0; v < vel_index.size(); v++) {
-    csv_file << vel_index.at(v);
-    if (v != vel_index.size() - 1) {
-      csv_file << ",";
-    }
-  }
-  csv_file << "\n";
-
-  for (std::size_t p = 0; p < pedal_index.size(); p++) {
-    csv_file << pedal_index.at(p) << ",";
-    for (std::size_t v = 0; v < vel_index.size(); v++) {
-      csv_file << std::fixed << std::setprecision(precision_) << value_map.at(p).at(v);
-      if (v != vel_index.size() - 1) {
-        csv_file << ",";
-      }
-    }
-    csv_file << "\n";
-  }
-  csv_file.close();
   RCLCPP_DEBUG_STREAM(get_logger(), "output map to " << filename);
   return true;
 }
@@ -0,0 +1,414 @@
+//
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "accel_brake_map_calibrator/calibrator_core.hpp"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace accel_brake_map_calibrator
+{
+
+MapGrid::MapGrid(const Map & map)
+: rows_(map.size()), cols_(map.empty() ? 0 : map.front().size())
+{
+  values_.reserve(rows_ * cols_);
+  for (const auto & row : map) {
+    values_.insert(values_.end(), row.begin(), row.end());
+  }
+}
+
+Map MapGrid::toMap() const
+{
+  Map map(rows_);
+  for (std::size_t row = 0; row < rows_; row++) {
+    const auto begin = values_.begin() + row * cols_;
+    map.at(row).assign(begin, begin + cols_);
+  }
+  return map;
+}
+
+CalibratorCore::CalibratorCore(
+  const raw_vehicle_cmd_converter::AccelMap & accel_map,
+  const raw_vehicle_cmd_converter::BrakeMap & brake_map, const CalibratorParam & param)
+: param_(param),
+  accel_vel_index_(accel_map.getVelIdx()),
+  brake_vel_index_(brake_map.getVelIdx()),
+  accel_pedal_index_(accel_map.getThrottleIdx()),
+  brake_pedal_index_(brake_map.getBrakeIdx()),
+  accel_map_value_(accel_map.getAccelMap()),
+  brake_map_value_(brake_map.getBrakeMap()),
+  update_accel_map_value_(accel_map_value_),
+  update_brake_map_value_(brake_map_value_),
+  covariance_(param.initial_covariance)
+{
+  const auto genConstMat = [](const MapGrid & map, const double val) {
+    return MapGrid(map.rows(), map.cols(), val);
+  };
+  accel_offset_covariance_value_ = genConstMat(accel_map_value_, covariance_);
+  brake_offset_covariance_value_ = genConstMat(brake_map_value_, covariance_);
+
+  map_offset_vec_ = MapGrid(
+    accel_map_value_.rows() + brake_map_value_.rows() - 1, accel_map_value_.cols(), map_offset_);
+  covariance_vec_ = MapGrid(map_offset_vec_.rows(), map_offset_vec_.cols(), covariance_);
+
+  accel_map_offset_vec_ = genConstMat(accel_map_value_, map_offset_);
+  brake_map_offset_vec_ = genConstMat(brake_map_value_, map_offset_);
+  const auto genCovarianceMat = [this](const MapGrid & map) {
+    const std::size_t num = (map.rows() - 1) * (map.cols() - 1);
+    const Eigen::Matrix4d initial_covariance = Eigen::Matrix4d::Identity() * covariance_;
+    std::vector<double> covariance_mat(16 * num);
+    for (std::size_t i = 0; i < num; i++) {
+      std::copy(initial_covariance.data(), initial_covariance.data() + 16, &covariance_mat[16 * i]);
+    }
+    return covariance_mat;
+  };
+  accel_covariance_mat_ = genCovarianceMat(accel_map_value_);
+  brake_covariance_mat_ = genCovarianceMat(brake_map_value_);
+
+  accel_data_mean_mat_ = genConstMat(accel_map_value_, map_offset_);
+  brake_data_mean_mat_ = genConstMat(brake_map_value_, map_offset_);
+  accel_data_covariance_mat_ = genConstMat(accel_map_value_, covariance_);
+  brake_data_covariance_mat_ = genConstMat(brake_map_value_, covariance_);
+  accel_data_num_ = genConstMat(accel_map_value_, 1);
+  brake_data_num_ = genConstMat(brake_map_value_, 1);
+}
+
+bool CalibratorCore::update(
+  const double velocity, const double accel_pedal, const double brake_pedal,
+  const double measured_acc, int * unified_pedal_index, int * vel_index)
+{
+  const bool accel_mode = accel_pedal > std::numeric_limits<double>::epsilon();
+  const double pedal = accel_mode ? accel_pedal : brake_pedal;
+
+  // get pedal index
+  int pedal_idx = 0;
+  int vel_idx = 0;
+  if (!indexValueSearch(
+        accel_mode ? accel_pedal_index_ : brake_pedal_index_, pedal, param_.pedal_diff_threshold,
+        &pedal_idx)) {
+    // not match pedal output to pedal value in index
+    return false;
+  }
+  if (!indexValueSearch(
+        accel_mode ? accel_vel_index_ : brake_vel_index_, velocity,
+        param_.velocity_diff_threshold, &vel_idx)) {
+    // not match current velocity to velocity value in index
+    return false;
+  }
+
+  // update map
+  auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
+  const double map_acc = update_map_value(pedal_idx, vel_idx);
+  if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL) {
+    updateEachValOffset(accel_mode, pedal_idx, vel_idx, measured_acc, map_acc);
+  } else if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_TOTAL) {
+    updateTotalMapOffset(measured_acc, map_acc);
+  } else if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
+    updateFourCellAroundOffset(accel_mode, pedal_idx, vel_idx, pedal, velocity, measured_acc);
+  }
+
+  // when update 0 pedal index, update another map
+  if (pedal_idx == 0) {
+    auto & another_map_value = accel_mode ? update_brake_map_value_ : update_accel_map_value_;
+    another_map_value(0, vel_idx) = update_map_value(0, vel_idx);
+    if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
+      another_map_value(0, vel_idx + 1) = update_map_value(0, vel_idx + 1);
+    }
+  }
+
+  // take consistency of map
+  takeConsistencyOfAccelMap();
+  takeConsistencyOfBrakeMap();
+
+  if (unified_pedal_index) {
+    *unified_pedal_index = getUnifiedIndexFromAccelBrakeIndex(accel_mode, pedal_idx);
+  }
+  if (vel_index) {
+    *vel_index = vel_idx;
+  }
+  return true;
+}
+
+int CalibratorCore::getUnifiedIndexFromAccelBrakeIndex(
+  const bool accel_map, const std::size_t index) const
+{
+  if (accel_map) {
+    // accel map
+    return index + brake_map_value_.rows() - 1;
+  } else {
+    // brake map
+    return brake_map_value_.rows() - index - 1;
+  }
+}
+
+bool CalibratorCore::indexValueSearch(
+  const std::vector<double> & value_index, const double value, const double value_thresh,
+  int * searched_index) const
+{
+  if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_FOUR_CELL_AROUND) {
+    /*  return lower left index.
+    +-------+   +:grid
+    |    *  |   *:given data
+    |       |   o:index to return
+    o-------+
+    */
+    if (value < 0) {
+      std::cerr << "error : invalid value." << std::endl;
+      return false;
+    }
+    double old_diff_value = -999;  // TODO(Hirano)
+    for (std::size_t i = 0; i < value_index.size(); i++) {
+      const double diff_value = value_index.at(i) - value;
+      if (diff_value <= 0 && old_diff_value < diff_value) {
+        *searched_index = i;
+        old_diff_value = diff_value;
+      } else {
+        return true;
+      }
+    }
+  } else {
+    for (std::size_t i = 0; i < value_index.size(); i++) {
+      const double diff_value = std::fabs(value_index.at(i) - value);
+      if (diff_value <= value_thresh) {
+        *searched_index = i;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void CalibratorCore::updateEachValOffset(
+  const bool accel_mode, const int pedal_index, const int vel_index, const double measured_acc,
+  const double map_acc)
+{
+  const int ped_idx = getUnifiedIndexFromAccelBrakeIndex(accel_mode, pedal_index);
+  double & map_offset = map_offset_vec_(ped_idx, vel_index);
+  double & covariance = covariance_vec_(ped_idx, vel_index);
+
+  /* calculate adaptive map offset */
+  const double phi = 1.0;
+  const double forgetting_factor = param_.forgetting_factor;
+  covariance = (covariance - (covariance * phi * phi * covariance) /
+                               (forgetting_factor + phi * covariance * phi)) /
+               forgetting_factor;
+
+  const double coef = (covariance * phi) / (forgetting_factor + phi * covariance * phi);
+
+  const double error_map_offset = measured_acc - map_acc;
+  map_offset = map_offset + coef * error_map_offset;
+
+  /* update map */
+  if (accel_mode) {
+    update_accel_map_value_(pedal_index, vel_index) =
+      accel_map_value_(pedal_index, vel_index) + map_offset;
+  } else {
+    update_brake_map_value_(pedal_index, vel_index) =
+      brake_map_value_(pedal_index, vel_index) + map_offset;
+  }
+}
+
+void CalibratorCore::updateTotalMapOffset(const double measured_acc, const double map_acc)
+{
+  /* calculate adaptive map offset */
+  const double phi = 1.0;
+  const double forgetting_factor = param_.forgetting_factor;
+  covariance_ = (covariance_ - (covariance_ * phi * phi * covariance_) /
+                                 (forgetting_factor + phi * covariance_ * phi)) /
+                forgetting_factor;
+
+  const double coef = (covariance_ * phi) / (forgetting_factor + phi * covariance_ * phi);
+  const double error_map_offset = measured_acc - map_acc;
+  map_offset_ = map_offset_ + coef * error_map_offset;
+
+  /* update map (the last pedal row and velocity column are kept) */
+  const auto addOffset = [this](const MapGrid & map_value, MapGrid & update_map_value) {
+    const std::size_t cols = map_value.cols();
+    for (std::size_t ped_idx = 0; ped_idx + 1 < map_value.rows(); ped_idx++) {
+      const double * src = map_value.data() + ped_idx * cols;
+      double * dst = update_map_value.data() + ped_idx * cols;
+      for (std::size_t vel_idx = 0; vel_idx + 1 < cols; vel_idx++) {
+        dst[vel_idx] = src[vel_idx] + map_offset_;
+      }
+    }
+  };
+  addOffset(accel_map_value_, update_accel_map_value_);
+  addOffset(brake_map_value_, update_brake_map_value_);
+}
+
+void CalibratorCore::updateFourCellAroundOffset(
+  const bool accel_mode, const int pedal_index, const int vel_index, const double pedal,
+  const double velocity, const double measured_acc)
+{
+  auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
+  auto & offset_covariance_value =
+    accel_mode ? accel_offset_covariance_value_ : brake_offset_covariance_value_;
+  const auto & map_value = accel_mode ? accel_map_value_ : brake_map_value_;
+  const auto & pedal_index_ = accel_mode ? accel_pedal_index_ : brake_pedal_index_;
+  const auto & vel_index_ = accel_mode ? accel_vel_index_ : brake_vel_index_;
+  auto & map_offset_vec = accel_mode ? accel_map_offset_vec_ : brake_map_offset_vec_;
+  auto & covariance_mat = accel_mode ? accel_covariance_mat_ : brake_covariance_mat_;
+  auto & data_mean_mat = accel_mode ? accel_data_mean_mat_ : brake_data_mean_mat_;
+  auto & data_covariance_mat = accel_mode ? accel_data_covariance_mat_ : brake_data_covariance_mat_;
+  auto & data_weighted_num = accel_mode ? accel_data_num_ : brake_data_num_;
+
+  const std::size_t ped_idx_l = pedal_index + 0;
+  const std::size_t ped_idx_h = pedal_index + 1;
+  const std::size_t vel_idx_l = vel_index + 0;
+  const std::size_t vel_idx_h = vel_index + 1;
+  // cells in the order of phi: (l, l), (h, l), (l, h), (h, h)
+  const std::size_t cell_ped_idx[4] = {ped_idx_l, ped_idx_h, ped_idx_l, ped_idx_h};
+  const std::size_t cell_vel_idx[4] = {vel_idx_l, vel_idx_l, vel_idx_h, vel_idx_h};
+
+  const double xl = pedal_index_.at(ped_idx_l);
+  const double xh = pedal_index_.at(ped_idx_h);
+  const double rx = (pedal - xl) / (xh - xl);
+  const double yl = vel_index_.at(vel_idx_l);
+  const double yh = vel_index_.at(vel_idx_h);
+  const double ry = (velocity - yl) / (yh - yl);
+
+  const Eigen::Vector4d phi((1 - rx) * (1 - ry), rx * (1 - ry), (1 - rx) * ry, rx * ry);
+  Eigen::Vector4d theta;
+  Eigen::Vector4d map_offset;
+  for (int i = 0; i < 4; i++) {
+    theta(i) = update_map_value(cell_ped_idx[i], cell_vel_idx[i]);
+    map_offset(i) = map_offset_vec(cell_ped_idx[i], cell_vel_idx[i]);
+  }
+
+  Eigen::Map<Eigen::Matrix4d> covariance(
+    &covariance_mat[16 * (ped_idx_l * (map_value.cols() - 1) + vel_idx_l)]);
+
+  /* calculate adaptive map offset */
+  // the covariance stays symmetric, so that phi^T * P = (P * phi)^T
+  const double forgetting_factor = param_.forgetting_factor;
+  const Eigen::Vector4d covariance_phi = covariance * phi;
+  const double rk = phi.dot(covariance_phi);
+
+  const Eigen::Vector4d G = covariance_phi / (forgetting_factor + rk);
+  const double beta = rk > 0 ? (forgetting_factor - (1 - forgetting_factor) / rk) : 1;
+  covariance -= covariance_phi * covariance_phi.transpose() / (1 / beta + rk);  // anti-windup
+  const double eta_hat = phi.dot(theta);
+
+  const double error_map_offset = measured_acc - eta_hat;
+  const Eigen::Vector4d updated_map_offset = map_offset + G * error_map_offset;
+
+  /* input calculated result and update map */
+  for (int i = 0; i < 4; i++) {
+    const std::size_t ped_idx = cell_ped_idx[i];
+    const std::size_t vel_idx = cell_vel_idx[i];
+    double & mean = data_mean_mat(ped_idx, vel_idx);
+    double & sigma = data_covariance_mat(ped_idx, vel_idx);
+    double & weighted_sum = data_weighted_num(ped_idx, vel_idx);
+    const double pre_mean = mean;
+    mean = (weighted_sum * pre_mean + error_map_offset) / (weighted_sum + 1);
+    sigma = (weighted_sum * (sigma + pre_mean * pre_mean) + error_map_offset * error_map_offset) /
+              (weighted_sum + 1) -
+            mean * mean;
+    weighted_sum = weighted_sum + 1;
+
+    map_offset_vec(ped_idx, vel_idx) = updated_map_offset(i);
+    update_map_value(ped_idx, vel_idx) = map_value(ped_idx, vel_idx) + map_offset(i);
+    offset_covariance_value(ped_idx, vel_idx) = std::sqrt(sigma);
+  }
+}
+
+void CalibratorCore::takeConsistencyOfAccelMap()
+{
+  const double bit = std::pow(1e-01, param_.precision);
+  const std::size_t cols = update_accel_map_value_.cols();
+  for (std::size_t ped_idx = 0; ped_idx + 1 < update_accel_map_value_.rows(); ped_idx++) {
+    double * current = update_accel_map_value_.data() + ped_idx * cols;
+    double * next_ped = current + cols;
+    for (std::size_t vel_idx = 0; vel_idx + 1 < cols; vel_idx++) {
+      const double current_acc = current[vel_idx];
+
+      if (current_acc <= current[vel_idx + 1]) {
+        // the higher the velocity, the lower the acceleration
+        current[vel_idx + 1] = current_acc - bit;
+      }
+
+      if (current_acc >= next_ped[vel_idx]) {
+        // the higher the accel pedal, the higher the acceleration
+        next_ped[vel_idx] = current_acc + bit;
+      }
+    }
+  }
+}
+
+void CalibratorCore::takeConsistencyOfBrakeMap()
+{
+  const double bit = std::pow(1e-01, param_.precision);
+  const std::size_t cols = update_brake_map_value_.cols();
+  for (std::size_t ped_idx = 0; ped_idx + 1 < update_brake_map_value_.rows(); ped_idx++) {
+    double * current = update_brake_map_value_.data() + ped_idx * cols;
+    double * next_ped = current + cols;
+    for (std::size_t vel_idx = 0; vel_idx + 1 < cols; vel_idx++) {
+      const double current_acc = current[vel_idx];
+
+      if (current_acc <= current[vel_idx + 1]) {
+        // the higher the velocity, the lower the acceleration
+        current[vel_idx + 1] = current_acc - bit;
+      }
+
+      if (current_acc <= next_ped[vel_idx]) {
+        // the higher the brake pedal, the lower the acceleration
+        next_ped[vel_idx] = current_acc - bit;
+      }
+    }
+  }
+}
+
+bool writeMapToCSV(
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const MapGrid & value_map, const int precision, const std::string & filename)
+{
+  std::ofstream csv_file(filename);
+  if (!csv_file.is_open()) {
+    return false;
+  }
+
+  csv_file << "default,";
+  for (std::size_t v = 0; v < vel_index.size(); v++) {
+    csv_file << vel_index.at(v);
+    if (v != vel_index.size() - 1) {
+      csv_file << ",";
+    }
+  }
+  csv_file << "\n";
+
+  for (std::size_t p = 0; p < pedal_index.size(); p++) {
+    csv_file << pedal_index.at(p) << ",";
+    for (std::size_t v = 0; v < vel_index.size(); v++) {
+      csv_file << std::fixed << std::setprecision(precision) << value_map(p, v);
+      if (v != vel_index.size() - 1) {
+        csv_file << ",";
+      }
+    }
+    csv_file << "\n";
+  }
+  return true;
+}
+
+}  // namespace accel_brake_map_calibrator
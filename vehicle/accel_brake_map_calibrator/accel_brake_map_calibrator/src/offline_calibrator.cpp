@@ -0,0 +1,211 @@
+//
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Calibrate the accel / brake map from the log written by the node (output_log_file with
+// pedal_accel_graph_output) at full CPU speed, without ROS.
+
+#include "accel_brake_map_calibrator/calibrator_core.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+using accel_brake_map_calibrator::CalibratorCore;
+using accel_brake_map_calibrator::CalibratorParam;
+
+// columns of the log, see AccelBrakeMapCalibrator::addIndexToCSV
+enum LOG_COLUMN {
+  VELOCITY = 1,
+  FINAL_ACCEL = 4,
+  ACCEL_PEDAL = 5,
+  BRAKE_PEDAL = 6,
+  ACCEL_PEDAL_SPEED = 7,
+  BRAKE_PEDAL_SPEED = 8,
+  PITCH = 9,
+  STEER = 10,
+  JERK = 11,
+};
+constexpr std::size_t num_used_columns = 12;
+
+// same default values as config/accel_brake_map_calibrator.param.yaml
+struct FilterParam
+{
+  double velocity_min_threshold{0.1};
+  double max_steer_threshold{0.2};
+  double max_pitch_threshold{0.02};
+  double max_jerk_threshold{0.7};
+  double pedal_velocity_thresh{0.15};
+};
+
+// same checks as AccelBrakeMapCalibrator::timerCallback
+bool isValidData(const std::vector<double> & row, const FilterParam & param)
+{
+  constexpr double epsilon = std::numeric_limits<double>::epsilon();
+  return row.at(VELOCITY) >= param.velocity_min_threshold &&
+         std::fabs(row.at(PITCH)) <= param.max_pitch_threshold &&
+         std::fabs(row.at(STEER)) <= param.max_steer_threshold &&
+         std::fabs(row.at(JERK)) <= param.max_jerk_threshold &&
+         !(row.at(ACCEL_PEDAL) > epsilon && row.at(BRAKE_PEDAL) > epsilon) &&
+         std::fabs(row.at(ACCEL_PEDAL_SPEED)) <= param.pedal_velocity_thresh &&
+         std::fabs(row.at(BRAKE_PEDAL_SPEED)) <= param.pedal_velocity_thresh;
+}
+
+bool parseRow(const std::string & line, std::vector<double> * row)
+{
+  row->clear();
+  std::stringstream ss(line);
+  std::string cell;
+  while (row->size() < num_used_columns && std::getline(ss, cell, ',')) {
+    try {
+      row->push_back(std::stod(cell));
+    } catch (const std::exception &) {
+      return false;
+    }
+  }
+  return row->size() == num_used_columns;
+}
+
+void printUsage(const char * program)
+{
+  std::printf(
+    "usage: %s <default_map_dir> <log_csv> <output_dir> [--<parameter> <value>]...\n"
+    "parameters: update_method, initial_covariance, velocity_min_threshold,\n"
+    "  velocity_diff_threshold, pedal_diff_threshold, max_steer_threshold, max_pitch_threshold,\n"
+    "  max_jerk_threshold, pedal_velocity_thresh, precision\n",
+    program);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 4 || (argc - 4) % 2 != 0) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  const std::string default_map_dir = argv[1];
+  const std::string log_file = argv[2];
+  const std::string output_dir = argv[3];
+
+  CalibratorParam param;
+  FilterParam filter_param;
+  param.update_method = accel_brake_map_calibrator::UPDATE_OFFSET_FOUR_CELL_AROUND;
+  const std::map<std::string, double *> double_params = {
+    {"initial_covariance", &param.initial_covariance},
+    {"velocity_diff_threshold", &param.velocity_diff_threshold},
+    {"pedal_diff_threshold", &param.pedal_diff_threshold},
+    {"velocity_min_threshold", &filter_param.velocity_min_threshold},
+    {"max_steer_threshold", &filter_param.max_steer_threshold},
+    {"max_pitch_threshold", &filter_param.max_pitch_threshold},
+    {"max_jerk_threshold", &filter_param.max_jerk_threshold},
+    {"pedal_velocity_thresh", &filter_param.pedal_velocity_thresh},
+  };
+  const std::map<std::string, int> update_methods = {
+    {"update_offset_each_cell", accel_brake_map_calibrator::UPDATE_OFFSET_EACH_CELL},
+    {"update_offset_total", accel_brake_map_calibrator::UPDATE_OFFSET_TOTAL},
+    {"update_offset_four_cell_around", accel_brake_map_calibrator::UPDATE_OFFSET_FOUR_CELL_AROUND},
+  };
+  for (int i = 4; i < argc; i += 2) {
+    const std::string option = argv[i];
+    const std::string name = option.rfind("--", 0) == 0 ? option.substr(2) : "";
+    const std::string value = argv[i + 1];
+    try {
+      if (name == "update_method") {
+        param.update_method = update_methods.at(value);
+      } else if (name == "precision") {
+        param.precision = std::stoi(value);
+      } else {
+        *double_params.at(name) = std::stod(value);
+      }
+    } catch (const std::exception &) {
+      std::printf("invalid parameter: %s %s\n", argv[i], argv[i + 1]);
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  raw_vehicle_cmd_converter::AccelMap accel_map;
+  raw_vehicle_cmd_converter::BrakeMap brake_map;
+  if (
+    !accel_map.readAccelMapFromCSV(default_map_dir + "/accel_map.csv") ||
+    !brake_map.readBrakeMapFromCSV(default_map_dir + "/brake_map.csv")) {
+    std::printf("Cannot read accel/brake map in %s\n", default_map_dir.c_str());
+    return 1;
+  }
+
+  std::ifstream log(log_file);
+  if (!log.is_open()) {
+    std::printf("Cannot open log file %s\n", log_file.c_str());
+    return 1;
+  }
+
+  CalibratorCore calibrator(accel_map, brake_map, param);
+  std::size_t num_data = 0;
+  std::size_t num_invalid_line = 0;
+  std::size_t num_filtered = 0;
+  std::size_t num_updated = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  std::string line;
+  std::getline(log, line);  // header
+  std::vector<double> row;
+  while (std::getline(log, line)) {
+    if (!parseRow(line, &row)) {
+      num_invalid_line++;
+      continue;
+    }
+    num_data++;
+    if (!isValidData(row, filter_param)) {
+      num_filtered++;
+      continue;
+    }
+    num_updated += calibrator.update(
+      row.at(VELOCITY), row.at(ACCEL_PEDAL), row.at(BRAKE_PEDAL), row.at(FINAL_ACCEL));
+  }
+  const double elapsed_time =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+  std::printf(
+    "data: %zu, invalid lines: %zu, filtered: %zu, updated: %zu (%.3f s, %.0f data/s)\n", num_data,
+    num_invalid_line, num_filtered, num_updated, elapsed_time,
+    elapsed_time > 0.0 ? num_data / elapsed_time : 0.0);
+  if (num_updated == 0) {
+    std::printf("The map is not updated. No file is written.\n");
+    return 1;
+  }
+
+  const auto output_accel_file = output_dir + "/accel_map.csv";
+  const auto output_brake_file = output_dir + "/brake_map.csv";
+  if (
+    !accel_brake_map_calibrator::writeMapToCSV(
+      accel_map.getVelIdx(), accel_map.getThrottleIdx(), calibrator.getUpdatedAccelMap(),
+      param.precision, output_accel_file) ||
+    !accel_brake_map_calibrator::writeMapToCSV(
+      brake_map.getVelIdx(), brake_map.getBrakeIdx(), calibrator.getUpdatedBrakeMap(),
+      param.precision, output_brake_file)) {
+    std::printf("Failed to write the maps in %s\n", output_dir.c_str());
+    return 1;
+  }
+  std::printf("output maps to %s and %s\n", output_accel_file.c_str(), output_brake_file.c_str());
+  return 0;
+}
@@ -16,6 +16,7 @@
 #define RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
+#include "raw_vehicle_cmd_converter/map_table.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -43,6 +44,7 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> throttle_index_;
   std::vector<std::vector<double>> accel_map_;
+  MapTable accel_table_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
@@ -16,6 +16,7 @@
 #define RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
+#include "raw_vehicle_cmd_converter/map_table.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -44,6 +45,7 @@ private:
   std::vector<double> brake_index_;
   std::vector<double> brake_index_rev_;
   std::vector<std::vector<double>> brake_map_;
+  MapTable brake_table_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
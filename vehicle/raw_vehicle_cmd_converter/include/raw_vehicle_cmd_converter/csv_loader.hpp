@@ -38,6 +38,8 @@ public:
   static std::vector<double> getColumnIndex(const Table & table);
   static double clampValue(
     const double val, const std::vector<double> & ranges, const std::string & name);
+  static double clampValue(
+    const double val, const double min_value, const double max_value, const char * name);
 
 private:
   std::string csv_path_;
@@ -0,0 +1,104 @@
+//  Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef RAW_VEHICLE_CMD_CONVERTER__MAP_TABLE_HPP_
+#define RAW_VEHICLE_CMD_CONVERTER__MAP_TABLE_HPP_
+
+#include "raw_vehicle_cmd_converter/csv_loader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+/**
+ * @brief map stored in a contiguous row-major array, for allocation-free lookups
+ * @details the lookups give the same results as interpolating each row with interpolation::lerp
+ * and then interpolating the resulting column, which is how the maps were evaluated before.
+ * The column index must be strictly increasing (see isValidIndex).
+ */
+class MapTable
+{
+public:
+  /// @brief segment of an index containing a key: the key is between index[i] and index[i + 1]
+  struct Segment
+  {
+    size_t index;
+    double ratio;
+  };
+
+  MapTable() = default;
+  explicit MapTable(const Map & map);
+
+  size_t rows() const { return rows_; }
+  size_t cols() const { return cols_; }
+
+  /// @brief true if the index is usable by interpolation::lerp (2 keys or more, increasing)
+  static bool isValidIndex(const std::vector<double> & index);
+
+  /**
+   * @brief find the segment of the key with the convention of interpolation::lerp
+   * @param [in] index strictly increasing index
+   * @param [in] key key within the range of the index
+   */
+  static Segment findSegment(const std::vector<double> & index, const double key);
+
+  /// @brief value of the row interpolated in the column segment
+  double interpolateRow(const size_t row, const Segment & column) const;
+
+  /// @brief value interpolated in the row segment of the column interpolated in the column segment
+  double interpolate(const Segment & row, const Segment & column) const;
+
+  /**
+   * @brief same as interpolation::lerp(keys, values, query) with keys and values given by functions
+   * @details used to interpolate in a column of the map without building it. As interpolation::lerp
+   * it throws std::invalid_argument if the keys are not increasing or the query is out of them.
+   */
+  template <class KeyFunction, class ValueFunction>
+  static double lerp(
+    const size_t size, const KeyFunction & key, const ValueFunction & value, const double query)
+  {
+    for (size_t i = 0; i + 1 < size; ++i) {
+      if (key(i) >= key(i + 1)) {
+        throw std::invalid_argument("Either base_keys or query_keys is not sorted.");
+      }
+    }
+    constexpr double epsilon = 1e-3;
+    const double front = key(0);
+    const double back = key(size - 1);
+    if (query < front - epsilon || back + epsilon < query) {
+      throw std::invalid_argument("query_keys is out of base_keys");
+    }
+    const double clamped_query = std::min(std::max(query, front), back);
+
+    size_t i = 0;
+    while (key(i + 1) < clamped_query) {
+      ++i;
+    }
+    const double ratio = (clamped_query - key(i)) / (key(i + 1) - key(i));
+    return lerpValue(value(i), value(i + 1), ratio);
+  }
+
+private:
+  static double lerpValue(const double src_val, const double dst_val, const double ratio);
+
+  size_t rows_{0};
+  size_t cols_{0};
+  std::vector<double> values_;
+};
+}  // namespace raw_vehicle_cmd_converter
+
+#endif  // RAW_VEHICLE_CMD_CONVERTER__MAP_TABLE_HPP_
@@ -16,6 +16,7 @@
 #define RAW_VEHICLE_CMD_CONVERTER__STEER_MAP_HPP_
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
+#include "raw_vehicle_cmd_converter/map_table.hpp"
 #include "raw_vehicle_cmd_converter/pid.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -36,6 +37,7 @@ private:
   std::vector<double> steer_index_;
   std::vector<double> output_index_;
   std::vector<std::vector<double>> steer_map_;
+  MapTable steer_table_;
   rclcpp::Logger logger_{rclcpp::get_logger("raw_vehicle_cmd_converter").get_child("steer_map")};
 };
 }  // namespace raw_vehicle_cmd_converter
@@ -14,8 +14,6 @@
 
 #include "raw_vehicle_cmd_converter/accel_map.hpp"
 
-#include "interpolation/linear_interpolation.hpp"
-
 #include <algorithm>
 #include <chrono>
 #include <string>
@@ -38,48 +36,52 @@ bool AccelMap::readAccelMapFromCSV(const std::string & csv_path, const bool vali
   vel_index_ = CSVLoader::getRowIndex(table);
   throttle_index_ = CSVLoader::getColumnIndex(table);
   accel_map_ = CSVLoader::getMap(table);
+  if (!MapTable::isValidIndex(vel_index_) || !MapTable::isValidIndex(throttle_index_)) {
+    std::cerr << "Cannot read " << csv_path << ". The indices should be increasing" << std::endl;
+    return false;
+  }
   if (validation && !CSVLoader::validateMap(accel_map_, true)) {
     return false;
   }
+  accel_table_ = MapTable(accel_map_);
   return true;
 }
 
 bool AccelMap::getThrottle(const double acc, double vel, double & throttle) const
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "throttle: vel");
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "throttle: vel");
+  const auto vel_segment = MapTable::findSegment(vel_index_, clamped_vel);
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accelerations : accel_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, accelerations, clamped_vel));
-  }
+  const auto acc_at = [&](const size_t i) { return accel_table_.interpolateRow(i, vel_segment); };
+  const auto throttle_at = [&](const size_t i) { return throttle_index_[i]; };
+
   // calculate throttle
   // When the desired acceleration is smaller than the throttle area, return false => brake sequence
   // When the desired acceleration is greater than the throttle area, return max throttle
-  if (acc < interpolated_acc_vec.front()) {
+  if (acc < acc_at(0)) {
     return false;
-  } else if (interpolated_acc_vec.back() < acc) {
+  } else if (acc_at(accel_table_.rows() - 1) < acc) {
     throttle = throttle_index_.back();
     return true;
   }
-  throttle = interpolation::lerp(interpolated_acc_vec, throttle_index_, acc);
+  throttle = MapTable::lerp(accel_table_.rows(), acc_at, throttle_at, acc);
   return true;
 }
 
 bool AccelMap::getAcceleration(const double throttle, const double vel, double & acc) const
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "throttle: vel");
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (const auto & acc_vec : accel_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-  }
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "throttle: vel");
 
   // calculate throttle
   // When the desired acceleration is smaller than the throttle area, return min acc
   // When the desired acceleration is greater than the throttle area, return max acc
-  const double clamped_throttle = CSVLoader::clampValue(throttle, throttle_index_, "throttle: acc");
-  acc = interpolation::lerp(throttle_index_, interpolated_acc_vec, clamped_throttle);
+  const double clamped_throttle = CSVLoader::clampValue(
+    throttle, throttle_index_.front(), throttle_index_.back(), "throttle: acc");
+  acc = accel_table_.interpolate(
+    MapTable::findSegment(throttle_index_, clamped_throttle),
+    MapTable::findSegment(vel_index_, clamped_vel));
 
   return true;
 }
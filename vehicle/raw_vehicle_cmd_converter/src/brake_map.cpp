@@ -14,8 +14,6 @@
 
 #include "raw_vehicle_cmd_converter/brake_map.hpp"
 
-#include "interpolation/linear_interpolation.hpp"
-
 #include <algorithm>
 #include <string>
 #include <vector>
@@ -36,61 +34,65 @@ bool BrakeMap::readBrakeMapFromCSV(const std::string & csv_path, const bool vali
   brake_index_ = CSVLoader::getColumnIndex(table);
   brake_map_ = CSVLoader::getMap(table);
   brake_index_rev_ = brake_index_;
+  if (!MapTable::isValidIndex(vel_index_) || !MapTable::isValidIndex(brake_index_)) {
+    std::cerr << "Cannot read " << csv_path << ". The indices should be increasing" << std::endl;
+    return false;
+  }
   if (validation && !CSVLoader::validateMap(brake_map_, false)) {
     return false;
   }
   std::reverse(std::begin(brake_index_rev_), std::end(brake_index_rev_));
+  brake_table_ = MapTable(brake_map_);
 
   return true;
 }
 
 bool BrakeMap::getBrake(const double acc, const double vel, double & brake)
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "brake: vel");
-
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "brake: vel");
+  const auto vel_segment = MapTable::findSegment(vel_index_, clamped_vel);
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accelerations : brake_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, accelerations, clamped_vel));
-  }
+  const auto acc_at = [&](const size_t i) { return brake_table_.interpolateRow(i, vel_segment); };
+  const size_t last = brake_table_.rows() - 1;
 
   // calculate brake
   // When the desired acceleration is smaller than the brake area, return max brake on the map
   // When the desired acceleration is greater than the brake area, return min brake on the map
-  if (acc < interpolated_acc_vec.back()) {
+  if (acc < acc_at(last)) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the acc range. Desired acc: %f < min acc on map: %f. return max "
       "value.",
-      acc, interpolated_acc_vec.back());
+      acc, acc_at(last));
     brake = brake_index_.back();
     return true;
-  } else if (interpolated_acc_vec.front() < acc) {
+  } else if (acc_at(0) < acc) {
     brake = brake_index_.front();
     return true;
   }
 
-  std::reverse(std::begin(interpolated_acc_vec), std::end(interpolated_acc_vec));
-  brake = interpolation::lerp(interpolated_acc_vec, brake_index_rev_, acc);
+  // the acceleration decreases with the brake, interpolate in the reversed column
+  const auto reversed_acc_at = [&](const size_t i) { return acc_at(last - i); };
+  const auto reversed_brake_at = [&](const size_t i) { return brake_index_rev_[i]; };
+  brake = MapTable::lerp(brake_table_.rows(), reversed_acc_at, reversed_brake_at, acc);
 
   return true;
 }
 
 bool BrakeMap::getAcceleration(const double brake, const double vel, double & acc) const
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "brake: vel");
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (const auto & acc_vec : brake_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-  }
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "brake: vel");
 
   // calculate brake
   // When the desired acceleration is smaller than the brake area, return min acc
   // When the desired acceleration is greater than the brake area, return min acc
-  const double clamped_brake = CSVLoader::clampValue(brake, brake_index_, "brake: acc");
-  acc = interpolation::lerp(brake_index_, interpolated_acc_vec, clamped_brake);
+  const double clamped_brake =
+    CSVLoader::clampValue(brake, brake_index_.front(), brake_index_.back(), "brake: acc");
+  acc = brake_table_.interpolate(
+    MapTable::findSegment(brake_index_, clamped_brake),
+    MapTable::findSegment(vel_index_, clamped_vel));
 
   return true;
 }
@@ -146,4 +146,15 @@ double CSVLoader::clampValue(
   return val;
 }
 
+double CSVLoader::clampValue(
+  const double val, const double min_value, const double max_value, const char * name)
+{
+  if (val < min_value || max_value < val) {
+    std::cerr << "Input " << name << ": " << val << " is out of range. use closest value."
+              << std::endl;
+    return std::min(std::max(val, min_value), max_value);
+  }
+  return val;
+}
+
 }  // namespace raw_vehicle_cmd_converter
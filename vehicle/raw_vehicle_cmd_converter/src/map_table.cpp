@@ -0,0 +1,63 @@
+//  Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "raw_vehicle_cmd_converter/map_table.hpp"
+
+#include "interpolation/linear_interpolation.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+MapTable::MapTable(const Map & map)
+: rows_(map.size()), cols_(map.empty() ? 0 : map.front().size())
+{
+  values_.reserve(rows_ * cols_);
+  for (const auto & row : map) {
+    values_.insert(values_.end(), row.begin(), row.end());
+  }
+}
+
+bool MapTable::isValidIndex(const std::vector<double> & index)
+{
+  return index.size() >= 2 && interpolation_utils::isIncreasing(index);
+}
+
+MapTable::Segment MapTable::findSegment(const std::vector<double> & index, const double key)
+{
+  // first segment whose end is not lower than the key, as the linear search of lerp
+  const auto end = std::lower_bound(std::next(index.begin()), std::prev(index.end()), key);
+  const size_t i = static_cast<size_t>(std::distance(index.begin(), end)) - 1;
+  return Segment{i, (key - index[i]) / (index[i + 1] - index[i])};
+}
+
+double MapTable::interpolateRow(const size_t row, const Segment & column) const
+{
+  const double * values = values_.data() + row * cols_ + column.index;
+  return lerpValue(values[0], values[1], column.ratio);
+}
+
+double MapTable::interpolate(const Segment & row, const Segment & column) const
+{
+  return lerpValue(
+    interpolateRow(row.index, column), interpolateRow(row.index + 1, column), row.ratio);
+}
+
+double MapTable::lerpValue(const double src_val, const double dst_val, const double ratio)
+{
+  return interpolation::lerp(src_val, dst_val, ratio);
+}
+}  // namespace raw_vehicle_cmd_converter
@@ -14,8 +14,7 @@
 
 #include "raw_vehicle_cmd_converter/steer_map.hpp"
 
-#include "interpolation/linear_interpolation.hpp"
-
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -35,22 +34,35 @@ bool SteerMap::readSteerMapFromCSV(const std::string & csv_path, const bool vali
   steer_index_ = CSVLoader::getRowIndex(table);
   output_index_ = CSVLoader::getColumnIndex(table);
   steer_map_ = CSVLoader::getMap(table);
+  if (!MapTable::isValidIndex(steer_index_) || !MapTable::isValidIndex(output_index_)) {
+    std::cerr << "Cannot read " << csv_path << ". The indices should be increasing" << std::endl;
+    return false;
+  }
   if (validation && !CSVLoader::validateMap(steer_map_, true)) {
     return false;
   }
+  steer_table_ = MapTable(steer_map_);
   return true;
 }
 
 void SteerMap::getSteer(const double steer_rate, const double steer, double & output) const
 {
-  const double clamped_steer = CSVLoader::clampValue(steer, steer_index_, "steer: steer");
-  std::vector<double> steer_rate_interp = {};
-  for (const auto & steer_rate_vec : steer_map_) {
-    steer_rate_interp.push_back(interpolation::lerp(steer_index_, steer_rate_vec, clamped_steer));
-  }
+  const double clamped_steer =
+    CSVLoader::clampValue(steer, steer_index_.front(), steer_index_.back(), "steer: steer");
+  const auto steer_segment = MapTable::findSegment(steer_index_, clamped_steer);
+  const auto steer_rate_at = [&](const size_t i) {
+    return steer_table_.interpolateRow(i, steer_segment);
+  };
+  const auto output_at = [&](const size_t i) { return output_index_[i]; };
 
+  double min_steer_rate = steer_rate_at(0);
+  double max_steer_rate = min_steer_rate;
+  for (size_t i = 1; i < steer_table_.rows(); ++i) {
+    min_steer_rate = std::min(min_steer_rate, steer_rate_at(i));
+    max_steer_rate = std::max(max_steer_rate, steer_rate_at(i));
+  }
   const double clamped_steer_rate =
-    CSVLoader::clampValue(steer_rate, steer_rate_interp, "steer: steer_rate");
-  output = interpolation::lerp(steer_rate_interp, output_index_, clamped_steer_rate);
+    CSVLoader::clampValue(steer_rate, min_steer_rate, max_steer_rate, "steer: steer_rate");
+  output = MapTable::lerp(steer_table_.rows(), steer_rate_at, output_at, clamped_steer_rate);
 }
 }  // namespace raw_vehicle_cmd_converter
@@ -120,6 +120,11 @@ TEST(ConverterTests, LoadValidPath)
   EXPECT_FALSE(accel_map.readAccelMapFromCSV(map_path + "test_1col_map.csv", true));
   EXPECT_FALSE(accel_map.readAccelMapFromCSV(map_path + "test_inconsistent_rows_map.csv", true));
   EXPECT_FALSE(accel_map.readAccelMapFromCSV(map_path + "test_not_interpolatable.csv", true));
+
+  // for indices which cannot be interpolated, even without validation
+  EXPECT_FALSE(accel_map.readAccelMapFromCSV(map_path + "test_not_increasing_index.csv", false));
+  EXPECT_FALSE(brake_map.readBrakeMapFromCSV(map_path + "test_not_increasing_index.csv", false));
+  EXPECT_FALSE(steer_map.readSteerMapFromCSV(map_path + "test_not_increasing_index.csv", false));
 }
 
 TEST(ConverterTests, AccelMapCalculation)